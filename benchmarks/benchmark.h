@@ -0,0 +1,132 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <json.h>
+
+/**
+ * \brief Configuration of the benchmarks, set from the command line.
+ */
+struct BenchmarkOptions
+{
+    /// Only benchmarks whose name contains this string are run.
+    std::string filter = "";
+
+    /// Minimum measured time for each microbenchmark, in seconds.
+    double minTime = 0.5;
+
+    /// Number of lines of the synthetic Programs.
+    uint64_t programSize = 64;
+
+    /// Number of roots of the synthetic TPGGraphs.
+    uint64_t nbRoots = 100;
+
+    /// Number of generations trained by each macrobenchmark.
+    uint64_t nbGenerations = 20;
+
+    /// Number of threads used by mutations, imports and training.
+    uint64_t nbThreads = std::thread::hardware_concurrency();
+
+    /// Seed of all random number generators.
+    uint64_t seed = 0;
+
+    /// Check whether a benchmark is selected by the filter.
+    bool isSelected(const std::string& name) const
+    {
+        return name.find(filter) != std::string::npos;
+    }
+};
+
+/**
+ * \brief Call the given function repeatedly for at least minTime seconds.
+ *
+ * The number of calls between two reads of the clock doubles until the
+ * minimum time is reached, so that the clock overhead stays negligible for
+ * short functions.
+ *
+ * \param[in] minTime minimum measured time in seconds.
+ * \param[in] op function to measure.
+ * \return a JSON object with the number of iterations and the measured time.
+ */
+template <typename Op> Json::Value measure(double minTime, Op&& op)
+{
+    uint64_t nbIterations = 0;
+    uint64_t batchSize = 1;
+    double elapsed = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    while (elapsed < minTime) {
+        for (uint64_t i = 0; i < batchSize; i++) {
+            op();
+        }
+        nbIterations += batchSize;
+        batchSize *= 2;
+        elapsed = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    }
+
+    Json::Value result;
+    result["iterations"] = (Json::UInt64)nbIterations;
+    result["seconds"] = elapsed;
+    result["nsPerIteration"] = elapsed * 1.0e9 / (double)nbIterations;
+    result["iterationsPerSecond"] = (double)nbIterations / elapsed;
+    return result;
+}
+
+/**
+ * \brief Run the microbenchmarks selected by the options.
+ *
+ * \param[in] options configuration of the benchmarks.
+ * \param[in,out] results array where one JSON object is appended for each
+ * executed benchmark.
+ */
+void runMicroBenchmarks(const BenchmarkOptions& options, Json::Value& results);
+
+/**
+ * \brief Run the macrobenchmarks selected by the options.
+ *
+ * \param[in] options configuration of the benchmarks.
+ * \param[in,out] results array where one JSON object is appended for each
+ * executed benchmark.
+ */
+void runMacroBenchmarks(const BenchmarkOptions& options, Json::Value& results);
+
+#endif
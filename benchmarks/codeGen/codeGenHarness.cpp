@@ -0,0 +1,632 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include <json.h>
+
+#include "archive.h"
+#include "codeGen/tpgGenerationEngineFactory.h"
+#include "data/primitiveTypeArray.h"
+#include "environment.h"
+#include "file/tpgGraphDotExporter.h"
+#include "file/tpgGraphDotImporter.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/rng.h"
+#include "mutator/tpgMutator.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+#include "util/timestamp.h"
+
+/// Name of the generated inference files, and of the compiled executables.
+static const std::string GENERATED_NAME = "harness";
+
+/**
+ * \brief Configuration of the harness, set from the command line.
+ */
+struct HarnessOptions
+{
+    /// DOT file of the TPGGraph. A random TPGGraph is used when empty.
+    std::string dotPath = "";
+
+    /// Observation trace. Random observations are used when empty.
+    std::string tracePath = "";
+
+    /// Directory where code is generated and compiled.
+    std::string outputDir = "codeGenHarness";
+
+    /// Command used to compile the generated code.
+    std::string compiler = "cc -O2 -ffp-contract=off";
+
+    /// Number of registers of the Environment.
+    uint64_t nbRegisters = 8;
+
+    /// Number of data of random observations.
+    uint64_t nbData = 16;
+
+    /// Number of random observations.
+    uint64_t nbObservations = 1000;
+
+    /// Number of roots of the random TPGGraph.
+    uint64_t nbRoots = 10;
+
+    /// Number of replays of the trace during measurements.
+    uint64_t nbPasses = 100;
+
+    /// Generate code with the optimize GenerationParameters.
+    bool optimize = false;
+
+    /// Seed of random number generators.
+    uint64_t seed = 0;
+};
+
+/**
+ * \brief Fill the instruction Set used to import the TPGGraph.
+ *
+ * The DOT file does not describe instructions, only their index in the Set:
+ * when replaying a TPGGraph trained with another Set, this function must be
+ * edited to declare the same instructions, in the same order.
+ */
+static void fillInstructionSet(Instructions::Set& set)
+{
+    static Instructions::LambdaInstruction<double, double> add(
+        [](double a, double b) -> double { return a + b; }, "$0 = $1 + $2;");
+    static Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) -> double { return a - b; }, "$0 = $1 - $2;");
+    static Instructions::LambdaInstruction<double, double> mult(
+        [](double a, double b) -> double { return a * b; }, "$0 = $1 * $2;");
+    static Instructions::LambdaInstruction<double, double> div(
+        [](double a, double b) -> double { return a / b; }, "$0 = $1 / $2;");
+    static Instructions::LambdaInstruction<double, double> max(
+        [](double a, double b) -> double { return (a < b) ? b : a; },
+        "$0 = (($1) < ($2)) ? ($2) : ($1);");
+    static Instructions::LambdaInstruction<double> exp(
+        [](double a) -> double { return std::exp(a); }, "$0 = exp($1);");
+    static Instructions::LambdaInstruction<double> cos(
+        [](double a) -> double { return std::cos(a); }, "$0 = cos($1);");
+    set.add(add);
+    set.add(sub);
+    set.add(mult);
+    set.add(div);
+    set.add(max);
+    set.add(exp);
+    set.add(cos);
+}
+
+/**
+ * \brief Read an observation trace.
+ *
+ * The trace holds one observation per line, with the same number of values,
+ * separated with white spaces. Empty lines are ignored.
+ *
+ * \param[in] path path of the trace file.
+ * \return the observations of the trace.
+ * \throw std::runtime_error if the file can not be read or if observations
+ * do not all have the same size.
+ */
+static std::vector<std::vector<double>> readTrace(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open trace " + path);
+    }
+
+    std::vector<std::vector<double>> trace;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream values(line);
+        std::vector<double> observation;
+        double value;
+        while (values >> value) {
+            observation.push_back(value);
+        }
+        if (observation.empty()) {
+            continue;
+        }
+        if (!trace.empty() && observation.size() != trace.front().size()) {
+            throw std::runtime_error("Observation " +
+                                     std::to_string(trace.size()) +
+                                     " of the trace has a different size.");
+        }
+        trace.push_back(observation);
+    }
+    if (trace.empty()) {
+        throw std::runtime_error("Trace " + path + " is empty.");
+    }
+    return trace;
+}
+
+/// Write a trace with enough digits to be parsed exactly by the C code.
+static void writeTrace(const std::string& path,
+                       const std::vector<std::vector<double>>& trace)
+{
+    std::ofstream file(path);
+    file.precision(17);
+    for (const auto& observation : trace) {
+        for (size_t i = 0; i < observation.size(); i++) {
+            file << ((i > 0) ? " " : "") << observation.at(i);
+        }
+        file << "\n";
+    }
+}
+
+/**
+ * \brief Write the C main replaying a trace with the generated inference.
+ *
+ * The executable takes the trace, the file where actions are written and
+ * the number of passes over the trace. It prints the CPU time spent in
+ * inferences, in seconds.
+ */
+static void writeMain(const std::string& path, size_t nbObservations,
+                      size_t nbData, size_t nbRoots)
+{
+    std::ofstream file(path);
+    file << "#include <stdio.h>\n"
+         << "#include <stdlib.h>\n"
+         << "#include <time.h>\n\n"
+         << "#include \"" << GENERATED_NAME << ".h\"\n\n"
+         << "#define NB_OBS " << nbObservations << "\n"
+         << "#define NB_DATA " << nbData << "\n"
+         << "#define NB_ROOTS " << nbRoots << "\n\n"
+         << "double* in1;\n"
+         << "static double trace[NB_OBS][NB_DATA];\n"
+         << "static int actions[NB_OBS][NB_ROOTS];\n\n"
+         << "int main(int argc, char* argv[])\n"
+         << "{\n"
+         << "\tif (argc != 4) {\n"
+         << "\t\tfprintf(stderr, \"usage: %s trace actions passes\\n\", "
+         << "argv[0]);\n"
+         << "\t\treturn 3;\n"
+         << "\t}\n\n"
+         << "\tFILE* in = fopen(argv[1], \"r\");\n"
+         << "\tif (in == NULL) {\n"
+         << "\t\treturn 3;\n"
+         << "\t}\n"
+         << "\tfor (int o = 0; o < NB_OBS; o++) {\n"
+         << "\t\tfor (int d = 0; d < NB_DATA; d++) {\n"
+         << "\t\t\tif (fscanf(in, \"%lf\", &trace[o][d]) != 1) {\n"
+         << "\t\t\t\treturn 3;\n"
+         << "\t\t\t}\n"
+         << "\t\t}\n"
+         << "\t}\n"
+         << "\tfclose(in);\n\n"
+         << "\tint nbPasses = atoi(argv[3]);\n"
+         << "\tclock_t start = clock();\n"
+         << "\tfor (int pass = 0; pass < nbPasses; pass++) {\n"
+         << "\t\tfor (int o = 0; o < NB_OBS; o++) {\n"
+         << "\t\t\tin1 = trace[o];\n"
+         << "\t\t\tfor (int r = 0; r < NB_ROOTS; r++) {\n"
+         << "\t\t\t\tactions[o][r] = inferenceTPG(r);\n"
+         << "\t\t\t}\n"
+         << "\t\t}\n"
+         << "\t}\n"
+         << "\tdouble seconds = (double)(clock() - start) / CLOCKS_PER_SEC;\n\n"
+         << "\tFILE* out = fopen(argv[2], \"w\");\n"
+         << "\tif (out == NULL) {\n"
+         << "\t\treturn 3;\n"
+         << "\t}\n"
+         << "\tfor (int o = 0; o < NB_OBS; o++) {\n"
+         << "\t\tfor (int r = 0; r < NB_ROOTS; r++) {\n"
+         << "\t\t\tfprintf(out, \"%d \", actions[o][r]);\n"
+         << "\t\t}\n"
+         << "\t\tfprintf(out, \"\\n\");\n"
+         << "\t}\n"
+         << "\tfclose(out);\n"
+         << "\tprintf(\"%.9f\\n\", seconds);\n"
+         << "\treturn 0;\n"
+         << "}\n";
+}
+
+/**
+ * \brief Replay the trace with the TPGExecutionEngine.
+ *
+ * Like in the C main, observations are loaded before the measurement, and
+ * the CPU time spent in inferences is measured with clock().
+ *
+ * \param[in] env Environment of the TPGGraph, whose data source is data.
+ * \param[in] tpg the TPGGraph to execute.
+ * \param[in] data data source of the Environment, copied for each
+ * observation of the trace.
+ * \param[in] trace observations to replay.
+ * \param[in] nbPasses number of replays of the trace.
+ * \param[out] actions action of each root for each observation.
+ * \return the measured CPU time, in seconds.
+ */
+static double runInterpreter(const Environment& env, const TPG::TPGGraph& tpg,
+                             const Data::PrimitiveTypeArray<double>& data,
+                             const std::vector<std::vector<double>>& trace,
+                             uint64_t nbPasses,
+                             std::vector<std::vector<int>>& actions)
+{
+    TPG::TPGExecutionEngine tee(env);
+    auto roots = tpg.getRootVertices();
+    actions.assign(trace.size(), std::vector<int>(roots.size()));
+
+    // One copy of the data source per observation.
+    std::vector<std::unique_ptr<Data::PrimitiveTypeArray<double>>>
+        observations;
+    std::vector<std::vector<std::reference_wrapper<const Data::DataHandler>>>
+        dataSources;
+    for (const auto& observation : trace) {
+        observations.emplace_back(
+            (Data::PrimitiveTypeArray<double>*)data.clone());
+        for (size_t d = 0; d < observation.size(); d++) {
+            observations.back()->setDataAt(typeid(double), d,
+                                           observation.at(d));
+        }
+        dataSources.push_back({*observations.back()});
+    }
+
+    std::clock_t start = std::clock();
+    for (uint64_t pass = 0; pass < nbPasses; pass++) {
+        for (size_t o = 0; o < trace.size(); o++) {
+            tee.setDataSources(dataSources.at(o));
+            for (size_t r = 0; r < roots.size(); r++) {
+                actions.at(o).at(r) =
+                    (int)((const TPG::TPGAction*)tee
+                              .executeFromRoot(*roots.at(r))
+                              .back())
+                        ->getActionID();
+            }
+        }
+    }
+    return (double)(std::clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * \brief Generate, compile and run the inference code of one generation
+ * mode.
+ *
+ * \param[in] mode generation mode, "switch" or "stack".
+ * \param[in] tpg the TPGGraph to generate.
+ * \param[in] options configuration of the harness.
+ * \param[in] nbObservations number of observations of the trace.
+ * \param[in] nbData number of values of each observation.
+ * \param[out] actions action of each root for each observation.
+ * \return the measured time, in seconds.
+ * \throw std::runtime_error if the compilation or execution fails.
+ */
+static double runGeneratedCode(const std::string& mode,
+                               const TPG::TPGGraph& tpg,
+                               const HarnessOptions& options,
+                               size_t nbObservations, size_t nbData,
+                               std::vector<std::vector<int>>& actions)
+{
+    const std::string dir = options.outputDir + "/" + mode + "/";
+    mkdir(dir.c_str(), 0755);
+
+    size_t nbRoots = tpg.getRootVertices().size();
+    CodeGen::GenerationParameters params;
+    params.optimize = options.optimize;
+    for (size_t r = 0; r < nbRoots; r++) {
+        params.roots.push_back(r);
+    }
+    {
+        CodeGen::TPGGenerationEngineFactory factory(
+            (mode == "switch")
+                ? CodeGen::TPGGenerationEngineFactory::switchMode
+                : CodeGen::TPGGenerationEngineFactory::stackMode);
+        auto tpgGen = factory.create(GENERATED_NAME, tpg, dir, params);
+        tpgGen->generateTPGGraph();
+        // Files are closed when the engine is destroyed.
+    }
+
+    const std::string executable = dir + GENERATED_NAME;
+    const std::string cmdCompile =
+        options.compiler + " -I" + dir + " -I" + options.outputDir + " -o " +
+        executable + " " + dir + GENERATED_NAME + ".c " + dir +
+        GENERATED_NAME + "_program.c " + options.outputDir + "/main.c -lm";
+    if (system(cmdCompile.c_str()) != 0) {
+        throw std::runtime_error("Compilation failed: " + cmdCompile);
+    }
+
+    const std::string actionsPath = dir + "actions.txt";
+    const std::string timePath = dir + "time.txt";
+    const std::string cmdExec = executable + " " + options.outputDir +
+                                "/trace.txt " + actionsPath + " " +
+                                std::to_string(options.nbPasses) + " > " +
+                                timePath;
+    if (system(cmdExec.c_str()) != 0) {
+        throw std::runtime_error("Execution failed: " + cmdExec);
+    }
+
+    std::ifstream actionsFile(actionsPath);
+    actions.assign(nbObservations, std::vector<int>(nbRoots));
+    for (auto& observationActions : actions) {
+        for (int& action : observationActions) {
+            actionsFile >> action;
+        }
+    }
+
+    double seconds = 0.0;
+    std::ifstream timeFile(timePath);
+    timeFile >> seconds;
+    return seconds;
+}
+
+/**
+ * \brief Count the decisions differing from the reference ones.
+ *
+ * The first differences are printed on the standard error.
+ */
+static uint64_t compareActions(const std::string& mode,
+                               const std::vector<std::vector<int>>& reference,
+                               const std::vector<std::vector<int>>& actions)
+{
+    uint64_t nbDifferences = 0;
+    for (size_t o = 0; o < reference.size(); o++) {
+        for (size_t r = 0; r < reference.at(o).size(); r++) {
+            if (reference.at(o).at(r) != actions.at(o).at(r)) {
+                if (nbDifferences < 10) {
+                    std::cerr << mode << ": action " << actions.at(o).at(r)
+                              << " instead of " << reference.at(o).at(r)
+                              << " for root " << r << " on observation " << o
+                              << std::endl;
+                }
+                nbDifferences++;
+            }
+        }
+    }
+    return nbDifferences;
+}
+
+/// Build the JSON result of one execution mode.
+static Json::Value makeResult(double seconds, uint64_t nbDecisions)
+{
+    Json::Value result;
+    result["seconds"] = seconds;
+    result["decisions"] = (Json::UInt64)nbDecisions;
+    result["decisionsPerSecond"] = (double)nbDecisions / seconds;
+    return result;
+}
+
+/// Print the command line usage.
+static void printUsage(const char* executable)
+{
+    std::cerr
+        << "Usage: " << executable << " [options]" << std::endl
+        << "  --dot <file>          TPGGraph to replay. A random TPGGraph is "
+           "used by default."
+        << std::endl
+        << "  --trace <file>        Observations to replay, one per line. "
+           "Random observations are used by default."
+        << std::endl
+        << "  --output-dir <dir>    Directory of the generated code."
+        << std::endl
+        << "  --compiler <cmd>      Command compiling the generated code."
+        << std::endl
+        << "  --registers <n>       Number of registers of the Environment."
+        << std::endl
+        << "  --nb-data <n>         Size of random observations." << std::endl
+        << "  --observations <n>    Number of random observations."
+        << std::endl
+        << "  --nb-roots <n>        Number of roots of the random TPGGraph."
+        << std::endl
+        << "  --passes <n>          Number of replays of the trace."
+        << std::endl
+        << "  --optimize            Generate optimized code." << std::endl
+        << "  --seed <n>            Seed of random number generators."
+        << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    HarnessOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (arg == "--optimize") {
+            options.optimize = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--dot") {
+                options.dotPath = value;
+            }
+            else if (arg == "--trace") {
+                options.tracePath = value;
+            }
+            else if (arg == "--output-dir") {
+                options.outputDir = value;
+            }
+            else if (arg == "--compiler") {
+                options.compiler = value;
+            }
+            else if (arg == "--registers") {
+                options.nbRegisters = std::stoull(value);
+            }
+            else if (arg == "--nb-data") {
+                options.nbData = std::stoull(value);
+            }
+            else if (arg == "--observations") {
+                options.nbObservations = std::stoull(value);
+            }
+            else if (arg == "--nb-roots") {
+                options.nbRoots = std::stoull(value);
+            }
+            else if (arg == "--passes") {
+                options.nbPasses = std::stoull(value);
+            }
+            else if (arg == "--seed") {
+                options.seed = std::stoull(value);
+            }
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        catch (std::logic_error&) {
+            std::cerr << "Invalid value " << value << " for " << arg
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    Mutator::RNG rng(options.seed);
+    std::vector<std::vector<double>> trace;
+    try {
+        if (options.tracePath.empty()) {
+            trace.assign(options.nbObservations,
+                         std::vector<double>(options.nbData));
+            for (auto& observation : trace) {
+                for (double& value : observation) {
+                    value = rng.getDouble(-10.0, 10.0);
+                }
+            }
+        }
+        else {
+            trace = readTrace(options.tracePath);
+        }
+    }
+    catch (std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    Instructions::Set set;
+    fillInstructionSet(set);
+    Data::PrimitiveTypeArray<double> data(trace.front().size());
+    Environment env(
+        set, std::vector<std::reference_wrapper<const Data::DataHandler>>{data},
+        options.nbRegisters);
+    TPG::TPGGraph tpg(env);
+
+    mkdir(options.outputDir.c_str(), 0755);
+    if (options.dotPath.empty()) {
+        Mutator::MutationParameters params;
+        params.tpg.nbActions = 5;
+        params.tpg.nbRoots = options.nbRoots;
+        params.tpg.maxInitOutgoingEdges = 3;
+        params.tpg.maxOutgoingEdges = 5;
+        params.tpg.pEdgeDeletion = 0.7;
+        params.tpg.pEdgeAddition = 0.7;
+        params.tpg.pProgramMutation = 0.2;
+        params.tpg.pEdgeDestinationChange = 0.1;
+        params.tpg.pEdgeDestinationIsAction = 0.5;
+        params.prog.maxProgramSize = 20;
+        params.prog.pAdd = 0.5;
+        params.prog.pDelete = 0.5;
+        params.prog.pMutate = 1.0;
+        params.prog.pSwap = 1.0;
+        Archive archive;
+        Mutator::TPGMutator::initRandomTPG(tpg, params, rng);
+        Mutator::TPGMutator::populateTPG(tpg, archive, params, rng, 1);
+        // Keep the random TPGGraph to reproduce the results.
+        File::TPGGraphDotExporter dotExporter(
+            (options.outputDir + "/random.dot").c_str(), tpg);
+        dotExporter.print();
+    }
+    else {
+        File::TPGGraphDotImporter dotImporter(options.dotPath.c_str(), env,
+                                              tpg);
+        dotImporter.importGraph();
+    }
+
+    writeTrace(options.outputDir + "/trace.txt", trace);
+    writeMain(options.outputDir + "/main.c", trace.size(),
+              trace.front().size(), tpg.getRootVertices().size());
+    std::ofstream(options.outputDir + "/externHeader.h")
+        << "#include <float.h>\n#include <math.h>\n";
+
+    const uint64_t nbDecisions =
+        trace.size() * tpg.getRootVertices().size() * options.nbPasses;
+    Json::Value root;
+    root["version"] = GEGELATI_VERSION;
+    root["date"] = Util::getCurrentDate();
+    Json::Value& configuration = root["configuration"];
+    configuration["dot"] = options.dotPath;
+    configuration["trace"] = options.tracePath;
+    configuration["observations"] = (Json::UInt64)trace.size();
+    configuration["roots"] = (Json::UInt64)tpg.getRootVertices().size();
+    configuration["passes"] = (Json::UInt64)options.nbPasses;
+    configuration["optimize"] = options.optimize;
+
+    std::vector<std::vector<int>> reference;
+    double seconds = runInterpreter(env, tpg, data, trace, options.nbPasses,
+                                    reference);
+    root["interpreter"] = makeResult(seconds, nbDecisions);
+    std::cerr << "interpreter: "
+              << root["interpreter"]["decisionsPerSecond"].asDouble()
+              << " decisions/s" << std::endl;
+
+    bool identical = true;
+    for (const std::string mode : {"switch", "stack"}) {
+        std::vector<std::vector<int>> actions;
+        try {
+            seconds = runGeneratedCode(mode, tpg, options, trace.size(),
+                                       trace.front().size(), actions);
+        }
+        catch (std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        uint64_t nbDifferences = compareActions(mode, reference, actions);
+        identical &= (nbDifferences == 0);
+
+        Json::Value& result = root[mode];
+        result = makeResult(seconds, nbDecisions);
+        result["differences"] = (Json::UInt64)nbDifferences;
+        std::cerr << mode << ": " << result["decisionsPerSecond"].asDouble()
+                  << " decisions/s, " << nbDifferences << " differences"
+                  << std::endl;
+    }
+
+    Json::StreamWriterBuilder writerBuilder;
+    writerBuilder["precision"] = 6;
+    std::unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+    writer->write(root, &std::cout);
+    std::cout << std::endl;
+
+    return (identical) ? 0 : 2;
+}
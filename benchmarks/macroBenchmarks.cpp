@@ -0,0 +1,194 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "learn/adversarialLearningAgent.h"
+#include "learn/classificationLearningAgent.h"
+#include "learn/learningParameters.h"
+#include "learn/parallelLearningAgent.h"
+
+#include "learn/fakeClassificationLearningEnvironment.h"
+#include "learn/stickGameAdversarial.h"
+#include "learn/stickGameWithOpponent.h"
+
+#include "benchmark.h"
+
+/**
+ * \brief LearningEnvironment counting the actions done by all its clones.
+ *
+ * Each action corresponds to one decision taken by the TPG, so the counter
+ * gives the number of inferences done during the training.
+ */
+template <class Env> class CountingEnvironment : public Env
+{
+  protected:
+    /// Counter shared with all clones.
+    std::shared_ptr<std::atomic<uint64_t>> nbDecisions;
+
+  public:
+    CountingEnvironment()
+        : Env(), nbDecisions{std::make_shared<std::atomic<uint64_t>>(0)} {};
+
+    Learn::LearningEnvironment* clone() const override
+    {
+        return new CountingEnvironment<Env>(*this);
+    }
+
+    void doAction(uint64_t actionID) override
+    {
+        nbDecisions->fetch_add(1, std::memory_order_relaxed);
+        Env::doAction(actionID);
+    }
+
+    /// Get the number of actions done by this environment and its clones.
+    uint64_t getNbDecisions() const
+    {
+        return nbDecisions->load();
+    }
+};
+
+/// LearningParameters shared by all macrobenchmarks.
+static Learn::LearningParameters getLearningParameters(
+    const BenchmarkOptions& options)
+{
+    Learn::LearningParameters params;
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 5;
+    params.ratioDeletedRoots = 0.5;
+    params.maxNbEvaluationPerPolicy =
+        params.nbIterationsPerPolicyEvaluation * 3;
+    params.nbThreads = options.nbThreads;
+    params.mutation.tpg.maxInitOutgoingEdges = 3;
+    params.mutation.tpg.nbRoots = options.nbRoots;
+    params.mutation.tpg.pEdgeDeletion = 0.7;
+    params.mutation.tpg.pEdgeAddition = 0.7;
+    params.mutation.tpg.pProgramMutation = 0.2;
+    params.mutation.tpg.pEdgeDestinationChange = 0.1;
+    params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+    params.mutation.tpg.maxOutgoingEdges = 4;
+    params.mutation.tpg.forceProgramBehaviorChangeOnMutation = true;
+    params.mutation.prog.maxProgramSize = options.programSize;
+    params.mutation.prog.pAdd = 0.5;
+    params.mutation.prog.pDelete = 0.5;
+    params.mutation.prog.pMutate = 1.0;
+    params.mutation.prog.pSwap = 1.0;
+    params.mutation.prog.pConstantMutation = 0.5;
+    params.mutation.prog.minConstValue = 0;
+    params.mutation.prog.maxConstValue = 1;
+    return params;
+}
+
+/**
+ * \brief Train a LearningAgent for a fixed number of generations.
+ *
+ * \param[in] name name of the benchmark.
+ * \param[in] la the initialized LearningAgent.
+ * \param[in] le the environment of the LearningAgent.
+ * \param[in] options configuration of the benchmarks.
+ * \return the JSON object holding the benchmark result.
+ */
+template <class Env>
+static Json::Value trainAgent(const std::string& name,
+                              Learn::LearningAgent& la,
+                              const CountingEnvironment<Env>& le,
+                              const BenchmarkOptions& options)
+{
+    la.init(options.seed);
+    uint64_t nbDecisionsAtStart = le.getNbDecisions();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < options.nbGenerations; i++) {
+        la.trainOneGeneration(i);
+    }
+    double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+    uint64_t nbDecisions = le.getNbDecisions() - nbDecisionsAtStart;
+
+    Json::Value result;
+    result["name"] = name;
+    result["generations"] = (Json::UInt64)options.nbGenerations;
+    result["seconds"] = elapsed;
+    result["generationsPerSecond"] = (double)options.nbGenerations / elapsed;
+    result["decisions"] = (Json::UInt64)nbDecisions;
+    result["decisionsPerSecond"] = (double)nbDecisions / elapsed;
+    result["nbVertices"] = (Json::UInt64)la.getTPGGraph()->getNbVertices();
+
+    std::cerr << name << ": " << result["generationsPerSecond"].asDouble()
+              << " generations/s, " << result["decisionsPerSecond"].asDouble()
+              << " decisions/s" << std::endl;
+    return result;
+}
+
+void runMacroBenchmarks(const BenchmarkOptions& options, Json::Value& results)
+{
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<int> addInt;
+    Instructions::AddPrimitiveType<double> addDouble;
+    Instructions::LambdaInstruction<double, double> minus(
+        [](double a, double b) -> double { return a - b; });
+    set.add(addInt);
+    set.add(addDouble);
+    set.add(minus);
+
+    Learn::LearningParameters params = getLearningParameters(options);
+
+    if (options.isSelected("macro/stickGame")) {
+        CountingEnvironment<StickGameWithOpponent> le;
+        Learn::ParallelLearningAgent la(le, set, params);
+        results.append(trainAgent("macro/stickGame", la, le, options));
+    }
+
+    if (options.isSelected("macro/stickGameAdversarial")) {
+        CountingEnvironment<StickGameAdversarial> le;
+        Learn::AdversarialLearningAgent la(le, set, params);
+        results.append(
+            trainAgent("macro/stickGameAdversarial", la, le, options));
+    }
+
+    if (options.isSelected("macro/fakeClassification")) {
+        CountingEnvironment<FakeClassificationLearningEnvironment> le;
+        Learn::ClassificationLearningAgent<Learn::ParallelLearningAgent> la(
+            le, set, params);
+        results.append(
+            trainAgent("macro/fakeClassification", la, le, options));
+    }
+}
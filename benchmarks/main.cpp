@@ -0,0 +1,156 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "util/timestamp.h"
+
+#include "benchmark.h"
+
+/// Print the command line usage.
+static void printUsage(const char* executable)
+{
+    std::cerr
+        << "Usage: " << executable << " [options]" << std::endl
+        << "  --filter <str>        Only run benchmarks whose name contains "
+           "<str>."
+        << std::endl
+        << "  --output <file>       Write JSON results to <file> instead of "
+           "stdout."
+        << std::endl
+        << "  --min-time <s>        Minimum time per microbenchmark."
+        << std::endl
+        << "  --program-size <n>    Number of lines of synthetic programs."
+        << std::endl
+        << "  --nb-roots <n>        Number of roots of synthetic and trained "
+           "TPGs."
+        << std::endl
+        << "  --generations <n>     Number of generations per "
+           "macrobenchmark."
+        << std::endl
+        << "  --threads <n>         Number of threads." << std::endl
+        << "  --seed <n>            Seed of random number generators."
+        << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    std::string outputPath = "";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--filter") {
+                options.filter = value;
+            }
+            else if (arg == "--output") {
+                outputPath = value;
+            }
+            else if (arg == "--min-time") {
+                options.minTime = std::stod(value);
+            }
+            else if (arg == "--program-size") {
+                options.programSize = std::stoull(value);
+            }
+            else if (arg == "--nb-roots") {
+                options.nbRoots = std::stoull(value);
+            }
+            else if (arg == "--generations") {
+                options.nbGenerations = std::stoull(value);
+            }
+            else if (arg == "--threads") {
+                options.nbThreads = std::stoull(value);
+            }
+            else if (arg == "--seed") {
+                options.seed = std::stoull(value);
+            }
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        catch (std::logic_error&) {
+            std::cerr << "Invalid value " << value << " for " << arg
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    Json::Value root;
+    root["version"] = GEGELATI_VERSION;
+    root["date"] = Util::getCurrentDate();
+    Json::Value& configuration = root["configuration"];
+    configuration["minTime"] = options.minTime;
+    configuration["programSize"] = (Json::UInt64)options.programSize;
+    configuration["nbRoots"] = (Json::UInt64)options.nbRoots;
+    configuration["generations"] = (Json::UInt64)options.nbGenerations;
+    configuration["threads"] = (Json::UInt64)options.nbThreads;
+    configuration["seed"] = (Json::UInt64)options.seed;
+
+    Json::Value& results = root["benchmarks"];
+    results = Json::Value(Json::arrayValue);
+    runMicroBenchmarks(options, results);
+    runMacroBenchmarks(options, results);
+
+    Json::StreamWriterBuilder writerBuilder;
+    writerBuilder["precision"] = 6;
+    std::unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+    if (outputPath.empty()) {
+        writer->write(root, &std::cout);
+        std::cout << std::endl;
+    }
+    else {
+        std::ofstream file(outputPath);
+        if (!file.is_open()) {
+            std::cerr << "Could not open " << outputPath << std::endl;
+            return 1;
+        }
+        writer->write(root, &file);
+        file << std::endl;
+    }
+
+    return 0;
+}
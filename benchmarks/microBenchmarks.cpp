@@ -0,0 +1,318 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+#include "archive.h"
+#include "data/primitiveTypeArray.h"
+#include "environment.h"
+#include "file/tpgGraphBinaryExporter.h"
+#include "file/tpgGraphBinaryImporter.h"
+#include "file/tpgGraphDotExporter.h"
+#include "file/tpgGraphDotImporter.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/multByConstant.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/programMutator.h"
+#include "mutator/rng.h"
+#include "mutator/tpgMutator.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+
+#include "benchmark.h"
+
+/// Number of actions of the synthetic TPGGraphs.
+static const uint64_t NB_ACTIONS = 10;
+
+/// Number of rounds of decimation and population of synthetic TPGGraphs.
+static const uint64_t NB_POPULATION_ROUNDS = 10;
+
+/// Path of the files written by the import/export benchmarks.
+static const char* DOT_FILE_PATH = "benchmark_tmp.dot";
+static const char* BINARY_FILE_PATH = "benchmark_tmp.tpgb";
+
+/**
+ * \brief Data, Environment and parameters shared by microbenchmarks.
+ */
+class MicroBenchmarkContext
+{
+  public:
+    Instructions::Set set;
+    Data::PrimitiveTypeArray<double> data;
+    std::unique_ptr<Environment> env;
+    Mutator::MutationParameters params;
+    Mutator::RNG rng;
+
+    MicroBenchmarkContext(const BenchmarkOptions& options)
+        : data(32), rng(options.seed)
+    {
+        static Instructions::AddPrimitiveType<double> add;
+        static Instructions::MultByConstant<double> multByConst;
+        static Instructions::LambdaInstruction<double, double> minus(
+            [](double a, double b) -> double { return a - b; });
+        static Instructions::LambdaInstruction<double, double> max(
+            [](double a, double b) -> double { return (a > b) ? a : b; });
+        set.add(add);
+        set.add(multByConst);
+        set.add(minus);
+        set.add(max);
+
+        for (uint64_t i = 0; i < data.getAddressSpace(typeid(double)); i++) {
+            data.setDataAt(typeid(double), i, rng.getDouble(-10.0, 10.0));
+        }
+
+        env = std::make_unique<Environment>(
+            set,
+            std::vector<std::reference_wrapper<const Data::DataHandler>>{data},
+            8, 5);
+
+        params.tpg.nbActions = NB_ACTIONS;
+        params.tpg.nbRoots = options.nbRoots;
+        params.tpg.maxInitOutgoingEdges = 3;
+        params.tpg.maxOutgoingEdges = 5;
+        params.tpg.pEdgeDeletion = 0.7;
+        params.tpg.pEdgeAddition = 0.7;
+        params.tpg.pProgramMutation = 0.2;
+        params.tpg.pEdgeDestinationChange = 0.1;
+        params.tpg.pEdgeDestinationIsAction = 0.5;
+        params.tpg.forceProgramBehaviorChangeOnMutation = false;
+        params.prog.maxProgramSize = options.programSize;
+        params.prog.pAdd = 0.5;
+        params.prog.pDelete = 0.5;
+        params.prog.pMutate = 1.0;
+        params.prog.pSwap = 1.0;
+        params.prog.pConstantMutation = 0.5;
+        params.prog.minConstValue = -10;
+        params.prog.maxConstValue = 10;
+    }
+
+    /// Create a random Program with exactly programSize lines.
+    std::shared_ptr<Program::Program> createProgram(uint64_t programSize)
+    {
+        auto program = std::make_shared<Program::Program>(*env);
+        Mutator::ProgramMutator::initRandomProgram(*program, params, rng);
+        while (program->getNbLines() < programSize) {
+            Mutator::ProgramMutator::insertRandomLine(*program, rng);
+        }
+        program->identifyIntrons();
+        return program;
+    }
+
+    /// Remove half of the non-action roots of a TPGGraph.
+    void decimate(TPG::TPGGraph& tpg)
+    {
+        auto roots = tpg.getRootVertices();
+        for (size_t i = 0; i < roots.size(); i += 2) {
+            if (dynamic_cast<const TPG::TPGAction*>(roots.at(i)) == nullptr) {
+                tpg.removeVertex(*roots.at(i));
+            }
+        }
+    }
+
+    /**
+     * \brief Create a TPGGraph with nbRoots roots.
+     *
+     * The graph goes through several rounds of decimation and population to
+     * reach a structure comparable to a TPGGraph under training.
+     */
+    std::unique_ptr<TPG::TPGGraph> createTPG(const BenchmarkOptions& options)
+    {
+        auto tpg = std::make_unique<TPG::TPGGraph>(*env);
+        Archive archive;
+        Mutator::TPGMutator::initRandomTPG(*tpg, params, rng);
+        Mutator::TPGMutator::populateTPG(*tpg, archive, params, rng,
+                                         options.nbThreads);
+        for (uint64_t i = 0; i < NB_POPULATION_ROUNDS; i++) {
+            decimate(*tpg);
+            Mutator::TPGMutator::populateTPG(*tpg, archive, params, rng,
+                                             options.nbThreads);
+        }
+        return tpg;
+    }
+};
+
+/// Print a one line summary of a microbenchmark result.
+static void printResult(const Json::Value& result)
+{
+    std::cerr << result["name"].asString() << ": "
+              << result["nsPerIteration"].asDouble() << " ns/iteration ("
+              << result["iterations"].asUInt64() << " iterations)"
+              << std::endl;
+}
+
+void runMicroBenchmarks(const BenchmarkOptions& options, Json::Value& results)
+{
+    MicroBenchmarkContext context(options);
+
+    if (options.isSelected("micro/programExecution")) {
+        auto program = context.createProgram(options.programSize);
+        Program::ProgramExecutionEngine pee(*program);
+        double sum = 0.0;
+        Json::Value result = measure(options.minTime, [&pee, &sum]() {
+            sum += pee.executeProgram();
+        });
+        result["name"] = "micro/programExecution";
+        result["programSize"] = (Json::UInt64)options.programSize;
+        result["nbIntrons"] = (Json::UInt64)program->identifyIntrons();
+        // Prevent the compiler from optimizing executions away.
+        result["checksum"] = sum;
+        printResult(result);
+        results.append(result);
+    }
+
+    std::unique_ptr<TPG::TPGGraph> tpg;
+    if (options.isSelected("micro/tpgExecution") ||
+        options.isSelected("micro/dot") || options.isSelected("micro/binary")) {
+        tpg = context.createTPG(options);
+    }
+
+    if (options.isSelected("micro/tpgExecution")) {
+        TPG::TPGExecutionEngine tee(*context.env);
+        auto roots = tpg->getRootVertices();
+        size_t rootIdx = 0;
+        uint64_t nbVisitedVertices = 0;
+        Json::Value result = measure(
+            options.minTime, [&tee, &roots, &rootIdx, &nbVisitedVertices]() {
+                nbVisitedVertices +=
+                    tee.executeFromRoot(*roots.at(rootIdx)).size();
+                rootIdx = (rootIdx + 1) % roots.size();
+            });
+        result["name"] = "micro/tpgExecution";
+        result["nbVertices"] = (Json::UInt64)tpg->getNbVertices();
+        result["nbRoots"] = (Json::UInt64)roots.size();
+        result["avgTraceLength"] = (double)nbVisitedVertices /
+                                   result["iterations"].asDouble();
+        printResult(result);
+        results.append(result);
+    }
+
+    if (options.isSelected("micro/archiveAddRecording")) {
+        Archive archive(50, 1.0, options.seed);
+        std::vector<std::shared_ptr<Program::Program>> programs;
+        for (auto i = 0; i < 10; i++) {
+            programs.push_back(context.createProgram(options.programSize));
+        }
+        std::vector<std::reference_wrapper<const Data::DataHandler>> sources{
+            context.data};
+        uint64_t counter = 0;
+        Json::Value result = measure(options.minTime, [&]() {
+            // Change the data to insert new recordings.
+            context.data.setDataAt(typeid(double),
+                                   counter % context.data.getAddressSpace(
+                                                 typeid(double)),
+                                   (double)counter);
+            archive.addRecording(programs.at(counter % programs.size()).get(),
+                                 sources, (double)counter, true);
+            counter++;
+        });
+        result["name"] = "micro/archiveAddRecording";
+        printResult(result);
+        results.append(result);
+    }
+
+    if (options.isSelected("micro/populateTPG")) {
+        auto populatedTPG = context.createTPG(options);
+        Archive archive;
+        uint64_t nbIterations = 0;
+        double elapsed = 0.0;
+        // Only the population is measured, not the decimation.
+        while (elapsed < options.minTime) {
+            context.decimate(*populatedTPG);
+            auto start = std::chrono::steady_clock::now();
+            Mutator::TPGMutator::populateTPG(*populatedTPG, archive,
+                                             context.params, context.rng,
+                                             options.nbThreads);
+            elapsed += std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+            nbIterations++;
+        }
+        Json::Value result;
+        result["name"] = "micro/populateTPG";
+        result["iterations"] = (Json::UInt64)nbIterations;
+        result["seconds"] = elapsed;
+        result["nsPerIteration"] = elapsed * 1.0e9 / (double)nbIterations;
+        result["iterationsPerSecond"] = (double)nbIterations / elapsed;
+        result["nbRoots"] = (Json::UInt64)options.nbRoots;
+        printResult(result);
+        results.append(result);
+    }
+
+    if (options.isSelected("micro/dot")) {
+        File::TPGGraphDotExporter exporter(DOT_FILE_PATH, *tpg);
+        Json::Value result =
+            measure(options.minTime, [&exporter]() { exporter.print(); });
+        result["name"] = "micro/dotExport";
+        result["nbVertices"] = (Json::UInt64)tpg->getNbVertices();
+        printResult(result);
+        results.append(result);
+
+        TPG::TPGGraph importedTPG(*context.env);
+        File::TPGGraphDotImporter importer(DOT_FILE_PATH, *context.env,
+                                           importedTPG, options.nbThreads);
+        result = measure(options.minTime,
+                         [&importer]() { importer.importGraph(); });
+        result["name"] = "micro/dotImport";
+        result["nbVertices"] = (Json::UInt64)importedTPG.getNbVertices();
+        printResult(result);
+        results.append(result);
+        std::remove(DOT_FILE_PATH);
+    }
+
+    if (options.isSelected("micro/binary")) {
+        File::TPGGraphBinaryExporter exporter(BINARY_FILE_PATH, *tpg);
+        Json::Value result =
+            measure(options.minTime, [&exporter]() { exporter.print(); });
+        result["name"] = "micro/binaryExport";
+        result["nbVertices"] = (Json::UInt64)tpg->getNbVertices();
+        printResult(result);
+        results.append(result);
+
+        TPG::TPGGraph importedTPG(*context.env);
+        File::TPGGraphBinaryImporter importer(BINARY_FILE_PATH, importedTPG);
+        result = measure(options.minTime,
+                         [&importer]() { importer.importGraph(); });
+        result["name"] = "micro/binaryImport";
+        result["nbVertices"] = (Json::UInt64)importedTPG.getNbVertices();
+        printResult(result);
+        results.append(result);
+        std::remove(BINARY_FILE_PATH);
+    }
+}
@@ -45,6 +45,7 @@
 #include "data/dataHandler.h"
 #include "mutator/rng.h"
 #include "program/program.h"
+#include "util/memoryUsage.h"
 
 /**
  * \brief Class used to store one recording of an Archive.
@@ -267,6 +268,19 @@ class Archive
      * \brief Clear all content from the Archive.
      */
     void clear();
+
+    /**
+     * \brief Add the estimated memory footprint of the Archive to a
+     * MemoryUsage.
+     *
+     * The Archive and its ArchiveRecording are added to the
+     * archiveRecordings component, and the copies of DataHandler it holds to
+     * the archiveDataHandlers component. Recorded Program are not owned by
+     * the Archive and are not accounted for.
+     *
+     * \param[in,out] usage the MemoryUsage to update.
+     */
+    void addMemoryUsage(Util::MemoryUsage& usage) const;
 };
 
 #endif
@@ -0,0 +1,112 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifdef CODE_GENERATION
+
+#ifndef GENERATION_PARAMETERS_H
+#define GENERATION_PARAMETERS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace CodeGen {
+    /**
+     * \brief Structure holding the parameters of the code generation.
+     */
+    typedef struct GenerationParameters
+    {
+        /**
+         * \brief Generate reentrant inference code.
+         *
+         * By default, the generated programs read the data sources through
+         * global variables (in1, in2, ...) that must be defined by the user.
+         *
+         * When true, the data sources and the registers are instead
+         * accessed through a Context structure, declared in the generated
+         * header of programs. A pointer to the Context is given to
+         * inferenceTPG() and forwarded to all team and program functions,
+         * which keep no other mutable state. Several threads may thus call
+         * inferenceTPG() concurrently, each with its own Context.
+         */
+        bool reentrant = false;
+
+        /**
+         * \brief Number of observations processed together by the generated
+         * inferenceTPGBatch() function.
+         *
+         * When non zero, inferenceTPGBatch() is generated in addition to
+         * inferenceTPG(). It infers the actions of an array of Observation,
+         * by chunks of batchSize observations: each reachable program is
+         * executed on all observations pending in a team within a single
+         * loop, and observations are routed through the TPG by partitioning
+         * lists of indices. Requires the reentrant mode.
+         */
+        size_t batchSize = 0;
+
+        /**
+         * \brief Optimize the generated code.
+         *
+         * When true, the generated code is simplified without altering the
+         * decisions of the TPG:
+         * - Only the vertices reachable from the exported root, and the
+         *   programs of their outgoing edges, are generated.
+         * - Intron lines of programs are not generated, even if the intron
+         *   flags of the Program were never computed.
+         * - Constants are inlined as literals in the lines using them, so
+         *   that unused constants are not declared.
+         * - In inferenceTPG() of the switch mode, the bid of a program
+         *   shared by several edges is computed once per inference.
+         */
+        bool optimize = false;
+
+        /**
+         * \brief Roots of the TPGGraph exported by the generated code.
+         *
+         * Each element is an index in the vector returned by
+         * TPGGraph::getRootVertices().
+         *
+         * When empty, the generated code is executed from the first root
+         * of the TPGGraph, and inferenceTPG() takes no root argument.
+         *
+         * Otherwise, all selected roots share the generated team and program
+         * functions, and inferenceTPG() takes an additional int rootId
+         * argument, the index of the root to execute in this vector.
+         * Batch inference supports a single selected root.
+         */
+        std::vector<size_t> roots;
+    } GenerationParameters;
+} // namespace CodeGen
+
+#endif // GENERATION_PARAMETERS_H
+
+#endif // CODE_GENERATION
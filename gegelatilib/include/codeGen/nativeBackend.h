@@ -0,0 +1,307 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifdef NATIVE_BACKEND
+
+#ifndef NATIVE_BACKEND_H
+#define NATIVE_BACKEND_H
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "environment.h"
+#include "program/program.h"
+#include "tpg/tpgGraph.h"
+
+namespace CodeGen {
+    /**
+     * \brief Execution backend running long-lived Program as native code.
+     *
+     * During a training, the Program of TPGEdge surviving many generations
+     * are executed far more often than new ones. The NativeBackend tracks
+     * the Program of a TPGGraph from one generation to the next, with the
+     * update() method. When a Program has survived minNbGenerations
+     * generations, the NativeBackend generates its C code with the
+     * ProgramGenerationEngine (in reentrant mode), and compiles it with the
+     * locally installed C compiler into a shared object, which is then
+     * loaded with dlopen. All Program becoming eligible during the same
+     * update() are compiled together, on a background thread, so that the
+     * training is never stopped by the compilation.
+     *
+     * Once compiled, getNativeFunction() returns the native function of the
+     * Program, which is used by the TPGExecutionEngine given to
+     * TPGExecutionEngine::setNativeBackend(). Program that are not compiled
+     * yet, or whose code can not be generated, are still interpreted.
+     *
+     * Native functions are generated from the print templates of the
+     * Instruction, which must thus compute exactly the same results as
+     * their C++ implementation.
+     *
+     * The NativeBackend keeps a shared pointer to each tracked Program, and
+     * releases it when the Program is no longer in the TPGGraph given to
+     * update().
+     */
+    class NativeBackend
+    {
+      public:
+        /**
+         * \brief Signature of the native function of a Program.
+         *
+         * The native function takes an array holding, for each data source
+         * of the Environment, a pointer to its first element, and returns
+         * the result of the Program.
+         */
+        typedef double (*NativeFunction)(const void* const* dataSources);
+
+        /// Native functions of the compiled Program.
+        typedef std::unordered_map<const Program::Program*, NativeFunction>
+            NativeFunctionMap;
+
+      protected:
+        /**
+         * \brief Private copy of the data sources of the Environment.
+         *
+         * The code generation queries characteristics of the data sources,
+         * which must not be shared with the threads executing Program.
+         */
+        std::vector<std::unique_ptr<Data::DataHandler>> privateDataSources;
+
+        /// Environment of the code generation, built on privateDataSources.
+        std::unique_ptr<Environment> env;
+
+        /// Number of update() a Program must survive before its compilation.
+        const uint64_t minNbGenerations;
+
+        /// Command used to compile a shared object.
+        const std::string compilerCommand;
+
+        /// Directory holding the generated files and shared objects.
+        std::string workDir;
+
+        /// Information on a Program tracked by the NativeBackend.
+        typedef struct TrackedProgram
+        {
+            /// Shared pointer keeping the Program alive while it is tracked.
+            std::shared_ptr<Program::Program> program;
+
+            /// Number of update() during which the Program was in the graph.
+            uint64_t nbGenerations = 0;
+
+            /// Was the Program already submitted for compilation.
+            bool submitted = false;
+        } TrackedProgram;
+
+        /// Program tracked by the NativeBackend.
+        std::unordered_map<const Program::Program*, TrackedProgram> tracked;
+
+        /**
+         * \brief Native function of the compiled Program still tracked.
+         *
+         * The map is never modified once published: a modified copy replaces
+         * it atomically, so that executing threads read it without locking.
+         */
+        std::shared_ptr<const NativeFunctionMap> nativeFunctions;
+
+        /// Incremented each time new nativeFunctions are published.
+        std::atomic<uint64_t> nativeFunctionsVersion{1};
+
+        /// Mutex protecting tracked, and serializing the publication of
+        /// nativeFunctions.
+        mutable std::shared_mutex mutex;
+
+        /// Publish new nativeFunctions. Must be called with the mutex held.
+        void publishNativeFunctions(
+            std::shared_ptr<const NativeFunctionMap> functions);
+
+        /// Handles of the loaded shared objects.
+        std::vector<void*> libraries;
+
+        /// Batches of Program waiting for their compilation.
+        std::queue<std::vector<std::shared_ptr<Program::Program>>> jobs;
+
+        /// Mutex protecting jobs, busy and stop.
+        std::mutex jobsMutex;
+
+        /// Notifies the worker of new jobs, and waiting threads of their end.
+        std::condition_variable jobsCondition;
+
+        /// Is the worker currently compiling a job.
+        bool busy = false;
+
+        /// Is the worker requested to stop.
+        bool stop = false;
+
+        /// Number of shared objects successfully compiled.
+        size_t nbCompilations = 0;
+
+        /// Number of Program whose native function could not be built.
+        size_t nbFailures = 0;
+
+        /// Thread compiling the jobs.
+        std::thread worker;
+
+        /// Main function of the worker thread.
+        void workerLoop();
+
+        /**
+         * \brief Generate, compile and load the native code of Program.
+         *
+         * \param[in] programs the Program to compile together.
+         * \param[in] libIdx index of the shared object, used to name files.
+         */
+        void compile(const std::vector<std::shared_ptr<Program::Program>>&
+                         programs,
+                     size_t libIdx);
+
+      public:
+        /**
+         * \brief Constructor of the NativeBackend.
+         *
+         * Creates a private temporary directory for the generated files, and
+         * starts the compilation thread.
+         *
+         * \param[in] env the Environment of the compiled Program.
+         * \param[in] minNbGenerations number of update() a Program must be
+         * present in the TPGGraph to be compiled.
+         * \param[in] compilerCommand command used to build the shared
+         * objects, to which the output and source files are appended.
+         * Floating-point contraction is disabled by default, so that native
+         * results remain identical to interpreted ones.
+         * \throws std::runtime_error if the temporary directory can not be
+         * created.
+         */
+        NativeBackend(const Environment& env, uint64_t minNbGenerations = 3,
+                      const std::string& compilerCommand =
+                          "cc -O2 -ffp-contract=off -shared -fPIC");
+
+        /// Deleted copy constructor.
+        NativeBackend(const NativeBackend& other) = delete;
+
+        /// Deleted assignment operator.
+        NativeBackend& operator=(const NativeBackend& other) = delete;
+
+        /**
+         * \brief Destructor of the NativeBackend.
+         *
+         * Stops the compilation thread, unloads the shared objects and
+         * removes the temporary directory.
+         */
+        ~NativeBackend();
+
+        /**
+         * \brief Update the tracked Program with those of a TPGGraph.
+         *
+         * Program of the graph see their number of generations incremented,
+         * and are submitted for compilation when it reaches
+         * minNbGenerations. Program no longer in the graph are released.
+         *
+         * This method should be called once per generation, while no
+         * TPGExecutionEngine using this NativeBackend is executing.
+         *
+         * \param[in] graph the TPGGraph whose Program are tracked.
+         */
+        void update(const TPG::TPGGraph& graph);
+
+        /**
+         * \brief Get the native function of a Program.
+         *
+         * This method can be called concurrently by several threads, and
+         * never blocks. Threads executing many Program should rather keep
+         * the map returned by getNativeFunctions() until
+         * getNativeFunctionsVersion() changes.
+         *
+         * \param[in] prog the Program whose native function is requested.
+         * \return the native function, or nullptr if the Program is not
+         * compiled.
+         */
+        NativeFunction getNativeFunction(const Program::Program& prog) const;
+
+        /**
+         * \brief Get the current native functions of the compiled Program.
+         *
+         * The returned map is immutable. It may contain a Program released
+         * by a later update(), so it must be replaced whenever
+         * getNativeFunctionsVersion() changes.
+         */
+        std::shared_ptr<const NativeFunctionMap> getNativeFunctions() const;
+
+        /// Get the version of the native functions, changing each time
+        /// native functions are added or removed.
+        uint64_t getNativeFunctionsVersion() const;
+
+        /// Block until all submitted Program are compiled.
+        void waitForCompilations();
+
+        /// Get the number of Program currently executed natively.
+        size_t getNbNativePrograms() const;
+
+        /// Get the number of shared objects successfully compiled.
+        size_t getNbCompilations();
+
+        /// Get the number of Program whose native function failed to build.
+        size_t getNbFailures();
+
+        /**
+         * \brief Get the pointers to the data given to native functions.
+         *
+         * Only DataHandler giving a Data::DataHandler::ScalarAccess to their
+         * contiguous array of primitive types are supported. The pointers
+         * remain valid as long as the storage of the DataHandler is not
+         * replaced or reallocated.
+         *
+         * \param[in] dataSources the data sources of the execution.
+         * \param[out] pointers filled with the pointer to the first element
+         * of each data source.
+         * \return false if a data source is not supported, in which case
+         * Program must be interpreted.
+         */
+        static bool getDataPointers(
+            const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+                dataSources,
+            std::vector<const void*>& pointers);
+    };
+} // namespace CodeGen
+
+#endif // NATIVE_BACKEND_H
+
+#endif // NATIVE_BACKEND
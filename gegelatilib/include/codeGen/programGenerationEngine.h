@@ -40,6 +40,7 @@
 #define PROGRAM_GENERATION_ENGINE_H
 #include <fstream>
 
+#include "codeGen/generationParameters.h"
 #include "data/dataHandlerPrinter.h"
 #include "data/primitiveTypeArray.h"
 #include "instructions/instruction.h"
@@ -58,6 +59,12 @@ namespace CodeGen {
      * In the generated code, inclusion of externHeader.h allows including
      * necessary headers (like math.h) to compile the generated code without
      * modifying it.
+     *
+     * When the reentrant GenerationParameters is set, the data sources and
+     * registers are accessed through a Context structure declared in the
+     * generated header, and given by pointer to each program function.
+     * With a non-zero batchSize, a batch version of each program is also
+     * generated, which executes the program on a list of Observation.
      */
     class ProgramGenerationEngine : public Program::ProgramEngine
     {
@@ -66,6 +73,9 @@ namespace CodeGen {
         /// Instruction.
         static const std::regex operand_regex;
 
+        /// regex used to identify accesses to constants in generated code.
+        static const std::regex constant_regex;
+
         /**
          * \brief Name given to the global variable in generated files.
          *
@@ -84,6 +94,15 @@ namespace CodeGen {
         /// name of the temporary operand used in the TPG's programs.
         static const std::string nameOperandVariable;
 
+        /// name of the pointer to the Context in reentrant programs.
+        static const std::string nameContextVariable;
+
+        /// name of the pointer to the current Observation in batch programs.
+        static const std::string nameObservationVariable;
+
+        /// Parameters of the code generation.
+        const GenerationParameters params;
+
         /// The file in which programs will be added.
         std::ofstream fileC;
         /// The file in which prototypes of programs will be added.
@@ -92,6 +111,17 @@ namespace CodeGen {
         ///  Utility class used to print data accesses in generated code.
         Data::DataHandlerPrinter dataPrinter;
 
+        /// Name of the structure pointer through which data sources are
+        /// accessed in the program being generated. Empty for global ones.
+        std::string nameDataOwner;
+
+        /// Indentation of the generated lines of the current program.
+        std::string lineIndent{"\t"};
+
+        /// Intron flag of each line of the current program, computed when
+        /// the optimize GenerationParameters is set. Empty otherwise.
+        std::vector<bool> intronLines;
+
       public:
         /// inherited from Program::ProgramEngine
         virtual void processLine() override;
@@ -113,11 +143,14 @@ namespace CodeGen {
          * \param[in] path a const reference to the path in which the file must
          * be generated. By default, the file is generated in the current
          * directory.
+         *
+         * \param[in] params the parameters of the code generation.
          */
-        ProgramGenerationEngine(const std::string& filename,
-                                const Environment& env,
-                                const std::string& path = "./")
-            : ProgramEngine(env), dataPrinter()
+        ProgramGenerationEngine(
+            const std::string& filename, const Environment& env,
+            const std::string& path = "./",
+            const GenerationParameters& params = GenerationParameters())
+            : ProgramEngine(env), params{params}, dataPrinter()
         {
             openFile(filename, path, env.getNbConstant());
         }
@@ -139,11 +172,14 @@ namespace CodeGen {
          *
          * \param[in] path const reference to the path in which the file is
          * generated
+         *
+         * \param[in] params the parameters of the code generation.
          */
-        ProgramGenerationEngine(const std::string& filename,
-                                const Program::Program& p,
-                                const std::string& path = "./")
-            : ProgramEngine(p), dataPrinter()
+        ProgramGenerationEngine(
+            const std::string& filename, const Program::Program& p,
+            const std::string& path = "./",
+            const GenerationParameters& params = GenerationParameters())
+            : ProgramEngine(p), params{params}, dataPrinter()
         {
             openFile(filename, path, p.getEnvironment().getNbConstant());
             setProgram(p);
@@ -176,8 +212,8 @@ namespace CodeGen {
          * Print a function in the file "filename"_program.c that regroups all
          * the instruction of the program and return a double. The name of the
          * printed function is based on the identifier of the program. The
-         * declaration of function of the program with ID=1 is double P1(int*
-         * action)
+         * declaration of function of the program with ID=1 is double P1(), or
+         * double P1(Context* ctx) in reentrant mode.
          *
          * \param[in] progID : unique identifier of the program used to generate
          *            the name of the function in the C file.
@@ -192,6 +228,23 @@ namespace CodeGen {
         void generateProgram(uint64_t progID,
                              const bool ignoreException = false);
 
+        /**
+         * \brief Generate the batch version of the member program.
+         *
+         * Print a function void P<id>Batch(const Observation* inputs,
+         * const int* idx, int nb, double* bids) storing in bids[k] the
+         * result of the program executed on the Observation inputs[idx[k]],
+         * for k in [0, nb).
+         *
+         * This function is called by generateProgram() when the batchSize
+         * of the GenerationParameters is non zero.
+         *
+         * \param[in] progID identifier of the program.
+         * \param[in] ignoreException see generateProgram().
+         */
+        void generateProgramBatch(uint64_t progID,
+                                  const bool ignoreException = false);
+
       protected:
         /**
          * \brief Set global variables in the file holding the programs.
@@ -206,6 +259,27 @@ namespace CodeGen {
          */
         void initGlobalVar(size_t nbConstant);
 
+        /**
+         * \brief Declare the Context structure in the header of programs.
+         *
+         * In reentrant mode, the Context replaces the global variables
+         * printed by initGlobalVar(). It holds the registers of programs,
+         * and a pointer to each data source of the Environment, typed
+         * accordingly.
+         *
+         * \param[in] nbConstant size_t of the number of Data::Constant
+         * available for a Program.
+         */
+        void initContext(size_t nbConstant);
+
+        /**
+         * \brief Print the declaration of the constants of the member
+         * program.
+         *
+         * \param[in] indent indentation of the printed declaration.
+         */
+        void printConstants(const std::string& indent);
+
         /**
          * \brief Generates the line of C code that implements the instruction
          * in parameter.
@@ -246,6 +320,16 @@ namespace CodeGen {
          */
         void initOperandCurrentLine();
 
+        /**
+         * \brief Replace accesses to the array of constants with the literal
+         * value of the accessed constants of the member program.
+         *
+         * \param[in] code the generated code accessing constants.
+         * \return a copy of code where each access to nameConstantVariable
+         * is replaced with the value of the constant.
+         */
+        std::string inlineConstants(const std::string& code) const;
+
         /**
          * \brief Method returning the name of the data source in the file
          * generated.
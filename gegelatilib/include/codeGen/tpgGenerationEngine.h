@@ -65,6 +65,13 @@ namespace CodeGen {
      *
      * The repo gegelati apps give some example of the template code completed
      * for TicTacToe, Pendulum and StickGame.
+     *
+     * With the reentrant GenerationParameters, the generated inferenceTPG()
+     * takes a pointer to the Context structure declared in the header of
+     * programs, which is forwarded to all generated functions. With a non
+     * zero batchSize, an inferenceTPGBatch() function is also generated.
+     * When roots are selected, inferenceTPG() takes the index of the root
+     * to execute as its last argument.
      */
     class TPGGenerationEngine : public TPG::TPGAbstractEngine
     {
@@ -75,6 +82,9 @@ namespace CodeGen {
          */
         inline static const std::string filenameProg = "program";
 
+        /// Parameters of the code generation.
+        const GenerationParameters params;
+
         /// File holding the functions in charge of iterating through the TPG.
         std::ofstream fileMain;
         /// header file for the function that iterates through the TPG.
@@ -118,10 +128,17 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] params the parameters of the code generation.
+         *
+         * \throw std::invalid_argument if a selected root index is not the
+         * index of a root of the TPGGraph, or if a batch inference is
+         * requested for more than one root.
          */
-        TPGGenerationEngine(const std::string& filename,
-                            const TPG::TPGGraph& tpg,
-                            const std::string& path = "./");
+        TPGGenerationEngine(
+            const std::string& filename, const TPG::TPGGraph& tpg,
+            const std::string& path = "./",
+            const GenerationParameters& params = GenerationParameters());
 
         /**
          * \brief destructor of the class.
@@ -178,6 +195,58 @@ namespace CodeGen {
          * generated.
          */
         virtual void generateAction(const TPG::TPGAction& action) = 0;
+
+        /**
+         * \brief Get the roots of the TPGGraph exported by the generated code.
+         *
+         * \return the roots selected in the GenerationParameters, or the
+         * first root of the TPGGraph if no root was selected.
+         */
+        std::vector<const TPG::TPGVertex*> getGeneratedRoots() const;
+
+        /**
+         * \brief Get the parameters of the generated inferenceTPG() function.
+         *
+         * \return the comma-separated parameters of inferenceTPG(), that is,
+         * the pointer to the Context in reentrant mode, and the index of the
+         * executed root when roots are selected in the GenerationParameters.
+         */
+        std::string getInferenceParameters() const;
+
+        /**
+         * \brief Get the vertices of the TPGGraph for which code must be
+         * generated.
+         *
+         * With the optimize GenerationParameters, only the vertices reachable
+         * from the exported roots of the TPGGraph are returned. Otherwise, all
+         * vertices of the TPGGraph are returned.
+         *
+         * \return the vertices to generate, in the order of
+         * TPGGraph::getVertices().
+         */
+        std::vector<const TPG::TPGVertex*> getGeneratedVertices() const;
+
+        /**
+         * \brief Method generating the batch inference of the TPG.
+         *
+         * The generated function
+         * void inferenceTPGBatch(BatchContext* ctx, const Observation* inputs,
+         * int* actions, int nb) writes in actions[i] the action of the TPG
+         * for the observation inputs[i], for i in [0, nb).
+         *
+         * Observations are processed by chunks of batchSize. The
+         * BatchContext holds, for each team reachable from the root, the
+         * list of indices of the observations pending in this team. Teams
+         * are processed in topological order: the batch versions of the
+         * programs of a team are executed over all its pending
+         * observations, and each observation index is then moved to the
+         * list of the destination of its winning edge, or its action is
+         * written if this destination is an action.
+         *
+         * This method must be called after all programs of the TPGGraph were
+         * generated.
+         */
+        void generateBatchInference();
     };
 } // namespace CodeGen
 
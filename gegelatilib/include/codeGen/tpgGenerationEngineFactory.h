@@ -74,11 +74,14 @@ namespace CodeGen {
         /**
          * @brief Factory method to create a codegen with the configured mode.
          *
+         * @param[in] params the parameters forwarded to the created codegen.
+         *
          * @return a unique_ptr<TPGGenerationEngine>.
          */
         std::unique_ptr<TPGGenerationEngine> create(
             const std::string& filename, const TPG::TPGGraph& tpg,
-            const std::string& path = "./");
+            const std::string& path = "./",
+            const GenerationParameters& params = GenerationParameters());
 
       private:
         enum generationEngineMode mode;
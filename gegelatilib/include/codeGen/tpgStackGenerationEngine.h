@@ -66,7 +66,9 @@ namespace CodeGen {
          * \brief function printing generic code in the main file.
          *
          * This function prints generic code to execute the TPG and manage the
-         * stack of visited edges.
+         * stack of visited edges. When the generated code must be reentrant,
+         * the Context given to inferenceTPG() is forwarded to all functions
+         * and programs, and the arrays of edges are accessed as read-only.
          */
         virtual void initTpgFile();
 
@@ -92,10 +94,13 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] params the parameters of the code generation.
          */
-        TPGStackGenerationEngine(const std::string& filename,
-                                 const TPG::TPGGraph& tpg,
-                                 const std::string& path = "./");
+        TPGStackGenerationEngine(
+            const std::string& filename, const TPG::TPGGraph& tpg,
+            const std::string& path = "./",
+            const GenerationParameters& params = GenerationParameters());
 
         /**
          * \brief destructor of the class.
@@ -160,6 +165,17 @@ namespace CodeGen {
          */
         virtual void setRoot(const TPG::TPGVertex& root);
 
+        /**
+         * \brief Define the roots executed by the generated inferenceTPG().
+         *
+         * Without roots selected in the GenerationParameters, calls setRoot()
+         * with the first root. Otherwise, defines the array roots of function
+         * pointers, indexed by the rootId argument of inferenceTPG().
+         *
+         * \param[in] roots the roots exported by the generated code.
+         */
+        void setRoots(const std::vector<const TPG::TPGVertex*>& roots);
+
         /**
          * \brief Generate function name depending on the vertex type.
          *
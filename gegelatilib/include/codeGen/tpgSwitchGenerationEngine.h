@@ -40,6 +40,8 @@
 
 #ifndef TPG_SWITCH_GENERATION_ENGINE_H
 #define TPG_SWITCH_GENERATION_ENGINE_H
+#include <map>
+
 #include "codeGen/tpgGenerationEngine.h"
 
 namespace CodeGen {
@@ -49,10 +51,19 @@ namespace CodeGen {
      * Each program of the TPGGraph is represented by a C function.
      * All the functions are regrouped in a file. Another file holds
      * the required functions to iterate through the TPGGraph.
+     *
+     * With the optimize GenerationParameters, the bid of a program shared by
+     * several generated edges is stored in a local array of inferenceTPG()
+     * the first time it is computed, and reused by other edges during the
+     * same inference.
      */
     class TPGSwitchGenerationEngine : public CodeGen::TPGGenerationEngine
     {
       protected:
+        /// Index in the generated cache of bids of each program shared by
+        /// several generated edges. Empty when not optimizing.
+        std::map<const Program::Program*, size_t> sharedPrograms;
+
         /**
          * \brief function printing generic code in the main file.
          *
@@ -83,11 +94,14 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] params the parameters of the code generation.
          */
-        TPGSwitchGenerationEngine(const std::string& filename,
-                                  const TPG::TPGGraph& tpg,
-                                  const std::string& path = "./")
-            : TPGGenerationEngine(filename, tpg, path){};
+        TPGSwitchGenerationEngine(
+            const std::string& filename, const TPG::TPGGraph& tpg,
+            const std::string& path = "./",
+            const GenerationParameters& params = GenerationParameters())
+            : TPGGenerationEngine(filename, tpg, path, params){};
 
         /**
          * \brief destructor of the class.
@@ -134,6 +134,9 @@ namespace Data {
          */
         virtual DataHandler* clone() const override;
 
+        /// Inherited from DataHandler
+        virtual size_t getMemoryFootprint() const override;
+
         /// Inherited from DataHandler
         virtual size_t getAddressSpace(
             const std::type_info& type) const override;
@@ -170,6 +173,12 @@ namespace Data {
         return result;
     }
 
+    template <class T> size_t Array2DWrapper<T>::getMemoryFootprint() const
+    {
+        // Wrapped data is not owned by the Array2DWrapper.
+        return sizeof(Array2DWrapper<T>);
+    }
+
     template <typename T>
     std::vector<size_t> Array2DWrapper<T>::getAddressesAccessed(
         const std::type_info& type, const size_t address) const
@@ -37,6 +37,7 @@
 #ifndef ARRAY_WRAPPER_H
 #define ARRAY_WRAPPER_H
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <regex>
@@ -165,6 +166,9 @@ namespace Data {
          */
         virtual DataHandler* clone() const override;
 
+        /// Inherited from DataHandler
+        virtual size_t getMemoryFootprint() const override;
+
         /// Inherited from DataHandler
         virtual bool canHandle(const std::type_info& type) const override;
 
@@ -200,6 +204,14 @@ namespace Data {
          */
         void setPointer(std::vector<T>* ptr);
 
+        /**
+         * \brief Get the pointer of the ArrayWrapper.
+         *
+         * \return the pointer to the vector currently managed by the
+         * ArrayWrapper, possibly nullptr.
+         */
+        const std::vector<T>* getPointer() const;
+
         /// Inherited from DataHandler
         virtual UntypedSharedPtr getDataAt(const std::type_info& type,
                                            const size_t address) const override;
@@ -208,6 +220,9 @@ namespace Data {
         virtual std::vector<size_t> getAddressesAccessed(
             const std::type_info& type, const size_t address) const override;
 
+        /// Inherited from DataHandler
+        virtual ScalarAccess getScalarAccess() const override;
+
 #ifdef CODE_GENERATION
         /// Inherited from DataHandler
         virtual const std::type_info& getNativeType() const override;
@@ -270,6 +285,12 @@ namespace Data {
         return result;
     }
 
+    template <class T> size_t ArrayWrapper<T>::getMemoryFootprint() const
+    {
+        // Wrapped data is not owned by the ArrayWrapper.
+        return sizeof(ArrayWrapper<T>);
+    }
+
     template <class T>
     size_t ArrayWrapper<T>::getAddressSpace(const std::type_info& type) const
     {
@@ -348,21 +369,39 @@ namespace Data {
 
         // Else, the only other supported type is cstyle array.
 
-        // Allocate the array
+        // Check the copied range once, since an unsupported type has a null
+        // address space.
         size_t arraySize = this->nbElements - this->getAddressSpace(type) + 1;
-        T* array = new T[arraySize];
-
-        // Copy its content
-        for (size_t idx = 0; idx < arraySize; idx++) {
-            array[idx] = this->containerPtr->at(address + idx);
+        if (address + arraySize > this->containerPtr->size()) {
+            throw std::out_of_range("Array exceeds the ArrayWrapper data.");
         }
 
+        // Allocate the array and copy its content
+        T* array = new T[arraySize];
+        std::copy_n(this->containerPtr->data() + address, arraySize, array);
+
         // Create the UntypedSharedPtr
         UntypedSharedPtr result{
             std::make_shared<UntypedSharedPtr::Model<const T[]>>(array)};
         return result;
     }
 
+    template <class T>
+    DataHandler::ScalarAccess ArrayWrapper<T>::getScalarAccess() const
+    {
+        ScalarAccess access;
+        if (this->containerPtr != nullptr) {
+            access.type = &typeid(T);
+            access.data = this->containerPtr->data();
+            access.get = [](const void* data, size_t address) {
+                return UntypedSharedPtr(
+                    static_cast<const T*>(data) + address,
+                    UntypedSharedPtr::emptyDestructor<const T>());
+            };
+        }
+        return access;
+    }
+
     template <class T> size_t ArrayWrapper<T>::getLargestAddressSpace() const
     {
         // Currently, largest addres space is for the template Type T.
@@ -404,6 +443,12 @@ namespace Data {
         this->invalidCachedHash = true;
     }
 
+    template <class T>
+    inline const std::vector<T>* ArrayWrapper<T>::getPointer() const
+    {
+        return this->containerPtr;
+    }
+
     template <class T> inline size_t ArrayWrapper<T>::updateHash() const
     {
         // Null pointer case
@@ -123,6 +123,18 @@ namespace Data {
          */
         virtual DataHandler* clone() const = 0;
 
+        /**
+         * \brief Get the estimated memory footprint of the DataHandler.
+         *
+         * The footprint includes the DataHandler object and the data it owns,
+         * but not data wrapped from an external container. Default
+         * implementation returns the size of the DataHandler class and
+         * should be overridden by classes owning data.
+         *
+         * \return the footprint in bytes.
+         */
+        virtual size_t getMemoryFootprint() const;
+
         /**
          * \brief Get the ID of the DataHandler.
          *
@@ -240,6 +252,36 @@ namespace Data {
         virtual std::vector<size_t> getAddressesAccessed(
             const std::type_info& type, const size_t address) const = 0;
 
+        /**
+         * \brief Direct access to the scalar data of a DataHandler.
+         *
+         * When type is not nullptr, get(data, address) returns the same
+         * UntypedSharedPtr as getDataAt(*type, address), without any check
+         * of the address.
+         */
+        typedef struct ScalarAccess
+        {
+            /// Type of the directly accessible data, nullptr if none.
+            const std::type_info* type = nullptr;
+
+            /// First element of the data.
+            const void* data = nullptr;
+
+            /// Function returning the element of data at the given address.
+            UntypedSharedPtr (*get)(const void* data, size_t address) = nullptr;
+        } ScalarAccess;
+
+        /**
+         * \brief Get a direct access to the scalar data of the DataHandler.
+         *
+         * The returned access is only valid until the data of the DataHandler
+         * is replaced or reallocated. By default, no direct access is
+         * provided.
+         *
+         * \return the ScalarAccess to the data of the DataHandler.
+         */
+        virtual ScalarAccess getScalarAccess() const;
+
         /**
          * \brief Scale a location from the Environment largestAddressSpace to
          * the largestAddressSpace of the dataHandler, for the given data type.
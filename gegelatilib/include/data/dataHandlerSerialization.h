@@ -0,0 +1,120 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef DATA_HANDLER_SERIALIZATION_H
+#define DATA_HANDLER_SERIALIZATION_H
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "data/dataHandler.h"
+
+namespace Data {
+    /**
+     * \brief Functions used to store raw values and DataHandler content in
+     * binary buffers.
+     *
+     * Buffers are only meant to be read back on a machine with the same
+     * architecture, for example by another process or after a restart of
+     * the same program.
+     */
+    namespace Serialization {
+        /**
+         * \brief Append the raw bytes of a value to a buffer.
+         *
+         * \param[in,out] buffer the buffer to which the value is appended.
+         * \param[in] value the appended value.
+         */
+        template <typename T>
+        void appendValue(std::string& buffer, const T& value)
+        {
+            buffer.append((const char*)&value, sizeof(T));
+        }
+
+        /**
+         * \brief Read a value at the given offset of a buffer.
+         *
+         * \param[in] buffer the buffer from which the value is read.
+         * \param[in,out] offset the position of the value in the buffer,
+         * advanced after the value.
+         * \return the read value.
+         * \throw std::runtime_error if the buffer is too short.
+         */
+        template <typename T>
+        T readValue(const std::string& buffer, size_t& offset)
+        {
+            if (offset + sizeof(T) > buffer.size()) {
+                throw std::runtime_error("Truncated serialized data.");
+            }
+            T value;
+            std::memcpy(&value, buffer.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        /**
+         * \brief Append the content of a DataHandler to a buffer.
+         *
+         * Supported DataHandler are ArrayWrapper of double, float, int,
+         * int64_t, uint8_t and char, including PrimitiveTypeArray and
+         * PrimitiveTypeArray2D.
+         *
+         * \param[in,out] buffer the buffer to which the content is appended.
+         * \param[in] dHandler the DataHandler whose content is appended.
+         * \return false if the type of DataHandler is not supported, in
+         * which case the buffer is left unchanged.
+         */
+        bool appendDataHandlerContent(std::string& buffer,
+                                      const DataHandler& dHandler);
+
+        /**
+         * \brief Fill a DataHandler with the content read from a buffer.
+         *
+         * The DataHandler must be a PrimitiveTypeArray or a
+         * PrimitiveTypeArray2D with the type and size of the serialized one,
+         * typically a clone of the DataHandler whose content was serialized.
+         *
+         * \param[in] buffer the buffer from which the content is read.
+         * \param[in,out] offset the position of the content in the buffer,
+         * advanced after the content.
+         * \param[in,out] dHandler the DataHandler to fill.
+         * \throw std::runtime_error if the content does not match the
+         * DataHandler or if the buffer is too short.
+         */
+        void readDataHandlerContent(const std::string& buffer, size_t& offset,
+                                    DataHandler& dHandler);
+    }; // namespace Serialization
+};     // namespace Data
+
+#endif
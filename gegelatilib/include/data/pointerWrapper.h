@@ -99,6 +99,9 @@ namespace Data {
          */
         virtual DataHandler* clone() const override;
 
+        /// Inherited from DataHandler
+        virtual size_t getMemoryFootprint() const override;
+
         /// Inherited from DataHandler
         virtual bool canHandle(const std::type_info& type) const override;
 
@@ -177,6 +180,12 @@ namespace Data {
         return result;
     }
 
+    template <class T> size_t PointerWrapper<T>::getMemoryFootprint() const
+    {
+        // Wrapped data is not owned by the PointerWrapper.
+        return sizeof(PointerWrapper<T>);
+    }
+
     template <class T>
     inline bool PointerWrapper<T>::canHandle(const std::type_info& type) const
     {
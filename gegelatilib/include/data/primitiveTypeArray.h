@@ -83,6 +83,9 @@ namespace Data {
         /// Inherited from DataHandler
         virtual DataHandler* clone() const override;
 
+        /// Inherited from DataHandler
+        virtual size_t getMemoryFootprint() const override;
+
         /**
          * \brief Sets all elements of the Array to 0 (or its equivalent for
          * the given template param.)
@@ -186,6 +189,12 @@ namespace Data {
         return result;
     }
 
+    template <class T> size_t PrimitiveTypeArray<T>::getMemoryFootprint() const
+    {
+        return sizeof(PrimitiveTypeArray<T>) +
+               this->data.capacity() * sizeof(T);
+    }
+
     template <class T> void PrimitiveTypeArray<T>::resetData()
     {
         for (T& elt : this->data) {
@@ -94,6 +94,9 @@ namespace Data {
         /// Inherited from DataHandler
         virtual DataHandler* clone() const override;
 
+        /// Inherited from DataHandler
+        virtual size_t getMemoryFootprint() const override;
+
         /**
          * \brief Sets all elements of the Array to 0 (or its equivalent for
          * the given template param.)
@@ -186,6 +189,13 @@ namespace Data {
         return result;
     }
 
+    template <typename T>
+    size_t PrimitiveTypeArray2D<T>::getMemoryFootprint() const
+    {
+        return sizeof(PrimitiveTypeArray2D<T>) +
+               this->data.capacity() * sizeof(T);
+    }
+
     template <class T> void PrimitiveTypeArray2D<T>::resetData()
     {
         for (T& elt : this->data) {
@@ -0,0 +1,154 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TPG_GRAPH_BINARY_EXPORTER_H
+#define TPG_GRAPH_BINARY_EXPORTER_H
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "file/tpgGraphBinaryFormat.h"
+#include "program/program.h"
+#include "tpg/tpgGraph.h"
+
+namespace File {
+    /**
+     * \brief Class used to export a TPGGraph into a compact binary file.
+     *
+     * Contrary to the TPGGraphDotExporter, which is intended for
+     * visualization, the binary format described in TPGGraphBinaryFormat is
+     * intended for saving and reloading TPGGraph efficiently, for example
+     * to ship trained TPGGraph to inference targets. The whole file is
+     * written in a single pass, and preserves the order of TPGVertex and
+     * TPGEdge, as well as the sharing of Program between TPGEdge.
+     */
+    class TPGGraphBinaryExporter
+    {
+      protected:
+        /**
+         * \brief File in which the binary content is written during export.
+         */
+        FILE* pFile;
+
+        /**
+         * \brief Const reference to the exported TPGGraph.
+         */
+        const TPG::TPGGraph& tpg;
+
+        /**
+         * \brief Write raw data in the file.
+         *
+         * \param[in] data pointer to the written data.
+         * \param[in] size number of bytes to write.
+         * \throws std::runtime_error if the data could not be written.
+         */
+        void write(const void* data, size_t size);
+
+        /**
+         * \brief Write the content of a Program in the program section.
+         *
+         * \param[in] program the Program to write.
+         */
+        void writeProgram(const Program::Program& program);
+
+      public:
+        /**
+         * \brief Constructor for the exporter.
+         *
+         * \param[in] filePath initial path to the file where the binary
+         * content will be written.
+         * \param[in] graph const reference to the graph whose content will
+         * be exported.
+         * \throws std::runtime_error in case no file could be opened at the
+         * given filePath.
+         */
+        TPGGraphBinaryExporter(const char* filePath, const TPG::TPGGraph& graph)
+            : pFile{NULL}, tpg{graph}
+        {
+            if ((pFile = fopen(filePath, "wb")) == NULL) {
+                throw std::runtime_error("Could not open file " +
+                                         std::string(filePath));
+            }
+        };
+
+        /// Copy construction is disabled, as for the TPGGraphDotExporter.
+        TPGGraphBinaryExporter(const TPGGraphBinaryExporter& other) = delete;
+
+        /// Assignment is disabled, as for the TPGGraphDotExporter.
+        TPGGraphBinaryExporter& operator=(const TPGGraphBinaryExporter& other) =
+            delete;
+
+        /**
+         * Destructor for the exporter.
+         *
+         * Closes the file.
+         */
+        ~TPGGraphBinaryExporter()
+        {
+            if (pFile != NULL) {
+                fclose(pFile);
+            }
+        }
+
+        /**
+         * \brief Set a new file for the exporter.
+         *
+         * \param[in] newFilePath new path to the file where the binary
+         * content will be written.
+         * \throws std::runtime_error in case no file could be opened at the
+         * given newFilePath.
+         */
+        void setNewFilePath(const char* newFilePath)
+        {
+            //  Close previous file
+            fclose(pFile);
+
+            // open new one;
+            if ((pFile = fopen(newFilePath, "wb")) == NULL) {
+                throw std::runtime_error("Could not open file " +
+                                         std::string(newFilePath));
+            }
+        }
+
+        /**
+         * \brief Write the TPGGraph given when constructing the
+         * TPGGraphBinaryExporter into the binary file.
+         *
+         * \throws std::runtime_error if the content could not be written.
+         */
+        void print();
+    };
+}; // namespace File
+
+#endif
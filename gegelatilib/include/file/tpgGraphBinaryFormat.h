@@ -0,0 +1,155 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TPG_GRAPH_BINARY_FORMAT_H
+#define TPG_GRAPH_BINARY_FORMAT_H
+
+#include <cstdint>
+
+namespace File {
+    /**
+     * \brief Description of the binary file format used by the
+     * TPGGraphBinaryExporter and TPGGraphBinaryImporter.
+     *
+     * A binary TPGGraph file is made of the following consecutive sections,
+     * all aligned on 8 bytes and stored with the endianness of the exporting
+     * machine:
+     * - A Header, identifying the file format and its version, the signature
+     *   of the Environment of the TPGGraph, and the size of the following
+     *   sections.
+     * - The vertex table, with one VertexEntry per TPGVertex of the TPGGraph,
+     *   in the order of TPGGraph::getVertices().
+     * - The edge table, with one EdgeEntry per TPGEdge of the TPGGraph, in
+     *   the order of TPGGraph::getEdges().
+     * - The program section, with for each Program:
+     *   - its number of lines, stored in a uint64_t,
+     *   - its constants, stored as int32_t, padded with zeros to the next
+     *     multiple of 8 bytes,
+     *   - its lines, each stored as 2 + 2 * maxNbOperands uint64_t: the
+     *     instruction index, the destination index, and the data source
+     *     index and location of each operand.
+     *
+     * Since all the content is stored with fixed size fields, a file can be
+     * mapped in memory and read in place with near-zero parsing.
+     */
+    namespace TPGGraphBinaryFormat {
+        /// Magic number at the beginning of all binary TPGGraph files.
+        static const char magic[8] = {'G', 'E', 'G', 'E', 'L', 'T', 'P', 'G'};
+
+        /// Version of the binary format written by the exporter.
+        static const uint32_t version = 1;
+
+        /// Value used to detect an endianness mismatch at import.
+        static const uint32_t endianness = 0x01020304;
+
+        /// Type of a TPGVertex in the vertex table.
+        enum VertexType : uint64_t
+        {
+            TEAM = 0,
+            ACTION = 1
+        };
+
+        /**
+         * \brief Header of a binary TPGGraph file.
+         */
+        struct Header
+        {
+            /// Magic number identifying the file format.
+            char magic[8];
+
+            /// Version of the file format.
+            uint32_t version;
+
+            /// Endianness marker.
+            uint32_t endianness;
+
+            /// Number of instructions of the Environment.
+            uint64_t nbInstructions;
+
+            /// Maximum number of operands of the Environment.
+            uint64_t maxNbOperands;
+
+            /// Number of registers of the Environment.
+            uint64_t nbRegisters;
+
+            /// Number of constants of the Environment.
+            uint64_t nbConstants;
+
+            /// Number of data sources of the Environment.
+            uint64_t nbDataSources;
+
+            /// Number of entries in the vertex table.
+            uint64_t nbVertices;
+
+            /// Number of entries in the edge table.
+            uint64_t nbEdges;
+
+            /// Number of Program in the program section.
+            uint64_t nbPrograms;
+        };
+
+        /**
+         * \brief Entry of the vertex table.
+         */
+        struct VertexEntry
+        {
+            /// Type of the TPGVertex.
+            uint64_t type;
+
+            /// ID of the TPGAction, unused for TPGTeam.
+            uint64_t actionID;
+        };
+
+        /**
+         * \brief Entry of the edge table.
+         */
+        struct EdgeEntry
+        {
+            /// Index of the source TPGVertex in the vertex table.
+            uint64_t source;
+
+            /// Index of the destination TPGVertex in the vertex table.
+            uint64_t destination;
+
+            /// Index of the Program in the program section.
+            uint64_t program;
+        };
+
+        static_assert(sizeof(Header) == 80, "Unexpected Header size.");
+        static_assert(sizeof(VertexEntry) == 16,
+                      "Unexpected VertexEntry size.");
+        static_assert(sizeof(EdgeEntry) == 24, "Unexpected EdgeEntry size.");
+    }; // namespace TPGGraphBinaryFormat
+};     // namespace File
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TPG_GRAPH_BINARY_IMPORTER_H
+#define TPG_GRAPH_BINARY_IMPORTER_H
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "file/tpgGraphBinaryFormat.h"
+#include "program/program.h"
+#include "tpg/tpgGraph.h"
+
+namespace File {
+    /**
+     * \brief Class used to import a TPGGraph from a binary file written by
+     * the TPGGraphBinaryExporter.
+     *
+     * The file is mapped in memory (when supported by the platform) and its
+     * fixed size records are read in place. The imported TPGGraph has the
+     * same vertices, edges and Program sharing, in the same order, as the
+     * exported one.
+     */
+    class TPGGraphBinaryImporter
+    {
+      protected:
+        /**
+         * \brief Path of the file from which the TPGGraph is imported.
+         */
+        std::string filePath;
+
+        /**
+         * \brief TPGGraph imported from the binary file.
+         */
+        TPG::TPGGraph& tpg;
+
+        /**
+         * \brief Check that a header matches the format and the Environment
+         * of the TPGGraph.
+         *
+         * \param[in] header the Header read from the file.
+         * \throws std::runtime_error if the header is not valid or not
+         * compatible with the Environment of the TPGGraph.
+         */
+        void checkHeader(const TPGGraphBinaryFormat::Header& header) const;
+
+        /**
+         * \brief Create a Program from its content in the program section.
+         *
+         * \param[in,out] cursor pointer to the beginning of the Program in
+         * the program section, updated to point after the Program.
+         * \param[in] end pointer to the end of the file content.
+         * \return the created Program.
+         * \throws std::runtime_error if the Program content is truncated or
+         * not valid for the Environment of the TPGGraph.
+         */
+        std::shared_ptr<Program::Program> readProgram(const char*& cursor,
+                                                      const char* end) const;
+
+      public:
+        /**
+         * \brief Constructor for the importer.
+         *
+         * The TPGGraph is imported within the constructor.
+         *
+         * \param[in] filePath path to the binary file to import.
+         * \param[in] tpgref a Reference to the TPGGraph to build from the
+         * binary file. Its Environment must be compatible with the one
+         * used when exporting the file.
+         * \throws std::runtime_error in case the file could not be opened,
+         * or its content is not valid.
+         */
+        TPGGraphBinaryImporter(const char* filePath, TPG::TPGGraph& tpgref)
+            : filePath{filePath}, tpg{tpgref}
+        {
+            importGraph();
+        };
+
+        /**
+         * \brief Set a new file for the importer.
+         *
+         * Contrary to the constructor, the TPGGraph is not imported by this
+         * method.
+         *
+         * \param[in] newFilePath new path to the binary file to import.
+         */
+        void setNewFilePath(const char* newFilePath);
+
+        /**
+         * \brief Creates a TPGGraph from its description in a binary file.
+         *
+         * The content of the TPGGraph is replaced with the imported one.
+         * The whole content of the file is checked before the TPGGraph is
+         * cleared, so the TPGGraph is left untouched in case of error.
+         *
+         * \throws std::runtime_error in case the file could not be opened,
+         * or its content is not valid.
+         */
+        void importGraph();
+    };
+}; // namespace File
+
+#endif
@@ -41,11 +41,13 @@
 #include <cstdio>
 #include <fstream>
 #include <inttypes.h>
-#include <map>
 #include <memory>
-#include <regex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "learn/learningEnvironment.h"
 #include "tpg/tpgAction.h"
@@ -91,7 +93,7 @@ namespace File {
          * keep track of the pointers while restoring the TPGGraph described in
          * a dot file
          */
-        std::map<uint64_t, const TPG::TPGVertex*> vertexID;
+        std::unordered_map<uint64_t, const TPG::TPGVertex*> vertexID;
 
         /**
          * \brief Map associating pointers to Program to an integer ID.
@@ -100,7 +102,8 @@ namespace File {
          * keep track of the pointers while restoring the TPGGraph described in
          * a dot file
          */
-        std::map<uint64_t, std::shared_ptr<Program::Program>> programID;
+        std::unordered_map<uint64_t, std::shared_ptr<Program::Program>>
+            programID;
 
         /**
          * \brief Map associating pointers to TPGVertex representing actions
@@ -109,7 +112,7 @@ namespace File {
          * This map is used to ensure that identical actions are not created
          * more than once.
          */
-        std::map<uint64_t, const TPG::TPGVertex*> actionID;
+        std::unordered_map<uint64_t, const TPG::TPGVertex*> actionID;
 
         /**
          * \brief Map associating actions to the corresponding action ID
@@ -117,220 +120,83 @@ namespace File {
          * This map is here is used to access the correct TPGVertex while
          * linking an action.
          */
-        std::map<uint64_t, uint64_t> actionLabel;
+        std::unordered_map<uint64_t, uint64_t> actionLabel;
 
         /**
-         * \brief string used to spot the end of a line in the program
-         * description.
-         */
-        static const std::string lineSeparator;
-
-        /**
-         * \brief Contains the regex to identify a team declaration
-         *
-         * this regex values "T([0-9]+)\\x20\\x5B.*\\x5D"
+         * \brief Map associating a Program ID to the destination of the
+         * first TPGEdge declared with this Program.
          *
-         * Explanation :
-         *
-         * T([0-9]+)     looks for a T followed by a number. the number will be
-         * stored in a group
-         * \\x20\\x5B    looks for a succession of a whitespace and an opening
-         * bracket ('[')
-         * .*\\x5D		the following can be any sequence of character
-         * terminated by
-         * ]
-         *
-         * Example:
-         * T10 [fillcolor="#1199bb"]				Should pass
-         * P0 [fillcolor="#22cccc" shape=point]	Should not pass
+         * In the dot file, TPGEdge reusing an already declared Program only
+         * reference the Program and take the destination of its first
+         * TPGEdge.
          */
-        static const std::string teamRegex;
+        std::unordered_map<uint64_t, const TPG::TPGVertex*> programDestination;
 
         /**
-         * \brief Contains the regex to identify a program declaration
-         *
-         * this regex values "P([0-9]+)\\x20\\x5B.*\\x5D"
-         *
-         * Explanation :
+         * \brief Program whose lines are yet to be parsed, with their label.
          *
-         * P([0-9]+)     looks for a P followed by a number. the number will be
-         * stored in a group
-         * \\x20\\x5B    looks for a succession of a whitespace and an opening
-         * bracket ('[')
-         * .*\\x5D		the following can be any sequence of character
-         * terminated by
-         * ]
-         *
-         * Example:
-         * P0 [fillcolor="#22cccc" shape=point]	Should pass
-         * T10 [fillcolor="#1199bb"]				Should not pass
+         * Program bodies are stored during the reading of the file, and
+         * parsed after, possibly in parallel, by the parsePrograms method.
          */
-        static const std::string programRegex;
+        std::vector<std::pair<std::shared_ptr<Program::Program>, std::string>>
+            pendingPrograms;
 
         /**
-         * \brief contains the regex to identify an instruction declaration
-         *
-         * this regex values "I([0-9]+)\\x20\\x5B.*label=\"(.*)\"\\x5D"
-         *
-         * Explanation :
-         *
-         * I([0-9]+)     looks for a I followed by a number. the number will be
-         * stored in a group
-         * \\x20\\x5B    looks for a succession of a whitespace and an opening
-         * bracket ('[')
-         * .*			the following can be any sequence of character
-         * label=\"	    looks for the label declaration sequence.
-         * (.*)\"\\x5D	stores the content of the label in a group and  look for
-         * the ending sequence : "]
-         *
-         * Example:
-         * I0 [shape=box style=invis]			Should pass
-         * P0 [fillcolor="#22cccc" shape=point]	Should not pass
+         * \brief Maximum number of threads used to parse Program bodies.
          */
-        static const std::string instructionRegex;
+        uint64_t maxNbThreads;
 
         /**
-         * \brief contains the regex to identify an action declaration
-         *
-         * this regex values "A([0-9]+)\\x20\\x5B.*=\"([0-9]+)\"\\x5D"
-         *
-         * Explanation :
-         *
-         * A([0-9]+)     looks for a A followed by a number. the number will be
-         * stored in a group
-         * \\x20\\x5B    looks for a succession of a whitespace and an opening
-         * bracket ('[')
-         * .*=\"	        the following can be any sequence of character
-         * ending with ="
-         * ([0-9]+)	    looks for a number and stores it into the next group
-         * \"\\x5D 		the end of the sequence is made of "]
-         *
-         * Example:
-         * A0 [shape=box style=invis]			Should pass
-         * P0 [fillcolor="#22cccc" shape=point]	Should not pass
-         */
-        static const std::string actionRegex;
-
-        /**
-         * \brief contains the regex to identify a Program -> Instruction Link
-         *
-         * this regex values "P([0-9]+)\\x20->\\x20I([0-9]+).*"
-         *
-         * Explanation :
-         *
-         * P[0-9]+       looks for a P followed by a number. the number will be
-         * stored in a group
-         * \\x20	        looks for a whitespace
-         * ->			looxs for the sequence '->'
-         * \\x20 	    looks for a whitespace
-         * I[0-9]+       looks for a I followed by a number. the number will be
-         * stored in a group
-         * .*			the following can be any sequence of character
-         *
-         * Example:
-         * P22 -> I22[style=invis]			Should pass
-         * T0 -> P22 -> A11					Should not pass
+         * \brief string used to spot the end of a line in the program
+         * description.
          */
-        static const std::string linkProgramInstructionRegex;
+        static const std::string lineSeparator;
 
         /**
-         * \brief contains the regex to identify a Team -> Program -> Action
-         * Link
-         *
-         * this regex values
-         * "T([0-9]+)\\x20->\\x20P([0-9]+)\\x20->\\x20A([0-9]+).*"
+         * \brief Read an unsigned integer in a character string.
          *
-         * Explanation :
-         *
-         * T[0-9]+       looks for a T followed by a number. the number will be
-         * stored in a group
-         * \\x20	        looks for a whitespace
-         * ->			looxs for the sequence '->'
-         * \\x20	        looks for a whitespace
-         * P[0-9]+       looks for a P followed by a number. the number will be
-         * stored in a group
-         * \\x20	        looks for a whitespace
-         * ->			looxs for the sequence '->'
-         * \\x20	        looks for a whitespace
-         * A[0-9]+       looks for a A followed by a number. the number will be
-         * stored in a group
-         * .*			the following can be any sequence of character
-         *
-         * Example:
-         * P22 -> I22[style=invis]			Should not pass
-         * T0 -> P22 -> A11					Should pass
+         * \param[in,out] cursor the position of the first digit, advanced
+         * after the last digit.
+         * \param[out] value the read value.
+         * \return false if no digit was found at the cursor position.
          */
-        static const std::string linkProgramActionRegex;
+        static bool readUInt(const char*& cursor, uint64_t& value);
 
         /**
-         * \brief contains the regex to identify a Team -> Program -> Team Link
-         *
-         * this regex values
-         * "T([0-9]+)\\x20->\\x20P([0-9]+)\\x20->\\x20T([0-9]+).*"
+         * \brief Read a given sequence of characters in a character string.
          *
-         * Explanation :
-         *
-         * T[0-9]+       looks for a T followed by a number. the number will be
-         * stored in a group
-         * \\x20	        looks for a whitespace
-         * ->			looxs for the sequence '->'
-         * \\x20	        looks for a whitespace
-         * P[0-9]+       looks for a P followed by a number. the number will be
-         * stored in a group
-         * \\x20	        looks for a whitespace
-         * ->			looxs for the sequence '->'
-         * \\x20	        looks for a whitespace
-         * T[0-9]+       looks for a T followed by a number. the number will be
-         * stored in a group *			    the following can be any sequence of
-         * character
-         *
-         * Example:
-         * P22 -> I22[style=invis]			Should not pass
-         * T0 -> P22 -> T11					Should pass
+         * \param[in,out] cursor the position where the token is expected,
+         * advanced after the token if it was found.
+         * \param[in] token the expected sequence of characters.
+         * \return true if the token was found at the cursor position.
          */
-        static const std::string linkProgramTeamRegex;
+        static bool readToken(const char*& cursor, const char* token);
 
         /**
-         * \brief contains the regex to identify a Team -> Program Link
-         * the outgoing program vertex must already have been linked
-         *
-         * this regex values "T([0-9]+)\\x20->\\x20P([0-9]+)"
+         * \brief Fills a Program with the lines stored in its dot label.
          *
-         * Explanation :
+         * A line is stored in the label with the following format:
+         * inst_idx|dest_idx&op1_param1|op1_param2#...#opN_param1|opN_param2
+         * Lines are separated with the lineSeparator.
          *
-         * T[0-9]+       looks for a T followed by a number. the number will be
-         * stored in a group
-         * \\x20	        looks for a whitespace
-         * ->			looxs for the sequence '->'
-         * \\x20	        looks for a whitespace
-         * P[0-9]+       looks for a P followed by a number. the number will be
-         * stored in a group
+         * This method only accesses the given Program, and can thus be called
+         * concurrently on different Program.
          *
-         * Example:
-         * P22 -> I22[style=invis]			Should not pass
-         * T0 -> P22 -> T11					Should pass
+         * \param[in,out] program the Program to fill.
+         * \param[in] label the label of the Program in the dot file.
+         * \throws std::runtime_error if the label is malformed.
          */
-        static const std::string addLinkProgramRegex;
+        static void readProgramLines(Program::Program& program,
+                                     const std::string& label);
 
         /**
-         * \brief Reads the content of the operands and puts it in the line
-         * passed in parameter
+         * \brief Parses the bodies of all pendingPrograms.
          *
-         * \param[in] str the string to parse
-         * \param[in] line the line to fill with the parsed informations
-         */
-        void readOperands(std::string& str, Program::Line& line);
-
-        /**
-         * \brief Reads the content of a line and puts it in the line
-         * passed in parameter
+         * Program are parsed in parallel when maxNbThreads is greater than
+         * 1. If several Program are malformed, the exception of the first one
+         * in the file is rethrown.
          */
-        void readLine(std::smatch& matches);
-
-        /**
-         * \brief Create a program from its dot content and import its constants
-         */
-        void readProgram(std::smatch& matches);
+        void parsePrograms();
 
         /**
          * \brief dumps the header of the dot file
@@ -342,35 +208,68 @@ namespace File {
 
         /**
          * \brief reads and creates a TPGTeam.
+         *
+         * Team declaration format: T<id> [...]
+         *
+         * \param[in] id the identifier of the TPGTeam in the dot file.
          */
-        void readTeam(std::smatch& matches);
+        void readTeam(uint64_t id);
 
         /**
          * \brief reads and creates a TPGAction.
+         *
+         * Action declaration format: A<id> [... label="<actionID>"]
+         *
+         * \param[in] id the identifier of the TPGAction in the dot file.
+         * \param[in] cursor position following the identifier in the line.
+         * \return false if the line is not a valid action declaration.
          */
-        void readAction(std::smatch& matches);
+        bool readAction(uint64_t id, const char* cursor);
 
         /**
-         * \brief reads a link declaration and creates a team to action edge
+         * \brief Create a program from its dot content and import its
+         * constants.
+         *
+         * Program declaration format:
+         * P<id> [fillcolor="#cccccc" shape=point] //const0|const1|...|constn|
+         *
+         * \param[in] id the identifier of the Program in the dot file.
+         * \param[in] cursor position following the identifier in the line.
          */
-        void readLinkTeamProgramAction(std::smatch& matches);
+        void readProgram(uint64_t id, const char* cursor);
 
         /**
-         * \brief reads a link declaration and creates a team to team edge
+         * \brief Stores the label of a Program for later parsing.
+         *
+         * Instruction declaration format: I<id> [... label="<lines>"]
+         *
+         * \param[in] id the identifier of the Program in the dot file.
+         * \param[in] cursor position following the identifier in the line.
+         * \return false if the line is not a valid instruction declaration.
          */
-        void readLinkTeamProgramTeam(std::smatch& matches);
+        bool readInstructions(uint64_t id, const char* cursor);
 
         /**
-         * \brief reads a link declaration and creates a team to program's
-         * destination edge.
+         * \brief reads a link declaration and creates the corresponding
+         * TPGEdge.
+         *
+         * Supported formats are:
+         * - T<id> -> P<id> -> A<id> : TPGEdge from a TPGTeam to a TPGAction
+         * - T<id> -> P<id> -> T<id> : TPGEdge between two TPGTeam
+         * - T<id> -> P<id> : TPGEdge reusing an already declared Program,
+         *   towards the destination of its first TPGEdge.
+         *
+         * \param[in] teamID the identifier of the source TPGTeam.
+         * \param[in] cursor position following the identifier in the line.
+         * \return false if the line is not a valid link declaration.
          */
-        void readLinkTeamProgram(std::smatch& matches);
+        bool readLink(uint64_t teamID, const char* cursor);
 
         /**
          *	\brief reads a single line of the file
          *
          *	\return true if the line read matched any of the line
-         *characteristics specified as regexs.
+         *	characteristics of the exported dot files.
          */
         bool readLineFromFile();
 
@@ -384,12 +283,20 @@ namespace File {
          * be built
          * \param[in] tpgref a Reference to the TPGGraph to build from
          * the .dot file
+         * \param[in] maxNbThreads Integer parameter controlling the number of
+         * threads used to parse Program bodies. Possible values are:
+         *   - default:  Let the runtime decide using
+         *               std::thread::hardware_concurrency().
+         *   - `0` and `1`: Do not use parallelism.
+         *   - `n > 1`: Set the number of threads explicitly.
          * \throws std::runtime_error in case no file could be
          * opened at the given filePath.
          */
-        TPGGraphDotImporter(const char* filePath, Environment environment,
-                            TPG::TPGGraph& tpgref)
-            : env{environment}, tpg{tpgref}
+        TPGGraphDotImporter(
+            const char* filePath, Environment environment,
+            TPG::TPGGraph& tpgref,
+            uint64_t maxNbThreads = std::thread::hardware_concurrency())
+            : env{environment}, tpg{tpgref}, maxNbThreads{maxNbThreads}
         {
             pFile.open(filePath);
             if (!pFile.is_open()) {
@@ -46,13 +46,17 @@
 #ifndef GEGELATI_H
 #define GEGELATI_H
 
+#include <util/memoryUsage.h>
+#include <util/profiler.h>
 #include <util/timestamp.h>
+#include <util/trainingLoop.h>
 
 #include <data/array2DWrapper.h>
 #include <data/arrayWrapper.h>
 #include <data/constant.h>
 #include <data/constantHandler.h>
 #include <data/dataHandler.h>
+#include <data/dataHandlerSerialization.h>
 #include <data/hash.h>
 #include <data/pointerWrapper.h>
 #include <data/primitiveTypeArray.h>
@@ -60,14 +64,21 @@
 #include <data/untypedSharedPtr.h>
 
 #include <file/parametersParser.h>
+#include <file/tpgGraphBinaryExporter.h>
+#include <file/tpgGraphBinaryFormat.h>
+#include <file/tpgGraphBinaryImporter.h>
 #include <file/tpgGraphDotExporter.h>
 #include <file/tpgGraphDotImporter.h>
 
 #include <instructions/addPrimitiveType.h>
+#include <instructions/arrayInstructions.h>
+#include <instructions/arrayKernels.h>
+#include <instructions/inlineInstruction.h>
 #include <instructions/instruction.h>
 #include <instructions/lambdaInstruction.h>
 #include <instructions/multByConstant.h>
 #include <instructions/set.h>
+#include <instructions/staticSet.h>
 
 #include <learn/evaluationResult.h>
 #include <learn/job.h>
@@ -75,19 +86,26 @@
 #include <learn/learningEnvironment.h>
 #include <learn/learningParameters.h>
 #include <learn/parallelLearningAgent.h>
+#include <learn/policyPruner.h>
 
 #include <learn/adversarialEvaluationResult.h>
 #include <learn/adversarialJob.h>
 #include <learn/adversarialLearningAgent.h>
 #include <learn/adversarialLearningEnvironment.h>
+#include <learn/tournamentLearningAgent.h>
 
 #include <learn/classificationEvaluationResult.h>
 #include <learn/classificationLearningAgent.h>
 #include <learn/classificationLearningEnvironment.h>
 
+#include <learn/distributedLearningAgent.h>
+#include <learn/islandLearningAgent.h>
+#include <learn/learningAgentCheckpointer.h>
+
 #include <log/cycleDetectionLALogger.h>
 #include <log/laBasicLogger.h>
 #include <log/laLogger.h>
+#include <log/laMemoryLogger.h>
 #include <log/laPolicyStatsLogger.h>
 #include <log/logger.h>
 
@@ -101,6 +119,8 @@
 #include <program/program.h>
 #include <program/programEngine.h>
 #include <program/programExecutionEngine.h>
+#include <program/programSerialization.h>
+#include <program/staticProgramExecutionEngine.h>
 
 #include <tpg/policyStats.h>
 #include <tpg/tpgAbstractEngine.h>
@@ -113,6 +133,7 @@
 #include <tpg/tpgVertex.h>
 
 #include <tpg/instrumented/executionStats.h>
+#include <tpg/instrumented/streamingExecutionStats.h>
 #include <tpg/instrumented/tpgActionInstrumented.h>
 #include <tpg/instrumented/tpgEdgeInstrumented.h>
 #include <tpg/instrumented/tpgExecutionEngineInstrumented.h>
@@ -121,6 +142,7 @@
 #include <tpg/instrumented/tpgVertexInstrumentation.h>
 
 #ifdef CODE_GENERATION
+#include <codeGen/generationParameters.h>
 #include <codeGen/programGenerationEngine.h>
 #include <codeGen/tpgGenerationEngine.h>
 #include <codeGen/tpgGenerationEngineFactory.h>
@@ -128,6 +150,10 @@
 #include <codeGen/tpgSwitchGenerationEngine.h>
 #endif
 
+#ifdef NATIVE_BACKEND
+#include <codeGen/nativeBackend.h>
+#endif
+
 #include <archive.h>
 #include <environment.h>
 
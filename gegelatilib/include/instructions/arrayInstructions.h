@@ -0,0 +1,301 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef ARRAY_INSTRUCTIONS_H
+#define ARRAY_INSTRUCTIONS_H
+
+#include <functional>
+#include <string>
+
+#include "data/constant.h"
+#include "instructions/arrayKernels.h"
+#include "instructions/lambdaInstruction.h"
+
+namespace Instructions {
+
+    /**
+     * \brief Base class of the instructions of the array instruction library.
+     *
+     * Array instructions are LambdaInstruction whose function calls one of
+     * the ArrayKernels. Their print template implements the same evaluation
+     * order as the kernel, so that the generated code produces the same
+     * results as the executed instruction. The generated code requires
+     * math.h, which must be included in externHeader.h.
+     *
+     * Template parameters are the operand types of the LambdaInstruction.
+     */
+    template <typename First, typename... Rest>
+    class ArrayInstruction : public LambdaInstruction<First, Rest...>
+    {
+      protected:
+        /**
+         * \brief Constructor of the class.
+         *
+         * \param[in] function the function executed by the instruction.
+         * \param[in] printTemplate template of the code printed for the
+         * instruction. Ignored without code generation.
+         */
+        ArrayInstruction(std::function<double(First, Rest...)> function,
+                         const std::string& printTemplate)
+#ifdef CODE_GENERATION
+            : LambdaInstruction<First, Rest...>(function, printTemplate)
+#else
+            : LambdaInstruction<First, Rest...>(function)
+#endif // CODE_GENERATION
+        {
+        }
+
+        /**
+         * \brief Build the print template of a sum reduction.
+         *
+         * \param[in] n number of accumulated elements.
+         * \param[in] term accumulated expression, function of the index i.
+         * \param[in] result expression of the result, function of the sum
+         * named "sum".
+         */
+        static std::string printSum(size_t n, const std::string& term,
+                                    const std::string& result = "sum")
+        {
+            return "double acc[4] = {0.0, 0.0, 0.0, 0.0}; "
+                   "for (int i = 0; i < " +
+                   std::to_string(n) + "; i++) { acc[i % 4] += " + term +
+                   "; } double sum = (acc[0] + acc[1]) + (acc[2] + acc[3]); "
+                   "$0 = " +
+                   result + ";";
+        }
+
+        /**
+         * \brief Build the print template of a maximum or minimum.
+         *
+         * \param[in] n number of compared elements.
+         * \param[in] term compared expression, function of the index i.
+         * \param[in] isMax true for a maximum, false for a minimum.
+         */
+        static std::string printExtremum(size_t n, const std::string& term,
+                                         bool isMax)
+        {
+            const std::string op = (isMax) ? " > " : " < ";
+            const std::string init = (isMax) ? "-INFINITY" : "INFINITY";
+            return "double acc[4] = {" + init + ", " + init + ", " + init +
+                   ", " + init + "}; for (int i = 0; i < " +
+                   std::to_string(n) + "; i++) { double x = " + term +
+                   "; if (x" + op + "acc[i % 4]) { acc[i % 4] = x; } } " +
+                   "double m0 = (acc[1]" + op + "acc[0]) ? acc[1] : acc[0]; " +
+                   "double m1 = (acc[3]" + op + "acc[2]) ? acc[3] : acc[2]; " +
+                   "$0 = (m1" + op + "m0) ? m1 : m0;";
+        }
+    };
+
+    /// Sum of the elements of an array of N double.
+    template <size_t N>
+    class ArraySum : public ArrayInstruction<const double[N]>
+    {
+      public:
+        /// Constructor of the instruction.
+        ArraySum()
+            : ArrayInstruction<const double[N]>(
+                  [](const double* a) { return ArrayKernels::sum(a, N); },
+                  ArrayInstruction<const double[N]>::printSum(N, "$1[i]"))
+        {
+        }
+    };
+
+    /// Mean of the elements of an array of N double.
+    template <size_t N>
+    class ArrayMean : public ArrayInstruction<const double[N]>
+    {
+      public:
+        /// Constructor of the instruction.
+        ArrayMean()
+            : ArrayInstruction<const double[N]>(
+                  [](const double* a) {
+                      return ArrayKernels::sum(a, N) / (double)N;
+                  },
+                  ArrayInstruction<const double[N]>::printSum(
+                      N, "$1[i]", "sum / " + std::to_string(N) + ".0"))
+        {
+        }
+    };
+
+    /// Maximum of the elements of an array of N double, ignoring NaN.
+    template <size_t N>
+    class ArrayMax : public ArrayInstruction<const double[N]>
+    {
+      public:
+        /// Constructor of the instruction.
+        ArrayMax()
+            : ArrayInstruction<const double[N]>(
+                  [](const double* a) { return ArrayKernels::max(a, N); },
+                  ArrayInstruction<const double[N]>::printExtremum(N, "$1[i]",
+                                                                   true))
+        {
+        }
+    };
+
+    /// Minimum of the elements of an array of N double, ignoring NaN.
+    template <size_t N>
+    class ArrayMin : public ArrayInstruction<const double[N]>
+    {
+      public:
+        /// Constructor of the instruction.
+        ArrayMin()
+            : ArrayInstruction<const double[N]>(
+                  [](const double* a) { return ArrayKernels::min(a, N); },
+                  ArrayInstruction<const double[N]>::printExtremum(N, "$1[i]",
+                                                                   false))
+        {
+        }
+    };
+
+    /// Dot product of an array of N double with N constants.
+    template <size_t N>
+    class ArrayDotConstant
+        : public ArrayInstruction<const double[N], const Data::Constant[N]>
+    {
+      public:
+        /// Constructor of the instruction.
+        ArrayDotConstant()
+            : ArrayInstruction<const double[N], const Data::Constant[N]>(
+                  [](const double* a, const Data::Constant* c) {
+                      return ArrayKernels::dotConstant(a, c, N);
+                  },
+                  ArrayInstruction<const double[N], const Data::Constant[N]>::
+                      printSum(N, "$1[i] * (double)$2[i]"))
+        {
+        }
+    };
+
+    /// L1 distance between two arrays of N double.
+    template <size_t N>
+    class ArrayL1Distance
+        : public ArrayInstruction<const double[N], const double[N]>
+    {
+      public:
+        /// Constructor of the instruction.
+        ArrayL1Distance()
+            : ArrayInstruction<const double[N], const double[N]>(
+                  [](const double* a, const double* b) {
+                      return ArrayKernels::l1Distance(a, b, N);
+                  },
+                  ArrayInstruction<const double[N], const double[N]>::printSum(
+                      N, "fabs($1[i] - $2[i])"))
+        {
+        }
+    };
+
+    /// L2 distance between two arrays of N double.
+    template <size_t N>
+    class ArrayL2Distance
+        : public ArrayInstruction<const double[N], const double[N]>
+    {
+      public:
+        /// Constructor of the instruction.
+        ArrayL2Distance()
+            : ArrayInstruction<const double[N], const double[N]>(
+                  [](const double* a, const double* b) {
+                      return ArrayKernels::l2Distance(a, b, N);
+                  },
+                  ArrayInstruction<const double[N], const double[N]>::printSum(
+                      N, "($1[i] - $2[i]) * ($1[i] - $2[i])", "sqrt(sum)"))
+        {
+        }
+    };
+
+    /**
+     * \brief Convolution of a HxW window of double with a kernel of H*W
+     * constants, stored row by row.
+     */
+    template <size_t H, size_t W>
+    class WindowConvolution
+        : public ArrayInstruction<const double[H][W],
+                                  const Data::Constant[H * W]>
+    {
+      public:
+        /// Constructor of the instruction.
+        WindowConvolution()
+            : ArrayInstruction<const double[H][W],
+                               const Data::Constant[H * W]>(
+                  [](const double (*a)[W], const Data::Constant* c) {
+                      return ArrayKernels::dotConstant(a[0], c, H * W);
+                  },
+                  ArrayInstruction<const double[H][W],
+                                   const Data::Constant[H * W]>::
+                      printSum(H * W, "$1[i / " + std::to_string(W) + "][i % " +
+                                          std::to_string(W) +
+                                          "] * (double)$2[i]"))
+        {
+        }
+    };
+
+    /// Maximum of a HxW window of double, ignoring NaN.
+    template <size_t H, size_t W>
+    class WindowMaxPooling : public ArrayInstruction<const double[H][W]>
+    {
+      public:
+        /// Constructor of the instruction.
+        WindowMaxPooling()
+            : ArrayInstruction<const double[H][W]>(
+                  [](const double (*a)[W]) {
+                      return ArrayKernels::max(a[0], H * W);
+                  },
+                  ArrayInstruction<const double[H][W]>::printExtremum(
+                      H * W,
+                      "$1[i / " + std::to_string(W) + "][i % " +
+                          std::to_string(W) + "]",
+                      true))
+        {
+        }
+    };
+
+    /// Mean of a HxW window of double.
+    template <size_t H, size_t W>
+    class WindowAveragePooling : public ArrayInstruction<const double[H][W]>
+    {
+      public:
+        /// Constructor of the instruction.
+        WindowAveragePooling()
+            : ArrayInstruction<const double[H][W]>(
+                  [](const double (*a)[W]) {
+                      return ArrayKernels::sum(a[0], H * W) / (double)(H * W);
+                  },
+                  ArrayInstruction<const double[H][W]>::printSum(
+                      H * W,
+                      "$1[i / " + std::to_string(W) + "][i % " +
+                          std::to_string(W) + "]",
+                      "sum / " + std::to_string(H * W) + ".0"))
+        {
+        }
+    };
+} // namespace Instructions
+
+#endif // ARRAY_INSTRUCTIONS_H
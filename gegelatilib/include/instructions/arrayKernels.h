@@ -0,0 +1,112 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef ARRAY_KERNELS_H
+#define ARRAY_KERNELS_H
+
+#include <cstddef>
+
+#include "data/constant.h"
+
+namespace Instructions {
+    /**
+     * \brief Reduction kernels used by the array instructions.
+     *
+     * To be vectorizable without changing their result, all reductions use
+     * the same evaluation order: element i of the arrays is accumulated in
+     * lane (i % NB_LANES), in increasing order of i, and the lanes are then
+     * combined pairwise, ((lane0, lane1), (lane2, lane3)).
+     *
+     * The dispatched functions use AVX intrinsics when the executing CPU
+     * supports them, and the Scalar implementations otherwise. Both give
+     * bitwise identical results, which are also the results of the C code
+     * printed for the array instructions. Vectorized kernels are only
+     * compiled for x86-64 with GCC or Clang.
+     */
+    namespace ArrayKernels {
+        /// Number of independent accumulators of reductions.
+        static const size_t NB_LANES = 4;
+
+        /**
+         * \brief Check whether the dispatched kernels use SIMD intrinsics on
+         * the executing CPU.
+         */
+        bool isVectorized();
+
+        /// Sum of the n elements of a.
+        double sum(const double* a, size_t n);
+
+        /// Maximum of the n elements of a, ignoring NaN. -INFINITY if none.
+        double max(const double* a, size_t n);
+
+        /// Minimum of the n elements of a, ignoring NaN. INFINITY if none.
+        double min(const double* a, size_t n);
+
+        /// Dot product of the n elements of a with the n constants c.
+        double dotConstant(const double* a, const Data::Constant* c,
+                           size_t n);
+
+        /// L1 distance between the arrays a and b of n elements.
+        double l1Distance(const double* a, const double* b, size_t n);
+
+        /// L2 distance between the arrays a and b of n elements.
+        double l2Distance(const double* a, const double* b, size_t n);
+
+        /**
+         * \brief Reference implementations of the kernels, without
+         * intrinsics.
+         */
+        namespace Scalar {
+            /// See ArrayKernels::sum().
+            double sum(const double* a, size_t n);
+
+            /// See ArrayKernels::max().
+            double max(const double* a, size_t n);
+
+            /// See ArrayKernels::min().
+            double min(const double* a, size_t n);
+
+            /// See ArrayKernels::dotConstant().
+            double dotConstant(const double* a, const Data::Constant* c,
+                               size_t n);
+
+            /// See ArrayKernels::l1Distance().
+            double l1Distance(const double* a, const double* b, size_t n);
+
+            /// See ArrayKernels::l2Distance().
+            double l2Distance(const double* a, const double* b, size_t n);
+        } // namespace Scalar
+    }     // namespace ArrayKernels
+} // namespace Instructions
+
+#endif // ARRAY_KERNELS_H
@@ -0,0 +1,125 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef INLINE_INSTRUCTION_H
+#define INLINE_INSTRUCTION_H
+
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "instructions/lambdaInstruction.h"
+
+namespace Instructions {
+
+    /**
+     * \brief LambdaInstruction keeping a copy of its operation with its exact
+     * type.
+     *
+     * An InlineInstruction is used as any LambdaInstruction when stored in a
+     * Set. When stored in a StaticSet, its operation can also be called with
+     * typed operands, without std::function, so that the compiler can inline
+     * it.
+     *
+     * Template parameter Op is the type of the operation, usually a lambda.
+     * Template parameters First and Rest are the operand types, as for a
+     * LambdaInstruction.
+     */
+    template <typename Op, typename First, typename... Rest>
+    class InlineInstruction : public LambdaInstruction<First, Rest...>
+    {
+      protected:
+        /// Operation executed by the Instruction.
+        const Op operation;
+
+      public:
+        /// Operand types of the Instruction.
+        typedef std::tuple<First, Rest...> OperandTypes;
+
+        /// Delete the default constructor.
+        InlineInstruction() = delete;
+
+#ifdef CODE_GENERATION
+        /**
+         * \brief Constructor of a printable InlineInstruction.
+         *
+         * \param[in] operation the operation executed by the Instruction.
+         * \param[in] printTemplate std::string use at the generation. Check
+         * Instructions::Instruction for more details.
+         */
+        InlineInstruction(const Op& operation,
+                          const std::string& printTemplate = "")
+            : LambdaInstruction<First, Rest...>(operation, printTemplate),
+              operation{operation} {};
+#else
+        /**
+         * \brief Constructor of the InlineInstruction.
+         *
+         * \param[in] operation the operation executed by the Instruction.
+         */
+        InlineInstruction(const Op& operation)
+            : LambdaInstruction<First, Rest...>(operation),
+              operation{operation} {};
+#endif // CODE_GENERATION
+
+        /// Get the operation executed by the Instruction.
+        const Op& getOperation() const
+        {
+            return this->operation;
+        }
+    };
+
+    /**
+     * \brief Build an InlineInstruction from an operation whose type is
+     * deduced.
+     *
+     * Template parameters First and Rest are the operand types of the
+     * InlineInstruction. For example:
+     * \code{.cpp}
+     * auto add = Instructions::makeInlineInstruction<double, double>(
+     *     [](double a, double b) { return a + b; });
+     * \endcode
+     *
+     * \param[in] operation the operation executed by the Instruction.
+     * \param[in] args other arguments of the InlineInstruction constructor.
+     */
+    template <typename First, typename... Rest, typename Op, typename... Args>
+    InlineInstruction<Op, First, Rest...> makeInlineInstruction(
+        const Op& operation, Args&&... args)
+    {
+        return InlineInstruction<Op, First, Rest...>(
+            operation, std::forward<Args>(args)...);
+    }
+} // namespace Instructions
+
+#endif // INLINE_INSTRUCTION_H
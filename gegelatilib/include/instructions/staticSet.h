@@ -0,0 +1,399 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef STATIC_SET_H
+#define STATIC_SET_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "data/array2DWrapper.h"
+#include "data/arrayWrapper.h"
+#include "data/dataHandler.h"
+#include "instructions/inlineInstruction.h"
+#include "instructions/set.h"
+
+namespace Instructions {
+
+    /**
+     * \brief Set of InlineInstruction whose types are known at compile time.
+     *
+     * A StaticSet is a Set, and can be used as such to build an Environment.
+     * In addition, it owns its InlineInstruction and can execute them with a
+     * jump table over their index, calling their operation inline with typed
+     * operands. This static dispatch is used by the
+     * Program::StaticProgramExecutionEngine.
+     *
+     * Since the Set references the Instruction owned by the StaticSet, a
+     * StaticSet can neither be copied nor moved.
+     *
+     * Template parameters Instrs are the types of the InlineInstruction.
+     */
+    template <typename... Instrs> class StaticSet : public Set
+    {
+      public:
+        /**
+         * \brief Direct access to the data of a DataHandler.
+         *
+         * When data is not nullptr, operands whose type is the elementType,
+         * or a 1D array of it, are read directly at their location in the
+         * data. Other operands are fetched with DataHandler::getDataAt().
+         */
+        typedef struct DataAccess
+        {
+            /// DataHandler providing the operands.
+            const Data::DataHandler* handler = nullptr;
+
+            /// Element type of the directly accessed data.
+            const std::type_info* elementType = nullptr;
+
+            /// Whether 1D arrays can be read directly in the data.
+            bool contiguousArrays = false;
+
+            /// Number of elements of the data.
+            uint64_t nbElements = 0;
+
+            /// Function returning the current data of the handler.
+            const void* (*getData)(const Data::DataHandler& handler) = nullptr;
+
+            /// First element of the data, nullptr without direct access.
+            const void* data = nullptr;
+        } DataAccess;
+
+        /// Operand of a line executed with static dispatch.
+        typedef struct Operand
+        {
+            /// Access to the DataHandler providing the operand.
+            const DataAccess* access;
+
+            /// Location of the operand, before scaling.
+            uint64_t location;
+        } Operand;
+
+      protected:
+        /// InlineInstruction owned by the StaticSet.
+        const std::tuple<Instrs...> staticInstructions;
+
+      public:
+        /**
+         * \brief Constructor of the StaticSet.
+         *
+         * Instructions are added to the Set in the given order.
+         *
+         * \param[in] instructions the InlineInstruction of the StaticSet.
+         */
+        StaticSet(Instrs... instructions)
+            : staticInstructions{std::move(instructions)...}
+        {
+            std::apply([this](const Instrs&... i) { (this->add(i), ...); },
+                       this->staticInstructions);
+        }
+
+        /// Copy constructor is deleted.
+        StaticSet(const StaticSet&) = delete;
+
+        /// Get the number of InlineInstruction in the StaticSet.
+        static constexpr size_t getNbStaticInstructions()
+        {
+            return sizeof...(Instrs);
+        }
+
+        /**
+         * \brief Get the index of an Instruction in the StaticSet.
+         *
+         * \param[in] instruction the searched Instruction.
+         * \return the index of the Instruction, or getNbStaticInstructions()
+         * if the Instruction is not owned by the StaticSet.
+         */
+        size_t getStaticIndex(const Instruction& instruction) const
+        {
+            for (size_t i = 0; i < sizeof...(Instrs); i++) {
+                if (&this->getInstruction(i) == &instruction) {
+                    return i;
+                }
+            }
+            return sizeof...(Instrs);
+        }
+
+        /**
+         * \brief Setup the DataAccess to a DataHandler.
+         *
+         * Direct access is possible for DataHandler that are a
+         * Data::ArrayWrapper of an element type of the operands of the
+         * InlineInstruction.
+         *
+         * \param[in] handler the accessed DataHandler.
+         * \param[out] access the DataAccess to the handler. Its data is
+         * updated with refreshDataAccess().
+         */
+        static void initDataAccess(const Data::DataHandler& handler,
+                                   DataAccess& access)
+        {
+            access = DataAccess();
+            access.handler = &handler;
+            (initDataAccessForOperands<typename Instrs::OperandTypes>(
+                 handler, access) ||
+             ...);
+        }
+
+        /**
+         * \brief Update the data of a DataAccess.
+         *
+         * Must be called before executing instructions, since the data of a
+         * Data::ArrayWrapper may be changed with its setPointer() method.
+         *
+         * \param[in,out] access the updated DataAccess.
+         */
+        static void refreshDataAccess(DataAccess& access)
+        {
+            access.data = (access.getData != nullptr)
+                              ? access.getData(*access.handler)
+                              : nullptr;
+        }
+
+        /**
+         * \brief Execute an InlineInstruction of the StaticSet.
+         *
+         * \param[in] index the index of the InlineInstruction.
+         * \param[in] operands the operands of the InlineInstruction.
+         * \return the result of the InlineInstruction.
+         * \throws std::out_of_range if an operand of an Array type is larger
+         * than the data of its DataHandler.
+         */
+        double execute(size_t index, const Operand* operands) const
+        {
+            static constexpr std::array<Executor, sizeof...(Instrs)>
+                executors = makeExecutors(std::index_sequence_for<Instrs...>{});
+            return executors[index](*this, operands);
+        }
+
+      private:
+        /// Function executing an InlineInstruction of the StaticSet.
+        typedef double (*Executor)(const StaticSet&, const Operand*);
+
+        /**
+         * \brief Operand fetched with its exact type.
+         *
+         * Template parameter T is the operand type.
+         */
+        template <typename T> class TypedOperand
+        {
+          public:
+            /// Type of the elements of the operand.
+            typedef std::remove_const_t<std::remove_all_extents_t<T>> Element;
+
+          protected:
+            /// Keeps alive an operand fetched from its DataHandler.
+            std::shared_ptr<const Element> fetched;
+
+            /// First element of the operand.
+            const Element* pointer;
+
+          public:
+            /**
+             * \brief Fetch the operand.
+             *
+             * \param[in] operand the fetched operand.
+             */
+            TypedOperand(const Operand& operand)
+            {
+                const DataAccess& access = *operand.access;
+                constexpr uint64_t size =
+                    std::is_array<T>::value ? std::extent<T>::value : 1;
+                if (access.data != nullptr && std::rank<T>::value <= 1 &&
+                    (std::rank<T>::value == 0 || access.contiguousArrays) &&
+                    *access.elementType == typeid(Element)) {
+                    if (size > access.nbElements) {
+                        throw std::out_of_range(
+                            "Operand larger than its DataHandler.");
+                    }
+                    this->pointer =
+                        static_cast<const Element*>(access.data) +
+                        operand.location % (access.nbElements - size + 1);
+                }
+                else {
+                    const Data::DataHandler& handler = *access.handler;
+                    const Data::UntypedSharedPtr data = handler.getDataAt(
+                        typeid(T), handler.scaleLocation(operand.location,
+                                                         typeid(T)));
+                    if constexpr (std::is_array<T>::value) {
+                        this->fetched =
+                            data.getSharedPointer<const Element[]>();
+                    }
+                    else {
+                        this->fetched = data.getSharedPointer<const Element>();
+                    }
+                    this->pointer = this->fetched.get();
+                }
+            }
+
+            /// Get the operand as an argument of the operation.
+            auto get() const
+            {
+                if constexpr (!std::is_array<T>::value) {
+                    return *this->pointer;
+                }
+                else {
+                    return (std::remove_extent_t<T>*)this->pointer;
+                }
+            }
+        };
+
+        /**
+         * \brief Setup a direct access to a DataHandler for the element type
+         * of an operand type.
+         *
+         * Template parameter T is the operand type.
+         *
+         * \param[in] handler the accessed DataHandler.
+         * \param[in,out] access the DataAccess to setup.
+         * \return true if a direct access is possible.
+         */
+        template <typename T>
+        static bool initDataAccessForOperand(const Data::DataHandler& handler,
+                                             DataAccess& access)
+        {
+            typedef std::remove_const_t<std::remove_all_extents_t<T>> Element;
+            const auto* wrapper =
+                dynamic_cast<const Data::ArrayWrapper<Element>*>(&handler);
+            if (wrapper == nullptr) {
+                return false;
+            }
+            access.elementType = &typeid(Element);
+            // 1D arrays of 2D arrays are not contiguous in memory.
+            access.contiguousArrays =
+                dynamic_cast<const Data::Array2DWrapper<Element>*>(&handler) ==
+                nullptr;
+            access.nbElements = wrapper->getLargestAddressSpace();
+            access.getData =
+                [](const Data::DataHandler& wrapped) -> const void* {
+                const std::vector<Element>* vector =
+                    static_cast<const Data::ArrayWrapper<Element>&>(wrapped)
+                        .getPointer();
+                return (vector != nullptr) ? vector->data() : nullptr;
+            };
+            return true;
+        }
+
+        /**
+         * \brief Setup a direct access to a DataHandler for the element types
+         * of a tuple of operand types.
+         *
+         * Template parameter Tuple is the std::tuple of operand types.
+         *
+         * \param[in] handler the accessed DataHandler.
+         * \param[in,out] access the DataAccess to setup.
+         * \return true if a direct access is possible.
+         */
+        template <typename Tuple>
+        static bool initDataAccessForOperands(const Data::DataHandler& handler,
+                                              DataAccess& access)
+        {
+            return std::apply(
+                [&](auto*... types) {
+                    return (initDataAccessForOperand<
+                                std::remove_pointer_t<decltype(types)>>(
+                                handler, access) ||
+                            ...);
+                },
+                addPointers((Tuple*)nullptr));
+        }
+
+        /**
+         * \brief Build a tuple of null pointers to the types of a tuple.
+         *
+         * Pointers make it possible to iterate over array types, which can
+         * not be passed by value.
+         */
+        template <typename... Ts>
+        static std::tuple<Ts*...> addPointers(std::tuple<Ts...>*)
+        {
+            return std::tuple<Ts*...>{(Ts*)nullptr...};
+        }
+
+        /**
+         * \brief Execute the I-th InlineInstruction of the StaticSet.
+         *
+         * \param[in] set the StaticSet.
+         * \param[in] operands the operands of the InlineInstruction.
+         */
+        template <size_t I>
+        static double executeInstruction(const StaticSet& set,
+                                         const Operand* operands)
+        {
+            typedef std::tuple_element_t<I, std::tuple<Instrs...>> Instr;
+            return callOperation<Instr>(
+                std::get<I>(set.staticInstructions), operands,
+                std::make_index_sequence<
+                    std::tuple_size<typename Instr::OperandTypes>::value>{});
+        }
+
+        /**
+         * \brief Call the operation of an InlineInstruction with typed
+         * operands.
+         *
+         * Template parameter Instr is the type of the InlineInstruction.
+         *
+         * \param[in] instruction the executed InlineInstruction.
+         * \param[in] operands the operands of the InlineInstruction.
+         */
+        template <typename Instr, size_t... K>
+        static double callOperation(const Instr& instruction,
+                                    const Operand* operands,
+                                    std::index_sequence<K...>)
+        {
+            // Operands are fetched in order, and kept alive during the call.
+            const std::tuple<TypedOperand<
+                std::tuple_element_t<K, typename Instr::OperandTypes>>...>
+                typedOperands{operands[K]...};
+            return instruction.getOperation()(
+                std::get<K>(typedOperands).get()...);
+        }
+
+        /// Build the jump table of the StaticSet.
+        template <size_t... I>
+        static constexpr std::array<Executor, sizeof...(Instrs)> makeExecutors(
+            std::index_sequence<I...>)
+        {
+            return {&executeInstruction<I>...};
+        }
+    };
+} // namespace Instructions
+
+#endif // STATIC_SET_H
@@ -39,6 +39,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <set>
 #include <vector>
 
 #include "learn/job.h"
@@ -75,6 +76,14 @@ namespace Learn {
          */
         const int16_t posOfStudiedRoot;
 
+        /**
+         * Positions of the filler roots of the job.
+         *
+         * Filler roots only complete the number of players of a match, and
+         * their score is ignored.
+         */
+        std::set<size_t> fillerPositions;
+
       public:
         /// Deleted default constructor.
         AdversarialJob() = delete;
@@ -105,6 +114,21 @@ namespace Learn {
          */
         void addRoot(const TPG::TPGVertex* root);
 
+        /**
+         * \brief Adds a filler root to this job, whose score is ignored.
+         *
+         * @param[in] root The root that will be added to this job.
+         */
+        void addFillerRoot(const TPG::TPGVertex* root);
+
+        /**
+         * \brief Check whether a root of the job is a filler root.
+         *
+         * @param[in] i The index of the root in the list of roots.
+         * @return true if the root was added with addFillerRoot().
+         */
+        bool isFillerRoot(size_t i) const;
+
         /**
          * \brief Getter of the number of roots.
          *
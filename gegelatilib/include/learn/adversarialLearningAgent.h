@@ -37,6 +37,10 @@
 #ifndef ADVERSARIAL_LEARNING_AGENT_H
 #define ADVERSARIAL_LEARNING_AGENT_H
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "learn/adversarialEvaluationResult.h"
 #include "learn/adversarialJob.h"
 #include "learn/adversarialLearningAgent.h"
@@ -87,6 +91,69 @@ namespace Learn {
          */
         size_t agentsPerEvaluation;
 
+        /**
+         * \brief Cache of the results of previously played matches.
+         *
+         * Each entry associates the ordered list of roots of an
+         * AdversarialJob and the LearningMode in which it was evaluated, to
+         * the AdversarialEvaluationResult obtained for this job.
+         *
+         * The cache is only filled and used when the LearningEnvironment
+         * isDeterministic(). In such environments, the seed given to the
+         * reset() method has no influence on the outcome of a match, and
+         * policies of the TPGGraph are never modified once created. Hence,
+         * a match between the same roots, in the same order, always produces
+         * the same result, no matter the generation in which it is played.
+         * Since champions survive for many generations, a large portion of
+         * the matches of each generation are served from this cache.
+         *
+         * Entries referencing a root removed from the TPGGraph are purged in
+         * decimateWorstRoots(), before the memory of the removed TPGVertex
+         * can be reused by a new one.
+         */
+        std::map<std::pair<std::vector<const TPG::TPGVertex*>, LearningMode>,
+                 std::shared_ptr<AdversarialEvaluationResult>>
+            matchResultsCache;
+
+        /**
+         * \brief Evaluate all roots with parallelism, and update the
+         * matchResultsCache with the results of newly played matches.
+         *
+         * The matchResultsCache is only updated after all jobs were
+         * evaluated, in the order of the job indexes. Hence, jobs of a given
+         * generation only rely on results obtained in previous generations,
+         * and the evaluation remains deterministic, whatever the number of
+         * threads.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in] results Map to store the resulting score of evaluated
+         * roots.
+         */
+        void evaluateAllRootsInParallel(
+            uint64_t generationNumber, LearningMode mode,
+            std::multimap<std::shared_ptr<EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override;
+
+        /**
+         * \brief Store the results of the evaluated jobs in the
+         * matchResultsCache.
+         *
+         * Nothing happens if the LearningEnvironment is not deterministic.
+         *
+         * \param[in] resultsPerJobMap map linking the job number with its
+         * results and itself.
+         * \param[in] mode the LearningMode used during the evaluation of the
+         * jobs.
+         */
+        void updateMatchResultsCache(
+            const std::map<uint64_t,
+                           std::pair<std::shared_ptr<EvaluationResult>,
+                                     std::shared_ptr<Job>>>& resultsPerJobMap,
+            LearningMode mode);
+
         /**
          * \brief Subfunction of evaluateAllRootsInParallel which handles the
          * gathering of results and the merge of the archives, adapted to
@@ -143,6 +210,55 @@ namespace Learn {
         {
         }
 
+        /**
+         * \brief Initialize the AdversarialLearningAgent.
+         *
+         * In addition to LearningAgent::init(), the matchResultsCache is
+         * cleared.
+         *
+         * \param[in] seed the seed given to the TPGMutator.
+         */
+        void init(uint64_t seed = 0) override;
+
+        /**
+         * \brief Removes from the TPGGraph the root TPGVertex with the worst
+         * results.
+         *
+         * In addition to LearningAgent::decimateWorstRoots(), all entries of
+         * the matchResultsCache involving a removed TPGVertex are discarded.
+         *
+         * \param[in,out] results a multimap containing root TPGVertex
+         * associated to their score during an evaluation.
+         */
+        void decimateWorstRoots(
+            std::multimap<std::shared_ptr<EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override;
+
+        /**
+         * \brief Forget all match results stored in the matchResultsCache.
+         *
+         * This method must be called whenever TPGVertex are removed from the
+         * TPGGraph outside of the training process (e.g. with
+         * keepBestPolicy()) before training is resumed.
+         */
+        void clearMatchResultsCache();
+
+        /**
+         * \brief Get the number of match results stored in the
+         * matchResultsCache.
+         *
+         * \return the number of entries of the matchResultsCache.
+         */
+        size_t getNbCachedMatchResults() const;
+
+        /**
+         * \brief Get the estimated memory footprint of the learning process.
+         *
+         * In addition to LearningAgent::getMemoryUsage(), the
+         * matchResultsCache is added to the caches component.
+         */
+        virtual Util::MemoryUsage getMemoryUsage() const override;
+
         /**
          * \brief Evaluate all root TPGVertex of the TPGGraph.
          *
@@ -193,6 +309,10 @@ namespace Learn {
          * AdversarialEvaluationResult will also contain the number of
          * iterations that have been done in this job, that could be useful to
          * combine results later.
+         * If the LearningEnvironment isDeterministic() and the job was
+         * already evaluated in a previous generation, the match is not played
+         * again and a copy of the result stored in the matchResultsCache is
+         * returned instead.
          */
         virtual std::shared_ptr<EvaluationResult> evaluateJob(
             TPG::TPGExecutionEngine& tee, const Job& job,
@@ -0,0 +1,287 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef DISTRIBUTED_LEARNING_AGENT_H
+#define DISTRIBUTED_LEARNING_AGENT_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "archive.h"
+#include "learn/evaluationResult.h"
+#include "learn/job.h"
+#include "learn/parallelLearningAgent.h"
+#include "program/program.h"
+
+namespace Learn {
+    /**
+     * \brief ParallelLearningAgent evaluating its roots in separate worker
+     * processes.
+     *
+     * LearningParameters::nbThreads worker processes are forked from the
+     * current process at the first parallel evaluation, or when calling
+     * startWorkers(), and are kept alive until the DistributedLearningAgent
+     * is destroyed or stopWorkers() is called. Each worker owns a private
+     * copy of the LearningEnvironment, which makes it possible to evaluate
+     * non-copyable LearningEnvironment in parallel.
+     *
+     * Workers never read the TPGGraph of the main process. Each job is sent
+     * through a local socket as a self-contained message holding the job
+     * index, generation number, LearningMode, archive seed, and the
+     * serialized subgraph reachable from the evaluated root, with its
+     * Program. Workers rebuild the subgraph in a private TPGGraph, and answer
+     * with the EvaluationResult of the job and with the recordings of its
+     * Archive, including the content of the archived DataHandler. Recorded
+     * Program are identified by their index in the sent subgraph.
+     *
+     * Roots whose evaluation is skipped, because they were already evaluated
+     * LearningParameters::maxNbEvaluationPerPolicy times, are handled in the
+     * main process and never sent to workers, and the results of other
+     * roots are combined with their previous results in the main process.
+     * Jobs are distributed dynamically to idle workers, but results and
+     * archives are gathered by job index, which gives exactly the same
+     * results and Archive as the ParallelLearningAgent.
+     *
+     * Limitations:
+     * - Workers are created with fork(). Only the thread calling fork() is
+     *   duplicated, so workers should be started with startWorkers() before
+     *   the process creates other threads, for example the background
+     *   writer of a LearningAgentCheckpointer. Workers therefore share the
+     *   Environment and LearningEnvironment of the main process as they
+     *   were when forked, and only workers forked from the main process are
+     *   supported, although the job messages do not rely on shared memory.
+     * - Only the score, number of evaluations and inference cost of the
+     *   EvaluationResult returned by evaluateJob() are sent back, as an
+     *   EvaluationResult.
+     * - Archive recordings are only sent back for DataHandler deriving from
+     *   Data::ArrayWrapper of a primitive type (double, float, int, int64_t,
+     *   uint8_t or char). Recordings involving other DataHandler are dropped.
+     * - Side effects of the evaluation in the worker processes, such as the
+     *   statistics of instrumented TPGGraph, are not reported back, and the
+     *   NativeBackend of the agent, if any, is not used by workers.
+     * - Worker processes are not available on Windows, where a
+     *   std::runtime_error is thrown when a parallel evaluation is needed.
+     */
+    class DistributedLearningAgent : public ParallelLearningAgent
+    {
+      protected:
+        /// Sockets connected to the worker processes, if started.
+        std::vector<int> workerSockets;
+
+        /// Process identifiers of the worker processes, if started.
+        std::vector<int64_t> workerPids;
+
+        /**
+         * \brief Evaluate all jobs in worker processes.
+         *
+         * **Replaces the function from the base class ParallelLearningAgent.**
+         *
+         * Worker processes are started with startWorkers() if needed.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[out] resultsPerJobMap map linking the job number with its
+         * results and itself.
+         * \param[out] archiveMap map linking the job number with its gathered
+         * archive.
+         * \throw std::runtime_error if a worker process can not be created, or
+         * terminates unexpectedly. All workers are stopped in this case.
+         */
+        void evaluateAllRootsInParallelExecute(
+            uint64_t generationNumber, LearningMode mode,
+            std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
+                                         std::shared_ptr<Job>>>&
+                resultsPerJobMap,
+            std::map<uint64_t, Archive*>& archiveMap) override;
+
+        /**
+         * \brief Function implementing the behavior of worker processes.
+         *
+         * The worker reads job messages built with encodeJob() from the
+         * given socket until an empty message is received. For each job, it
+         * rebuilds the subgraph of the job in a private TPGGraph and sends
+         * back the message built with encodeJobResult().
+         *
+         * \param[in] socket file descriptor of the socket connected to the
+         * main process.
+         */
+        void workerLoop(int socket);
+
+        /**
+         * \brief Serialize a job and the subgraph reachable from its root.
+         *
+         * \param[in] job the serialized job.
+         * \param[in] jobIdx the index of the job in the list of jobs.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the evaluation.
+         * \param[out] programs the Program of the subgraph, in their order
+         * in the message.
+         * \return the message to send to a worker process.
+         */
+        std::string encodeJob(const Job& job, uint64_t jobIdx,
+                              uint64_t generationNumber, LearningMode mode,
+                              std::vector<const Program::Program*>& programs)
+            const;
+
+        /**
+         * \brief Deserialize a message built with encodeJob().
+         *
+         * \param[in] message the message received from the main process.
+         * \param[in,out] graph the TPGGraph in which the subgraph of the job
+         * is built. Its previous content is cleared.
+         * \param[out] jobIdx the index of the job in the list of jobs.
+         * \param[out] generationNumber the integer number of the current
+         * generation.
+         * \param[out] mode the LearningMode to use during the evaluation.
+         * \param[out] archiveSeed the archive seed of the job.
+         * \param[out] programs the Program of the rebuilt subgraph, in their
+         * order in the message.
+         * \return the root of the rebuilt subgraph.
+         * \throw std::runtime_error if the message is malformed.
+         */
+        const TPG::TPGVertex* decodeJob(
+            const std::string& message, TPG::TPGGraph& graph, uint64_t& jobIdx,
+            uint64_t& generationNumber, LearningMode& mode,
+            uint64_t& archiveSeed,
+            std::vector<const Program::Program*>& programs) const;
+
+        /**
+         * \brief Serialize the result and the Archive of an evaluated job.
+         *
+         * \param[in] jobIdx the index of the job in the list of jobs.
+         * \param[in] result the EvaluationResult of the job.
+         * \param[in] archive pointer to the Archive filled during the job
+         * evaluation, if any.
+         * \param[in] programs the Program of the evaluated subgraph, used to
+         * identify the Program of the recordings by their index.
+         * \return the message to send to the main process.
+         */
+        std::string encodeJobResult(
+            uint64_t jobIdx, const EvaluationResult& result,
+            const Archive* archive,
+            const std::vector<const Program::Program*>& programs) const;
+
+        /**
+         * \brief Deserialize a message built with encodeJobResult().
+         *
+         * The DataHandler of the rebuilt Archive are copies of the data
+         * sources of the Environment of the LearningAgent, filled with the
+         * received data.
+         *
+         * \param[in] message the message received from a worker.
+         * \param[in] jobs the list of jobs of the evaluation.
+         * \param[in] programs the Program sent with each job, as returned by
+         * encodeJob().
+         * \param[out] jobIdx the index of the job in the list of jobs.
+         * \param[out] archive pointer to the rebuilt Archive. Only set in
+         * LearningMode::TRAINING.
+         * \param[in] mode the LearningMode used during the evaluation.
+         * \return the EvaluationResult of the job.
+         * \throw std::runtime_error if the message is malformed.
+         */
+        std::shared_ptr<EvaluationResult> decodeJobResult(
+            const std::string& message,
+            const std::vector<std::shared_ptr<Job>>& jobs,
+            const std::vector<std::vector<const Program::Program*>>& programs,
+            uint64_t& jobIdx, Archive*& archive, LearningMode mode) const;
+
+      public:
+        /**
+         * \brief Constructor for DistributedLearningAgent.
+         *
+         * Based on default constructor of ParallelLearningAgent. The
+         * nbThreads parameter gives the number of worker processes.
+         *
+         * \param[in] le The LearningEnvironment for the TPG.
+         * \param[in] iSet Set of Instruction used to compose Programs in the
+         *            learning process.
+         * \param[in] p The LearningParameters for the LearningAgent.
+         * \param[in] factory The TPGFactory used to create the TPGGraph. A
+         * default TPGFactory is used if none is provided.
+         */
+        DistributedLearningAgent(
+            LearningEnvironment& le, const Instructions::Set& iSet,
+            const LearningParameters& p,
+            const TPG::TPGFactory& factory = TPG::TPGFactory())
+            : ParallelLearningAgent(le, iSet, p, factory){};
+
+        /// Destructor stopping the worker processes.
+        virtual ~DistributedLearningAgent();
+
+        /**
+         * \brief Fork the worker processes, if not already started.
+         *
+         * Does nothing if nbThreads is lower than 2.
+         *
+         * \throw std::runtime_error if a worker process can not be created.
+         */
+        void startWorkers();
+
+        /**
+         * \brief Stop the worker processes and wait for their termination.
+         *
+         * \param[in] kill whether workers are killed instead of being asked
+         * to terminate.
+         */
+        void stopWorkers(bool kill = false);
+
+        /// Get the number of running worker processes.
+        size_t getNbWorkers() const;
+
+        /**
+         * \brief Evaluate all root TPGVertex of the TPGGraph.
+         *
+         * **Replaces the function from the base class ParallelLearningAgent.**
+         *
+         * Contrary to the ParallelLearningAgent, the evaluation is done in
+         * parallel even if the LearningEnvironment is not copyable. With a
+         * single worker, the evaluation is done sequentially within the
+         * current process.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         */
+        std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
+        evaluateAllRoots(uint64_t generationNumber, LearningMode mode) override;
+    };
+} // namespace Learn
+
+#endif
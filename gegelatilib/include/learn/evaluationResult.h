@@ -57,6 +57,9 @@ namespace Learn {
         /// Number of evaluation leading to this result.
         size_t nbEvaluation;
 
+        /// Average inference cost of the policy per decision.
+        double inferenceCost = 0.0;
+
       public:
         /**
          * \brief Deleted default constructor.
@@ -91,10 +94,31 @@ namespace Learn {
          */
         virtual size_t getNbEvaluation() const;
 
+        /**
+         * \brief Get the average inference cost of the evaluated policy.
+         *
+         * The inference cost is the average number of Program lines executed
+         * per decision of the policy. It is only measured by the
+         * LearningAgent when the inference cost is used for selecting roots,
+         * and is 0.0 otherwise.
+         */
+        double getInferenceCost() const;
+
+        /**
+         * \brief Set the average inference cost of the evaluated policy.
+         *
+         * \param[in] cost the average number of Program lines executed per
+         * decision of the policy.
+         */
+        void setInferenceCost(double cost);
+
         /**
          * \brief Polymorphic addition assignement operator for
          * EvaluationResult.
          *
+         * Inference costs of the two EvaluationResult are averaged, weighted
+         * with their number of evaluation.
+         *
          * \throw std::runtime_error in case the other EvaluationResult and
          * this have a different typeid.
          */
@@ -0,0 +1,206 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef ISLAND_LEARNING_AGENT_H
+#define ISLAND_LEARNING_AGENT_H
+
+#include <memory>
+#include <vector>
+
+#include "learn/learningEnvironment.h"
+#include "learn/learningParameters.h"
+#include "learn/parallelLearningAgent.h"
+
+namespace Learn {
+    /**
+     * \brief Class used to train several independent populations of TPGGraph
+     * in parallel, with periodic migrations of their best policies.
+     *
+     * Each island is a ParallelLearningAgent with its own TPGGraph, Archive,
+     * Mutator::RNG and copy of the LearningEnvironment. During each
+     * generation, the whole evolutionary process (population, evaluation and
+     * decimation) of all islands is run concurrently, each island using its
+     * share of the LearningParameters::nbThreads threads.
+     *
+     * Every migrationPeriod generations, the nbMigrants best roots of each
+     * island are copied, together with the subgraph reachable from them, into
+     * the next island (the last island sending its migrants to the first
+     * one). Migrants are selected in all islands before any copy is done, and
+     * copies are made in island order, which keeps the training
+     * deterministic for a given seed.
+     */
+    class IslandLearningAgent
+    {
+      protected:
+        /// Copies of the LearningEnvironment used by the islands.
+        std::vector<std::unique_ptr<LearningEnvironment>> learningEnvironments;
+
+        /// LearningAgent of each island.
+        std::vector<std::unique_ptr<ParallelLearningAgent>> islands;
+
+        /// Parameters for the learning process
+        LearningParameters params;
+
+        /// Number of generations between two migrations.
+        uint64_t migrationPeriod;
+
+        /// Number of roots sent by each island during a migration.
+        size_t nbMigrants;
+
+        /**
+         * \brief Select the roots of an island sent to the next island.
+         *
+         * The selected roots are the nbMigrants root TPGTeam of the island
+         * with the best EvaluationResult. In case of equality, roots are
+         * selected following the order of the TPGGraph root vertices.
+         *
+         * \param[in] island the ParallelLearningAgent whose roots are
+         * selected.
+         * \return the selected roots, best first.
+         */
+        std::vector<const TPG::TPGVertex*> selectMigrants(
+            ParallelLearningAgent& island) const;
+
+      public:
+        /**
+         * \brief Constructor for IslandLearningAgent.
+         *
+         * \param[in] le The LearningEnvironment for the TPG. It is cloned
+         * for all islands, except the first one.
+         * \param[in] iSet Set of Instruction used to compose Programs in the
+         *            learning process.
+         * \param[in] p The LearningParameters for the LearningAgent. The
+         * nbThreads parameter is evenly shared between islands.
+         * \param[in] nbIslands The number of independent populations.
+         * \param[in] migrationPeriod The number of generations between two
+         * migrations. No migration happens if 0.
+         * \param[in] nbMigrants The number of roots sent by each island
+         * during a migration.
+         * \param[in] factory The TPGFactory used to create the TPGGraph. A
+         * default TPGFactory is used if none is provided.
+         * \throw std::runtime_error if there are several islands and the
+         * LearningEnvironment is not copyable.
+         */
+        IslandLearningAgent(LearningEnvironment& le,
+                            const Instructions::Set& iSet,
+                            const LearningParameters& p, size_t nbIslands = 2,
+                            uint64_t migrationPeriod = 10,
+                            size_t nbMigrants = 1,
+                            const TPG::TPGFactory& factory = TPG::TPGFactory());
+
+        /// Default destructor.
+        virtual ~IslandLearningAgent() = default;
+
+        /**
+         * \brief Get the number of islands.
+         *
+         * \return the number of islands of the IslandLearningAgent.
+         */
+        size_t getNbIslands() const;
+
+        /**
+         * \brief Get the ParallelLearningAgent of an island.
+         *
+         * Accessing the island can be used to add LALogger to it, or to get
+         * its TPGGraph.
+         *
+         * \param[in] idx the index of the island.
+         * \return a reference to the ParallelLearningAgent of the island.
+         * \throw std::out_of_range if the index exceeds the number of
+         * islands.
+         */
+        ParallelLearningAgent& getIsland(size_t idx);
+
+        /**
+         * \brief Initialize all islands.
+         *
+         * Each island is initialized with a distinct seed derived from the
+         * given one, which gives each island its own stream of random
+         * numbers.
+         *
+         * \param[in] seed the seed from which the seeds of islands are
+         * derived.
+         */
+        virtual void init(uint64_t seed = 0);
+
+        /**
+         * \brief Train all islands for one generation, and migrate roots if
+         * the migrationPeriod is reached.
+         *
+         * \param[in] generationNumber the generation number.
+         */
+        virtual void trainOneGeneration(uint64_t generationNumber);
+
+        /**
+         * \brief Copy the best roots of each island into the next one.
+         *
+         * Nothing happens if there is a single island.
+         */
+        virtual void migrate();
+
+        /**
+         * \brief Train the islands for a given number of generation.
+         *
+         * Behaves like LearningAgent::train().
+         *
+         * \param[in] altTraining a reference to a boolean value that can be
+         * used to halt the training process before its completion.
+         * \param[in] printProgressBar select whether a progress bar will be
+         * printed in the console.
+         * \return the number of completed generations.
+         */
+        uint64_t train(volatile bool& altTraining, bool printProgressBar);
+
+        /**
+         * \brief Get the index of the island holding the best root
+         * encountered since the last init.
+         *
+         * \return the index of the island whose bestRoot has the best
+         * EvaluationResult. In case of equality, the first island is
+         * returned.
+         */
+        size_t getBestIslandIdx() const;
+
+        /**
+         * \brief Get the best root TPG::Vertex encountered in all islands
+         * since the last init.
+         *
+         * \return a reference to the bestRoot attribute of the best island.
+         */
+        const std::pair<const TPG::TPGVertex*,
+                        std::shared_ptr<EvaluationResult>>&
+        getBestRoot() const;
+    };
+} // namespace Learn
+
+#endif
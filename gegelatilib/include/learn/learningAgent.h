@@ -54,6 +54,11 @@
 #include "learn/job.h"
 #include "learn/learningEnvironment.h"
 #include "learn/learningParameters.h"
+#include "learn/policyPruner.h"
+
+#ifdef NATIVE_BACKEND
+#include "codeGen/nativeBackend.h"
+#endif // NATIVE_BACKEND
 namespace Learn {
 
     /**
@@ -62,6 +67,9 @@ namespace Learn {
      */
     class LearningAgent
     {
+        /// Checkpointer saving and restoring the protected training state.
+        friend class LearningAgentCheckpointer;
+
       protected:
         /// LearningEnvironment with which the LearningAgent will interact.
         LearningEnvironment& learningEnvironment;
@@ -118,6 +126,24 @@ namespace Learn {
         /// generation
         double bestScoreLastGen = 0.0;
 
+#ifdef NATIVE_BACKEND
+        /// NativeBackend executing long-lived Program natively, if any.
+        CodeGen::NativeBackend* nativeBackend = nullptr;
+#endif // NATIVE_BACKEND
+
+        /**
+         * \brief Create a TPGExecutionEngine for evaluating policies.
+         *
+         * The TPGExecutionEngine is created by the TPGFactory of the
+         * TPGGraph, and uses the NativeBackend of the LearningAgent, if any.
+         *
+         * \param[in] env the Environment of the TPGExecutionEngine.
+         * \param[in] arch the Archive of the TPGExecutionEngine, if any.
+         * \return the new TPGExecutionEngine.
+         */
+        std::unique_ptr<TPG::TPGExecutionEngine> createTPGExecutionEngine(
+            const Environment& env, Archive* arch) const;
+
       public:
         /**
          * \brief Constructor for LearningAgent.
@@ -185,6 +211,23 @@ namespace Learn {
          */
         void addLogger(Log::LALogger& logger);
 
+#ifdef NATIVE_BACKEND
+        /**
+         * \brief Set a NativeBackend for the training.
+         *
+         * After each decimation, the NativeBackend is updated with the
+         * surviving Program of the TPGGraph, and long-lived Program are
+         * compiled in the background. All TPGExecutionEngine of the
+         * LearningAgent then execute compiled Program natively.
+         *
+         * The NativeBackend must have been built for the Environment of the
+         * LearningAgent, and outlive its training.
+         *
+         * \param[in] backend A pointer (possibly NULL) to a NativeBackend.
+         */
+        void setNativeBackend(CodeGen::NativeBackend* backend);
+#endif // NATIVE_BACKEND
+
         /**
          * \brief Evaluates policy starting from the given root.
          *
@@ -297,6 +340,9 @@ namespace Learn {
          * The resultsPerRoot attribute is updated to remove results associated
          * to removed vertices.
          *
+         * When isInferenceCostSelected() is true, roots are ranked with
+         * isWorseWithInferenceCost() instead of their score alone.
+         *
          * \param[in,out] results a multimap containing root TPGVertex
          * associated to their score during an evaluation.
          */
@@ -304,6 +350,32 @@ namespace Learn {
             std::multimap<std::shared_ptr<EvaluationResult>,
                           const TPG::TPGVertex*>& results);
 
+        /**
+         * \brief Check whether the inference cost of roots is used for their
+         * selection.
+         *
+         * \return true if the inferenceCostWeight or maxInferenceCost
+         * LearningParameters is non-zero.
+         */
+        bool isInferenceCostSelected() const;
+
+        /**
+         * \brief Compare two EvaluationResult accounting for their inference
+         * cost.
+         *
+         * A result whose inference cost exceeds the maxInferenceCost
+         * LearningParameters, when non-zero, is worse than all results within
+         * this budget. Otherwise, results are compared on their score
+         * decreased by the inferenceCostWeight LearningParameters multiplied
+         * by their inference cost.
+         *
+         * \param[in] a the first compared EvaluationResult.
+         * \param[in] b the second compared EvaluationResult.
+         * \return true if a is worse than b.
+         */
+        bool isWorseWithInferenceCost(const EvaluationResult& a,
+                                      const EvaluationResult& b) const;
+
         /**
          * \brief Train the TPGGraph for a given number of generation.
          *
@@ -383,6 +455,28 @@ namespace Learn {
                         std::shared_ptr<EvaluationResult>>&
         getBestRoot() const;
 
+        /**
+         * \brief Get the EvaluationResult of the TPGVertex evaluated since the
+         * last init.
+         *
+         * \return a const reference to the resultsPerRoot attribute.
+         */
+        const std::map<const TPG::TPGVertex*,
+                       std::shared_ptr<EvaluationResult>>&
+        getResultsPerRoot() const;
+
+        /**
+         * \brief Get the estimated memory footprint of the learning process.
+         *
+         * The footprint includes the TPGGraph with its Program, the Archive
+         * and the cached EvaluationResult of roots. Memory used by the
+         * LearningEnvironment and by temporary objects created during
+         * the training is not included.
+         *
+         * \return a MemoryUsage with the footprint of each component.
+         */
+        virtual Util::MemoryUsage getMemoryUsage() const;
+
         /**
          * \brief This method keeps only the bestRoot policy in the TPGGraph.
          *
@@ -391,6 +485,22 @@ namespace Learn {
          */
         void keepBestPolicy();
 
+        /**
+         * \brief Keep only the bestRoot policy in the TPGGraph, and prune it.
+         *
+         * After a call to keepBestPolicy(), the policy is pruned with a
+         * PolicyPruner executing nbIterationsPerPolicyEvaluation episodes of
+         * at most maxNbActionsPerEval actions of the LearningEnvironment, in
+         * VALIDATION mode.
+         *
+         * \param[in] tolerance the maximum ratio of decisions on the
+         * workload that may be changed by the pruning.
+         * \return a summary of the effects of the pruning.
+         * \throw std::runtime_error if the TPGVertex referenced in the
+         * bestRoot attribute is no longer a TPGVertex of the TPGGraph.
+         */
+        PolicyPruner::PruningResult pruneBestPolicy(double tolerance = 0.0);
+
         /**
          * \brief Takes a given TPGVertex and creates a job containing it.
          * Useful for example in adversarial mode where a job could contain a
@@ -433,7 +543,7 @@ namespace Learn {
          *
          * \param[in] seed the seed given to the TPGMutator.
          */
-        void init(uint64_t seed = 0);
+        virtual void init(uint64_t seed = 0);
     };
 }; // namespace Learn
 
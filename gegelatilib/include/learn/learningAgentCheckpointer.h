@@ -0,0 +1,377 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef LEARNING_AGENT_CHECKPOINTER_H
+#define LEARNING_AGENT_CHECKPOINTER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "program/program.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgVertex.h"
+
+#include "learn/evaluationResult.h"
+#include "learn/learningAgent.h"
+
+namespace Learn {
+    /**
+     * \brief Class saving the complete training state of a LearningAgent
+     * after each generation, and restoring it to resume an interrupted
+     * training.
+     *
+     * Contrary to a TPGGraph exported in a dot file, a checkpoint contains
+     * everything needed to continue the training exactly where it stopped:
+     * the TPGGraph, the Archive, the EvaluationResult of all roots, the best
+     * root, the state of the Mutator::RNG and the number of generations.
+     *
+     * Checkpoints are appended as records to a single file. Since most of
+     * the TPGGraph and Archive are left untouched by a generation, each
+     * record only contains the vertices, edges and Program that were not
+     * already saved in a previous record, together with the list of vertices
+     * and edges currently in the TPGGraph, and the archived DataHandler and
+     * recordings added or removed since the previous record. The results of
+     * the roots, whose number is bounded by the LearningParameters, are saved
+     * entirely in each record.
+     *
+     * Every snapshotInterval records, a snapshot record containing the
+     * complete state is written in a new file replacing the previous one.
+     * Hence, the file never contains more than snapshotInterval records, and
+     * resuming only replays the records following the snapshot.
+     *
+     * Records are encoded by the checkpoint() method, and written to the
+     * file by a background thread, so that the training can go on while
+     * the previous generation is being written. Each record is stored with
+     * its size and a checksum, so that a record truncated by a crash of the
+     * program is detected and ignored when resuming.
+     *
+     * Programs of the TPGGraph must not be modified once they are saved in
+     * a checkpoint, which is the case with the Mutator::TPGMutator.
+     *
+     * Typical usage:
+     * \code{.cpp}
+     * Learn::LearningAgentCheckpointer checkpointer(la, "training.ckpt",
+     *                                               true);
+     * for (uint64_t i = checkpointer.getNbGenerations(); i < nbGen; i++) {
+     *     la.trainOneGeneration(i);
+     *     checkpointer.checkpoint(i + 1);
+     * }
+     * \endcode
+     */
+    class LearningAgentCheckpointer
+    {
+      protected:
+        /// Information saved for a TPGVertex.
+        typedef struct VertexEntry
+        {
+            /// Identifier of the vertex in the checkpoint file.
+            uint64_t id;
+
+            /// Is the vertex a TPGAction.
+            bool isAction;
+
+            /// Action identifier of TPGAction vertices.
+            uint64_t actionID;
+        } VertexEntry;
+
+        /// Information saved for a TPGEdge.
+        typedef struct EdgeEntry
+        {
+            /// Identifier of the edge in the checkpoint file.
+            uint64_t id;
+
+            /// Identifier of the source TPGVertex.
+            uint64_t source;
+
+            /// Identifier of the destination TPGVertex.
+            uint64_t destination;
+
+            /// Identifier of the Program of the edge.
+            uint64_t program;
+        } EdgeEntry;
+
+        /// Information saved for an ArchiveRecording.
+        typedef struct RecordingEntry
+        {
+            /// Program of the recording, as stored in the Archive.
+            const Program::Program* prog;
+
+            /// Identifier of the Program in the checkpoint file.
+            uint64_t program;
+
+            /// Hash of the archived DataHandler of the recording.
+            size_t dataHash;
+
+            /// Result of the recording.
+            double result;
+        } RecordingEntry;
+
+        /// State accumulated while reading the records of a checkpoint file.
+        struct ReplayState;
+
+        /// LearningAgent whose state is saved.
+        LearningAgent& agent;
+
+        /// Path of the checkpoint file.
+        std::string filePath;
+
+        /// Number of records between two snapshots.
+        uint64_t snapshotInterval;
+
+        /// Number of records in the file since the last snapshot, included.
+        uint64_t nbRecordsInFile = 0;
+
+        /// Number of generations saved in the last checkpoint.
+        uint64_t nbGenerations = 0;
+
+        /// Next identifier given to a vertex, edge or Program.
+        uint64_t nextId = 0;
+
+        /// Saved vertices of the current TPGGraph.
+        std::unordered_map<const TPG::TPGVertex*, VertexEntry> vertexEntries;
+
+        /// Saved edges of the current TPGGraph.
+        std::unordered_map<const TPG::TPGEdge*, EdgeEntry> edgeEntries;
+
+        /**
+         * \brief Saved Program of the current TPGGraph, with their identifier.
+         *
+         * Holding the Program ensures that their address is not reused by a
+         * new Program while they are known by the checkpointer.
+         */
+        std::unordered_map<
+            const Program::Program*,
+            std::pair<uint64_t, std::shared_ptr<Program::Program>>>
+            programEntries;
+
+        /**
+         * \brief Storage whose addresses replace the pointers to deleted
+         * Program in the restored Archive.
+         *
+         * These addresses are never dereferenced, like the pointers to
+         * deleted Program in an Archive.
+         */
+        std::unique_ptr<char[]> deletedProgramKeys;
+
+        /// Saved ArchiveRecording of the Archive, in their order of insertion.
+        std::deque<RecordingEntry> recordingEntries;
+
+        /// Hashes of the saved archived DataHandler.
+        std::unordered_set<size_t> dataHashes;
+
+        /// File to which records are appended.
+        FILE* pFile = nullptr;
+
+        /// Thread writing the records to the file.
+        std::thread writer;
+
+        /// Mutex protecting the pending records and writer status.
+        std::mutex writerMutex;
+
+        /// Condition used to notify the writer and the waiting threads.
+        std::condition_variable writerCondition;
+
+        /// Records waiting to be written to the file, and whether they are
+        /// snapshots.
+        std::deque<std::pair<std::string, bool>> pendingRecords;
+
+        /// Is a record being written by the writer thread.
+        bool isWriting = false;
+
+        /// Is the writer thread requested to stop.
+        bool stopWriter = false;
+
+        /**
+         * \brief Error encountered by the writer thread, if any.
+         *
+         * Once set, pending and new records are dropped, since they would
+         * depend on a record missing from the file.
+         */
+        std::exception_ptr writerError;
+
+        /**
+         * \brief Encode the state of the LearningAgent in a record payload.
+         *
+         * The vertexEntries, edgeEntries, programEntries, recordingEntries
+         * and dataHashes are updated with the content of the current
+         * TPGGraph and Archive.
+         *
+         * \param[in] isSnapshot when true, these attributes are cleared
+         * first so that the complete state is encoded.
+         * \return the encoded payload.
+         */
+        std::string encodeState(bool isSnapshot);
+
+        /**
+         * \brief Decode the TPGGraph and Archive part of a record payload.
+         *
+         * \param[in] payload the payload of the record.
+         * \param[in,out] state the state updated with the content of the
+         * record.
+         * \throw std::runtime_error if the payload is invalid.
+         */
+        void decodeRecord(const std::string& payload,
+                          ReplayState& state) const;
+
+        /**
+         * \brief Restore the state of the LearningAgent from the last record
+         * of a checkpoint file.
+         *
+         * \param[in] state the state built from the records of the file,
+         * starting from the last snapshot.
+         * \throw std::runtime_error if the payload is invalid.
+         */
+        void restoreState(ReplayState& state);
+
+        /**
+         * \brief Append the serialized EvaluationResult to a buffer.
+         *
+         * ClassificationEvaluationResult are saved with their per-class
+         * scores, other types are saved as a base EvaluationResult.
+         */
+        static void appendEvaluationResult(std::string& buffer,
+                                           const EvaluationResult& result);
+
+        /// Read an EvaluationResult saved with appendEvaluationResult.
+        static std::shared_ptr<EvaluationResult> readEvaluationResult(
+            const std::string& buffer, size_t& offset);
+
+        /// Header written at the beginning of checkpoint files.
+        std::string makeHeader() const;
+
+        /**
+         * \brief Read the checkpoint file and restore the LearningAgent from
+         * its last complete record.
+         *
+         * An incomplete or corrupted trailing record is removed from the
+         * file.
+         *
+         * \return false if the file is missing or empty.
+         * \throw std::runtime_error if the file is not a valid checkpoint
+         * file of a compatible LearningAgent.
+         */
+        bool resumeFromFile();
+
+        /// Main function of the writer thread.
+        void writeRecords();
+
+        /**
+         * \brief Replace the checkpoint file with a new file containing only
+         * the given snapshot record.
+         *
+         * The snapshot is written and synchronized in a temporary file which
+         * is then renamed, so that a crash never leaves the checkpoint file
+         * without a complete snapshot.
+         *
+         * \return false if the snapshot could not be written.
+         */
+        bool writeSnapshot(const std::string& record);
+
+        /// Rethrow the error of the writer thread, if any.
+        void checkWriterError();
+
+      public:
+        /**
+         * \brief Constructor of the checkpointer.
+         *
+         * \param[in] agent the LearningAgent whose state is saved.
+         * \param[in] filePath the path of the checkpoint file.
+         * \param[in] resume when true and the file contains checkpoints,
+         * the state of the LearningAgent is restored from the last one and
+         * new checkpoints are appended to the file. Otherwise, the file is
+         * (re)created empty.
+         * \param[in] snapshotInterval the number of records after which a
+         * new snapshot replaces the content of the file. A value of 1 writes
+         * the complete state in each record.
+         * \throw std::runtime_error if the file can not be opened, or if it
+         * is not a checkpoint file of a compatible LearningAgent.
+         */
+        LearningAgentCheckpointer(LearningAgent& agent,
+                                  const std::string& filePath,
+                                  bool resume = false,
+                                  uint64_t snapshotInterval = 16);
+
+        /// Deleted copy constructor.
+        LearningAgentCheckpointer(const LearningAgentCheckpointer& other) =
+            delete;
+
+        /**
+         * \brief Destructor.
+         *
+         * Waits for all pending records to be written before closing the
+         * file.
+         */
+        ~LearningAgentCheckpointer();
+
+        /**
+         * \brief Get the number of generations of the last checkpoint.
+         *
+         * After a resume, this is the number of generations to skip in the
+         * training loop.
+         */
+        uint64_t getNbGenerations() const;
+
+        /**
+         * \brief Save the current state of the LearningAgent.
+         *
+         * The state is encoded before the method returns, so the training
+         * can continue immediately. The record is written to the file in the
+         * background.
+         *
+         * \param[in] nbGenerations the number of generations trained so far.
+         * \throw std::runtime_error if a previous record could not be
+         * written. The file then ends with the last record written
+         * successfully.
+         */
+        void checkpoint(uint64_t nbGenerations);
+
+        /**
+         * \brief Wait until all records are written to the file.
+         *
+         * \throw std::runtime_error if a record could not be written.
+         */
+        void wait();
+    };
+}; // namespace Learn
+
+#endif
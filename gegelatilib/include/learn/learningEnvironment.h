@@ -122,6 +122,21 @@ namespace Learn {
          */
         virtual bool isCopyable() const;
 
+        /**
+         * \brief Is the outcome of a simulation in the LearningEnvironment
+         * fully determined by the sequence of actions performed.
+         *
+         * A deterministic LearningEnvironment ignores the seed given to the
+         * reset method: two simulations driven by the same policies (and
+         * performed in the same LearningMode) always produce the same scores.
+         * LearningAgent may exploit this property to avoid replaying
+         * simulations whose outcome is already known.
+         *
+         * \return true if the LearningEnvironment is deterministic. Default
+         * implementation returns false.
+         */
+        virtual bool isDeterministic() const;
+
         /**
          * \brief Get the number of actions available for this
          * LearningEnvironment.
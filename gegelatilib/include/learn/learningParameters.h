@@ -107,6 +107,43 @@ namespace Learn {
         /// generation.
         double ratioDeletedRoots = 0.5;
 
+        /// JSon comment
+        inline static const std::string inferenceCostWeightComment =
+            "// [Only used in LearningAgent and ParallelLearningAgent.]\n"
+            "// Penalty subtracted from the score of a root, for each program "
+            "line executed\n"
+            "// per decision, when selecting the roots to delete. A non-zero "
+            "value requires\n"
+            "// a TPGGraph built with a TPGInstrumentedFactory.\n"
+            "// \"inferenceCostWeight\" : 0.0, // Default value";
+        /**
+         * \brief Weight of the inference cost in the selection of roots.
+         *
+         * When deciding which roots are deleted, the score of each root is
+         * decreased by this weight multiplied by the average number of
+         * program lines executed per decision of the root. A value of 0.0
+         * ranks roots on their score alone.
+         */
+        double inferenceCostWeight = 0.0;
+
+        /// JSon comment
+        inline static const std::string maxInferenceCostComment =
+            "// [Only used in LearningAgent and ParallelLearningAgent.]\n"
+            "// Maximum average number of program lines executed per "
+            "decision of a root.\n"
+            "// Roots exceeding it are deleted before all others. A non-zero "
+            "value requires\n"
+            "// a TPGGraph built with a TPGInstrumentedFactory.\n"
+            "// \"maxInferenceCost\" : 0.0, // Default value (no limit)";
+        /**
+         * \brief Inference cost budget of the roots.
+         *
+         * When deciding which roots are deleted, roots whose average number
+         * of program lines executed per decision exceeds this budget are
+         * deleted first. A value of 0.0 sets no budget.
+         */
+        double maxInferenceCost = 0.0;
+
         /// JSon comment
         inline static const std::string nbGenerationsComment =
             "// Number of generations of the training.\n"
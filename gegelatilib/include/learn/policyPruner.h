@@ -0,0 +1,209 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef POLICY_PRUNER_H
+#define POLICY_PRUNER_H
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "learn/learningEnvironment.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgGraph.h"
+#include "tpg/tpgVertex.h"
+
+namespace Learn {
+    /**
+     * \brief Utility class for simplifying a trained policy.
+     *
+     * The prune() method executes a policy on a workload of episodes of a
+     * LearningEnvironment, counts the number of times each TPGEdge of the
+     * policy wins the bid of its team, and removes from the TPGGraph:
+     * - the TPGEdge that never win a bid. Since bids of other TPGEdge are not
+     * affected, removing them never changes decisions on the workload.
+     * - optionally, TPGEdge winning rarely, as long as the ratio of decisions
+     * changed on the workload stays within a given tolerance.
+     * - all TPGVertex no longer reachable from the root of the policy. Their
+     * Program are freed with their TPGEdge when no longer used.
+     *
+     * Traversal counts are collected by the PolicyPruner itself, as in
+     * TPGEdgeInstrumented::getNbTraversal(), so any TPGGraph can be pruned
+     * and the counters of an instrumented TPGGraph are left untouched.
+     *
+     * Decisions are compared by replaying the actions of the unpruned
+     * policy, so both policies are queried in the same states. This
+     * requires a LearningEnvironment reset with the same seed and given the
+     * same actions to go through the same states.
+     */
+    class PolicyPruner
+    {
+      public:
+        /// Summary of the effects of a pruning.
+        typedef struct PruningResult
+        {
+            /// Number of TPGVertex of the policy before pruning.
+            size_t nbVerticesBefore = 0;
+            /// Number of TPGVertex of the policy after pruning.
+            size_t nbVerticesAfter = 0;
+            /// Number of TPGEdge of the policy before pruning.
+            size_t nbEdgesBefore = 0;
+            /// Number of TPGEdge of the policy after pruning.
+            size_t nbEdgesAfter = 0;
+            /// Number of distinct Program of the policy before pruning.
+            size_t nbProgramsBefore = 0;
+            /// Number of distinct Program of the policy after pruning.
+            size_t nbProgramsAfter = 0;
+            /// Number of decisions taken on the workload.
+            uint64_t nbDecisions = 0;
+            /// Number of decisions changed by the pruning on the workload.
+            uint64_t nbChangedDecisions = 0;
+            /// Average number of teams evaluated per decision before pruning.
+            double avgEvaluatedTeamsBefore = 0.0;
+            /// Average number of teams evaluated per decision after pruning.
+            double avgEvaluatedTeamsAfter = 0.0;
+            /// Average number of programs evaluated per decision before
+            /// pruning.
+            double avgEvaluatedProgramsBefore = 0.0;
+            /// Average number of programs evaluated per decision after
+            /// pruning.
+            double avgEvaluatedProgramsAfter = 0.0;
+            /// Average number of program lines executed per decision before
+            /// pruning.
+            double avgExecutedLinesBefore = 0.0;
+            /// Average number of program lines executed per decision after
+            /// pruning.
+            double avgExecutedLinesAfter = 0.0;
+
+            /// Get the ratio of decisions changed by the pruning.
+            double getDecisionChangeRatio() const;
+
+            /// Get the relative reduction of the number of program lines
+            /// executed per decision, between 0.0 and 1.0.
+            double getInferenceCostReduction() const;
+        } PruningResult;
+
+      protected:
+        /// LearningEnvironment providing the workload.
+        LearningEnvironment& learningEnvironment;
+
+        /// Number of episodes of the workload.
+        uint64_t nbEpisodes;
+
+        /// Maximum number of actions per episode of the workload.
+        uint64_t maxNbActionsPerEpisode;
+
+        /// Maximum ratio of decisions changed by the pruning.
+        double tolerance;
+
+        /// Mode in which the LearningEnvironment is reset.
+        LearningMode mode;
+
+        /// Statistics of the execution of a policy on the workload.
+        typedef struct WorkloadStats
+        {
+            /// Number of traversals of each TPGEdge.
+            std::map<const TPG::TPGEdge*, uint64_t> nbTraversals;
+            /// Actions taken in each episode.
+            std::vector<std::vector<uint64_t>> actions;
+            /// Number of decisions.
+            uint64_t nbDecisions = 0;
+            /// Number of decisions differing from the replayed actions.
+            uint64_t nbChangedDecisions = 0;
+            /// Total number of evaluated teams.
+            uint64_t nbEvaluatedTeams = 0;
+            /// Total number of evaluated programs.
+            uint64_t nbEvaluatedPrograms = 0;
+            /// Total number of executed lines.
+            uint64_t nbExecutedLines = 0;
+            /// Was the execution interrupted by a team whose TPGEdge are all
+            /// excluded.
+            bool reachedEmptyTeam = false;
+        } WorkloadStats;
+
+        /**
+         * \brief Execute a policy on the workload.
+         *
+         * \param[in] graph the TPGGraph containing the policy.
+         * \param[in] root the root TPGVertex of the policy.
+         * \param[in] excludedEdges TPGEdge ignored during the execution.
+         * \param[in] replayedActions if not nullptr, actions applied to the
+         * LearningEnvironment instead of those of the policy, which are
+         * compared to them.
+         * \return the statistics of the execution.
+         */
+        WorkloadStats executeWorkload(
+            const TPG::TPGGraph& graph, const TPG::TPGVertex& root,
+            const std::set<const TPG::TPGEdge*>& excludedEdges,
+            const std::vector<std::vector<uint64_t>>* replayedActions);
+
+      public:
+        /**
+         * \brief Constructor of the PolicyPruner.
+         *
+         * \param[in] le the LearningEnvironment providing the workload. It
+         * must be the LearningEnvironment whose data sources are used by the
+         * Environment of the pruned TPGGraph.
+         * \param[in] nbEpisodes the number of episodes of the workload.
+         * \param[in] maxNbActionsPerEpisode the maximum number of actions per
+         * episode.
+         * \param[in] tolerance the maximum ratio of decisions on the workload
+         * that may be changed by the pruning. With 0.0, only TPGEdge that
+         * never win a bid are removed.
+         * \param[in] mode the LearningMode in which the LearningEnvironment
+         * is reset.
+         * \throw std::invalid_argument if the tolerance is not within
+         * [0.0, 1.0].
+         */
+        PolicyPruner(LearningEnvironment& le, uint64_t nbEpisodes,
+                     uint64_t maxNbActionsPerEpisode, double tolerance = 0.0,
+                     LearningMode mode = LearningMode::VALIDATION);
+
+        /**
+         * \brief Prune a policy of a TPGGraph.
+         *
+         * All TPGVertex of the TPGGraph that are not reachable from the root
+         * after the pruning, including other roots, are removed.
+         *
+         * \param[in,out] graph the TPGGraph containing the policy.
+         * \param[in] root the root TPGVertex of the policy.
+         * \return a summary of the effects of the pruning.
+         * \throw std::runtime_error if the root is not a TPGVertex of the
+         * graph.
+         */
+        PruningResult prune(TPG::TPGGraph& graph, const TPG::TPGVertex& root);
+    };
+} // namespace Learn
+
+#endif
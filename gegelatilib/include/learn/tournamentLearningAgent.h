@@ -0,0 +1,222 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TOURNAMENT_LEARNING_AGENT_H
+#define TOURNAMENT_LEARNING_AGENT_H
+
+#include <atomic>
+#include <vector>
+
+#include "learn/adversarialLearningAgent.h"
+
+namespace Learn {
+    /**
+     * \brief AdversarialLearningAgent evaluating its roots with a balanced
+     * round-robin tournament.
+     *
+     * Contrary to the AdversarialLearningAgent, where each root faces teams
+     * of champions and only the score of the studied root is kept, roots are
+     * all confronted to each other and every participant of a match is
+     * scored. Each round of the tournament splits the whole population into
+     * groups of agentsPerEvaluation roots, so all roots play the same number
+     * of matches and all jobs have the same size. For the same number of
+     * evaluations per root, agentsPerEvaluation times fewer matches are
+     * played than with the AdversarialLearningAgent.
+     *
+     * Rounds are built with the circle method: the first root keeps its seat
+     * while the others rotate by one seat at each round. With two agents per
+     * evaluation and an even number of roots, each pair of roots meets
+     * exactly once every nbRoots - 1 rounds.
+     *
+     * During the parallel evaluation, matches are grouped by home root, the
+     * root of the match coming first in the list of roots, and these groups
+     * are gathered into blocks of matches of similar size. Several blocks
+     * are made per thread, and each thread picks the next unevaluated block
+     * until all are evaluated, which keeps the policies of a few home roots
+     * hot in each thread while balancing matches of unequal lengths. Each
+     * thread stores the results of its matches in slots reserved for its
+     * jobs, hence no mutual exclusion is needed while matches are played.
+     * Scores are then accumulated per root following the job order, which
+     * keeps the evaluation deterministic whatever the number of threads.
+     */
+    class TournamentLearningAgent : public AdversarialLearningAgent
+    {
+      protected:
+        /**
+         * \brief Evaluate all the jobs of the tournament with parallelism.
+         *
+         * **Replaces the function from the base class ParallelLearningAgent.**
+         *
+         * Jobs created by makeJobs are sorted by home root and split into
+         * blocks with makeJobBlocks(). Blocks are evaluated by up to
+         * maxNbThreads threads, the main thread using the main
+         * LearningEnvironment.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[out] resultsPerJobMap map linking the job number with its
+         * results and itself.
+         * \param[out] archiveMap map linking the job number with its gathered
+         * archive.
+         */
+        void evaluateAllRootsInParallelExecute(
+            uint64_t generationNumber, LearningMode mode,
+            std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
+                                         std::shared_ptr<Job>>>&
+                resultsPerJobMap,
+            std::map<uint64_t, Archive*>& archiveMap) override;
+
+        /// Number of blocks of jobs made for each thread.
+        static const size_t NB_BLOCKS_PER_THREAD = 4;
+
+        /**
+         * \brief Function implementing the behavior of threads evaluating
+         * blocks of jobs of the tournament.
+         *
+         * Threads pick blocks with the shared nextBlock index until all
+         * blocks are evaluated. Results and archives of the job at index i of
+         * the jobs vector are stored at the same index in the results and
+         * archives vectors. Since blocks never overlap, these vectors are
+         * accessed without mutual exclusion.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in] jobs the complete list of jobs of the tournament.
+         * \param[in] order indexes of the jobs, sorted by block.
+         * \param[in] blocks the index in order of the first job of each
+         * block, followed by order.size().
+         * \param[in,out] nextBlock index of the next block to evaluate.
+         * \param[out] results vector storing the result of each job.
+         * \param[out] archives vector storing the Archive of each job.
+         * \param[in] useMainEnvironment boolean indicating whether a copy
+         * of the LearningEnvironment should be made, or if the main
+         * LearningEnvironment can be used.
+         */
+        void evalJobBlockThread(
+            uint64_t generationNumber, LearningMode mode,
+            const std::vector<std::shared_ptr<Job>>& jobs,
+            const std::vector<size_t>& order, const std::vector<size_t>& blocks,
+            std::atomic<size_t>& nextBlock,
+            std::vector<std::shared_ptr<EvaluationResult>>& results,
+            std::vector<Archive*>& archives, bool useMainEnvironment);
+
+      public:
+        /**
+         * \brief Constructor for TournamentLearningAgent.
+         *
+         * Based on default constructor of AdversarialLearningAgent
+         *
+         * \param[in] le The LearningEnvironment for the TPG.
+         * \param[in] iSet Set of Instruction used to compose Programs in the
+         *            learning process.
+         * \param[in] p The LearningParameters for the LearningAgent.
+         * \param[in] agentsPerEval The number of agents each simulation will
+         * need.
+         * \param[in] factory The TPGFactory used to create the TPGGraph. A
+         * default TPGFactory is used if none is provided.
+         */
+        TournamentLearningAgent(
+            LearningEnvironment& le, const Instructions::Set& iSet,
+            const LearningParameters& p, size_t agentsPerEval = 2,
+            const TPG::TPGFactory& factory = TPG::TPGFactory())
+            : AdversarialLearningAgent(le, iSet, p, agentsPerEval, factory)
+        {
+        }
+
+        /**
+         * \brief Get the number of rounds of the tournament.
+         *
+         * Each root takes part in one match per round. The number of rounds
+         * is computed so that each root is evaluated at least
+         * nbIterationsPerPolicyEvaluation times.
+         *
+         * \return the number of rounds of the tournament.
+         */
+        size_t getNbRounds() const;
+
+        /**
+         * \brief Sort jobs by home root and gather them into blocks.
+         *
+         * The home root of a job is its root coming first in the list of
+         * roots of the TPGGraph. Jobs of a home root are never split between
+         * blocks, and blocks are closed once they hold at least
+         * jobs.size() / nbBlocks jobs.
+         *
+         * \param[in] jobs the complete list of jobs of the tournament.
+         * \param[in] nbBlocks the targeted number of blocks.
+         * \param[out] order indexes of the jobs, sorted by home root.
+         * \return the index in order of the first job of each block,
+         * followed by order.size().
+         */
+        std::vector<size_t> makeJobBlocks(
+            const std::vector<std::shared_ptr<Job>>& jobs, size_t nbBlocks,
+            std::vector<size_t>& order) const;
+
+        /**
+         * \brief Puts all roots into AdversarialJob following a balanced
+         * round-robin schedule.
+         *
+         * Roots are placed on ceil(nbRoots / agentsPerEvaluation) *
+         * agentsPerEvaluation seats. If the number of roots is not a multiple
+         * of agentsPerEvaluation, the remaining seats are byes: in their
+         * group, they are taken by filler roots, the first roots of the list
+         * not playing in the group, whose score is ignored. Hence, all roots
+         * are scored on exactly one match per round, and never play against
+         * themselves when there are enough roots. At each round, all roots but
+         * the first one move to the next seat, and seats are gathered into
+         * groups so that the first seat faces the last one, the second faces
+         * the penultimate one, and so on. The playing order within each
+         * group is also rotated at each round so that roots do not always
+         * play at the same position.
+         *
+         * Jobs are created round after round, and the posOfStudiedRoot of
+         * each job is -1, meaning that the score of all its roots is used.
+         *
+         * \param[in] mode the mode of the training, determining for example
+         * if we generate values that we only need for training.
+         * \param[in] tpgGraph The TPG graph from which we will take the
+         * roots.
+         *
+         * @return A queue containing pointers of the created AdversarialJobs.
+         */
+        std::queue<std::shared_ptr<Learn::Job>> makeJobs(
+            Learn::LearningMode mode,
+            TPG::TPGGraph* tpgGraph = nullptr) override;
+    };
+} // namespace Learn
+
+#endif
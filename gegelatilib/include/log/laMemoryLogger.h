@@ -0,0 +1,145 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef LA_MEMORY_LOGGER_H
+#define LA_MEMORY_LOGGER_H
+
+#include <iomanip>
+
+#include "log/laLogger.h"
+#include "util/memoryUsage.h"
+
+namespace Log {
+
+    /**
+     * \brief Logger of the memory footprint of the learning process.
+     *
+     * At each generation, this LALogger logs the total footprint after the
+     * population of the TPGGraph, when the number of roots is maximal, and
+     * the footprint of each component at the end of the generation, as
+     * reported by LearningAgent::getMemoryUsage(). Values are logged in KiB,
+     * in regularly spaced columns.
+     */
+    class LAMemoryLogger : public LALogger
+    {
+      private:
+        /**
+         * Width of columns when logging values.
+         */
+        int colWidth = 11;
+
+        /// Log a value given in bytes, in KiB.
+        void logKiB(size_t bytes);
+
+      public:
+        /**
+         * \brief Same constructor as LaLogger. Default output is cout.
+         *
+         * \param[in] la LearningAgent whose memory footprint will be logged
+         * by the LAMemoryLogger.
+         * \param[in] out The output stream the logger will send
+         * elements to.
+         */
+        explicit LAMemoryLogger(Learn::LearningAgent& la,
+                                std::ostream& out = std::cout)
+            : LALogger(la, out)
+        {
+            // fixing float precision
+            *this << std::setprecision(1) << std::fixed << std::right;
+            this->logHeader();
+        }
+
+        /**
+         * Inherited via LaLogger
+         *
+         * \brief Logs the header (column names) of the tab that will be logged.
+         */
+        virtual void logHeader() override;
+
+        /**
+         * Inherited via LALogger.
+         *
+         * \brief Logs the generation of training.
+         *
+         * \param[in] generationNumber The number of the current
+         * generation.
+         */
+        virtual void logNewGeneration(uint64_t& generationNumber) override;
+
+        /**
+         * Inherited via LALogger.
+         *
+         * \brief Logs the total memory footprint after the population.
+         */
+        virtual void logAfterPopulateTPG() override;
+
+        /**
+         * Inherited via LaLogger.
+         *
+         * \brief Does nothing in this logger.
+         *
+         * \param[in] results scores of the evaluation.
+         */
+        virtual void logAfterEvaluate(
+            std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override;
+
+        /**
+         * Inherited via LaLogger.
+         *
+         * \brief Does nothing in this logger.
+         */
+        virtual void logAfterDecimate() override;
+
+        /**
+         * Inherited via LaLogger.
+         *
+         * \brief Does nothing in this logger.
+         *
+         * \param[in] results scores of the validation.
+         */
+        virtual void logAfterValidate(
+            std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override;
+
+        /**
+         * Inherited via LaLogger
+         *
+         * \brief Logs the footprint of each component at the end of the
+         * generation.
+         */
+        virtual void logEndOfTraining() override;
+    };
+}; // namespace Log
+
+#endif
@@ -38,6 +38,7 @@
 
 #include <memory>
 #include <random>
+#include <string>
 
 namespace Mutator {
 
@@ -82,6 +83,22 @@ namespace Mutator {
          */
         void setSeed(uint64_t seed);
 
+        /**
+         * \brief Get the internal state of the random number generator.
+         *
+         * \return a textual representation of the engine state, that can be
+         * given to setState() to resume the generation of random numbers.
+         */
+        std::string getState() const;
+
+        /**
+         * \brief Restore an internal state of the random number generator.
+         *
+         * \param[in] state a state previously returned by getState().
+         * \throw std::runtime_error if the state can not be parsed.
+         */
+        void setState(const std::string& state);
+
         /**
          * \brief Get a pseudo random int number between two bounds (included).
          *
@@ -36,7 +36,10 @@
 #ifndef TPG_MUTATOR_H
 #define TPG_MUTATOR_H
 
+#include <list>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "archive.h"
 #include "mutator/mutationParameters.h"
@@ -205,6 +208,85 @@ namespace Mutator {
             std::list<std::shared_ptr<Program::Program>>& newPrograms,
             const Mutator::MutationParameters& params, Mutator::RNG& rng);
 
+        /**
+         * \brief Structural mutations planned for a new root TPGTeam.
+         *
+         * A TPGTeamMutationPlan describes the outgoing TPGEdge of a TPGTeam
+         * obtained by cloning an existing root TPGTeam and applying
+         * the structural mutations of the mutateTPGTeam function to it,
+         * without modifying the TPGGraph. Plans can thus be built
+         * concurrently, and applied later to the TPGGraph, in a
+         * deterministic order, with the applyTPGTeamMutationPlan function.
+         */
+        struct TPGTeamMutationPlan
+        {
+            /**
+             * \brief Outgoing TPGEdge of the planned TPGTeam.
+             */
+            struct PlannedEdge
+            {
+                /// Existing TPGEdge of the graph duplicated by this edge.
+                const TPG::TPGEdge* model;
+
+                /// Destination of the duplicated TPGEdge.
+                const TPG::TPGVertex* destination;
+
+                /// Whether the Program of the model must be copied and
+                /// mutated.
+                bool mutateProgram;
+            };
+
+            /// Ordered outgoing TPGEdge of the planned TPGTeam.
+            std::vector<PlannedEdge> edges;
+        };
+
+        /**
+         * \brief Plan the structural mutations of a clone of a TPGTeam.
+         *
+         * This function draws random numbers from the given RNG exactly as
+         * a call to mutateTPGTeam on a freshly cloned TPGTeam would, but
+         * records the resulting outgoing TPGEdge in a TPGTeamMutationPlan
+         * instead of modifying the TPGGraph. Since the TPGGraph is only
+         * read, several plans can be built concurrently, as long as the
+         * TPGGraph is not modified in the meantime.
+         *
+         * \param[in] clonedTeam the TPGTeam whose clone is being mutated.
+         * \param[in] preExistingTeams the TPGTeam candidates for destination.
+         * \param[in] preExistingActions the TPGAction candidates for
+         *            destination.
+         * \param[in] preExistingEdges the TPGEdge candidates for cloning.
+         * \param[in] params Probability parameters for the mutation.
+         * \param[in] rng Random Number Generator used in the mutation process.
+         * \return the TPGTeamMutationPlan of the mutated clone.
+         */
+        TPGTeamMutationPlan planTPGTeamMutation(
+            const TPG::TPGTeam& clonedTeam,
+            const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+            const std::vector<const TPG::TPGAction*>& preExistingActions,
+            const std::list<const TPG::TPGEdge*>& preExistingEdges,
+            const Mutator::MutationParameters& params, Mutator::RNG& rng);
+
+        /**
+         * \brief Create a new TPGTeam in the TPGGraph from a
+         * TPGTeamMutationPlan.
+         *
+         * Program of planned TPGEdge flagged for mutation are copied and
+         * added to the newPrograms list. Their behavior must be mutated
+         * after this function to complete the mutation process.
+         *
+         * \param[in,out] graph the TPGGraph within which the TPGTeam is
+         *                created.
+         * \param[in] plan the TPGTeamMutationPlan to apply.
+         * \param[in,out] newPrograms List of new Program created for the
+         *                TPGTeam.
+         * \return a const reference to the created TPGTeam.
+         * \throw std::runtime_error if a model TPGEdge of the plan does not
+         * belong to the TPGGraph.
+         */
+        const TPG::TPGTeam& applyTPGTeamMutationPlan(
+            TPG::TPGGraph& graph, const TPGTeamMutationPlan& plan,
+            std::list<std::shared_ptr<Program::Program>>& newPrograms);
+
         /**
          * \brief Mutate the behavior of a Program and ensure its unicity
          * against the given Archive.
@@ -255,6 +337,13 @@ namespace Mutator {
          * If the given TPGGraph already has more root TPGVertex than the
          * targetted number of root teams, nothing happens.
          *
+         * The structural mutations of new root TPGTeam are planned in
+         * batches with the planTPGTeamMutation function, possibly in
+         * parallel, each with a private RNG seeded from the given one. Plans
+         * are then applied to the TPGGraph in a fixed order, until the
+         * targetted number of roots is reached, so that the result does not
+         * depend on the number of threads.
+         *
          * \param[in,out] graph the TPGGraph to mutate.
          * \param[in] archive Archive used to assess the uniqueness of the
          *            mutated Program behavior.
@@ -266,6 +355,9 @@ namespace Mutator {
          *               std::thread::hardware_concurrency().
          *   - `0` and `1`: Do not use parallelism.
          *   - `n > 1`: Set the number of threads explicitly.
+         * \throw std::runtime_error if no TPGEdge can be duplicated in a new
+         * root. Exceptions raised while planning mutations in parallel are
+         * rethrown in the calling thread.
          */
         void populateTPG(
             TPG::TPGGraph& graph, const Archive& archive,
@@ -131,6 +131,13 @@ namespace Program {
          */
         const Environment& getEnvironment() const;
 
+        /**
+         * \brief Get the estimated memory footprint of the Line.
+         *
+         * \return the size of the Line object and of its operands, in bytes.
+         */
+        size_t getMemoryFootprint() const;
+
         /**
          * \brief Getter for the destinationIndex of this Line.
          *
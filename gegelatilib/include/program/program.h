@@ -38,13 +38,18 @@
 #define PROGRAM_H
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "data/constantHandler.h"
 #include "environment.h"
 #include "program/line.h"
+#include "util/memoryUsage.h"
 
 namespace Program {
+    // Declare struct defined in programEngine.h
+    struct ProgramValidation;
+
     /**
      * \brief The Program class contains a list of program lines that can be
      * executed within a well defined Environment.
@@ -68,6 +73,18 @@ namespace Program {
          */
         std::vector<std::pair<Line*, bool>> lines;
 
+        /**
+         * \brief Validation of the Lines by a ProgramEngine, if any.
+         *
+         * Like the intron property, the validation is computed once and
+         * reused by all executions of the Program. It is cleared by all
+         * methods giving access to, or modifying, the lines.
+         *
+         * The validation is accessed atomically, since a Program may be
+         * executed by several threads at once.
+         */
+        mutable std::shared_ptr<const ProgramValidation> validation;
+
         /**
          *   \brief Constants of the Program
          *
@@ -102,6 +119,7 @@ namespace Program {
          */
         Program(const Program& other)
             : environment{other.environment}, lines{other.lines},
+              validation{std::atomic_load(&other.validation)},
               constants{other.constants}
         {
             // Replace lines with their copy
@@ -227,6 +245,17 @@ namespace Program {
          */
         bool isIntron(uint64_t index) const;
 
+        /**
+         * \brief Compute which Line of the Program are introns.
+         *
+         * Contrary to identifyIntrons(), this method does not update the
+         * intron flag stored with each Line of the Program.
+         *
+         * \return a vector with one boolean per Line of the Program, true
+         * if the Line is an intron.
+         */
+        std::vector<bool> findIntrons() const;
+
         /**
          * \brief Scan the Line of the Program to identify introns.
          *
@@ -237,6 +266,22 @@ namespace Program {
          */
         uint64_t identifyIntrons();
 
+        /**
+         * \brief Get the validation cached by a ProgramEngine, if any.
+         *
+         * \return the last validation given to setValidation(), or nullptr
+         * if the Program was modified since.
+         */
+        std::shared_ptr<const ProgramValidation> getValidation() const;
+
+        /**
+         * \brief Cache the validation of the Program by a ProgramEngine.
+         *
+         * \param[in] validation the validation of the current Lines.
+         */
+        void setValidation(
+            std::shared_ptr<const ProgramValidation> validation) const;
+
         /**
          *  \brief get the constantHandler object of the Program
          *
@@ -279,6 +324,18 @@ namespace Program {
          * \param[in] other the Program whose behavior is compared.
          */
         bool hasIdenticalBehavior(const Program& other) const;
+
+        /**
+         * \brief Add the estimated memory footprint of the Program to a
+         * MemoryUsage.
+         *
+         * The Program object and its table of lines are added to the
+         * programs component, its Line objects to the lines component, and
+         * its constants to the constants component.
+         *
+         * \param[in,out] usage the MemoryUsage to update.
+         */
+        void addMemoryUsage(Util::MemoryUsage& usage) const;
     };
 } // namespace Program
 #endif
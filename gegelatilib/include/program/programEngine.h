@@ -38,11 +38,69 @@
 #ifndef PROGRAMENGINE_H
 #define PROGRAMENGINE_H
 
+#include <memory>
+#include <stdexcept>
+
 #include "data/primitiveTypeArray.h"
 #include "data/untypedSharedPtr.h"
 #include "program/program.h"
 
 namespace Program {
+    /**
+     * \brief Non-intron Line of a validated Program.
+     *
+     * The operands of the Line are stored in the operands of its
+     * ProgramValidation, starting at index firstOperand.
+     */
+    typedef struct ValidatedLine
+    {
+        /// Index of the Instruction in the Instructions::Set.
+        uint64_t instructionIndex;
+
+        /// Instruction of the Line.
+        const Instructions::Instruction* instruction;
+
+        /// Index of the destination register.
+        uint64_t destinationIndex;
+
+        /// Index of the first operand in the operands of the validation.
+        size_t firstOperand;
+    } ValidatedLine;
+
+    /**
+     * \brief Validation of a Program by a ProgramEngine.
+     *
+     * The validation only depends on the Lines of the Program and on the
+     * number of registers, constants and DataHandler of the ProgramEngine.
+     * It is cached in the Program, and reused by all ProgramEngine with the
+     * same characteristics.
+     */
+    typedef struct ProgramValidation
+    {
+        /// Number of registers of the validating ProgramEngine.
+        uint64_t nbRegisters;
+
+        /// Number of constants of the validating ProgramEngine.
+        size_t nbConstants;
+
+        /// Number of DataHandler of the validating ProgramEngine.
+        size_t nbDataHandlers;
+
+        /// Whether the Program can be executed without checking its Line.
+        bool isValid = false;
+
+        /// Non-intron Line of the Program, if it is valid.
+        std::vector<ValidatedLine> lines;
+
+        /**
+         * \brief Operands of the lines.
+         *
+         * Each operand is a pair with the index of its DataHandler in
+         * dataScsConstsAndRegs, and its scaled location.
+         */
+        std::vector<std::pair<uint64_t, uint64_t>> operands;
+    } ProgramValidation;
+
     /**
      * \brief This abstract class is the base class for any program engine
      * (generation and execution)
@@ -69,6 +127,51 @@ namespace Program {
         // Data::PrimitiveTypeArray<double> to keep track of
         // accessed addresses.
 
+        /// Number of registers stored in the engine itself.
+        static const size_t NB_INLINE_REGISTERS = 16;
+
+        /// Number of constants stored in the engine itself.
+        static const size_t NB_INLINE_CONSTANTS = 16;
+
+        /**
+         * \brief Registers of validated Program, when they fit inline.
+         *
+         * Validated Program are executed on registerValues and
+         * constantValues, while the registers DataHandler and the constants
+         * DataHandler of dataScsConstsAndRegs are used by other Program and
+         * by code generation.
+         */
+        alignas(64) double inlineRegisters[NB_INLINE_REGISTERS];
+
+        /// Constants of validated Program, when they fit inline.
+        alignas(64) Data::Constant inlineConstants[NB_INLINE_CONSTANTS];
+
+        /// Registers of validated Program, when they do not fit inline.
+        std::vector<double> heapRegisters;
+
+        /// Constants of validated Program, when they do not fit inline.
+        std::vector<Data::Constant> heapConstants;
+
+        /// Registers of validated Program.
+        double* registerValues;
+
+        /// Constants of validated Program, copied by setProgram().
+        Data::Constant* constantValues;
+
+        /// Number of constants of the Environment.
+        size_t nbConstants;
+
+        /**
+         * \brief Operand pointing to each element of registerValues.
+         *
+         * Scalar operands of validated Program are fetched by copying these
+         * Data::UntypedSharedPtr, without calling the DataHandler.
+         */
+        std::vector<Data::UntypedSharedPtr> registerOperands;
+
+        /// Operand pointing to each element of constantValues.
+        std::vector<Data::UntypedSharedPtr> constantOperands;
+
         /// Data sources from the environment used for archiving a program.
         std::vector<std::reference_wrapper<const Data::DataHandler>>
             dataSources;
@@ -80,6 +183,62 @@ namespace Program {
         /// Program counter of the execution engine.
         uint64_t programCounter;
 
+        /// Whether the current Program was validated by setProgram().
+        bool programValidated = false;
+
+        /// Validation of the current Program, set by setProgram().
+        std::shared_ptr<const ProgramValidation> validation;
+
+        /// Instructions::Set for which addressSpaces were computed.
+        const Instructions::Set* addressSpacesSet = nullptr;
+
+        /**
+         * \brief Address space of each operand of each Instruction, in each
+         * DataHandler of dataScsConstsAndRegs.
+         *
+         * The address space of operand j of Instruction i in DataHandler k is
+         * stored at index (i * maxNbOperands + j) * nbDataHandlers + k. A null
+         * address space means that the DataHandler cannot provide the operand.
+         */
+        std::vector<uint64_t> addressSpaces;
+
+        /**
+         * \brief Check whether all non-intron Line of a Program can be
+         * executed, and list them in a ProgramValidation.
+         *
+         * A Line can be executed if its Instruction and destination register
+         * exist, and if each of its operands refers to an existing DataHandler
+         * providing the operand type.
+         *
+         * The validation cached in the Program is reused when it was computed
+         * for the characteristics of this ProgramEngine. Otherwise, the new
+         * validation is cached in the Program.
+         *
+         * \param[in] prog the checked Program.
+         * \return the validation of the Program.
+         */
+        std::shared_ptr<const ProgramValidation> validateProgram(
+            const Program& prog);
+
+        /**
+         * \brief Fill a ProgramValidation with the Line of a Program.
+         *
+         * \param[in] prog the checked Program.
+         * \param[in,out] validation the validation whose lines and operands
+         * are filled, up to the first Line that can not be executed.
+         * \return true if all non-intron Line can be executed.
+         */
+        bool fillValidation(const Program& prog,
+                            ProgramValidation& validation);
+        /**
+         * \brief Allocate registerValues and constantValues, and build their
+         * registerOperands and constantOperands.
+         *
+         * \param[in] nbRegs the number of registers of the Environment.
+         * \param[in] nbConsts the number of constants of the Environment.
+         */
+        void initValues(size_t nbRegs, size_t nbConsts);
+
       protected:
         /**
          * \brief Constructor of the class.
@@ -93,6 +252,8 @@ namespace Program {
             : programCounter{0}, registers{env.getNbRegisters()}, program{NULL},
               dataSources{env.getDataSources()}
         {
+            this->initValues(env.getNbRegisters(), env.getNbConstant());
+
             // Setup the data sources
             dataScsConstsAndRegs.push_back(this->registers);
 
@@ -131,6 +292,9 @@ namespace Program {
             // Check that T is either convertible to a const DataHandler
             static_assert(
                 std::is_convertible<T&, const Data::DataHandler&>::value);
+            this->initValues(prog.getEnvironment().getNbRegisters(),
+                             prog.getEnvironment().getNbConstant());
+
             // Setup the data sources
             this->dataScsConstsAndRegs.push_back(this->registers);
 
@@ -169,10 +333,20 @@ namespace Program {
         virtual void processLine() = 0;
 
       public:
+        /**
+         * \brief Copy constructor is deleted.
+         *
+         * registerOperands and constantOperands point to the engine itself.
+         */
+        ProgramEngine(const ProgramEngine& other) = delete;
+
         /**
          * \brief Method for changing the Program executed by a
          * ProgramExecutionEngin.
          *
+         * The non-intron Line of the Program are checked once with
+         * validateProgram().
+         *
          * \param[in] prog the const Program that will be executed by the
          * ProgramExecutionEngine. \throws std::runtime_error if the Environment
          * references by the Program is incompatible with the dataSources of the
@@ -180,6 +354,17 @@ namespace Program {
          */
         void setProgram(const Program& prog);
 
+        /**
+         * \brief Check whether the current Program was validated when set.
+         *
+         * Validated Program are executed without checking their Line, and
+         * must not be modified until setProgram() is called again.
+         *
+         * \return true if all non-intron Line of the current Program can be
+         * executed.
+         */
+        bool isProgramValidated() const;
+
         /**
          * \brief Method for changing the dataSources on which the Program will
          * be executed.
@@ -187,7 +372,8 @@ namespace Program {
          * \param[in] dataSrc The vector of DataHandler references with which
          * the Program will be executed.
          * \throws std::runtime_error if the Environment references by the
-         * Program is incompatible with the given dataSources.
+         * Program is incompatible with the given dataSources, or if no
+         * Program is set and the number of dataSources changes.
          */
         template <class T>
         void setDataSources(
@@ -291,6 +477,21 @@ namespace Program {
         // Check that T is either convertible to a const DataHandler
         static_assert(std::is_convertible<T&, const Data::DataHandler&>::value);
 
+        if (this->program == NULL) {
+            // Without Program, the data sources replace the current ones,
+            // which follow the registers and constants.
+            if (dataSrc.size() != this->dataSources.size()) {
+                throw std::runtime_error("Number of data sources differs from "
+                                         "the current ones.");
+            }
+            size_t offset = this->dataScsConstsAndRegs.size() - dataSrc.size();
+            this->dataSources = dataSrc;
+            for (size_t idx = 0; idx < dataSrc.size(); idx++) {
+                this->dataScsConstsAndRegs.at(idx + offset) = dataSrc.at(idx);
+            }
+            return;
+        }
+
         // Replace the references in attributes
         this->dataSources = dataSrc;
         // we need this offset to push the constant at the first
@@ -55,6 +55,26 @@ namespace Program {
         /// Default constructor is deleted.
         ProgramExecutionEngine() = delete;
 
+        /// Operands of the executed Line, kept to avoid reallocations.
+        std::vector<Data::UntypedSharedPtr> operands;
+
+        /**
+         * \brief Direct access to the scalar data of each DataHandler of
+         * dataScsConstsAndRegs, updated before each validated execution.
+         *
+         * Registers and constants are not accessed through their DataHandler
+         * and have no access.
+         */
+        std::vector<Data::DataHandler::ScalarAccess> scalarAccesses;
+
+        /**
+         * \brief Execute the validated Line of the current Program.
+         *
+         * Since the Program was validated by setProgram(), operands are
+         * fetched without checking the Line, and without catching exceptions.
+         */
+        virtual void executeValidatedProgram();
+
       public:
         /**
          * \brief Constructor of the class.
@@ -111,6 +131,9 @@ namespace Program {
          * \brief Execute the program completely and returns the content of
          * register 0.
          *
+         * Program validated by setProgram() are executed with
+         * executeValidatedProgram(), others with iterateThroughtProgram().
+         *
          * \param[in] ignoreException When true, all exceptions thrown when
          *            fetching current instructions, operands are
          *            caught and the current program Line is simply ignored.
@@ -0,0 +1,83 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef PROGRAM_SERIALIZATION_H
+#define PROGRAM_SERIALIZATION_H
+
+#include <memory>
+#include <string>
+
+#include "environment.h"
+#include "program/program.h"
+
+namespace Program {
+    /**
+     * \brief Functions used to store Program in binary buffers.
+     *
+     * As for Data::Serialization, buffers are only meant to be read back on
+     * a machine with the same architecture.
+     */
+    namespace Serialization {
+        /**
+         * \brief Append a Program to a buffer.
+         *
+         * The constants and the lines of the Program are appended, including
+         * intron lines.
+         *
+         * \param[in,out] buffer the buffer to which the Program is appended.
+         * \param[in] program the appended Program.
+         * \param[in] env the Environment of the Program.
+         */
+        void appendProgram(std::string& buffer, const Program& program,
+                           const Environment& env);
+
+        /**
+         * \brief Read a Program appended to a buffer with appendProgram().
+         *
+         * Intron lines of the read Program are identified.
+         *
+         * \param[in] buffer the buffer from which the Program is read.
+         * \param[in,out] offset the position of the Program in the buffer,
+         * advanced after the Program.
+         * \param[in] env the Environment of the created Program.
+         * \return the created Program.
+         * \throw std::runtime_error if the buffer is too short or if a line
+         * of the Program is not valid for the Environment.
+         */
+        std::shared_ptr<Program> readProgram(const std::string& buffer,
+                                             size_t& offset,
+                                             const Environment& env);
+    }; // namespace Serialization
+};     // namespace Program
+
+#endif
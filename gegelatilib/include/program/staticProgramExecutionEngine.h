@@ -0,0 +1,189 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef STATIC_PROGRAM_EXECUTION_ENGINE_H
+#define STATIC_PROGRAM_EXECUTION_ENGINE_H
+
+#include <stdexcept>
+#include <vector>
+
+#include "environment.h"
+#include "instructions/staticSet.h"
+#include "program/line.h"
+#include "program/programExecutionEngine.h"
+
+namespace Program {
+    /**
+     * \brief ProgramExecutionEngine executing Program lines with the static
+     * dispatch of an Instructions::StaticSet.
+     *
+     * Instead of fetching operands as Data::UntypedSharedPtr and calling the
+     * virtual Instruction::execute() method, each Line is executed by calling
+     * the operation of its InlineInstruction with typed operands. Operands
+     * are read directly in the registers, the constants and the
+     * Data::ArrayWrapper data sources whenever possible.
+     *
+     * Results are identical to those of the ProgramExecutionEngine.
+     *
+     * Template parameters Instrs are the types of the InlineInstruction of the
+     * StaticSet.
+     */
+    template <typename... Instrs>
+    class StaticProgramExecutionEngine : public ProgramExecutionEngine
+    {
+      protected:
+        /// StaticSet used for executing the instructions.
+        const Instructions::StaticSet<Instrs...>& staticSet;
+
+        /// Index in the StaticSet of each Instruction of the Environment.
+        std::vector<size_t> staticIndexes;
+
+        /// Access to the data of each DataHandler of dataScsConstsAndRegs.
+        std::vector<typename Instructions::StaticSet<Instrs...>::DataAccess>
+            dataAccesses;
+
+        /// Operands of the executed Line.
+        std::vector<typename Instructions::StaticSet<Instrs...>::Operand>
+            staticOperands;
+
+        /**
+         * \brief Update the dataAccesses before executing a Program.
+         *
+         * Data sources, constants and their data may have changed since the
+         * last execution.
+         */
+        void refreshDataAccesses()
+        {
+            for (size_t i = 0; i < this->dataScsConstsAndRegs.size(); i++) {
+                const Data::DataHandler& handler =
+                    this->dataScsConstsAndRegs.at(i).get();
+                auto& access = this->dataAccesses.at(i);
+                if (access.handler != &handler) {
+                    Instructions::StaticSet<Instrs...>::initDataAccess(handler,
+                                                                      access);
+                }
+                Instructions::StaticSet<Instrs...>::refreshDataAccess(access);
+            }
+        }
+
+        /// Inherited from Program::ProgramExecutionEngine
+        virtual void executeValidatedProgram() override
+        {
+            this->refreshDataAccesses();
+            // Validated programs use the inline registers and constants.
+            // Registers are read directly by any instruction with a double
+            // operand, which all instructions reading registers have.
+            if (this->dataAccesses[0].elementType != nullptr) {
+                this->dataAccesses[0].data = this->registerValues;
+            }
+            if (this->nbConstants > 0 &&
+                this->dataAccesses[1].elementType != nullptr) {
+                this->dataAccesses[1].data = this->constantValues;
+            }
+            const ProgramValidation& validation = *this->validation;
+            for (const ValidatedLine& line : validation.lines) {
+                const size_t index = this->staticIndexes[line.instructionIndex];
+                const size_t nbOperands = line.instruction->getNbOperands();
+                for (size_t i = 0; i < nbOperands; i++) {
+                    const std::pair<uint64_t, uint64_t>& operand =
+                        validation.operands[line.firstOperand + i];
+                    this->staticOperands[i] = {
+                        &this->dataAccesses[operand.first], operand.second};
+                }
+
+                const double result =
+                    this->staticSet.execute(index, this->staticOperands.data());
+                this->registerValues[line.destinationIndex] = result;
+            }
+        }
+
+      public:
+        /**
+         * \brief Constructor of the class.
+         *
+         * \param[in] set the StaticSet used to build the Environment.
+         * \param[in] env The Environment in which the Program will be executed.
+         * \throws std::invalid_argument if an Instruction of the Environment
+         * is not owned by the StaticSet.
+         */
+        StaticProgramExecutionEngine(
+            const Instructions::StaticSet<Instrs...>& set,
+            const Environment& env)
+            : ProgramExecutionEngine(env), staticSet{set},
+              dataAccesses(dataScsConstsAndRegs.size()),
+              staticOperands(env.getMaxNbOperands())
+        {
+            const Instructions::Set& envSet = env.getInstructionSet();
+            for (size_t i = 0; i < envSet.getNbInstructions(); i++) {
+                size_t index = set.getStaticIndex(envSet.getInstruction(i));
+                if (index == set.getNbStaticInstructions()) {
+                    throw std::invalid_argument(
+                        "Instruction of the Environment is not part of the "
+                        "StaticSet.");
+                }
+                this->staticIndexes.push_back(index);
+            }
+        }
+
+        /// Inherited from Program::ProgramEngine
+        virtual void iterateThroughtProgram(
+            const bool ignoreException) override
+        {
+            this->refreshDataAccesses();
+            ProgramExecutionEngine::iterateThroughtProgram(ignoreException);
+        }
+
+        /// Inherited from Program::ProgramEngine
+        virtual void processLine() override
+        {
+            const Line& line = this->getCurrentLine();
+            const size_t index =
+                this->staticIndexes.at(line.getInstructionIndex());
+            const size_t nbOperands =
+                this->staticSet.getInstruction(index).getNbOperands();
+            for (size_t i = 0; i < nbOperands; i++) {
+                const std::pair<uint64_t, uint64_t>& operand =
+                    line.getOperand(i);
+                this->staticOperands[i] = {
+                    &this->dataAccesses.at(operand.first), operand.second};
+            }
+
+            const double result =
+                this->staticSet.execute(index, this->staticOperands.data());
+            this->registers.setDataAt(typeid(double),
+                                      line.getDestinationIndex(), result);
+        }
+    };
+} // namespace Program
+
+#endif // STATIC_PROGRAM_EXECUTION_ENGINE_H
@@ -234,7 +234,10 @@ namespace TPG {
          * \brief Analyze the execution statistics of multiple inferences
          * done with a TPGExecutionEngineInstrumented.
          *
-         * Previous results will be erased.
+         * Only the traces recorded by the TPGExecutionEngineInstrumented
+         * are analyzed, see
+         * TPGExecutionEngineInstrumented::setTraceRecording(). Previous
+         * results will be erased.
          *
          * \param[in] tee the TPGExecutionEngineInstrumented.
          * \param[in] graph the TPGGraph executed with tee.
@@ -0,0 +1,236 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef STREAMING_EXECUTION_STATS_H
+#define STREAMING_EXECUTION_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace TPG {
+    /**
+     * \brief Execution statistics aggregated online, in constant memory.
+     *
+     * Contrary to the ExecutionStats class, which analyzes the execution
+     * traces recorded by a TPGExecutionEngineInstrumented after the fact,
+     * this class is updated by the TPGExecutionEngineInstrumented at the end
+     * of each inference, when given to its setStreamingStats() method. No
+     * trace needs to be stored, so statistics of a deployed policy can be
+     * collected continuously, and read or exported at any time.
+     *
+     * Distributions are stored in histograms with a fixed number of bins of
+     * identical width. Bin i counts the inferences whose value is in
+     * [i * binWidth, (i + 1) * binWidth[, except for the last bin which also
+     * counts all larger values.
+     *
+     * An instance must not be updated by several threads concurrently. When
+     * several engines run in parallel, each should have its own instance,
+     * the instances being merged with operator+=.
+     */
+    class StreamingExecutionStats
+    {
+      protected:
+        /// Number of bins of the histograms.
+        size_t nbBins;
+
+        /// Width of the bins of the histograms.
+        uint64_t binWidth;
+
+        /// Number of aggregated inferences.
+        uint64_t nbInferences = 0;
+
+        /// Total number of evaluated teams.
+        uint64_t totalEvaluatedTeams = 0;
+
+        /// Total number of evaluated programs.
+        uint64_t totalEvaluatedPrograms = 0;
+
+        /// Total number of executed lines.
+        uint64_t totalExecutedLines = 0;
+
+        /// Total number of executions of each instruction.
+        std::vector<uint64_t> totalExecutionsPerInstruction;
+
+        /// Histogram of the number of evaluated teams per inference.
+        std::vector<uint64_t> histogramEvaluatedTeams;
+
+        /// Histogram of the number of evaluated programs per inference.
+        std::vector<uint64_t> histogramEvaluatedPrograms;
+
+        /// Histogram of the number of executed lines per inference.
+        std::vector<uint64_t> histogramExecutedLines;
+
+        /**
+         * \brief Histograms of the number of executions of each instruction
+         * per inference.
+         *
+         * As in ExecutionStats, only the inferences executing an instruction
+         * at least once are counted in its histogram.
+         */
+        std::vector<std::vector<uint64_t>> histogramExecutionsPerInstruction;
+
+        /// Get the bin of the histograms containing a value.
+        size_t getBin(uint64_t value) const;
+
+      public:
+        /**
+         * \brief Constructor.
+         *
+         * \param[in] nbInstructions the number of instructions of the
+         * Environment of the executed TPGGraph.
+         * \param[in] nbBins the number of bins of the histograms.
+         * \param[in] binWidth the width of the bins of the histograms.
+         * \throw std::invalid_argument if nbBins or binWidth is 0.
+         */
+        StreamingExecutionStats(size_t nbInstructions, size_t nbBins = 64,
+                                uint64_t binWidth = 1);
+
+        /**
+         * \brief Aggregate the statistics of one inference.
+         *
+         * \param[in] nbEvaluatedTeams the number of teams evaluated.
+         * \param[in] nbEvaluatedPrograms the number of programs evaluated.
+         * \param[in] nbExecutedLines the number of program lines executed.
+         * \param[in] nbExecutionsPerInstruction the number of executions of
+         * each instruction, indexed by instruction index.
+         * \throw std::invalid_argument if the size of
+         * nbExecutionsPerInstruction differs from the number of instructions.
+         */
+        void addInference(
+            uint64_t nbEvaluatedTeams, uint64_t nbEvaluatedPrograms,
+            uint64_t nbExecutedLines,
+            const std::vector<uint64_t>& nbExecutionsPerInstruction);
+
+        /**
+         * \brief Merge the statistics of another instance.
+         *
+         * \param[in] other the merged instance.
+         * \throw std::invalid_argument if the number of instructions, number
+         * of bins or bin width of the two instances differ.
+         */
+        StreamingExecutionStats& operator+=(
+            const StreamingExecutionStats& other);
+
+        /// Get the number of instructions.
+        size_t getNbInstructions() const;
+
+        /// Get the number of bins of the histograms.
+        size_t getNbBins() const;
+
+        /// Get the width of the bins of the histograms.
+        uint64_t getBinWidth() const;
+
+        /// Get the number of aggregated inferences.
+        uint64_t getNbInferences() const;
+
+        /// Get the average number of evaluated teams per inference, or 0
+        /// before the first inference.
+        double getAvgEvaluatedTeams() const;
+
+        /// Get the average number of programs evaluated per inference, or 0
+        /// before the first inference.
+        double getAvgEvaluatedPrograms() const;
+
+        /// Get the average number of executed lines per inference, or 0
+        /// before the first inference.
+        double getAvgExecutedLines() const;
+
+        /// Get the average number of executions per inference of each
+        /// instruction, indexed by instruction index. Averages are 0 before
+        /// the first inference.
+        std::vector<double> getAvgNbExecutionPerInstruction() const;
+
+        /// Get the histogram of the number of evaluated teams.
+        const std::vector<uint64_t>& getHistogramEvaluatedTeams() const;
+
+        /// Get the histogram of the number of evaluated programs.
+        const std::vector<uint64_t>& getHistogramEvaluatedPrograms() const;
+
+        /// Get the histogram of the number of executed lines.
+        const std::vector<uint64_t>& getHistogramExecutedLines() const;
+
+        /// Get the histograms of the number of executions of each
+        /// instruction, indexed by instruction index.
+        const std::vector<std::vector<uint64_t>>&
+        getHistogramNbExecutionPerInstruction() const;
+
+        /// Reset all statistics.
+        void clear();
+
+        /**
+         * \brief Export the current statistics to a file using Json format.
+         *
+         * Data is organized as in ExecutionStats::writeStatsToJson(), except
+         * that there are no trace statistics and that distributions are
+         * indexed by the first value of their non-empty bins:
+         *
+         *      {
+         *          "ExecutionStats" :
+         *          {
+         *              "nbInferences" : value,
+         *              "binWidth" : value,
+         *              "avgEvaluatedTeams" : value,
+         *              "avgEvaluatedPrograms" : value,
+         *              "avgExecutedLines" : value,
+         *              "avgNbExecutionPerInstruction" :
+         *              {
+         *                  "InstructionIndex" : nbExecution,
+         *                  ...
+         *              },
+         *              "distributionEvaluatedPrograms" :
+         *              {
+         *                  "N" : count of inferences in the bin starting
+         *                  at N,
+         *                  ...
+         *              },
+         *              "distributionEvaluatedTeams" : { ... },
+         *              "distributionExecutedLines" : { ... },
+         *              "distributionNbExecutionPerInstruction" :
+         *              {
+         *                  "InstructionIndex" : { "N" : count, ... },
+         *                  ...
+         *              }
+         *          }
+         *      }
+         *
+         * \param[in] filePath the path of the exported file.
+         * \param[in] noIndent if true, the file is written without
+         * indentation.
+         */
+        void writeStatsToJson(const char* filePath,
+                              bool noIndent = false) const;
+    };
+} // namespace TPG
+
+#endif // STREAMING_EXECUTION_STATS_H
@@ -53,6 +53,13 @@ namespace TPG {
         TPGActionInstrumented(const uint64_t id) : TPGAction(id)
         {
         }
+
+        /// Inherited from TPGVertex
+        virtual size_t getMemoryFootprint() const override
+        {
+            return sizeof(TPGActionInstrumented) +
+                   this->getEdgeListsFootprint();
+        }
     };
 } // namespace TPG
 
@@ -57,6 +57,9 @@ namespace TPG {
         {
         }
 
+        /// Inherited from TPGEdge
+        virtual size_t getMemoryFootprint() const override;
+
         /**
          * \brief Get the number of time a TPGEdge was visited.
          *
@@ -70,6 +73,14 @@ namespace TPG {
          */
         void incrementNbVisits() const;
 
+        /**
+         * \brief Add the given number to the number of visits for this
+         * TPGEdge.
+         *
+         * \param[in] nb the number of visits to add.
+         */
+        void addNbVisits(uint64_t nb) const;
+
         /**
          * \brief Get the number of time a TPGEdge was traversed.
          *
@@ -83,6 +94,14 @@ namespace TPG {
          */
         void incrementNbTraversal() const;
 
+        /**
+         * \brief Add the given number to the number of traversal for this
+         * TPGEdge.
+         *
+         * \param[in] nb the number of traversals to add.
+         */
+        void addNbTraversal(uint64_t nb) const;
+
         /**
          *  \brief Reset the instrumentation attributes.
          */
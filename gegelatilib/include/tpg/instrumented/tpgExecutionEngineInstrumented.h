@@ -37,25 +37,137 @@
 #ifndef TPG_EXECUTION_ENGINE_INSTRUMENTED_H
 #define TPG_EXECUTION_ENGINE_INSTRUMENTED_H
 
+#include <cstdint>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "archive.h"
+#include "mutator/rng.h"
 #include "program/programExecutionEngine.h"
 #include "tpg/tpgExecutionEngine.h"
 
+#include "tpg/instrumented/streamingExecutionStats.h"
 #include "tpg/tpgGraph.h"
 
 namespace TPG {
     /**
      * Specialization of the TPGExecutionEngine class.
+     *
+     * In addition to the inference, this engine updates the counters of the
+     * instrumented TPGVertex and TPGEdge of the executed TPGGraph, and
+     * records the execution traces.
+     *
+     * To keep the instrumentation enabled for long periods, the number of
+     * recorded traces can be bounded with setTraceRecording(), and counters
+     * can be accumulated within the engine with setCounterBuffering(), then
+     * merged in the TPGGraph on demand. Statistics can also be aggregated
+     * online, without recording traces, with setStreamingStats().
      */
     class TPGExecutionEngineInstrumented : public TPGExecutionEngine
     {
+      public:
+        /// Policies for selecting the execution traces to record.
+        enum TraceRecordingMode
+        {
+            /// All traces are recorded.
+            ALL,
+            /// No trace is recorded.
+            NONE,
+            /// One trace is recorded every N inferences.
+            EVERY_NTH,
+            /// A uniform random sample of N traces is kept, with reservoir
+            /// sampling.
+            RESERVOIR,
+            /// The N last traces are kept.
+            RING_BUFFER
+        };
+
       protected:
-        /// History of all previous execution traces. New traces are pushed
-        /// back.
-        std::vector<std::vector<const TPGVertex*>> traceHistory;
+        /// Current trace recording policy.
+        TraceRecordingMode traceMode = ALL;
+
+        /// Parameter N of the trace recording policy.
+        uint64_t traceParameter = 0;
+
+        /// Random number generator used for reservoir sampling.
+        Mutator::RNG traceRng;
+
+        /// Number of inferences since the trace history was cleared.
+        uint64_t nbInferences = 0;
+
+        /// Position of a recorded trace within the traceVertices.
+        typedef struct TraceSlot
+        {
+            /// Index of the first vertex of the trace.
+            uint64_t offset;
+            /// Number of vertices of the trace.
+            uint64_t length;
+        } TraceSlot;
+
+        /**
+         * \brief Vertices of all recorded traces, stored contiguously.
+         *
+         * Storing all traces in a single buffer avoids an allocation per
+         * trace. When recorded traces are replaced, their vertices are left
+         * in the buffer until the buffer is compacted.
+         */
+        std::vector<const TPGVertex*> traceVertices;
+
+        /// Recorded traces, in the traceVertices.
+        std::vector<TraceSlot> traceSlots;
+
+        /// Index of the oldest trace in traceSlots in RING_BUFFER mode.
+        uint64_t firstTraceSlot = 0;
+
+        /// Number of traceVertices belonging to recorded traces.
+        uint64_t nbLiveTraceVertices = 0;
+
+        /// Are counters accumulated within the engine.
+        bool counterBuffering = false;
+
+        /// Visits of TPGTeam and TPGAction not yet merged in the TPGGraph.
+        std::unordered_map<const TPGVertex*, uint64_t> pendingVertexVisits;
+
+        /// Visits and traversals of TPGEdge not yet merged in the TPGGraph.
+        std::unordered_map<const TPGEdge*, std::pair<uint64_t, uint64_t>>
+            pendingEdgeCounters;
+
+        /// Number of instructions of the Environment.
+        const size_t nbInstructions;
+
+        /// Statistics updated at the end of each inference, if any.
+        StreamingExecutionStats* streamingStats = nullptr;
+
+        /// Number of programs evaluated during the current inference.
+        uint64_t currentNbEvaluatedPrograms = 0;
+
+        /// Number of lines executed during the current inference.
+        uint64_t currentNbExecutedLines = 0;
+
+        /// Number of executions of each instruction during the current
+        /// inference.
+        std::vector<uint64_t> currentNbExecutionsPerInstruction;
+
+        /**
+         * \brief Record a trace according to the trace recording policy.
+         *
+         * \param[in] trace the trace of the last inference.
+         */
+        void recordTrace(const std::vector<const TPGVertex*>& trace);
+
+        /**
+         * \brief Store a trace in the given slot.
+         *
+         * \param[in] slot index of the slot in traceSlots, or
+         * traceSlots.size() to add a new slot.
+         * \param[in] trace the stored trace.
+         */
+        void storeTrace(size_t slot,
+                        const std::vector<const TPGVertex*>& trace);
+
+        /// Remove the vertices of replaced traces from the traceVertices.
+        void compactTraces();
 
       public:
         /**
@@ -70,7 +182,16 @@ namespace TPG {
          */
         TPGExecutionEngineInstrumented(const Environment& env,
                                        Archive* arch = NULL)
-            : TPGExecutionEngine(env, arch){};
+            : TPGExecutionEngine(env, arch),
+              nbInstructions{env.getNbInstructions()} {};
+
+        /**
+         * \brief Destructor.
+         *
+         * Buffered counters are flushed in the instrumented TPGGraph, which
+         * must therefore outlive the engine when counters are buffered.
+         */
+        ~TPGExecutionEngineInstrumented();
 
         /**
          * \brief Specialization of the evaluateEdge function.
@@ -95,17 +216,111 @@ namespace TPG {
          *
          * In addition to calling the executeFromRoot method from
          * TPGExecutionEngine, this specialization increments the number of
-         * visits of the reached TPGAction.
+         * visits of the reached TPGAction and records the trace according
+         * to the trace recording policy.
          */
         const std::vector<const TPGVertex*> executeFromRoot(
             const TPGVertex& root) override;
 
-        /// Get all previous execution traces.
-        const std::vector<std::vector<const TPGVertex*>>& getTraceHistory()
-            const;
+        /**
+         * \brief Set the policy for recording execution traces.
+         *
+         * The trace history is cleared.
+         *
+         * \param[in] mode the recording policy.
+         * \param[in] parameter the N parameter of EVERY_NTH, RESERVOIR and
+         * RING_BUFFER modes. Ignored for other modes.
+         * \param[in] seed the seed of the random number generator used in
+         * RESERVOIR mode.
+         * \throw std::invalid_argument if the parameter is 0 for a mode
+         * using it.
+         */
+        void setTraceRecording(TraceRecordingMode mode, uint64_t parameter = 0,
+                               uint64_t seed = 0);
+
+        /// Get the current trace recording policy.
+        TraceRecordingMode getTraceRecordingMode() const;
+
+        /**
+         * \brief Get the number of inferences since the last call to
+         * clearTraceHistory(), recorded or not.
+         */
+        uint64_t getNbInferences() const;
+
+        /// Get the number of recorded traces.
+        uint64_t getNbRecordedTraces() const;
+
+        /**
+         * \brief Get a recorded trace.
+         *
+         * In RING_BUFFER mode, traces are indexed from the oldest to the
+         * newest. In other modes, traces are indexed in their order of
+         * recording, except in RESERVOIR mode where a replaced trace takes
+         * the index of the trace it replaced.
+         *
+         * \param[in] idx the index of the trace.
+         * \throw std::out_of_range if idx is not lower than the number of
+         * recorded traces.
+         */
+        std::vector<const TPGVertex*> getTrace(uint64_t idx) const;
+
+        /// Get all recorded execution traces, indexed as in getTrace().
+        std::vector<std::vector<const TPGVertex*>> getTraceHistory() const;
 
         /// Clear the trace history from all previous execution trace.
         void clearTraceHistory();
+
+        /**
+         * \brief Add the estimated memory footprint of the engine to a
+         * MemoryUsage.
+         *
+         * The trace history is added to the traces component, and the
+         * buffered counters to the caches component.
+         *
+         * \param[in,out] usage the MemoryUsage to update.
+         */
+        void addMemoryUsage(Util::MemoryUsage& usage) const;
+
+        /**
+         * \brief Enable or disable the buffering of counters.
+         *
+         * When enabled, visit and traversal counters are accumulated within
+         * the engine, without atomic operations nor dynamic_cast, and only
+         * merged in the instrumented TPGGraph by flushCounters(). This is
+         * useful when several engines execute the same TPGGraph in
+         * parallel. Disabling the buffering, or destroying the engine,
+         * flushes the counters.
+         *
+         * \param[in] enabled whether counters are buffered.
+         */
+        void setCounterBuffering(bool enabled);
+
+        /**
+         * \brief Merge the buffered counters in the instrumented TPGGraph.
+         *
+         * Must be called before reading the counters of the TPGGraph, and
+         * before any vertex or edge with buffered counters is removed from
+         * its TPGGraph.
+         *
+         * \throw std::bad_cast if the executed TPGGraph contains a non
+         * instrumented vertex or edge.
+         */
+        void flushCounters();
+
+        /**
+         * \brief Set the statistics updated at the end of each inference.
+         *
+         * Statistics are computed while the TPGGraph is executed, with the
+         * same definitions as in ExecutionStats::analyzeInferenceTrace().
+         *
+         * \param[in] stats pointer to the updated statistics, or nullptr to
+         * stop updating statistics. The pointed object must outlive its use
+         * by the engine, and must be built for the number of instructions of
+         * the Environment.
+         * \throw std::invalid_argument if the statistics do not have the
+         * number of instructions of the Environment.
+         */
+        void setStreamingStats(StreamingExecutionStats* stats);
     };
 }; // namespace TPG
 
@@ -47,6 +47,12 @@ namespace TPG {
     class TPGTeamInstrumented : public TPG::TPGTeam,
                                 public TPG::TPGVertexInstrumentation
     {
+      public:
+        /// Inherited from TPGVertex
+        virtual size_t getMemoryFootprint() const override
+        {
+            return sizeof(TPGTeamInstrumented) + this->getEdgeListsFootprint();
+        }
     };
 } // namespace TPG
 
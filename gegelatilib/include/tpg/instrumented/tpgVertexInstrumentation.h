@@ -58,6 +58,14 @@ namespace TPG {
          */
         void incrementNbVisits() const;
 
+        /**
+         * \brief Add the given number to the number of visits for this
+         * TPGVertexInstrumented.
+         *
+         * \param[in] nb the number of visits to add.
+         */
+        void addNbVisits(uint64_t nb) const;
+
         /**
          *  \brief Reset the instrumentation attributes.
          */
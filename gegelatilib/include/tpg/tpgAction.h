@@ -75,6 +75,9 @@ namespace TPG {
          */
         virtual void addOutgoingEdge(TPGEdge* edge);
 
+        /// Inherited from TPGVertex
+        virtual size_t getMemoryFootprint() const override;
+
         /**
          * \brief Get the action ID associated to the TPGAction.
          *
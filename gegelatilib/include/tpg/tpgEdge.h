@@ -97,6 +97,16 @@ namespace TPG {
          */
         std::shared_ptr<Program::Program> getProgramSharedPointer();
 
+        /**
+         * \brief Get the estimated memory footprint of the TPGEdge.
+         *
+         * The Program of the TPGEdge, which may be shared with other TPGEdge,
+         * is not included.
+         *
+         * \return the footprint in bytes.
+         */
+        virtual size_t getMemoryFootprint() const;
+
         /**
          * \brief Get the source TPGVertex of the TPGEdge.
          *
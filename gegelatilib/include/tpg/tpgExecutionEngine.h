@@ -45,6 +45,10 @@
 
 #include "tpg/tpgGraph.h"
 
+#ifdef NATIVE_BACKEND
+#include "codeGen/nativeBackend.h"
+#endif // NATIVE_BACKEND
+
 namespace TPG {
     /**
      * Class in charge of executing a TPGGraph.
@@ -68,6 +72,44 @@ namespace TPG {
          */
         Program::ProgramExecutionEngine progExecutionEngine;
 
+#ifdef NATIVE_BACKEND
+        /// Backend providing native functions for compiled Program, if any.
+        const CodeGen::NativeBackend* nativeBackend = nullptr;
+
+        /// Pointers to the data sources given to native functions.
+        std::vector<const void*> nativeDataPointers;
+
+        /// Can the data sources be given to native functions.
+        bool isNativeDataSupported = false;
+
+        /// Snapshot of the native functions of the nativeBackend.
+        std::shared_ptr<const CodeGen::NativeBackend::NativeFunctionMap>
+            nativeFunctions;
+
+        /// Version of the nativeFunctions snapshot.
+        uint64_t nativeFunctionsVersion = 0;
+
+        /**
+         * \brief Resolve the nativeDataPointers of the current data sources.
+         *
+         * Pointers are resolved once per inference in executeFromRoot(),
+         * rather than for each executed Program, since the storage of the
+         * data sources may be replaced between two inferences, for example
+         * with Data::ArrayWrapper::setPointer().
+         */
+        void updateNativeDataPointers();
+
+        /**
+         * \brief Get the native function of a Program from the snapshot of
+         * the nativeBackend, refreshed when a new version is published.
+         *
+         * \return the native function, or nullptr if the Program must be
+         * interpreted.
+         */
+        CodeGen::NativeBackend::NativeFunction getNativeFunction(
+            const Program::Program& prog);
+#endif // NATIVE_BACKEND
+
       public:
         /**
          * \brief Main constructor of the class.
@@ -79,8 +121,7 @@ namespace TPG {
          *                 given, meaning that no recording of the execution
          *                 will be made.
          */
-        TPGExecutionEngine(const Environment& env, Archive* arch = NULL)
-            : progExecutionEngine(env), archive{arch} {};
+        TPGExecutionEngine(const Environment& env, Archive* arch = NULL);
 
         ///  Default virtual destructor
         virtual ~TPGExecutionEngine() = default;
@@ -92,6 +133,37 @@ namespace TPG {
          */
         void setArchive(Archive* newArchive);
 
+        /**
+         * \brief Set the data sources on which Program are executed.
+         *
+         * By default, Program are executed on the data sources of the
+         * Environment given to the constructor.
+         *
+         * \param[in] dataSrc the new data sources, which must have the same
+         * types as those of the Environment.
+         * \throw std::runtime_error if the number of data sources differs
+         * from the Environment.
+         */
+        void setDataSources(
+            const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+                dataSrc);
+
+#ifdef NATIVE_BACKEND
+        /**
+         * \brief Set a NativeBackend for executing compiled Program.
+         *
+         * Program for which the NativeBackend provides a native function are
+         * executed with it, other Program are still interpreted.
+         *
+         * The address of the storage of the data sources is resolved when
+         * they are set, so a data source whose storage is reallocated must be
+         * set again with setDataSources().
+         *
+         * \param[in] backend A pointer (possibly NULL) to a NativeBackend.
+         */
+        void setNativeBackend(const CodeGen::NativeBackend* backend);
+#endif // NATIVE_BACKEND
+
         /**
          * \brief Execute the Program associated to an Edge and returns the
          * obtained double.
@@ -38,6 +38,7 @@
 #define TPG_GRAPH_H
 
 #include <list>
+#include <memory>
 
 #include "environment.h"
 #include "tpg/tpgAction.h"
@@ -45,6 +46,7 @@
 #include "tpg/tpgFactory.h"
 #include "tpg/tpgTeam.h"
 #include "tpg/tpgVertex.h"
+#include "util/memoryUsage.h"
 
 namespace TPG {
     /**
@@ -211,6 +213,26 @@ namespace TPG {
          */
         const TPGVertex& cloneVertex(const TPGVertex& vertex);
 
+        /**
+         * \brief Copy a TPGVertex of another TPGGraph and all the TPGVertex
+         * reachable from it into this TPGGraph.
+         *
+         * A new TPGTeam is created for each TPGTeam of the copied subgraph.
+         * TPGAction are not duplicated: the first TPGAction of this TPGGraph
+         * with the same action identifier is used, and a new TPGAction is
+         * only created if none exists. Program of the copied TPGEdge are
+         * duplicated within the Environment of this TPGGraph, and Program
+         * shared by several TPGEdge of the subgraph remain shared in the
+         * copy. The order of outgoing TPGEdge of each TPGTeam is preserved.
+         *
+         * \param[in] root the const reference to the TPGVertex of another
+         * TPGGraph from which the copy starts.
+         * \return a const reference to the copy of the given TPGVertex.
+         * \throw std::runtime_error if the Environment of the copied
+         * Program is not compatible with the one of this TPGGraph.
+         */
+        const TPGVertex& importSubGraph(const TPGVertex& root);
+
         /**
          * \brief Add a new TPGEdge to the TPGGraph.
          *
@@ -301,6 +323,18 @@ namespace TPG {
          */
         void clearProgramIntrons();
 
+        /**
+         * \brief Add the estimated memory footprint of the TPGGraph to a
+         * MemoryUsage.
+         *
+         * The TPGGraph and its TPGVertex are added to the vertices component,
+         * and its TPGEdge to the edges component. Each Program referenced by
+         * the TPGEdge is added once, even when shared by several TPGEdge.
+         *
+         * \param[in,out] usage the MemoryUsage to update.
+         */
+        void addMemoryUsage(Util::MemoryUsage& usage) const;
+
       protected:
         /// Environment of the TPGGraph
         const Environment& env;
@@ -340,6 +374,17 @@ namespace TPG {
          */
         std::list<std::unique_ptr<TPGEdge>>::iterator findEdge(
             const TPGEdge* edge);
+
+        /**
+         * \brief Duplicate a Program within the Environment of the TPGGraph.
+         *
+         * \param[in] program the const reference to the copied Program.
+         * \return a shared pointer to the new Program.
+         * \throw std::runtime_error if the Environment of the Program is not
+         * compatible with the one of the TPGGraph.
+         */
+        std::shared_ptr<Program::Program> importProgram(
+            const Program::Program& program) const;
     };
 }; // namespace TPG
 
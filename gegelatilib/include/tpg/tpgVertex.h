@@ -36,6 +36,7 @@
 #ifndef TPG_VERTEX_H
 #define TPG_VERTEX_H
 
+#include <cstddef>
 #include <list>
 
 namespace TPG {
@@ -109,7 +110,21 @@ namespace TPG {
          */
         virtual void removeOutgoingEdge(TPG::TPGEdge* edge);
 
+        /**
+         * \brief Get the estimated memory footprint of the TPGVertex.
+         *
+         * Default implementation returns the size of the TPGVertex class and
+         * of its lists of edges. Classes adding attributes should override
+         * this method.
+         *
+         * \return the footprint in bytes.
+         */
+        virtual size_t getMemoryFootprint() const;
+
       protected:
+        /// Get the estimated footprint of the lists of edges, in bytes.
+        size_t getEdgeListsFootprint() const;
+
         /**
          * \brief Protected default constructor to forbid the instanciation of
          * object of this abstract class.
@@ -0,0 +1,110 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+#include <utility>
+
+namespace Util {
+    /**
+     * \brief Estimated memory footprint, in bytes, of the components of a
+     * learning process.
+     *
+     * Footprints are estimated from the size of objects and the capacity of
+     * their containers. Overheads of the memory allocator are not included,
+     * and nodes of standard containers are assumed to have the layout of
+     * common standard library implementations.
+     */
+    struct MemoryUsage
+    {
+        /// TPGGraph and TPGVertex objects, with their lists of edges.
+        size_t vertices = 0;
+
+        /// TPGEdge objects.
+        size_t edges = 0;
+
+        /// Program objects and their tables of lines.
+        size_t programs = 0;
+
+        /// Line objects, with their operands.
+        size_t lines = 0;
+
+        /// Constants of the Program objects.
+        size_t constants = 0;
+
+        /// Archive object and its ArchiveRecording.
+        size_t archiveRecordings = 0;
+
+        /// Copies of DataHandler observations stored in the Archive.
+        size_t archiveDataHandlers = 0;
+
+        /// Cached evaluation results.
+        size_t caches = 0;
+
+        /// Execution traces recorded by instrumented engines.
+        size_t traces = 0;
+
+        /// Get the sum of all components.
+        size_t getTotal() const;
+
+        /**
+         * \brief Add the components of another MemoryUsage to this one.
+         *
+         * \param[in] other MemoryUsage whose components are added.
+         * \return a reference to this MemoryUsage.
+         */
+        MemoryUsage& operator+=(const MemoryUsage& other);
+    };
+
+    /// Estimated size of a node of a std::list holding T elements.
+    template <class T> constexpr size_t getListNodeSize()
+    {
+        return 2 * sizeof(void*) + sizeof(T);
+    }
+
+    /// Estimated size of a node of a std::map from K to V.
+    template <class K, class V> constexpr size_t getMapNodeSize()
+    {
+        return 4 * sizeof(void*) + sizeof(std::pair<const K, V>);
+    }
+
+    /// Estimated size of an object of type T owned by a std::shared_ptr.
+    template <class T> constexpr size_t getSharedObjectSize()
+    {
+        return 2 * sizeof(long) + sizeof(void*) + sizeof(T);
+    }
+} // namespace Util
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Util {
+    /**
+     * \brief Low-overhead profiler recording timed spans per thread.
+     *
+     * When enabled, each Profiler::Span records its start time and duration
+     * into a buffer private to the calling thread, so that no lock is taken
+     * on the recording path. When disabled (the default), constructing a Span
+     * costs a single atomic load.
+     *
+     * Thread buffers are attached to numbered lanes. A lane is released when
+     * its thread terminates and is reused by the next thread recording spans,
+     * so the short-lived worker threads created at each generation by the
+     * ParallelLearningAgent do not multiply the number of lanes.
+     *
+     * Recorded spans can be exported in the Chrome trace-event JSON format
+     * (viewable in chrome://tracing or Perfetto), and summarized into a
+     * per-lane utilization report.
+     *
+     * Export and clear methods must be called while no profiled code is
+     * running in other threads.
+     */
+    class Profiler
+    {
+      public:
+        /**
+         * \brief Span recorded by the Profiler.
+         *
+         * Times are expressed in nanoseconds since the Profiler epoch, which
+         * is reset by enable() (when previously disabled) and clear().
+         */
+        struct Event
+        {
+            /// Name of the span, must be a static string.
+            const char* name;
+
+            /// Category of the span, must be a static string.
+            const char* category;
+
+            /// Start time of the span.
+            uint64_t start;
+
+            /// Duration of the span.
+            uint64_t duration;
+
+            /// Nesting depth of the span within its thread.
+            uint32_t depth;
+        };
+
+        /**
+         * \brief Utilization summary of a lane.
+         *
+         * The busy time is the cumulated duration of the top-level spans of
+         * the lane, nested spans being already accounted for by their
+         * parent. All times are expressed in nanoseconds.
+         */
+        struct LaneUtilization
+        {
+            /// Index of the lane.
+            size_t lane;
+
+            /// Cumulated duration of the top-level spans.
+            uint64_t busyTime;
+
+            /// Duration of the profiled period.
+            uint64_t profiledTime;
+
+            /// Cumulated duration of spans, per span name.
+            std::map<std::string, uint64_t> timePerSpan;
+
+            /// Number of spans, per span name.
+            std::map<std::string, uint64_t> nbSpans;
+
+            /// Ratio of busyTime over profiledTime.
+            double getUtilization() const;
+        };
+
+        /**
+         * \brief RAII object recording a span for its whole lifetime.
+         *
+         * Nothing is recorded if the Profiler is disabled when the Span is
+         * constructed.
+         */
+        class Span
+        {
+          public:
+            /**
+             * \brief Start a span.
+             *
+             * \param[in] name name of the span. The pointer is kept as is,
+             * hence a string literal should be used.
+             * \param[in] category category of the span. The pointer is kept
+             * as is, hence a string literal should be used.
+             */
+            Span(const char* name, const char* category = "gegelati");
+
+            /// Deleted copy constructor.
+            Span(const Span&) = delete;
+
+            /// Deleted copy assignment.
+            Span& operator=(const Span&) = delete;
+
+            /// End the span and record it (if the Profiler was enabled).
+            ~Span();
+
+          private:
+            /// Name of the span.
+            const char* name;
+
+            /// Category of the span.
+            const char* category;
+
+            /// Start time of the span, or UINT64_MAX if not recorded.
+            uint64_t start;
+        };
+
+        /// Deleted constructor: the Profiler only has static members.
+        Profiler() = delete;
+
+        /**
+         * \brief Start recording spans.
+         *
+         * If the Profiler was disabled, the epoch is reset to the current
+         * time. Previously recorded spans are kept.
+         */
+        static void enable();
+
+        /// Stop recording spans.
+        static void disable();
+
+        /// Check whether spans are currently recorded.
+        static bool isEnabled();
+
+        /// Discard all recorded spans and reset the epoch.
+        static void clear();
+
+        /// Get the number of lanes created so far.
+        static size_t getNbLanes();
+
+        /**
+         * \brief Get a copy of the spans recorded in a lane.
+         *
+         * \param[in] lane index of the lane.
+         * \throw std::out_of_range if the lane does not exist.
+         */
+        static std::vector<Event> getEvents(size_t lane);
+
+        /**
+         * \brief Compute the utilization summary of all lanes.
+         *
+         * The profiled period goes from the epoch to the last call to
+         * disable(), or to the current time if the Profiler is enabled.
+         */
+        static std::vector<LaneUtilization> getUtilizationSummary();
+
+        /**
+         * \brief Write the recorded spans in Chrome trace-event format.
+         *
+         * Each span is written as a complete ("X") event, with one thread
+         * per lane.
+         *
+         * \param[in] filePath path of the written JSON file.
+         * \throw std::runtime_error if the file cannot be opened.
+         */
+        static void writeChromeTrace(const std::string& filePath);
+
+        /**
+         * \brief Write a human-readable utilization summary.
+         *
+         * \param[in] out stream where the summary is written.
+         */
+        static void writeUtilizationSummary(std::ostream& out);
+    };
+} // namespace Util
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef TRAINING_LOOP_H
+#define TRAINING_LOOP_H
+
+#include <cstdint>
+#include <functional>
+
+namespace Util {
+    /**
+     * \brief Train generations until all are trained or training is alted.
+     *
+     * Shared by the learning agents to train their generations and print
+     * their progress bar.
+     *
+     * \param[in] trainOneGeneration function training the generation whose
+     * number is given as an argument.
+     * \param[in] nbGenerations number of generations to train.
+     * \param[in] altTraining a reference to a boolean value that can be
+     * used to halt the training process before its completion.
+     * \param[in] printProgressBar select whether a progress bar is printed
+     * in the console.
+     * \return the number of trained generations.
+     */
+    uint64_t trainGenerations(
+        const std::function<void(uint64_t)>& trainOneGeneration,
+        uint64_t nbGenerations, volatile bool& altTraining,
+        bool printProgressBar);
+
+} // namespace Util
+
+#endif
@@ -226,3 +226,28 @@ void Archive::clear()
     this->recordings.clear();
     this->recordingsPerProgram.clear();
 }
+
+void Archive::addMemoryUsage(Util::MemoryUsage& usage) const
+{
+    typedef std::vector<std::reference_wrapper<const Data::DataHandler>>
+        DataHandlers;
+
+    // Recordings are stored twice: in the deque of recordings and in the
+    // per-program deques.
+    usage.archiveRecordings +=
+        sizeof(Archive) +
+        2 * this->recordings.size() * sizeof(ArchiveRecording) +
+        this->recordingsPerProgram.size() *
+            Util::getMapNodeSize<const Program::Program*,
+                                 std::deque<ArchiveRecording>>();
+
+    for (const auto& hashAndDataHandlers : this->dataHandlers) {
+        usage.archiveDataHandlers +=
+            Util::getMapNodeSize<size_t, DataHandlers>() +
+            hashAndDataHandlers.second.capacity() *
+                sizeof(std::reference_wrapper<const Data::DataHandler>);
+        for (const Data::DataHandler& dHandler : hashAndDataHandlers.second) {
+            usage.archiveDataHandlers += dHandler.getMemoryFootprint();
+        }
+    }
+}
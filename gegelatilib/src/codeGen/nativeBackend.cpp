@@ -0,0 +1,386 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifdef NATIVE_BACKEND
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "codeGen/generationParameters.h"
+#include "codeGen/programGenerationEngine.h"
+#include "tpg/tpgEdge.h"
+
+#include "codeGen/nativeBackend.h"
+
+/// Can the code of all lines of the Program be generated.
+static bool isPrintable(const Program::Program& prog)
+{
+    const Instructions::Set& set = prog.getEnvironment().getInstructionSet();
+    for (uint64_t i = 0; i < prog.getNbLines(); i++) {
+        const Program::Line& line = prog.getLine(i);
+        if (line.getInstructionIndex() >= set.getNbInstructions() ||
+            !set.getInstruction(line.getInstructionIndex()).isPrintable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Get the address of the first element of a DataHandler storing T.
+ *
+ * Only the storage of the DataHandler is given to native functions, never a
+ * copy of its data, so ptr is nullptr for DataHandler without a direct
+ * Data::DataHandler::ScalarAccess to their data.
+ *
+ * \return false if T is not the native type of the DataHandler.
+ */
+template <typename T>
+static bool getPointer(const Data::DataHandler& data, const void*& ptr)
+{
+    if (data.getNativeType() != typeid(T)) {
+        return false;
+    }
+    Data::DataHandler::ScalarAccess access = data.getScalarAccess();
+    ptr = (access.type != nullptr && *access.type == typeid(T)) ? access.data
+                                                               : nullptr;
+    return true;
+}
+
+CodeGen::NativeBackend::NativeBackend(const Environment& env,
+                                      uint64_t minNbGenerations,
+                                      const std::string& compilerCommand)
+    : minNbGenerations{minNbGenerations}, compilerCommand{compilerCommand},
+      nativeFunctions{std::make_shared<const NativeFunctionMap>()}
+{
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources;
+    for (const auto& data : env.getDataSources()) {
+        this->privateDataSources.emplace_back(data.get().clone());
+        dataSources.emplace_back(*this->privateDataSources.back());
+    }
+    this->env = std::make_unique<Environment>(
+        env.getInstructionSet(), dataSources, env.getNbRegisters(),
+        env.getNbConstant());
+
+    const char* tmpDir = std::getenv("TMPDIR");
+    std::string pattern = (tmpDir != nullptr && tmpDir[0] != '\0')
+                              ? std::string(tmpDir)
+                              : std::string("/tmp");
+    pattern += "/gegelatiNativeXXXXXX";
+    std::vector<char> dirName(pattern.begin(), pattern.end());
+    dirName.push_back('\0');
+    if (mkdtemp(dirName.data()) == nullptr) {
+        throw std::runtime_error("Could not create a directory for the "
+                                 "native code of Program.");
+    }
+    this->workDir = std::string(dirName.data()) + "/";
+
+    // Headers needed by the print templates of usual instructions.
+    std::ofstream header(this->workDir + "externHeader.h");
+    header << "#include <math.h>\n"
+           << "#include <float.h>\n"
+           << "#include <stdint.h>" << std::endl;
+    header.close();
+
+    this->worker = std::thread(&NativeBackend::workerLoop, this);
+}
+
+CodeGen::NativeBackend::~NativeBackend()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->jobsMutex);
+        this->stop = true;
+    }
+    this->jobsCondition.notify_all();
+    this->worker.join();
+
+    for (void* library : this->libraries) {
+        dlclose(library);
+    }
+    std::remove((this->workDir + "externHeader.h").c_str());
+    rmdir(this->workDir.c_str());
+}
+
+void CodeGen::NativeBackend::update(const TPG::TPGGraph& graph)
+{
+    std::vector<std::shared_ptr<Program::Program>> job;
+    {
+        std::unique_lock<std::shared_mutex> lock(this->mutex);
+
+        std::set<const Program::Program*> present;
+        for (const auto& edge : graph.getEdges()) {
+            std::shared_ptr<Program::Program> prog =
+                edge->getProgramSharedPointer();
+            if (!present.insert(prog.get()).second) {
+                continue;
+            }
+            TrackedProgram& trackedProg = this->tracked[prog.get()];
+            trackedProg.program = prog;
+            trackedProg.nbGenerations++;
+            if (!trackedProg.submitted &&
+                trackedProg.nbGenerations >= this->minNbGenerations) {
+                trackedProg.submitted = true;
+                job.push_back(prog);
+            }
+        }
+
+        // Release the Program that are no longer in the graph.
+        std::shared_ptr<NativeFunctionMap> functions;
+        for (auto iter = this->tracked.begin(); iter != this->tracked.end();) {
+            if (present.count(iter->first) == 0) {
+                if (this->nativeFunctions->count(iter->first) != 0) {
+                    if (functions == nullptr) {
+                        functions = std::make_shared<NativeFunctionMap>(
+                            *this->nativeFunctions);
+                    }
+                    functions->erase(iter->first);
+                }
+                iter = this->tracked.erase(iter);
+            }
+            else {
+                iter++;
+            }
+        }
+        if (functions != nullptr) {
+            this->publishNativeFunctions(std::move(functions));
+        }
+    }
+
+    if (!job.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(this->jobsMutex);
+            this->jobs.push(std::move(job));
+        }
+        this->jobsCondition.notify_all();
+    }
+}
+
+void CodeGen::NativeBackend::publishNativeFunctions(
+    std::shared_ptr<const NativeFunctionMap> functions)
+{
+    std::atomic_store(&this->nativeFunctions, std::move(functions));
+    this->nativeFunctionsVersion++;
+}
+
+CodeGen::NativeBackend::NativeFunction CodeGen::NativeBackend::
+    getNativeFunction(const Program::Program& prog) const
+{
+    std::shared_ptr<const NativeFunctionMap> functions =
+        this->getNativeFunctions();
+    auto iter = functions->find(&prog);
+    return (iter != functions->end()) ? iter->second : nullptr;
+}
+
+std::shared_ptr<const CodeGen::NativeBackend::NativeFunctionMap> CodeGen::
+    NativeBackend::getNativeFunctions() const
+{
+    return std::atomic_load(&this->nativeFunctions);
+}
+
+uint64_t CodeGen::NativeBackend::getNativeFunctionsVersion() const
+{
+    return this->nativeFunctionsVersion;
+}
+
+void CodeGen::NativeBackend::waitForCompilations()
+{
+    std::unique_lock<std::mutex> lock(this->jobsMutex);
+    this->jobsCondition.wait(
+        lock, [this] { return this->jobs.empty() && !this->busy; });
+}
+
+size_t CodeGen::NativeBackend::getNbNativePrograms() const
+{
+    return this->getNativeFunctions()->size();
+}
+
+size_t CodeGen::NativeBackend::getNbCompilations()
+{
+    std::lock_guard<std::mutex> lock(this->jobsMutex);
+    return this->nbCompilations;
+}
+
+size_t CodeGen::NativeBackend::getNbFailures()
+{
+    std::lock_guard<std::mutex> lock(this->jobsMutex);
+    return this->nbFailures;
+}
+
+bool CodeGen::NativeBackend::getDataPointers(
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+        dataSources,
+    std::vector<const void*>& pointers)
+{
+    pointers.resize(dataSources.size());
+    for (size_t i = 0; i < dataSources.size(); i++) {
+        const Data::DataHandler& data = dataSources.at(i).get();
+        const void*& ptr = pointers.at(i);
+        try {
+            if (!(getPointer<double>(data, ptr) ||
+                  getPointer<float>(data, ptr) ||
+                  getPointer<int32_t>(data, ptr) ||
+                  getPointer<uint32_t>(data, ptr) ||
+                  getPointer<int64_t>(data, ptr) ||
+                  getPointer<uint64_t>(data, ptr) ||
+                  getPointer<int16_t>(data, ptr) ||
+                  getPointer<uint16_t>(data, ptr) ||
+                  getPointer<int8_t>(data, ptr) ||
+                  getPointer<uint8_t>(data, ptr) ||
+                  getPointer<char>(data, ptr) ||
+                  getPointer<bool>(data, ptr)) ||
+                ptr == nullptr) {
+                return false;
+            }
+        }
+        catch (std::exception&) {
+            // The DataHandler does not give access to its storage.
+            return false;
+        }
+    }
+    return true;
+}
+
+void CodeGen::NativeBackend::workerLoop()
+{
+    size_t libIdx = 0;
+    while (true) {
+        std::vector<std::shared_ptr<Program::Program>> job;
+        {
+            std::unique_lock<std::mutex> lock(this->jobsMutex);
+            this->jobsCondition.wait(
+                lock, [this] { return this->stop || !this->jobs.empty(); });
+            if (this->stop) {
+                return;
+            }
+            job = std::move(this->jobs.front());
+            this->jobs.pop();
+            this->busy = true;
+        }
+
+        compile(job, libIdx++);
+
+        {
+            std::lock_guard<std::mutex> lock(this->jobsMutex);
+            this->busy = false;
+        }
+        this->jobsCondition.notify_all();
+    }
+}
+
+void CodeGen::NativeBackend::compile(
+    const std::vector<std::shared_ptr<Program::Program>>& programs,
+    size_t libIdx)
+{
+    const std::string name = "native" + std::to_string(libIdx);
+    const std::string path = this->workDir + name;
+
+    // Generate the reentrant code of the programs.
+    std::vector<std::shared_ptr<Program::Program>> compiled;
+    {
+        GenerationParameters params;
+        params.reentrant = true;
+        ProgramGenerationEngine progGen(name + "_program", *this->env,
+                                        this->workDir, params);
+        for (const auto& prog : programs) {
+            if (!isPrintable(*prog)) {
+                continue;
+            }
+            progGen.setProgram(*prog);
+            progGen.generateProgram(compiled.size());
+            compiled.push_back(prog);
+        }
+    }
+
+    // Entry points giving each data source to the Context of programs.
+    std::ofstream entries(path + ".c");
+    entries << "#include \"" << name << "_program.h\"" << std::endl;
+    for (size_t i = 0; i < compiled.size(); i++) {
+        entries << "\ndouble " << name << "P" << i
+                << "(const void* const* data){\n"
+                << "\tContext ctx;\n";
+        for (size_t d = 0; d < this->env->getDataSources().size(); d++) {
+            entries << "\tctx.in" << d + 1 << " = data[" << d << "];\n";
+        }
+        entries << "\treturn P" << i << "(&ctx);\n"
+                << "}" << std::endl;
+    }
+    entries.close();
+
+    void* library = nullptr;
+    if (!compiled.empty()) {
+        std::string cmd = this->compilerCommand + " -I\"" + this->workDir +
+                          "\" -o \"" + path + ".so\" \"" + path +
+                          "_program.c\" \"" + path + ".c\" -lm > \"" + path +
+                          ".log\" 2>&1";
+        if (std::system(cmd.c_str()) == 0) {
+            library = dlopen((path + ".so").c_str(), RTLD_NOW | RTLD_LOCAL);
+        }
+    }
+    // The loaded shared object remains mapped once its file is removed.
+    for (const char* ext : {"_program.c", "_program.h", ".c", ".so", ".log"}) {
+        std::remove((path + ext).c_str());
+    }
+
+    size_t nbLoaded = 0;
+    if (library != nullptr) {
+        this->libraries.push_back(library);
+        std::unique_lock<std::shared_mutex> lock(this->mutex);
+        auto functions =
+            std::make_shared<NativeFunctionMap>(*this->nativeFunctions);
+        for (size_t i = 0; i < compiled.size(); i++) {
+            std::string symbol = name + "P" + std::to_string(i);
+            auto function = (NativeFunction)dlsym(library, symbol.c_str());
+            // Program removed from the graph during the compilation are not
+            // published: their address may be reused by a new Program.
+            auto iter = this->tracked.find(compiled.at(i).get());
+            if (function != nullptr && iter != this->tracked.end() &&
+                iter->second.program == compiled.at(i)) {
+                (*functions)[compiled.at(i).get()] = function;
+            }
+            nbLoaded += (function != nullptr) ? 1 : 0;
+        }
+        this->publishNativeFunctions(std::move(functions));
+    }
+
+    std::lock_guard<std::mutex> lock(this->jobsMutex);
+    this->nbCompilations += (library != nullptr) ? 1 : 0;
+    this->nbFailures += programs.size() - nbLoaded;
+}
+
+#endif // NATIVE_BACKEND
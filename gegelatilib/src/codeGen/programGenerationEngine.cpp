@@ -41,8 +41,13 @@
 const std::regex CodeGen::ProgramGenerationEngine::operand_regex("(\\$[0-9]*)");
 const std::string CodeGen::ProgramGenerationEngine::nameRegVariable("reg");
 const std::string CodeGen::ProgramGenerationEngine::nameConstantVariable("cst");
+const std::regex CodeGen::ProgramGenerationEngine::constant_regex(
+    nameConstantVariable + "\\[([0-9]+)\\]");
 const std::string CodeGen::ProgramGenerationEngine::nameDataVariable("in");
 const std::string CodeGen::ProgramGenerationEngine::nameOperandVariable("op");
+const std::string CodeGen::ProgramGenerationEngine::nameContextVariable("ctx");
+const std::string CodeGen::ProgramGenerationEngine::nameObservationVariable(
+    "obs");
 
 void CodeGen::ProgramGenerationEngine::generateCurrentLine()
 {
@@ -50,12 +55,12 @@ void CodeGen::ProgramGenerationEngine::generateCurrentLine()
         this->getCurrentInstruction();
 
     if (instruction.isPrintable()) {
-        fileC << "\t{" << std::endl;
+        fileC << lineIndent << "{" << std::endl;
         initOperandCurrentLine();
         std::string codeLine = completeFormat(instruction);
         // init
-        fileC << "\t\t" << codeLine << "\n"
-              << "\t}" << std::endl;
+        fileC << lineIndent << "\t" << codeLine << "\n"
+              << lineIndent << "}" << std::endl;
     }
     else {
         throw std::runtime_error("The instruction is not printable, stop the "
@@ -66,31 +71,47 @@ void CodeGen::ProgramGenerationEngine::generateCurrentLine()
 void CodeGen::ProgramGenerationEngine::generateProgram(
     uint64_t progID, const bool ignoreException)
 {
-    fileC << "\ndouble P" << progID << "(){" << std::endl;
-    fileH << "double P" << progID << "();" << std::endl;
-
-    // instantiate register
-    fileC << "\tdouble " << nameRegVariable << "["
-          << program->getEnvironment().getNbRegisters() << "] = {";
-    for (int i = 0; i < program->getEnvironment().getNbRegisters(); ++i) {
-        fileC << "0";
-        if (i < program->getEnvironment().getNbRegisters() - 1) {
-            fileC << ", ";
-        }
+    nameDataOwner = (params.reentrant) ? nameContextVariable : "";
+    lineIndent = "\t";
+    if (params.optimize) {
+        intronLines = program->findIntrons();
     }
-    fileC << "};" << std::endl;
-    if (program->getEnvironment().getNbConstant() > 0) {
-        size_t nbCst = program->getEnvironment().getNbConstant();
-        fileC << "\tint32_t " << nameConstantVariable << "[" << nbCst
-              << "] = {";
-        for (int i = 0; i < nbCst; ++i) {
-            fileC << program->getConstantAt(i).value;
-            if (i < nbCst - 1) {
+    else {
+        intronLines.clear();
+    }
+
+    if (params.reentrant) {
+        fileC << "\ndouble P" << progID << "(Context* " << nameContextVariable
+              << "){" << std::endl;
+        fileH << "double P" << progID << "(Context* " << nameContextVariable
+              << ");" << std::endl;
+
+        // reset the registers of the context
+        fileC << "\tdouble* " << nameRegVariable << " = "
+              << nameContextVariable << "->" << nameRegVariable << ";"
+              << std::endl;
+        fileC << "\tfor (int i = 0; i < "
+              << program->getEnvironment().getNbRegisters() << "; i++) {\n"
+              << "\t\t" << nameRegVariable << "[i] = 0;\n"
+              << "\t}" << std::endl;
+    }
+    else {
+        fileC << "\ndouble P" << progID << "(){" << std::endl;
+        fileH << "double P" << progID << "();" << std::endl;
+
+        // instantiate register
+        fileC << "\tdouble " << nameRegVariable << "["
+              << program->getEnvironment().getNbRegisters() << "] = {";
+        size_t nbRegisters = program->getEnvironment().getNbRegisters();
+        for (size_t i = 0; i < nbRegisters; ++i) {
+            fileC << "0";
+            if (i < nbRegisters - 1) {
                 fileC << ", ";
             }
         }
         fileC << "};" << std::endl;
     }
+    printConstants("\t");
 
     iterateThroughtProgram(ignoreException);
 #ifdef DEBUG
@@ -100,6 +121,59 @@ void CodeGen::ProgramGenerationEngine::generateProgram(
     fileC << "#endif" << std::endl;
 #endif
     fileC << "\treturn reg[0];\n}" << std::endl;
+
+    if (params.batchSize > 0) {
+        generateProgramBatch(progID, ignoreException);
+    }
+}
+
+void CodeGen::ProgramGenerationEngine::generateProgramBatch(
+    uint64_t progID, const bool ignoreException)
+{
+    const std::string prototype = "void P" + std::to_string(progID) +
+                                  "Batch(const Observation* inputs, "
+                                  "const int* idx, int nb, double* bids)";
+    fileC << "\n" << prototype << "{" << std::endl;
+    fileH << prototype << ";" << std::endl;
+    printConstants("\t");
+
+    // One iteration of the loop per observation, with fresh registers.
+    fileC << "\tfor (int k = 0; k < nb; k++) {" << std::endl;
+    fileC << "\t\tconst Observation* " << nameObservationVariable
+          << " = &inputs[idx[k]];" << std::endl;
+    fileC << "\t\tdouble " << nameRegVariable << "["
+          << program->getEnvironment().getNbRegisters() << "] = {0};"
+          << std::endl;
+
+    const std::string previousOwner = nameDataOwner;
+    nameDataOwner = nameObservationVariable;
+    lineIndent = "\t\t";
+    iterateThroughtProgram(ignoreException);
+    nameDataOwner = previousOwner;
+    lineIndent = "\t";
+
+    fileC << "\t\tbids[k] = " << nameRegVariable << "[0];\n"
+          << "\t}\n"
+          << "}" << std::endl;
+}
+
+void CodeGen::ProgramGenerationEngine::printConstants(const std::string& indent)
+{
+    // Optimized programs use inlined constants.
+    if (!params.optimize && program->getEnvironment().getNbConstant() > 0) {
+        size_t nbCst = program->getEnvironment().getNbConstant();
+        // Constants are never modified, and can be shared by all threads.
+        fileC << indent
+              << ((params.reentrant) ? "static const int32_t " : "int32_t ")
+              << nameConstantVariable << "[" << nbCst << "] = {";
+        for (int i = 0; i < nbCst; ++i) {
+            fileC << program->getConstantAt(i).value;
+            if (i < nbCst - 1) {
+                fileC << ", ";
+            }
+        }
+        fileC << "};" << std::endl;
+    }
 }
 
 std::string CodeGen::ProgramGenerationEngine::completeFormat(
@@ -152,6 +226,40 @@ void CodeGen::ProgramGenerationEngine::initGlobalVar(size_t nbConstant)
     }
 }
 
+void CodeGen::ProgramGenerationEngine::initContext(size_t nbConstant)
+{
+    if (nbConstant > 0) {
+        fileC << "#include <stdint.h>" << std::endl;
+    }
+
+    fileH << "typedef struct Context {" << std::endl;
+    fileH << "\tdouble " << nameRegVariable << "["
+          << this->registers.getLargestAddressSpace() << "];" << std::endl;
+    for (size_t i = (nbConstant > 0) ? 2 : 1, cpt = 1;
+         i < this->dataScsConstsAndRegs.size(); ++i, ++cpt) {
+        const Data::DataHandler& d = this->dataScsConstsAndRegs.at(i);
+        std::string type = dataPrinter.getDemangleTemplateType(d);
+
+        fileH << "\tconst " << type << "* " << nameDataVariable << cpt << ";"
+              << std::endl;
+    }
+    fileH << "} Context;\n" << std::endl;
+
+    if (params.batchSize > 0) {
+        // Data sources of one observation processed by batch programs.
+        fileH << "typedef struct Observation {" << std::endl;
+        for (size_t i = (nbConstant > 0) ? 2 : 1, cpt = 1;
+             i < this->dataScsConstsAndRegs.size(); ++i, ++cpt) {
+            const Data::DataHandler& d = this->dataScsConstsAndRegs.at(i);
+            std::string type = dataPrinter.getDemangleTemplateType(d);
+
+            fileH << "\tconst " << type << "* " << nameDataVariable << cpt
+                  << ";" << std::endl;
+        }
+        fileH << "} Observation;\n" << std::endl;
+    }
+}
+
 void CodeGen::ProgramGenerationEngine::openFile(const std::string& filename,
                                                 const std::string& path,
                                                 size_t nbConstant)
@@ -160,6 +268,10 @@ void CodeGen::ProgramGenerationEngine::openFile(const std::string& filename,
         std::cout << "filename is empty" << std::endl;
         throw std::invalid_argument("filename is empty");
     }
+    if (params.batchSize > 0 && !params.reentrant) {
+        throw std::invalid_argument(
+            "Batch inference can only be generated in reentrant mode.");
+    }
     this->fileC.open(path + filename + ".c", std::ofstream::out);
     this->fileH.open(path + filename + ".h", std::ofstream::out);
 
@@ -190,7 +302,12 @@ void CodeGen::ProgramGenerationEngine::openFile(const std::string& filename,
 #ifdef DEBUG
     fileC << "#include <stdio.h>" << std::endl;
 #endif // DEBUG
-    initGlobalVar(nbConstant);
+    if (params.reentrant) {
+        initContext(nbConstant);
+    }
+    else {
+        initGlobalVar(nbConstant);
+    }
 }
 
 void CodeGen::ProgramGenerationEngine::initOperandCurrentLine()
@@ -207,12 +324,35 @@ void CodeGen::ProgramGenerationEngine::initOperandCurrentLine()
         const Data::DataHandler& dataSource = this->dataScsConstsAndRegs.at(
             sourceIdx); // Throws std::out_of_range
 
-        fileC << "\t\t" << instruction.getPrintablePrimitiveOperandType(i)
-              << " " << nameOperandVariable << i
-              << dataPrinter.printDataAt(dataSource, operandType, opIdx,
-                                         getNameSourceData(sourceIdx))
-              << std::endl;
+        std::string access = dataPrinter.printDataAt(
+            dataSource, operandType, opIdx, getNameSourceData(sourceIdx));
+        if (params.optimize &&
+            this->program->getEnvironment().getNbConstant() > 0 &&
+            sourceIdx == 1) {
+            access = inlineConstants(access);
+        }
+
+        fileC << lineIndent << "\t"
+              << instruction.getPrintablePrimitiveOperandType(i)
+              << " " << nameOperandVariable << i << access << std::endl;
+    }
+}
+
+std::string CodeGen::ProgramGenerationEngine::inlineConstants(
+    const std::string& code) const
+{
+    std::string result;
+    auto last = code.cbegin();
+    for (auto itr = std::sregex_iterator(code.begin(), code.end(),
+                                         constant_regex);
+         itr != std::sregex_iterator(); ++itr) {
+        result.append(last, (*itr)[0].first);
+        uint64_t idx = std::stoull((*itr)[1].str());
+        result += std::to_string(program->getConstantAt(idx).value);
+        last = (*itr)[0].second;
     }
+    result.append(last, code.cend());
+    return result;
 }
 
 std::string CodeGen::ProgramGenerationEngine::getNameSourceData(
@@ -231,12 +371,19 @@ std::string CodeGen::ProgramGenerationEngine::getNameSourceData(
             varNumber--;
         }
         nameDataSource = nameDataVariable + std::to_string(varNumber);
+        if (!nameDataOwner.empty()) {
+            nameDataSource = nameDataOwner + "->" + nameDataSource;
+        }
     }
     return nameDataSource;
 }
 
 void CodeGen::ProgramGenerationEngine::processLine()
 {
+    if (!intronLines.empty() && intronLines.at(this->programCounter)) {
+        // The line does not contribute to the result of the program.
+        return;
+    }
     this->generateCurrentLine();
 }
 
@@ -37,17 +37,33 @@
 
 #ifdef CODE_GENERATION
 
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
 #include "codeGen/tpgGenerationEngine.h"
 #include "data/demangle.h"
 #include "util/timestamp.h"
 
-CodeGen::TPGGenerationEngine::TPGGenerationEngine(const std::string& filename,
-                                                  const TPG::TPGGraph& tpg,
-                                                  const std::string& path)
-    : TPGAbstractEngine(tpg), progGenerationEngine{filename + "_" +
-                                                       filenameProg,
-                                                   tpg.getEnvironment(), path}
+CodeGen::TPGGenerationEngine::TPGGenerationEngine(
+    const std::string& filename, const TPG::TPGGraph& tpg,
+    const std::string& path, const GenerationParameters& params)
+    : TPGAbstractEngine(tpg), params{params},
+      progGenerationEngine{filename + "_" + filenameProg, tpg.getEnvironment(),
+                           path, params}
 {
+    for (size_t root : params.roots) {
+        if (root >= tpg.getRootVertices().size()) {
+            throw std::invalid_argument("Root " + std::to_string(root) +
+                                        " is not a root of the TPGGraph.");
+        }
+    }
+    if (params.batchSize > 0 && params.roots.size() > 1) {
+        throw std::invalid_argument(
+            "Batch inference can only be generated for a single root.");
+    }
+
     this->fileMain.open(path + filename + ".c", std::ofstream::out);
     this->fileMainH.open(path + filename + ".h", std::ofstream::out);
     if (!fileMain.is_open() || !fileMainH.is_open()) {
@@ -75,6 +91,12 @@ CodeGen::TPGGenerationEngine::TPGGenerationEngine(const std::string& filename,
               << " */\n\n";
     fileMainH << "#ifndef C_" << filename << "_H" << std::endl;
     fileMainH << "#define C_" << filename << "_H\n" << std::endl;
+    if (params.reentrant) {
+        // The Context structure is declared with the programs.
+        fileMainH << "#include \"" << filename << "_" << filenameProg
+                  << ".h\"\n"
+                  << std::endl;
+    }
 };
 
 CodeGen::TPGGenerationEngine::~TPGGenerationEngine()
@@ -84,4 +106,207 @@ CodeGen::TPGGenerationEngine::~TPGGenerationEngine()
     fileMainH.close();
 }
 
+std::vector<const TPG::TPGVertex*> CodeGen::TPGGenerationEngine::
+    getGeneratedRoots() const
+{
+    auto graphRoots = tpg.getRootVertices();
+    if (params.roots.empty()) {
+        return {graphRoots.at(0)};
+    }
+
+    std::vector<const TPG::TPGVertex*> roots;
+    for (size_t root : params.roots) {
+        roots.push_back(graphRoots.at(root));
+    }
+    return roots;
+}
+
+std::string CodeGen::TPGGenerationEngine::getInferenceParameters() const
+{
+    std::string parameters = (params.reentrant) ? "Context* ctx" : "";
+    if (!params.roots.empty()) {
+        parameters += (params.reentrant) ? ", int rootId" : "int rootId";
+    }
+    return parameters;
+}
+
+std::vector<const TPG::TPGVertex*> CodeGen::TPGGenerationEngine::
+    getGeneratedVertices() const
+{
+    std::vector<const TPG::TPGVertex*> vertices = tpg.getVertices();
+    if (!params.optimize) {
+        return vertices;
+    }
+
+    // Mark vertices reachable from the roots.
+    std::set<const TPG::TPGVertex*> reachable;
+    std::vector<const TPG::TPGVertex*> toVisit = getGeneratedRoots();
+    while (!toVisit.empty()) {
+        const TPG::TPGVertex* vertex = toVisit.back();
+        toVisit.pop_back();
+        if (reachable.insert(vertex).second) {
+            for (const TPG::TPGEdge* edge : vertex->getOutgoingEdges()) {
+                toVisit.push_back(edge->getDestination());
+            }
+        }
+    }
+
+    // Keep the original order of vertices.
+    vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
+                                  [&reachable](const TPG::TPGVertex* v) {
+                                      return reachable.count(v) == 0;
+                                  }),
+                   vertices.end());
+    return vertices;
+}
+
+/// Post-order depth-first traversal of the teams reachable from a vertex.
+static void orderTeams(const TPG::TPGVertex* vertex,
+                       std::set<const TPG::TPGVertex*>& visited,
+                       std::vector<const TPG::TPGTeam*>& postOrder)
+{
+    auto team = dynamic_cast<const TPG::TPGTeam*>(vertex);
+    if (team == nullptr || !visited.insert(vertex).second) {
+        return;
+    }
+    for (const TPG::TPGEdge* edge : team->getOutgoingEdges()) {
+        orderTeams(edge->getDestination(), visited, postOrder);
+    }
+    postOrder.push_back(team);
+}
+
+void CodeGen::TPGGenerationEngine::generateBatchInference()
+{
+    const TPG::TPGVertex* root = getGeneratedRoots().at(0);
+
+    // Teams reachable from the root, in topological order, root first.
+    std::set<const TPG::TPGVertex*> visited;
+    std::vector<const TPG::TPGTeam*> teams;
+    orderTeams(root, visited, teams);
+    std::reverse(teams.begin(), teams.end());
+    std::map<const TPG::TPGVertex*, size_t> teamIdx;
+    for (size_t i = 0; i < teams.size(); i++) {
+        teamIdx[teams.at(i)] = i;
+    }
+    // At least one list, so that the BatchContext is never empty.
+    const size_t nbLists = std::max<size_t>(teams.size(), 1);
+
+    fileMainH << "\n#define TPG_BATCH_SIZE " << params.batchSize << "\n\n"
+              << "typedef struct BatchContext {\n"
+              << "\tint nb[" << nbLists << "];\n"
+              << "\tint idx[" << nbLists << "][TPG_BATCH_SIZE];\n"
+              << "\tint cur[TPG_BATCH_SIZE];\n"
+              << "\tint choice[TPG_BATCH_SIZE];\n"
+              << "\tdouble best[TPG_BATCH_SIZE];\n"
+              << "\tdouble bids[TPG_BATCH_SIZE];\n"
+              << "} BatchContext;\n\n"
+              << "void inferenceTPGBatch(BatchContext* ctx, "
+              << "const Observation* inputs, int* actions, int nb);\n";
+
+    // One function per team, processing all its pending observations.
+    for (size_t t = 0; t < teams.size(); t++) {
+        const TPG::TPGTeam* team = teams.at(t);
+        const auto& edges = team->getOutgoingEdges();
+        fileMain << "\nstatic void executeBatch" << t
+                 << "(BatchContext* ctx, const Observation* inputs, "
+                 << "int* actions){\n"
+                 << "\tint nb = ctx->nb[" << t << "];\n"
+                 << "\tint* cur = ctx->cur;\n"
+                 << "\tfor (int k = 0; k < nb; k++) {\n"
+                 << "\t\tcur[k] = ctx->idx[" << t << "][k];\n"
+                 << "\t}\n"
+                 << "\tctx->nb[" << t << "] = 0;\n";
+
+        size_t e = 0;
+        for (const TPG::TPGEdge* edge : edges) {
+            const Program::Program& p = edge->getProgram();
+            uint64_t progID;
+            if (findProgramID(p, progID)) {
+                progGenerationEngine.setProgram(p);
+                progGenerationEngine.generateProgram(progID);
+            }
+            fileMain << "\tP" << progID << "Batch(inputs, cur, nb, "
+                     << ((e == 0) ? "ctx->best" : "ctx->bids") << ");\n"
+                     << "\tfor (int k = 0; k < nb; k++) {\n";
+            if (e == 0) {
+                fileMain << "\t\tctx->best[k] = (isnan(ctx->best[k])) ? "
+                         << "-INFINITY : ctx->best[k];\n"
+                         << "\t\tctx->choice[k] = 0;\n";
+            }
+            else {
+                fileMain << "\t\tdouble r = (isnan(ctx->bids[k])) ? "
+                         << "-INFINITY : ctx->bids[k];\n"
+                         << "\t\tif (r >= ctx->best[k]) {\n"
+                         << "\t\t\tctx->best[k] = r;\n"
+                         << "\t\t\tctx->choice[k] = " << e << ";\n"
+                         << "\t\t}\n";
+            }
+            fileMain << "\t}\n";
+            e++;
+        }
+
+        // Route each observation to the destination of its winning edge.
+        fileMain << "\tfor (int k = 0; k < nb; k++) {\n"
+                 << "\t\tswitch (ctx->choice[k]) {\n";
+        e = 0;
+        for (const TPG::TPGEdge* edge : edges) {
+            const TPG::TPGVertex* dest = edge->getDestination();
+            fileMain << "\t\tcase " << e++ << ":\n";
+            auto action = dynamic_cast<const TPG::TPGAction*>(dest);
+            if (action != nullptr) {
+                fileMain << "\t\t\tactions[cur[k]] = "
+                         << action->getActionID() << ";\n";
+            }
+            else {
+                size_t d = teamIdx.at(dest);
+                fileMain << "\t\t\tctx->idx[" << d << "][ctx->nb[" << d
+                         << "]++] = cur[k];\n";
+            }
+            fileMain << "\t\t\tbreak;\n";
+        }
+        fileMain << "\t\t}\n"
+                 << "\t}\n"
+                 << "}\n";
+    }
+
+    fileMain << "\nvoid inferenceTPGBatch(BatchContext* ctx, "
+             << "const Observation* inputs, int* actions, int nb){\n"
+             << "\tfor (int start = 0; start < nb; start += TPG_BATCH_SIZE) "
+             << "{\n"
+             << "\t\tint n = (nb - start < TPG_BATCH_SIZE) ? nb - start : "
+             << "TPG_BATCH_SIZE;\n";
+    if (teams.empty()) {
+        // The root is an action.
+        fileMain << "\t\tfor (int k = 0; k < n; k++) {\n"
+                 << "\t\t\tactions[start + k] = "
+                 << dynamic_cast<const TPG::TPGAction*>(root)->getActionID()
+                 << ";\n"
+                 << "\t\t}\n"
+                 << "\t}\n"
+                 << "}" << std::endl;
+        return;
+    }
+    fileMain << "\t\tfor (int t = 0; t < " << nbLists << "; t++) {\n"
+             << "\t\t\tctx->nb[t] = 0;\n"
+             << "\t\t}\n"
+             << "\t\tfor (int k = 0; k < n; k++) {\n"
+             << "\t\t\tctx->idx[0][k] = start + k;\n"
+             << "\t\t}\n"
+             << "\t\tctx->nb[0] = n;\n\n"
+             << "\t\t// A single pass suffices if the TPG has no cycle.\n"
+             << "\t\tint pending;\n"
+             << "\t\tdo {\n"
+             << "\t\t\tpending = 0;\n";
+    for (size_t t = 0; t < teams.size(); t++) {
+        fileMain << "\t\t\tif (ctx->nb[" << t << "] > 0) {\n"
+                 << "\t\t\t\tpending = 1;\n"
+                 << "\t\t\t\texecuteBatch" << t
+                 << "(ctx, inputs, actions);\n"
+                 << "\t\t\t}\n";
+    }
+    fileMain << "\t\t} while (pending);\n"
+             << "\t}\n"
+             << "}" << std::endl;
+}
+
 #endif // CODE_GENERATION
@@ -53,13 +53,16 @@ CodeGen::TPGGenerationEngineFactory::TPGGenerationEngineFactory(
 std::unique_ptr<CodeGen::TPGGenerationEngine> CodeGen::
     TPGGenerationEngineFactory::create(const std::string& filename,
                                        const TPG::TPGGraph& tpg,
-                                       const std::string& path)
+                                       const std::string& path,
+                                       const GenerationParameters& params)
 {
     if (this->mode == stackMode) {
-        return std::make_unique<TPGStackGenerationEngine>(filename, tpg, path);
+        return std::make_unique<TPGStackGenerationEngine>(filename, tpg, path,
+                                                          params);
     }
     else if (this->mode == switchMode) {
-        return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path);
+        return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path,
+                                                           params);
     }
     else {
         return nullptr;
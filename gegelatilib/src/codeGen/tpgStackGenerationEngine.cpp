@@ -42,8 +42,8 @@
 
 CodeGen::TPGStackGenerationEngine::TPGStackGenerationEngine(
     const std::string& filename, const TPG::TPGGraph& tpg,
-    const std::string& path)
-    : TPGGenerationEngine(filename, tpg, path)
+    const std::string& path, const GenerationParameters& params)
+    : TPGGenerationEngine(filename, tpg, path, params)
 {
 }
 
@@ -84,10 +84,14 @@ void CodeGen::TPGStackGenerationEngine::generateTeam(const TPG::TPGTeam& team)
 {
     uint64_t id = findVertexID(team);
     // print prototype and declaration of the function
-    fileMain << "void* T" << id << "(int* action){" << std::endl;
-    fileMainH << "void* T" << id << "(int* action);" << std::endl;
-    // generate static array
-    fileMain << "\tstatic Edge e[] = {" << std::endl;
+    const std::string ctxParam = params.reentrant ? "Context* ctx, " : "";
+    fileMain << "void* T" << id << "(" << ctxParam << "int* action){"
+             << std::endl;
+    fileMainH << "void* T" << id << "(" << ctxParam << "int* action);"
+              << std::endl;
+    // generate static array, read-only when the code must be reentrant
+    fileMain << "\tstatic " << (params.reentrant ? "const " : "")
+             << "Edge e[] = {" << std::endl;
     auto list = team.getOutgoingEdges();
     for (auto l = list.begin(); l != list.end(); l++) {
         if (l != list.begin()) {
@@ -103,7 +107,9 @@ void CodeGen::TPGStackGenerationEngine::generateTeam(const TPG::TPGTeam& team)
     // appel des fonction d'exécution
     fileMain << "\tint nbEdge = " << team.getOutgoingEdges().size() << ";"
              << std::endl;
-    fileMain << "\treturn executeTeam(e,nbEdge);\n}\n" << std::endl;
+    fileMain << "\treturn executeTeam(" << (params.reentrant ? "ctx, " : "")
+             << "e,nbEdge);\n}\n"
+             << std::endl;
 }
 
 void CodeGen::TPGStackGenerationEngine::generateAction(
@@ -111,8 +117,11 @@ void CodeGen::TPGStackGenerationEngine::generateAction(
 {
     uint64_t id = action.getActionID();
     // print prototype and declaration of the function
-    fileMain << "void* A" << id << "(int* action){" << std::endl;
-    fileMainH << "void* A" << id << "(int* action);" << std::endl;
+    const std::string ctxParam = params.reentrant ? "Context* ctx, " : "";
+    fileMain << "void* A" << id << "(" << ctxParam << "int* action){"
+             << std::endl;
+    fileMainH << "void* A" << id << "(" << ctxParam << "int* action);"
+              << std::endl;
 
     // print definition of the function
     fileMain << "\t*action = " << id << ";" << std::endl;
@@ -121,9 +130,43 @@ void CodeGen::TPGStackGenerationEngine::generateAction(
 
 void CodeGen::TPGStackGenerationEngine::setRoot(const TPG::TPGVertex& team)
 {
-    fileMainH << "\nextern void* (*root)(int* action);" << std::endl;
-    fileMain << "void* (*root)(int* action) = T" << findVertexID(team) << ";"
-             << std::endl;
+    if (params.reentrant) {
+        fileMainH << "\nextern void* (*const root)(Context* ctx, int* action);"
+                  << std::endl;
+        fileMain << "void* (*const root)(Context* ctx, int* action) = T"
+                 << findVertexID(team) << ";" << std::endl;
+    }
+    else {
+        fileMainH << "\nextern void* (*root)(int* action);" << std::endl;
+        fileMain << "void* (*root)(int* action) = T" << findVertexID(team)
+                 << ";" << std::endl;
+    }
+}
+
+void CodeGen::TPGStackGenerationEngine::setRoots(
+    const std::vector<const TPG::TPGVertex*>& roots)
+{
+    if (params.roots.empty()) {
+        setRoot(*roots.at(0));
+        return;
+    }
+
+    const std::string ctxParam = params.reentrant ? "Context* ctx, " : "";
+    fileMainH << "\nextern void* (*const roots[" << roots.size() << "])("
+              << ctxParam << "int* action);" << std::endl;
+    fileMain << "void* (*const roots[" << roots.size() << "])(" << ctxParam
+             << "int* action) = {";
+    for (auto root = roots.begin(); root != roots.end(); root++) {
+        fileMain << ((root != roots.begin()) ? ", " : "");
+        auto action = dynamic_cast<const TPG::TPGAction*>(*root);
+        if (action != nullptr) {
+            fileMain << "A" << action->getActionID();
+        }
+        else {
+            fileMain << "T" << findVertexID(**root);
+        }
+    }
+    fileMain << "};" << std::endl;
 }
 
 void CodeGen::TPGStackGenerationEngine::generateTPGGraph()
@@ -132,7 +175,7 @@ void CodeGen::TPGStackGenerationEngine::generateTPGGraph()
     initHeaderFile();
 
     std::map<const TPG::TPGTeam*, std::list<TPG::TPGEdge*>> graph;
-    auto vertices = this->tpg.getVertices();
+    auto vertices = this->getGeneratedVertices();
     // give an id for each team of the graph
     for (auto vertex : vertices) {
         if (dynamic_cast<const TPG::TPGTeam*>(vertex) != nullptr) {
@@ -142,11 +185,21 @@ void CodeGen::TPGStackGenerationEngine::generateTPGGraph()
             generateAction(*(const TPG::TPGAction*)vertex);
         }
     }
-    setRoot(*tpg.getRootVertices().at(0));
+    setRoots(getGeneratedRoots());
+    if (params.batchSize > 0) {
+        generateBatchInference();
+    }
 }
 
 void CodeGen::TPGStackGenerationEngine::initTpgFile()
 {
+    // Context forwarded to all functions and programs of reentrant code.
+    const std::string ctxParam = params.reentrant ? "Context* ctx, " : "";
+    const std::string ctxArg = params.reentrant ? "ctx, " : "";
+    const std::string ctxType = params.reentrant ? "Context*, " : "";
+    const std::string edgeType = params.reentrant ? "const Edge*" : "Edge*";
+    const std::string progArg = params.reentrant ? "ctx" : "";
+
     fileMain << "#include <limits.h> \n"
              << "#include <assert.h>\n"
              << "#include <stdio.h>\n"
@@ -154,40 +207,44 @@ void CodeGen::TPGStackGenerationEngine::initTpgFile()
              << "#include <stdbool.h>\n"
              << "#include <math.h>\n\n"
 
-             << "int inferenceTPG(){\n"
-             << "\treturn executeFromVertex(root);\n"
+             << "int inferenceTPG(" << getInferenceParameters() << "){\n"
+             << "\treturn executeFromVertex(" << ctxArg
+             << (params.roots.empty() ? "root" : "roots[rootId]") << ");\n"
              << "}\n\n"
 
-             << "int executeFromVertex(void*(*ptr_f)(int*action)){\n"
-             << "\tvoid*(*f)(int*action) = ptr_f;\n"
+             << "int executeFromVertex(" << ctxParam << "void*(*ptr_f)("
+             << ctxParam << "int*action)){\n"
+             << "\tvoid*(*f)(" << ctxParam << "int*action) = ptr_f;\n"
              << "\tint action = INT_MIN;\n"
              << "\twhile (f!=NULL){\n"
-             << "\t\tf= (void*(*)(int*)) (f(&action));\n"
+             << "\t\tf= (void*(*)(" << ctxType << "int*)) (f(" << ctxArg
+             << "&action));\n"
              << "\t}\n"
              << "\treturn action;\n}\n\n"
 
-             << "void* executeTeam(Edge* e, int nbEdge){\n"
-             << "\tint idxNext = execute(e, nbEdge); \n"
+             << "void* executeTeam(" << ctxParam << edgeType
+             << " e, int nbEdge){\n"
+             << "\tint idxNext = execute(" << ctxArg << "e, nbEdge); \n"
              << "\tif(idxNext != -1) {\n"
              << "\t\treturn e[idxNext].ptr_vertex;\n"
              << "\t}\n"
              << "\treturn NULL;\n"
              << "}\n\n"
 
-             << "int execute(Edge* e, int nbEdge){\n"
+             << "int execute(" << ctxParam << edgeType << " e, int nbEdge){\n"
              << "\tdouble bestResult;\n"
              << "\tint idxNext = 0;\n"
              << "\tint idx;\n"
              << "\tdouble r;\n\n"
 
-             << "\tbestResult = e[idxNext].ptr_prog();\n"
+             << "\tbestResult = e[idxNext].ptr_prog(" << progArg << ");\n"
              << "\tbestResult = (isnan(bestResult)) ? -INFINITY : bestResult;\n"
              << "\tidx = idxNext + 1;\n\n"
 
              << "\t// Check if there is another edge with a better result\n"
              << "\twhile (idx < nbEdge){\n"
 
-             << "\t\tr = e[idx].ptr_prog();\n"
+             << "\t\tr = e[idx].ptr_prog(" << progArg << ");\n"
              << "\t\tr = (isnan(r)) ? -INFINITY : r;\n"
              << "\t\tif (r >= bestResult){\n"
              << "\t\t\tbestResult = r;\n"
@@ -205,20 +262,37 @@ void CodeGen::TPGStackGenerationEngine::initHeaderFile()
     fileMainH << "#include <stdlib.h>\n\n";
 
     fileMainH << "typedef enum Vertex {";
-    for (auto vertex : this->tpg.getVertices()) {
+    for (auto vertex : this->getGeneratedVertices()) {
         fileMainH << vertexName(*vertex) << "Vert"
                   << ", ";
     }
 
-    fileMainH << "} Vertex;\n\n"
+    fileMainH << "} Vertex;\n\n";
+
+    if (params.reentrant) {
+        fileMainH
+            << "typedef struct Edge {\n"
+            << "\tVertex destination;\n"
+            << "\tdouble (*ptr_prog)(Context* ctx);\n"
+            << "\tvoid* (*ptr_vertex)(Context* ctx, int* action);\n"
+            << "}Edge;\n\n"
+
+            << "int inferenceTPG(" << getInferenceParameters() << ");\n"
+            << "int executeFromVertex(Context* ctx, "
+            << "void*(*)(Context* ctx, int*action));\n"
+            << "void* executeTeam(Context* ctx, const Edge* e, int nbEdge);\n"
+            << "int execute(Context* ctx, const Edge* e, int nbEdge);\n"
+            << std::endl;
+        return;
+    }
 
-              << "typedef struct Edge {\n"
+    fileMainH << "typedef struct Edge {\n"
               << "\tVertex destination;\n"
               << "\tdouble (*ptr_prog)();\n"
               << "\tvoid* (*ptr_vertex)(int* action);\n"
               << "}Edge;\n\n"
 
-              << "int inferenceTPG();\n"
+              << "int inferenceTPG(" << getInferenceParameters() << ");\n"
               << "int executeFromVertex(void*(*)(int*action));\n"
               << "void* executeTeam(Edge* e, int nbEdge);\n"
               << "int execute(Edge* e, int nbEdge);\n"
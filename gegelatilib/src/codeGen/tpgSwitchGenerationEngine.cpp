@@ -49,7 +49,19 @@ void CodeGen::TPGSwitchGenerationEngine::generateEdge(const TPG::TPGEdge& edge)
     if (findProgramID(p, progID)) {
         progGenerationEngine.generateProgram(progID);
     }
-    fileMain << "P" << progID << "()";
+    const std::string call = "P" + std::to_string(progID) + "(" +
+                             (params.reentrant ? "ctx" : "") + ")";
+    auto shared = sharedPrograms.find(&p);
+    if (shared != sharedPrograms.end()) {
+        // Compute the bid only on the first evaluation of the program.
+        const std::string idx = "[" + std::to_string(shared->second) + "]";
+        fileMain << "(bidCached" << idx << " ? bidCache" << idx
+                 << " : (bidCached" << idx << " = 1, bidCache" << idx
+                 << " = " << call << "))";
+    }
+    else {
+        fileMain << call;
+    }
 }
 
 void CodeGen::TPGSwitchGenerationEngine::generateTeam(const TPG::TPGTeam& team)
@@ -101,7 +113,21 @@ void CodeGen::TPGSwitchGenerationEngine::generateTPGGraph()
     initHeaderFile();
 
     std::map<const TPG::TPGTeam*, std::list<TPG::TPGEdge*>> graph;
-    auto vertices = this->tpg.getVertices();
+    auto vertices = this->getGeneratedVertices();
+
+    // Programs shared by several generated edges
+    sharedPrograms.clear();
+    if (params.optimize) {
+        std::map<const Program::Program*, size_t> nbUses;
+        for (auto vertex : vertices) {
+            for (const TPG::TPGEdge* edge : vertex->getOutgoingEdges()) {
+                const Program::Program* p = &edge->getProgram();
+                if (++nbUses[p] == 2) {
+                    sharedPrograms.emplace(p, sharedPrograms.size());
+                }
+            }
+        }
+    }
 
     // generate enum of teams and actions for readability
     fileMain << "enum vertices {";
@@ -111,11 +137,34 @@ void CodeGen::TPGSwitchGenerationEngine::generateTPGGraph()
     fileMain << "};" << std::endl << std::endl;
 
     // generate inference function
-    fileMain << "int inferenceTPG() {" << std::endl;
+    fileMain << "int inferenceTPG(" << getInferenceParameters() << ") {"
+             << std::endl;
+
+    // cache of bids of shared programs, valid for one inference
+    if (!sharedPrograms.empty()) {
+        fileMain << "\tdouble bidCache[" << sharedPrograms.size() << "];"
+                 << std::endl;
+        fileMain << "\tint bidCached[" << sharedPrograms.size() << "] = {0};"
+                 << std::endl;
+    }
 
     // start graph on root
-    fileMain << "\tenum vertices currentVertex = "
-             << vertexName(*tpg.getRootVertices().at(0)) << ";" << std::endl;
+    if (params.roots.empty()) {
+        fileMain << "\tenum vertices currentVertex = "
+                 << vertexName(*tpg.getRootVertices().at(0)) << ";"
+                 << std::endl;
+    }
+    else {
+        auto roots = getGeneratedRoots();
+        fileMain << "\tstatic const enum vertices roots[" << roots.size()
+                 << "] = { ";
+        for (auto root : roots) {
+            fileMain << vertexName(*root) << ", ";
+        }
+        fileMain << "};" << std::endl;
+        fileMain << "\tenum vertices currentVertex = roots[rootId];"
+                 << std::endl;
+    }
 
     // generate switch case to navigate the graph
     fileMain << "\twhile(1) {" << std::endl;
@@ -134,6 +183,9 @@ void CodeGen::TPGSwitchGenerationEngine::generateTPGGraph()
     fileMain << "\t\t}" << std::endl;
     fileMain << "\t}" << std::endl;
     fileMain << "}" << std::endl;
+    if (params.batchSize > 0) {
+        generateBatchInference();
+    }
 }
 
 void CodeGen::TPGSwitchGenerationEngine::initTpgFile()
@@ -167,7 +219,7 @@ void CodeGen::TPGSwitchGenerationEngine::initTpgFile()
 void CodeGen::TPGSwitchGenerationEngine::initHeaderFile()
 {
     fileMainH << "#include <stdlib.h>\n\n"
-              << "int inferenceTPG();\n";
+              << "int inferenceTPG(" << getInferenceParameters() << ");\n";
 }
 
 std::string CodeGen::TPGSwitchGenerationEngine::vertexName(
@@ -49,6 +49,11 @@ size_t Data::DataHandler::getId() const
     return this->id;
 }
 
+size_t Data::DataHandler::getMemoryFootprint() const
+{
+    return sizeof(DataHandler);
+}
+
 size_t Data::DataHandler::getHash() const
 {
     if (this->invalidCachedHash) {
@@ -58,6 +63,11 @@ size_t Data::DataHandler::getHash() const
     return this->cachedHash;
 }
 
+Data::DataHandler::ScalarAccess Data::DataHandler::getScalarAccess() const
+{
+    return ScalarAccess();
+}
+
 uint64_t Data::DataHandler::scaleLocation(const uint64_t rawLocation,
                                           const std::type_info& type) const
 {
@@ -0,0 +1,131 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include "data/arrayWrapper.h"
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+
+#include "data/dataHandlerSerialization.h"
+
+/**
+ * \brief Append the content of a DataHandler to a buffer if it is an
+ * ArrayWrapper<T>.
+ *
+ * \return false if the DataHandler is not an ArrayWrapper<T>.
+ */
+template <typename T>
+static bool appendArrayContent(std::string& buffer,
+                               const Data::DataHandler& dHandler, uint8_t tag)
+{
+    if (dynamic_cast<const Data::ArrayWrapper<T>*>(&dHandler) == nullptr) {
+        return false;
+    }
+    uint64_t nbElements = dHandler.getAddressSpace(typeid(T));
+    Data::Serialization::appendValue<uint8_t>(buffer, tag);
+    Data::Serialization::appendValue<uint64_t>(buffer, nbElements);
+    for (uint64_t i = 0; i < nbElements; i++) {
+        Data::Serialization::appendValue<T>(
+            buffer,
+            *dHandler.getDataAt(typeid(T), i).getSharedPointer<const T>());
+    }
+    return true;
+}
+
+/**
+ * \brief Fill a PrimitiveTypeArray<T> or a PrimitiveTypeArray2D<T> with the
+ * content read from a buffer.
+ *
+ * \throw std::runtime_error if the DataHandler has another type.
+ */
+template <typename T>
+static void readArrayContent(const std::string& buffer, size_t& offset,
+                             Data::DataHandler& dHandler)
+{
+    auto array = dynamic_cast<Data::PrimitiveTypeArray<T>*>(&dHandler);
+    auto array2D = dynamic_cast<Data::PrimitiveTypeArray2D<T>*>(&dHandler);
+    uint64_t nbElements =
+        Data::Serialization::readValue<uint64_t>(buffer, offset);
+    if ((array == nullptr && array2D == nullptr) ||
+        nbElements != dHandler.getAddressSpace(typeid(T))) {
+        throw std::runtime_error(
+            "Serialized data does not match the DataHandler.");
+    }
+    for (uint64_t i = 0; i < nbElements; i++) {
+        T value = Data::Serialization::readValue<T>(buffer, offset);
+        if (array != nullptr) {
+            array->setDataAt(typeid(T), i, value);
+        }
+        else {
+            array2D->setDataAt(typeid(T), i, value);
+        }
+    }
+}
+
+bool Data::Serialization::appendDataHandlerContent(
+    std::string& buffer, const DataHandler& dHandler)
+{
+    return appendArrayContent<double>(buffer, dHandler, 0) ||
+           appendArrayContent<float>(buffer, dHandler, 1) ||
+           appendArrayContent<int>(buffer, dHandler, 2) ||
+           appendArrayContent<int64_t>(buffer, dHandler, 3) ||
+           appendArrayContent<uint8_t>(buffer, dHandler, 4) ||
+           appendArrayContent<char>(buffer, dHandler, 5);
+}
+
+void Data::Serialization::readDataHandlerContent(const std::string& buffer,
+                                                 size_t& offset,
+                                                 DataHandler& dHandler)
+{
+    switch (readValue<uint8_t>(buffer, offset)) {
+    case 0:
+        readArrayContent<double>(buffer, offset, dHandler);
+        break;
+    case 1:
+        readArrayContent<float>(buffer, offset, dHandler);
+        break;
+    case 2:
+        readArrayContent<int>(buffer, offset, dHandler);
+        break;
+    case 3:
+        readArrayContent<int64_t>(buffer, offset, dHandler);
+        break;
+    case 4:
+        readArrayContent<uint8_t>(buffer, offset, dHandler);
+        break;
+    case 5:
+        readArrayContent<char>(buffer, offset, dHandler);
+        break;
+    default:
+        throw std::runtime_error("Unknown data type in serialized data.");
+    }
+}
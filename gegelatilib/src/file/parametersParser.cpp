@@ -198,6 +198,14 @@ void File::ParametersParser::setParameterFromString(
         params.ratioDeletedRoots = value.asDouble();
         return;
     }
+    if (param == "inferenceCostWeight") {
+        params.inferenceCostWeight = value.asDouble();
+        return;
+    }
+    if (param == "maxInferenceCost") {
+        params.maxInferenceCost = value.asDouble();
+        return;
+    }
     if (param == "nbGenerations") {
         params.nbGenerations = value.asUInt64();
         return;
@@ -257,6 +265,16 @@ void File::ParametersParser::writeParametersToJson(
     root["doValidation"].setComment(
         Learn::LearningParameters::doValidationComment, Json::commentBefore);
 
+    root["inferenceCostWeight"] = params.inferenceCostWeight;
+    root["inferenceCostWeight"].setComment(
+        Learn::LearningParameters::inferenceCostWeightComment,
+        Json::commentBefore);
+
+    root["maxInferenceCost"] = params.maxInferenceCost;
+    root["maxInferenceCost"].setComment(
+        Learn::LearningParameters::maxInferenceCostComment,
+        Json::commentBefore);
+
     root["maxNbActionsPerEval"] = params.maxNbActionsPerEval;
     root["maxNbActionsPerEval"].setComment(
         Learn::LearningParameters::maxNbActionsPerEvalComment,
@@ -0,0 +1,146 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "data/constant.h"
+#include "file/tpgGraphBinaryExporter.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgVertex.h"
+
+void File::TPGGraphBinaryExporter::write(const void* data, size_t size)
+{
+    if (size > 0 && fwrite(data, 1, size, pFile) != size) {
+        throw std::runtime_error("Could not write in the binary file.");
+    }
+}
+
+void File::TPGGraphBinaryExporter::writeProgram(
+    const Program::Program& program)
+{
+    const Environment& env = this->tpg.getEnvironment();
+
+    uint64_t nbLines = program.getNbLines();
+    this->write(&nbLines, sizeof(uint64_t));
+
+    // Constants, padded to 8 bytes
+    std::vector<int32_t> constants(env.getNbConstant() +
+                                   (env.getNbConstant() % 2));
+    for (size_t i = 0; i < env.getNbConstant(); i++) {
+        constants.at(i) = static_cast<int32_t>(program.getConstantAt(i));
+    }
+    this->write(constants.data(), constants.size() * sizeof(int32_t));
+
+    // Lines
+    std::vector<uint64_t> lineWords(2 + 2 * env.getMaxNbOperands());
+    for (size_t i = 0; i < program.getNbLines(); i++) {
+        const Program::Line& line = program.getLine(i);
+        lineWords.at(0) = line.getInstructionIndex();
+        lineWords.at(1) = line.getDestinationIndex();
+        for (size_t j = 0; j < env.getMaxNbOperands(); j++) {
+            const std::pair<uint64_t, uint64_t>& operand = line.getOperand(j);
+            lineWords.at(2 + 2 * j) = operand.first;
+            lineWords.at(3 + 2 * j) = operand.second;
+        }
+        this->write(lineWords.data(), lineWords.size() * sizeof(uint64_t));
+    }
+}
+
+void File::TPGGraphBinaryExporter::print()
+{
+    const Environment& env = this->tpg.getEnvironment();
+    const std::vector<const TPG::TPGVertex*> vertices =
+        this->tpg.getVertices();
+    const std::list<std::unique_ptr<TPG::TPGEdge>>& edges =
+        this->tpg.getEdges();
+
+    // Index vertices and programs
+    std::unordered_map<const TPG::TPGVertex*, uint64_t> vertexIdx;
+    for (const TPG::TPGVertex* vertex : vertices) {
+        vertexIdx.emplace(vertex, vertexIdx.size());
+    }
+    std::unordered_map<const Program::Program*, uint64_t> programIdx;
+    std::vector<const Program::Program*> programs;
+    for (const std::unique_ptr<TPG::TPGEdge>& edge : edges) {
+        const Program::Program* program = &edge->getProgram();
+        if (programIdx.emplace(program, programs.size()).second) {
+            programs.push_back(program);
+        }
+    }
+
+    // Header
+    TPGGraphBinaryFormat::Header header;
+    memcpy(header.magic, TPGGraphBinaryFormat::magic, sizeof(header.magic));
+    header.version = TPGGraphBinaryFormat::version;
+    header.endianness = TPGGraphBinaryFormat::endianness;
+    header.nbInstructions = env.getNbInstructions();
+    header.maxNbOperands = env.getMaxNbOperands();
+    header.nbRegisters = env.getNbRegisters();
+    header.nbConstants = env.getNbConstant();
+    header.nbDataSources = env.getNbDataSources();
+    header.nbVertices = vertices.size();
+    header.nbEdges = edges.size();
+    header.nbPrograms = programs.size();
+    this->write(&header, sizeof(header));
+
+    // Vertex table
+    for (const TPG::TPGVertex* vertex : vertices) {
+        TPGGraphBinaryFormat::VertexEntry entry{TPGGraphBinaryFormat::TEAM, 0};
+        auto action = dynamic_cast<const TPG::TPGAction*>(vertex);
+        if (action != nullptr) {
+            entry.type = TPGGraphBinaryFormat::ACTION;
+            entry.actionID = action->getActionID();
+        }
+        this->write(&entry, sizeof(entry));
+    }
+
+    // Edge table
+    for (const std::unique_ptr<TPG::TPGEdge>& edge : edges) {
+        TPGGraphBinaryFormat::EdgeEntry entry{
+            vertexIdx.at(edge->getSource()),
+            vertexIdx.at(edge->getDestination()),
+            programIdx.at(&edge->getProgram())};
+        this->write(&entry, sizeof(entry));
+    }
+
+    // Program section
+    for (const Program::Program* program : programs) {
+        this->writeProgram(*program);
+    }
+
+    // flush file
+    fflush(pFile);
+}
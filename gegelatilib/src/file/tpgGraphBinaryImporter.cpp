@@ -0,0 +1,290 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cstring>
+#include <fstream>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "data/constant.h"
+#include "file/tpgGraphBinaryImporter.h"
+
+namespace {
+    /**
+     * \brief Read-only view on the content of a file.
+     *
+     * The file is mapped in memory with mmap when available, and read in a
+     * buffer otherwise.
+     */
+    class FileView
+    {
+      private:
+        const char* data = nullptr;
+        size_t size = 0;
+#if defined(_MSC_VER) || defined(__MINGW32__)
+        std::vector<char> buffer;
+#endif
+
+      public:
+        FileView(const std::string& filePath)
+        {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+            std::ifstream file(filePath, std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Could not open file " + filePath);
+            }
+            buffer.assign(std::istreambuf_iterator<char>(file),
+                          std::istreambuf_iterator<char>());
+            data = buffer.data();
+            size = buffer.size();
+#else
+            int fd = open(filePath.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Could not open file " + filePath);
+            }
+            struct stat fileStat;
+            if (fstat(fd, &fileStat) != 0) {
+                close(fd);
+                throw std::runtime_error("Could not read file " + filePath);
+            }
+            size = fileStat.st_size;
+            if (size > 0) {
+                void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (map == MAP_FAILED) {
+                    close(fd);
+                    throw std::runtime_error("Could not map file " + filePath);
+                }
+                data = (const char*)map;
+            }
+            close(fd);
+#endif
+        }
+
+        FileView(const FileView& other) = delete;
+
+        ~FileView()
+        {
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+            if (data != nullptr) {
+                munmap((void*)data, size);
+            }
+#endif
+        }
+
+        const char* begin() const
+        {
+            return data;
+        }
+
+        const char* end() const
+        {
+            return data + size;
+        }
+    };
+} // namespace
+
+/**
+ * \brief Copy a record from the file content and advance the cursor.
+ *
+ * \throws std::runtime_error if the record exceeds the file content.
+ */
+template <class T>
+static void readRecord(T& record, const char*& cursor, const char* end)
+{
+    if ((size_t)(end - cursor) < sizeof(T)) {
+        throw std::runtime_error("Binary TPGGraph file is truncated.");
+    }
+    memcpy(&record, cursor, sizeof(T));
+    cursor += sizeof(T);
+}
+
+void File::TPGGraphBinaryImporter::checkHeader(
+    const TPGGraphBinaryFormat::Header& header) const
+{
+    if (memcmp(header.magic, TPGGraphBinaryFormat::magic,
+               sizeof(header.magic)) != 0) {
+        throw std::runtime_error("File " + this->filePath +
+                                 " is not a binary TPGGraph file.");
+    }
+    if (header.endianness != TPGGraphBinaryFormat::endianness) {
+        throw std::runtime_error("Binary TPGGraph file " + this->filePath +
+                                 " was exported with another endianness.");
+    }
+    if (header.version != TPGGraphBinaryFormat::version) {
+        throw std::runtime_error("Unsupported version " +
+                                 std::to_string(header.version) +
+                                 " of binary TPGGraph file.");
+    }
+
+    const Environment& env = this->tpg.getEnvironment();
+    if (header.nbInstructions != env.getNbInstructions() ||
+        header.maxNbOperands != env.getMaxNbOperands() ||
+        header.nbRegisters != env.getNbRegisters() ||
+        header.nbConstants != env.getNbConstant() ||
+        header.nbDataSources != env.getNbDataSources()) {
+        throw std::runtime_error("Environment of the binary TPGGraph file is "
+                                 "not compatible with the one of the "
+                                 "TPGGraph.");
+    }
+}
+
+std::shared_ptr<Program::Program> File::TPGGraphBinaryImporter::readProgram(
+    const char*& cursor, const char* end) const
+{
+    const Environment& env = this->tpg.getEnvironment();
+    auto program = std::make_shared<Program::Program>(env);
+
+    uint64_t nbLines;
+    readRecord(nbLines, cursor, end);
+
+    // Constants, padded to 8 bytes
+    for (size_t i = 0; i < env.getNbConstant(); i++) {
+        int32_t value;
+        readRecord(value, cursor, end);
+        program->getConstantHandler().setDataAt(typeid(Data::Constant), i,
+                                                Data::Constant{value});
+    }
+    if (env.getNbConstant() % 2 != 0) {
+        int32_t padding;
+        readRecord(padding, cursor, end);
+    }
+
+    // Lines
+    size_t lineSize = (2 + 2 * env.getMaxNbOperands()) * sizeof(uint64_t);
+    if (nbLines > (size_t)(end - cursor) / lineSize) {
+        throw std::runtime_error("Binary TPGGraph file is truncated.");
+    }
+    for (uint64_t i = 0; i < nbLines; i++) {
+        Program::Line& line = program->addNewLine();
+        uint64_t instructionIdx, destinationIdx;
+        readRecord(instructionIdx, cursor, end);
+        readRecord(destinationIdx, cursor, end);
+        bool valid = line.setInstructionIndex(instructionIdx) &&
+                     line.setDestinationIndex(destinationIdx);
+        for (size_t j = 0; j < env.getMaxNbOperands(); j++) {
+            uint64_t dataIndex, location;
+            readRecord(dataIndex, cursor, end);
+            readRecord(location, cursor, end);
+            valid = line.setOperand(j, dataIndex, location) && valid;
+        }
+        if (!valid) {
+            throw std::runtime_error(
+                "Binary TPGGraph file contains an invalid Program line.");
+        }
+    }
+    program->identifyIntrons();
+
+    return program;
+}
+
+void File::TPGGraphBinaryImporter::setNewFilePath(const char* newFilePath)
+{
+    this->filePath = newFilePath;
+}
+
+void File::TPGGraphBinaryImporter::importGraph()
+{
+    FileView file(this->filePath);
+    const char* cursor = file.begin();
+    const char* end = file.end();
+
+    TPGGraphBinaryFormat::Header header;
+    readRecord(header, cursor, end);
+    this->checkHeader(header);
+
+    // Vertex table
+    std::vector<TPGGraphBinaryFormat::VertexEntry> vertexEntries;
+    if (header.nbVertices > (size_t)(end - cursor) /
+                                sizeof(TPGGraphBinaryFormat::VertexEntry)) {
+        throw std::runtime_error("Binary TPGGraph file is truncated.");
+    }
+    vertexEntries.resize(header.nbVertices);
+    for (auto& entry : vertexEntries) {
+        readRecord(entry, cursor, end);
+        if (entry.type != TPGGraphBinaryFormat::TEAM &&
+            entry.type != TPGGraphBinaryFormat::ACTION) {
+            throw std::runtime_error(
+                "Binary TPGGraph file contains an unknown vertex type.");
+        }
+    }
+
+    // Edge table
+    std::vector<TPGGraphBinaryFormat::EdgeEntry> edgeEntries;
+    if (header.nbEdges >
+        (size_t)(end - cursor) / sizeof(TPGGraphBinaryFormat::EdgeEntry)) {
+        throw std::runtime_error("Binary TPGGraph file is truncated.");
+    }
+    edgeEntries.resize(header.nbEdges);
+    for (auto& entry : edgeEntries) {
+        readRecord(entry, cursor, end);
+        if (entry.source >= header.nbVertices ||
+            entry.destination >= header.nbVertices ||
+            entry.program >= header.nbPrograms ||
+            vertexEntries.at(entry.source).type !=
+                TPGGraphBinaryFormat::TEAM) {
+            throw std::runtime_error(
+                "Binary TPGGraph file contains an invalid edge.");
+        }
+    }
+
+    // Program section
+    std::vector<std::shared_ptr<Program::Program>> programs;
+    for (uint64_t i = 0; i < header.nbPrograms; i++) {
+        programs.push_back(this->readProgram(cursor, end));
+    }
+
+    // Everything was read successfully, build the graph.
+    this->tpg.clear();
+    std::vector<const TPG::TPGVertex*> vertices;
+    vertices.reserve(vertexEntries.size());
+    for (const auto& entry : vertexEntries) {
+        if (entry.type == TPGGraphBinaryFormat::TEAM) {
+            vertices.push_back(&this->tpg.addNewTeam());
+        }
+        else {
+            vertices.push_back(&this->tpg.addNewAction(entry.actionID));
+        }
+    }
+    for (const auto& entry : edgeEntries) {
+        this->tpg.addNewEdge(*vertices.at(entry.source),
+                             *vertices.at(entry.destination),
+                             programs.at(entry.program));
+    }
+}
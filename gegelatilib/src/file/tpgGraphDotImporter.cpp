@@ -34,153 +34,159 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <mutex>
+
+#include "data/constant.h"
 #include "file/tpgGraphDotImporter.h"
 
 const std::string File::TPGGraphDotImporter::lineSeparator("&#92;n");
-const std::string File::TPGGraphDotImporter::teamRegex(
-    "T([0-9]+)\\x20\\x5B.*\\x5D");
-const std::string File::TPGGraphDotImporter::programRegex(
-    "P([0-9]+)\\x20\\x5B.*\\x5D");
-const std::string File::TPGGraphDotImporter::instructionRegex(
-    "I([0-9]+)\\x20\\x5B.*label=\"(.*)\"\\x5D");
-const std::string File::TPGGraphDotImporter::actionRegex(
-    "A([0-9]+)\\x20\\x5B.*=\"([0-9]+)\"\\x5D");
-const std::string File::TPGGraphDotImporter::linkProgramInstructionRegex(
-    "P([0-9]+)\\x20->\\x20I([0-9]+).*");
-const std::string File::TPGGraphDotImporter::linkProgramActionRegex(
-    "T([0-9]+)\\x20->\\x20P([0-9]+)\\x20->\\x20A([0-9]+).*");
-const std::string File::TPGGraphDotImporter::linkProgramTeamRegex(
-    "T([0-9]+)\\x20->\\x20P([0-9]+)\\x20->\\x20T([0-9]+).*");
-const std::string File::TPGGraphDotImporter::addLinkProgramRegex(
-    "T([0-9]+)\\x20->\\x20P([0-9]+)");
-
-void File::TPGGraphDotImporter::readOperands(std::string& str, Program::Line& l)
+
+bool File::TPGGraphDotImporter::readUInt(const char*& cursor, uint64_t& value)
 {
-    std::string::size_type pos = 0;
-    std::string::size_type pos2;
-    std::string::size_type pos3;
-
-    uint64_t o_idx = 0;
-    uint64_t dataIndex = 0;
-    uint64_t location = 0;
-
-    // operands are stored in str with the following format :
-    // op1_param1|op1_param2#...|param_N
-
-    for (int i = 0; i < this->tpg.getEnvironment().getMaxNbOperands(); ++i) {
-        pos2 = str.find("|");
-        dataIndex = std::stoi(str.substr(pos, pos2));
-        pos2++; // skip the '|'
-        pos3 = str.find("#");
-        location = std::stoi(str.substr(pos2, pos3 - pos2));
-        str = str.substr(pos3 + 1,
-                         str.size() -
-                             pos3); // store the rest of the string and iterate
-
-        l.setOperand(o_idx, dataIndex, location, true);
-        o_idx++;
+    if (*cursor < '0' || *cursor > '9') {
+        return false;
     }
+    value = 0;
+    while (*cursor >= '0' && *cursor <= '9') {
+        value = value * 10 + (*cursor - '0');
+        cursor++;
+    }
+    return true;
+}
+
+bool File::TPGGraphDotImporter::readToken(const char*& cursor,
+                                          const char* token)
+{
+    size_t length = strlen(token);
+    if (strncmp(cursor, token, length) != 0) {
+        return false;
+    }
+    cursor += length;
+    return true;
 }
 
-void File::TPGGraphDotImporter::readLine(std::smatch& matches)
+void File::TPGGraphDotImporter::readProgramLines(Program::Program& program,
+                                                 const std::string& label)
 {
     // a line is stored in the .dot file with the following format
     // inst_idx|dest_idx&op1_param1|op1_param2#...#opN_param1|opN_param2
-    if (!this->lastLine.empty() && !matches.empty()) {
-        uint64_t prog_label = std::stoi(matches[1]);
-        std::string label = matches[2];
-
-        auto p_it = programID.find(prog_label);
-        if (p_it != programID.end() && !label.empty()) {
-            std::shared_ptr<Program::Program> p = p_it->second;
-            // stores the whole program
-            std::string instruction;
-
-            // used to seek delimiters in the variable "instruction"
-            std::string::size_type pos;
-            std::string::size_type pos1;
-            std::string::size_type pos2;
-
-            // instruction index of a line
-            uint64_t instructionIdx;
-            // destination index of a line
-            uint64_t destinationIdx;
-            // store operands in a new string
-            std::string operands;
-
-            // as long as there are lines in the program, parse those lines
-            bool cont = true;
-            while (cont) {
-                Program::Line& l = p.get()->addNewLine();
-                pos = label.find(this->lineSeparator);
-                instruction = label.substr(0, pos);
-                label = label.substr(pos + this->lineSeparator.size(),
-                                     label.size());
-
-                // extract everything before pos (ie |)
-                // corresponds to instruction index
-                pos1 = instruction.find("|");
-                instructionIdx = std::stoi(instruction.substr(0, pos1));
-
-                // extract destination index;
-                pos2 = instruction.find("&");
-                pos1++; // skip the '|'
-                destinationIdx = std::stoi(instruction.substr(
-                    pos1, pos2 - pos1)); // extract and convert to int
-
-                // extract operands as a string
-                pos2++; // skip the '$'
-                operands = instruction.substr(pos2, instruction.size());
-
-                // add indexes to line
-                l.setInstructionIndex(instructionIdx);
-                l.setDestinationIndex(destinationIdx);
-
-                // parse operands
-                readOperands(operands, l);
-
-                if (label.size() <= 3) {
-                    cont = false;
-                }
+    const Environment& env = program.getEnvironment();
+    const char* cursor = label.c_str();
+    const char* end = cursor + label.size();
+    while (end - cursor > (std::ptrdiff_t)lineSeparator.size()) {
+        Program::Line& l = program.addNewLine();
+        uint64_t instructionIdx;
+        uint64_t destinationIdx;
+        if (!readUInt(cursor, instructionIdx) || !readToken(cursor, "|") ||
+            !readUInt(cursor, destinationIdx) || !readToken(cursor, "&")) {
+            throw std::runtime_error("Malformed program line in dot file.");
+        }
+        l.setInstructionIndex(instructionIdx);
+        l.setDestinationIndex(destinationIdx);
+
+        // operands
+        for (uint64_t i = 0; i < env.getMaxNbOperands(); i++) {
+            uint64_t dataIndex;
+            uint64_t location;
+            if ((i != 0 && !readToken(cursor, "#")) ||
+                !readUInt(cursor, dataIndex) || !readToken(cursor, "|") ||
+                !readUInt(cursor, location)) {
+                throw std::runtime_error(
+                    "Malformed program operand in dot file.");
             }
-            p->identifyIntrons();
+            l.setOperand(i, dataIndex, location, true);
+        }
+
+        if (!readToken(cursor, lineSeparator.c_str())) {
+            throw std::runtime_error("Malformed program line in dot file.");
         }
     }
+    program.identifyIntrons();
 }
 
-void File::TPGGraphDotImporter::readProgram(std::smatch& matches)
+void File::TPGGraphDotImporter::parsePrograms()
 {
-    if (!this->lastLine.empty() && !matches.empty()) {
-        // Program definition :
-        // P0 [fillcolor="#cccccc" shape=point] //const0|const1|...|constn|
-        std::string::size_type pos;
-        std::string::size_type pos1;
-        // read constants
-        std::vector<Data::Constant> v_constant;
-        pos = this->lastLine.find("//") + 2;
-        pos1 = this->lastLine.find("|", pos);
-        for (;;) {
-            if (pos1 != std::string::npos) {
-                v_constant.push_back(
-                    {std::stoi(this->lastLine.substr(pos, pos1 - pos))});
-            }
-            else {
-                break;
+    size_t nbJobs = this->pendingPrograms.size();
+    std::vector<std::exception_ptr> errors(nbJobs);
+    auto parseJob = [this, &errors](size_t jobIdx) {
+        try {
+            auto& job = this->pendingPrograms.at(jobIdx);
+            readProgramLines(*job.first, job.second);
+        }
+        catch (...) {
+            errors.at(jobIdx) = std::current_exception();
+        }
+    };
+
+    if (this->maxNbThreads <= 1 || nbJobs <= 1) {
+        for (size_t idx = 0; idx < nbJobs; idx++) {
+            parseJob(idx);
+        }
+    }
+    else {
+        std::mutex mutex;
+        size_t nextJob = 0;
+        auto parallelWorker = [&]() {
+            while (true) {
+                size_t jobIdx;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (nextJob == nbJobs) {
+                        return;
+                    }
+                    jobIdx = nextJob++;
+                }
+                parseJob(jobIdx);
             }
-            pos = pos1 + 1;
-            pos1 = this->lastLine.find("|", pos);
+        };
+
+        std::vector<std::thread> threads;
+        uint64_t nbThreads = std::min<uint64_t>(this->maxNbThreads, nbJobs);
+        for (uint64_t idx = 0; idx < nbThreads - 1; idx++) {
+            threads.emplace_back(parallelWorker);
+        }
+        parallelWorker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    this->pendingPrograms.clear();
+
+    // Rethrow the first error, in file order
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
-        // create new program with the correct amount of constants
-        Program::Program* p = new Program::Program(this->tpg.getEnvironment());
-        // set the previously read constants
-        for (int i = 0; i < v_constant.size(); i++) {
-            p->getConstantHandler().setDataAt(typeid(Data::Constant), i,
-                                              v_constant.at(i));
+    }
+}
+
+void File::TPGGraphDotImporter::readProgram(uint64_t id, const char* cursor)
+{
+    // Program definition :
+    // P0 [fillcolor="#cccccc" shape=point] //const0|const1|...|constn|
+    // create new program with the correct amount of constants
+    auto p = std::make_shared<Program::Program>(this->tpg.getEnvironment());
+
+    // read constants
+    const char* constants = strstr(cursor, "//");
+    if (constants != nullptr) {
+        cursor = constants + 2;
+        size_t idx = 0;
+        while (strchr(cursor, '|') != nullptr) {
+            int32_t value = (int32_t)strtol(cursor, (char**)&cursor, 10);
+            if (!readToken(cursor, "|")) {
+                throw std::runtime_error(
+                    "Malformed program constants in dot file.");
+            }
+            p->getConstantHandler().setDataAt(typeid(Data::Constant), idx++,
+                                              Data::Constant{value});
         }
-        this->programID.insert(
-            std::pair<uint64_t, std::shared_ptr<Program::Program>>(
-                std::stoi(matches[1]), p));
     }
+    this->programID.emplace(id, p);
 }
 
 void File::TPGGraphDotImporter::dumpTPGGraphHeader()
@@ -200,123 +206,107 @@ void File::TPGGraphDotImporter::dumpTPGGraphHeader()
     }
 }
 
-void File::TPGGraphDotImporter::readTeam(std::smatch& matches)
+void File::TPGGraphDotImporter::readTeam(uint64_t id)
+{
+    this->vertexID.emplace(id, &this->tpg.addNewTeam());
+}
+
+bool File::TPGGraphDotImporter::readAction(uint64_t id, const char* cursor)
 {
-    if (!this->lastLine.empty() && !matches.empty()) {
-        this->vertexID.insert(std::pair<uint64_t, const TPG::TPGVertex*>(
-            std::stoi(matches[1]), &this->tpg.addNewTeam()));
+    // the action label is the last ="<number>" sequence of the line.
+    const char* label = nullptr;
+    for (const char* found = strstr(cursor, "=\""); found != nullptr;
+         found = strstr(found + 1, "=\"")) {
+        label = found;
+    }
+    uint64_t actionLabel;
+    if (label == nullptr || !readToken(label, "=\"") ||
+        !readUInt(label, actionLabel) || !readToken(label, "\"]")) {
+        return false;
+    }
+
+    // create a new action if none was previously created with this label
+    if (this->actionID.count(actionLabel) == 0) {
+        this->actionID.emplace(actionLabel,
+                               &this->tpg.addNewAction(actionLabel));
     }
+    this->actionLabel.emplace(id, actionLabel);
+    return true;
 }
 
-void File::TPGGraphDotImporter::readAction(std::smatch& matches)
+bool File::TPGGraphDotImporter::readInstructions(uint64_t id,
+                                                 const char* cursor)
 {
-    if (!this->lastLine.empty() && !matches.empty()) {
-        // the regex matches two groups (action number and action label)
-        uint64_t action_label = std::stoi(matches[2]);
-        uint64_t action_number = std::stoi(matches[1]);
-
-        // elmt points to the action with the same label as the action we are
-        // parsing
-        auto elmt = actionID.find(action_label);
-        if (elmt == actionID.end()) {
-            // create a new action and insert it if none was previously found
-            this->actionID.insert(std::pair<uint64_t, const TPG::TPGVertex*>(
-                action_label, &this->tpg.addNewAction(action_label)));
-        }
-        this->actionLabel.insert(
-            std::pair<uint64_t, uint64_t>(action_number, action_label));
+    const char* label = strstr(cursor, "label=\"");
+    const char* end = strrchr(cursor, '"');
+    if (label == nullptr || end == nullptr || end < label + 7) {
+        return false;
     }
+    label += 7;
+
+    auto p_it = this->programID.find(id);
+    if (p_it != this->programID.end() && end > label) {
+        this->pendingPrograms.emplace_back(p_it->second,
+                                           std::string(label, end - label));
+    }
+    return true;
 }
 
-void File::TPGGraphDotImporter::readLinkTeamProgramAction(std::smatch& matches)
+bool File::TPGGraphDotImporter::readLink(uint64_t teamID, const char* cursor)
 {
-    // Creating a edge from a team to an action
-    if (!this->lastLine.empty() && !matches.empty()) {
-        uint64_t team_in = std::stoi(matches[1]);
-        uint64_t program = std::stoi(matches[2]);
-        uint64_t act_out = std::stoi(matches[3]);
+    uint64_t program;
+    if (!readToken(cursor, " -> P") || !readUInt(cursor, program)) {
+        return false;
+    }
+
+    auto team_it = this->vertexID.find(teamID);
+    auto p_it = this->programID.find(program);
 
+    // Link with an explicit destination
+    const TPG::TPGVertex* destination = nullptr;
+    uint64_t destID;
+    if (readToken(cursor, " -> A")) {
+        if (!readUInt(cursor, destID)) {
+            return false;
+        }
         // get the action depending on its label
-        auto action_lab = this->actionLabel.find(act_out);
+        auto action_lab = this->actionLabel.find(destID);
         if (action_lab != this->actionLabel.end()) {
-            auto team_it = this->vertexID.find(team_in);
             auto action_it = this->actionID.find(action_lab->second);
-            // find the program to add to the edge
-            auto p_it = programID.find(program);
-            if (team_it != vertexID.end() &&
-                action_it != this->actionID.end() && p_it != programID.end()) {
-                const TPG::TPGVertex* team = team_it->second;
-                const TPG::TPGVertex* action = action_it->second;
-                std::shared_ptr<Program::Program> p = p_it->second;
-                this->tpg.addNewEdge(*team, *action, p);
+            if (action_it != this->actionID.end()) {
+                destination = action_it->second;
             }
         }
     }
-}
-
-void File::TPGGraphDotImporter::readLinkTeamProgramTeam(std::smatch& matches)
-{
-    // creating a edge between two teams
-    if (!this->lastLine.empty() && !matches.empty()) {
-        uint64_t team_in = std::stoi(matches[1]);
-        uint64_t program = std::stoi(matches[2]);
-        uint64_t team_out = std::stoi(matches[3]);
-
-        // get the source and destination teams
-        auto t1_it = this->vertexID.find(team_in);
-        auto t2_it = this->vertexID.find(team_out);
-
-        // find the program
-        auto p_it = programID.find(program);
-        if (p_it != programID.end()) {
-            std::shared_ptr<Program::Program> p = p_it->second;
-            if (t1_it != this->vertexID.end() &&
-                t2_it != this->vertexID.end()) {
-                const TPG::TPGVertex* team_i = t1_it->second;
-                const TPG::TPGVertex* team_o = t2_it->second;
-                this->tpg.addNewEdge(*team_i, *team_o, p);
-            }
+    else if (readToken(cursor, " -> T")) {
+        if (!readUInt(cursor, destID)) {
+            return false;
+        }
+        auto t2_it = this->vertexID.find(destID);
+        if (t2_it != this->vertexID.end()) {
+            destination = t2_it->second;
         }
     }
-}
-
-void File::TPGGraphDotImporter::readLinkTeamProgram(std::smatch& matches)
-{
-    if (!this->lastLine.empty() && !matches.empty()) {
-        uint64_t team_in = std::stoi(matches[1]);
-        uint64_t program = std::stoi(matches[2]);
-
-        // find edge
-        const std::list<std::unique_ptr<TPG::TPGEdge>>& edges =
-            this->tpg.getEdges();
-
-        // find one of the selected program edges :
-        auto p_it = programID.find(program);
-        if (p_it != programID.end()) {
-            std::shared_ptr<Program::Program> p = p_it->second;
-
-            auto edge_it =
-                std::find_if(edges.begin(), edges.end(),
-                             [p](const std::unique_ptr<TPG::TPGEdge>& other) {
-                                 return (&(other->getProgram()) == p.get());
-                             });
-            if (edge_it != edges.end()) // we got the corresponding edge :
-            {
-                // then get the team :
-                auto team_it = this->vertexID.find(team_in);
-                if (team_it != this->vertexID.end()) {
-                    const TPG::TPGVertex* team = team_it->second;
-                    this->tpg.addNewEdge(
-                        *team, *(edge_it->get()->getDestination()), p);
-                }
-            }
+    else {
+        // Link to the destination of the program first edge
+        auto dest_it = this->programDestination.find(program);
+        if (dest_it != this->programDestination.end()) {
+            destination = dest_it->second;
         }
     }
+
+    if (team_it != this->vertexID.end() && p_it != this->programID.end() &&
+        destination != nullptr) {
+        this->tpg.addNewEdge(*team_it->second, *destination, p_it->second);
+        this->programDestination.emplace(program, destination);
+    }
+    return true;
 }
 
 void File::TPGGraphDotImporter::importGraph()
 {
     // force seek at the beginning of file.
+    pFile.clear();
     pFile.seekg(0);
 
     // clear every storing objects
@@ -325,30 +315,26 @@ void File::TPGGraphDotImporter::importGraph()
     this->actionID.clear();
     this->actionLabel.clear();
     this->programID.clear();
+    this->programDestination.clear();
+    this->pendingPrograms.clear();
 
     // skip header
     this->dumpTPGGraphHeader();
+
+    // Read the file, leaving the parsing of program bodies for later
     bool read = true;
     while (read) {
         read = this->readLineFromFile();
     }
+
+    // Parse program bodies
+    this->parsePrograms();
 }
 
 bool File::TPGGraphDotImporter::readLineFromFile()
 {
     char buffer[MAX_READ_SIZE];
 
-    std::regex testActionDeclare(this->actionRegex);
-    std::regex testTeamDeclare(this->teamRegex);
-    std::regex testProgramDeclare(this->programRegex);
-    std::regex testInstructionDeclare(this->instructionRegex);
-    std::regex testLinkPI(this->linkProgramInstructionRegex);
-    std::regex testLinkTPA(this->linkProgramActionRegex);
-    std::regex testLinkTPT(this->linkProgramTeamRegex);
-    std::regex testLinkTP(this->addLinkProgramRegex);
-
-    std::smatch matches;
-
     if (!pFile.getline(buffer, MAX_READ_SIZE))
         throw std::ifstream::failure("Couldn't read in the given file");
     else {
@@ -356,38 +342,39 @@ bool File::TPGGraphDotImporter::readLineFromFile()
     }
 
     // check the line shape and parse it
-    if (std::regex_search(this->lastLine, matches, testTeamDeclare)) {
-        readTeam(matches);
-    }
-    else if (std::regex_search(this->lastLine, matches, testActionDeclare)) {
-        readAction(matches);
+    const char* cursor = this->lastLine.c_str();
+    while (*cursor == ' ' || *cursor == '\t') {
+        cursor++;
     }
-    else if (std::regex_search(this->lastLine, matches, testProgramDeclare)) {
-        readProgram(matches);
-    }
-    else if (std::regex_search(this->lastLine, matches,
-                               testInstructionDeclare)) {
-        readLine(matches);
+    char type = *cursor++;
+    uint64_t id;
+    if ((type != 'T' && type != 'A' && type != 'P' && type != 'I') ||
+        !readUInt(cursor, id)) {
+        return false;
     }
-    else if (std::regex_search(this->lastLine, matches, testLinkPI)) {
+
+    bool declaration = readToken(cursor, " [");
+    switch (type) {
+    case 'T':
+        if (declaration) {
+            readTeam(id);
+            return true;
+        }
+        return readLink(id, cursor);
+    case 'A':
+        return declaration && readAction(id, cursor);
+    case 'P':
+        if (declaration) {
+            readProgram(id, cursor);
+            return true;
+        }
         // by definition, a program is linked to its instruction from its
         // declaration. the link is used vor visualisation but doesn't require
         // to be parsed
-        return true;
-    }
-    else if (std::regex_search(this->lastLine, matches, testLinkTPA)) {
-        readLinkTeamProgramAction(matches);
-    }
-    else if (std::regex_search(this->lastLine, matches, testLinkTPT)) {
-        readLinkTeamProgramTeam(matches);
+        return readToken(cursor, " -> I");
+    default: // 'I'
+        return declaration && readInstructions(id, cursor);
     }
-    else if (std::regex_search(this->lastLine, matches, testLinkTP)) {
-        readLinkTeamProgram(matches);
-    }
-    else {
-        return false;
-    }
-    return true;
 }
 
 void File::TPGGraphDotImporter::setNewFilePath(const char* newFilePath)
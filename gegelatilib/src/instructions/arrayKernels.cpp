@@ -0,0 +1,327 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ARRAY_KERNELS_AVX
+#include <immintrin.h>
+#endif
+
+#include "instructions/arrayKernels.h"
+
+using Instructions::ArrayKernels::NB_LANES;
+
+static_assert(sizeof(Data::Constant) == sizeof(int32_t),
+              "Constants are loaded as int32_t by vectorized kernels.");
+
+/// Pairwise combination of the lanes of a sum.
+static double combineSum(const double lanes[NB_LANES])
+{
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/// Pairwise combination of the lanes of a maximum.
+static double combineMax(const double lanes[NB_LANES])
+{
+    double m0 = (lanes[1] > lanes[0]) ? lanes[1] : lanes[0];
+    double m1 = (lanes[3] > lanes[2]) ? lanes[3] : lanes[2];
+    return (m1 > m0) ? m1 : m0;
+}
+
+/// Pairwise combination of the lanes of a minimum.
+static double combineMin(const double lanes[NB_LANES])
+{
+    double m0 = (lanes[1] < lanes[0]) ? lanes[1] : lanes[0];
+    double m1 = (lanes[3] < lanes[2]) ? lanes[3] : lanes[2];
+    return (m1 < m0) ? m1 : m0;
+}
+
+double Instructions::ArrayKernels::Scalar::sum(const double* a, size_t n)
+{
+    double lanes[NB_LANES] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < n; i++) {
+        lanes[i % NB_LANES] += a[i];
+    }
+    return combineSum(lanes);
+}
+
+double Instructions::ArrayKernels::Scalar::max(const double* a, size_t n)
+{
+    double lanes[NB_LANES] = {-INFINITY, -INFINITY, -INFINITY, -INFINITY};
+    for (size_t i = 0; i < n; i++) {
+        // NaN values never replace the accumulated value.
+        if (a[i] > lanes[i % NB_LANES]) {
+            lanes[i % NB_LANES] = a[i];
+        }
+    }
+    return combineMax(lanes);
+}
+
+double Instructions::ArrayKernels::Scalar::min(const double* a, size_t n)
+{
+    double lanes[NB_LANES] = {INFINITY, INFINITY, INFINITY, INFINITY};
+    for (size_t i = 0; i < n; i++) {
+        if (a[i] < lanes[i % NB_LANES]) {
+            lanes[i % NB_LANES] = a[i];
+        }
+    }
+    return combineMin(lanes);
+}
+
+double Instructions::ArrayKernels::Scalar::dotConstant(const double* a,
+                                                       const Data::Constant* c,
+                                                       size_t n)
+{
+    double lanes[NB_LANES] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < n; i++) {
+        lanes[i % NB_LANES] += a[i] * (double)c[i].value;
+    }
+    return combineSum(lanes);
+}
+
+double Instructions::ArrayKernels::Scalar::l1Distance(const double* a,
+                                                      const double* b,
+                                                      size_t n)
+{
+    double lanes[NB_LANES] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < n; i++) {
+        lanes[i % NB_LANES] += std::fabs(a[i] - b[i]);
+    }
+    return combineSum(lanes);
+}
+
+double Instructions::ArrayKernels::Scalar::l2Distance(const double* a,
+                                                      const double* b,
+                                                      size_t n)
+{
+    double lanes[NB_LANES] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < n; i++) {
+        double d = a[i] - b[i];
+        lanes[i % NB_LANES] += d * d;
+    }
+    return std::sqrt(combineSum(lanes));
+}
+
+#ifdef ARRAY_KERNELS_AVX
+// One __m256d holds the NB_LANES accumulators. The "avx" target does not
+// enable FMA, so multiplications and additions are never contracted and
+// results stay identical to the Scalar kernels.
+
+__attribute__((target("avx"))) static double sumAvx(const double* a,
+                                                     size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + NB_LANES <= n; i += NB_LANES) {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(a + i));
+    }
+    double lanes[NB_LANES];
+    _mm256_storeu_pd(lanes, acc);
+    for (; i < n; i++) {
+        lanes[i % NB_LANES] += a[i];
+    }
+    return combineSum(lanes);
+}
+
+__attribute__((target("avx"))) static double maxAvx(const double* a,
+                                                     size_t n)
+{
+    // _mm256_max_pd(x, acc) is (x > acc) ? x : acc, like the Scalar kernel.
+    __m256d acc = _mm256_set1_pd(-INFINITY);
+    size_t i = 0;
+    for (; i + NB_LANES <= n; i += NB_LANES) {
+        acc = _mm256_max_pd(_mm256_loadu_pd(a + i), acc);
+    }
+    double lanes[NB_LANES];
+    _mm256_storeu_pd(lanes, acc);
+    for (; i < n; i++) {
+        if (a[i] > lanes[i % NB_LANES]) {
+            lanes[i % NB_LANES] = a[i];
+        }
+    }
+    return combineMax(lanes);
+}
+
+__attribute__((target("avx"))) static double minAvx(const double* a,
+                                                     size_t n)
+{
+    __m256d acc = _mm256_set1_pd(INFINITY);
+    size_t i = 0;
+    for (; i + NB_LANES <= n; i += NB_LANES) {
+        acc = _mm256_min_pd(_mm256_loadu_pd(a + i), acc);
+    }
+    double lanes[NB_LANES];
+    _mm256_storeu_pd(lanes, acc);
+    for (; i < n; i++) {
+        if (a[i] < lanes[i % NB_LANES]) {
+            lanes[i % NB_LANES] = a[i];
+        }
+    }
+    return combineMin(lanes);
+}
+
+__attribute__((target("avx"))) static double dotConstantAvx(
+    const double* a, const Data::Constant* c, size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + NB_LANES <= n; i += NB_LANES) {
+        __m256d constants = _mm256_cvtepi32_pd(
+            _mm_loadu_si128((const __m128i*)(c + i)));
+        acc = _mm256_add_pd(
+            acc, _mm256_mul_pd(_mm256_loadu_pd(a + i), constants));
+    }
+    double lanes[NB_LANES];
+    _mm256_storeu_pd(lanes, acc);
+    for (; i < n; i++) {
+        lanes[i % NB_LANES] += a[i] * (double)c[i].value;
+    }
+    return combineSum(lanes);
+}
+
+__attribute__((target("avx"))) static double sumAbsDiffAvx(const double* a,
+                                                            const double* b,
+                                                            size_t n)
+{
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + NB_LANES <= n; i += NB_LANES) {
+        __m256d d =
+            _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        acc = _mm256_add_pd(acc, _mm256_andnot_pd(signMask, d));
+    }
+    double lanes[NB_LANES];
+    _mm256_storeu_pd(lanes, acc);
+    for (; i < n; i++) {
+        lanes[i % NB_LANES] += std::fabs(a[i] - b[i]);
+    }
+    return combineSum(lanes);
+}
+
+__attribute__((target("avx"))) static double sumSquaredDiffAvx(
+    const double* a, const double* b, size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + NB_LANES <= n; i += NB_LANES) {
+        __m256d d =
+            _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(d, d));
+    }
+    double lanes[NB_LANES];
+    _mm256_storeu_pd(lanes, acc);
+    for (; i < n; i++) {
+        double d = a[i] - b[i];
+        lanes[i % NB_LANES] += d * d;
+    }
+    return combineSum(lanes);
+}
+#endif // ARRAY_KERNELS_AVX
+
+bool Instructions::ArrayKernels::isVectorized()
+{
+#ifdef ARRAY_KERNELS_AVX
+    // Also checks that the operating system saves AVX registers.
+    static const bool avx = __builtin_cpu_supports("avx");
+    return avx;
+#else
+    return false;
+#endif
+}
+
+double Instructions::ArrayKernels::sum(const double* a, size_t n)
+{
+#ifdef ARRAY_KERNELS_AVX
+    if (isVectorized()) {
+        return sumAvx(a, n);
+    }
+#endif
+    return Scalar::sum(a, n);
+}
+
+double Instructions::ArrayKernels::max(const double* a, size_t n)
+{
+#ifdef ARRAY_KERNELS_AVX
+    if (isVectorized()) {
+        return maxAvx(a, n);
+    }
+#endif
+    return Scalar::max(a, n);
+}
+
+double Instructions::ArrayKernels::min(const double* a, size_t n)
+{
+#ifdef ARRAY_KERNELS_AVX
+    if (isVectorized()) {
+        return minAvx(a, n);
+    }
+#endif
+    return Scalar::min(a, n);
+}
+
+double Instructions::ArrayKernels::dotConstant(const double* a,
+                                               const Data::Constant* c,
+                                               size_t n)
+{
+#ifdef ARRAY_KERNELS_AVX
+    if (isVectorized()) {
+        return dotConstantAvx(a, c, n);
+    }
+#endif
+    return Scalar::dotConstant(a, c, n);
+}
+
+double Instructions::ArrayKernels::l1Distance(const double* a,
+                                              const double* b, size_t n)
+{
+#ifdef ARRAY_KERNELS_AVX
+    if (isVectorized()) {
+        return sumAbsDiffAvx(a, b, n);
+    }
+#endif
+    return Scalar::l1Distance(a, b, n);
+}
+
+double Instructions::ArrayKernels::l2Distance(const double* a,
+                                              const double* b, size_t n)
+{
+#ifdef ARRAY_KERNELS_AVX
+    if (isVectorized()) {
+        return std::sqrt(sumSquaredDiffAvx(a, b, n));
+    }
+#endif
+    return Scalar::l2Distance(a, b, n);
+}
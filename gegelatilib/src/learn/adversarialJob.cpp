@@ -41,6 +41,17 @@ void Learn::AdversarialJob::addRoot(const TPG::TPGVertex* root)
     roots.emplace_back(root);
 }
 
+void Learn::AdversarialJob::addFillerRoot(const TPG::TPGVertex* root)
+{
+    fillerPositions.insert(roots.size());
+    roots.emplace_back(root);
+}
+
+bool Learn::AdversarialJob::isFillerRoot(size_t i) const
+{
+    return fillerPositions.count(i) != 0;
+}
+
 size_t Learn::AdversarialJob::getSize() const
 {
     return roots.size();
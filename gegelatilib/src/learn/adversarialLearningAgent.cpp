@@ -35,10 +35,20 @@
  */
 
 #include <fstream>
+#include <algorithm>
 #include <memory>
+#include <set>
 
 #include "learn/adversarialLearningAgent.h"
 
+void Learn::AdversarialLearningAgent::init(uint64_t seed)
+{
+    LearningAgent::init(seed);
+
+    // Vertices of the new TPGGraph may reuse addresses of former ones.
+    this->clearMatchResultsCache();
+}
+
 std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
 Learn::AdversarialLearningAgent::evaluateAllRoots(uint64_t generationNumber,
                                                   Learn::LearningMode mode)
@@ -54,6 +64,109 @@ Learn::AdversarialLearningAgent::evaluateAllRoots(uint64_t generationNumber,
     return results;
 }
 
+void Learn::AdversarialLearningAgent::evaluateAllRootsInParallel(
+    uint64_t generationNumber, LearningMode mode,
+    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
+        results)
+{
+    // Create Archive Map
+    std::map<uint64_t, Archive*> archiveMap;
+    // Create Map for results
+    std::map<uint64_t,
+             std::pair<std::shared_ptr<EvaluationResult>, std::shared_ptr<Job>>>
+        resultsPerJobMap;
+
+    evaluateAllRootsInParallelExecute(generationNumber, mode, resultsPerJobMap,
+                                      archiveMap);
+
+    // Cache is updated only once all jobs were evaluated to keep the
+    // evaluation deterministic.
+    updateMatchResultsCache(resultsPerJobMap, mode);
+
+    evaluateAllRootsInParallelCompileResults(resultsPerJobMap, results,
+                                             archiveMap);
+}
+
+void Learn::AdversarialLearningAgent::updateMatchResultsCache(
+    const std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
+                                       std::shared_ptr<Job>>>&
+        resultsPerJobMap,
+    LearningMode mode)
+{
+    if (!this->learningEnvironment.isDeterministic()) {
+        return;
+    }
+
+    for (const auto& resultPerJob : resultsPerJobMap) {
+        auto advJob = std::dynamic_pointer_cast<Learn::AdversarialJob>(
+            resultPerJob.second.second);
+        auto res = std::dynamic_pointer_cast<AdversarialEvaluationResult>(
+            resultPerJob.second.first);
+        // Existing entries are kept: they hold the exact same result.
+        this->matchResultsCache.emplace(
+            std::make_pair(advJob->getRoots(), mode), res);
+    }
+}
+
+void Learn::AdversarialLearningAgent::decimateWorstRoots(
+    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
+        results)
+{
+    LearningAgent::decimateWorstRoots(results);
+
+    if (this->matchResultsCache.empty()) {
+        return;
+    }
+
+    // Purge matches involving removed vertices
+    auto vertices = this->tpg->getVertices();
+    std::set<const TPG::TPGVertex*> remainingVertices(vertices.begin(),
+                                                      vertices.end());
+    auto iter = this->matchResultsCache.begin();
+    while (iter != this->matchResultsCache.end()) {
+        const auto& roots = iter->first.first;
+        bool isObsolete = std::any_of(
+            roots.begin(), roots.end(),
+            [&remainingVertices](const TPG::TPGVertex* root) {
+                return remainingVertices.count(root) == 0;
+            });
+        if (isObsolete) {
+            iter = this->matchResultsCache.erase(iter);
+        }
+        else {
+            iter++;
+        }
+    }
+}
+
+void Learn::AdversarialLearningAgent::clearMatchResultsCache()
+{
+    this->matchResultsCache.clear();
+}
+
+size_t Learn::AdversarialLearningAgent::getNbCachedMatchResults() const
+{
+    return this->matchResultsCache.size();
+}
+
+Util::MemoryUsage Learn::AdversarialLearningAgent::getMemoryUsage() const
+{
+    Util::MemoryUsage usage = LearningAgent::getMemoryUsage();
+
+    for (const auto& matchAndResult : this->matchResultsCache) {
+        usage.caches +=
+            Util::getMapNodeSize<
+                std::pair<std::vector<const TPG::TPGVertex*>, LearningMode>,
+                std::shared_ptr<AdversarialEvaluationResult>>() +
+            matchAndResult.first.first.capacity() *
+                sizeof(const TPG::TPGVertex*) +
+            Util::getSharedObjectSize<AdversarialEvaluationResult>() +
+            matchAndResult.second->getSize() * sizeof(double);
+    }
+
+    return usage;
+}
+
 void Learn::AdversarialLearningAgent::evaluateAllRootsInParallelCompileResults(
     std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
                                  std::shared_ptr<Job>>>& resultsPerJobMap,
@@ -79,6 +192,10 @@ void Learn::AdversarialLearningAgent::evaluateAllRootsInParallelCompileResults(
         // only take 1 root in consideration.
         for (int i = std::max((int16_t)0, advJob->getPosOfStudiedRoot());
              i < advJob->getSize(); i++) {
+            // Filler roots only complete the match.
+            if (advJob->isFillerRoot(i)) {
+                continue;
+            }
             auto root = (*advJob)[i];
             auto iterator = resultsPerRootMap.find(root);
             if (iterator == resultsPerRootMap.end()) {
@@ -129,6 +246,18 @@ std::shared_ptr<Learn::EvaluationResult> Learn::AdversarialLearningAgent::
 {
     auto& ale = (AdversarialLearningEnvironment&)le;
 
+    // Serve the match from cache if its outcome is already known.
+    // The cache is not modified during the evaluation, hence no need for
+    // mutual exclusion.
+    if (this->learningEnvironment.isDeterministic()) {
+        auto iter = this->matchResultsCache.find(
+            std::make_pair(((const AdversarialJob&)job).getRoots(), mode));
+        if (iter != this->matchResultsCache.end()) {
+            return std::make_shared<AdversarialEvaluationResult>(
+                *iter->second);
+        }
+    }
+
     // Init results
     auto results = std::make_shared<AdversarialEvaluationResult>(
         this->agentsPerEvaluation);
@@ -0,0 +1,632 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <cerrno>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "data/dataHandlerSerialization.h"
+#include "program/programSerialization.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgEdge.h"
+
+#include "learn/distributedLearningAgent.h"
+
+using Data::Serialization::appendDataHandlerContent;
+using Data::Serialization::appendValue;
+using Data::Serialization::readDataHandlerContent;
+using Data::Serialization::readValue;
+using Program::Serialization::appendProgram;
+using Program::Serialization::readProgram;
+
+std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
+Learn::DistributedLearningAgent::evaluateAllRoots(uint64_t generationNumber,
+                                                  Learn::LearningMode mode)
+{
+    if (this->maxNbThreads <= 1) {
+        // Sequential mode
+        return ParallelLearningAgent::evaluateAllRoots(generationNumber, mode);
+    }
+
+    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
+        results;
+    evaluateAllRootsInParallel(generationNumber, mode, results);
+    return results;
+}
+
+Learn::DistributedLearningAgent::~DistributedLearningAgent()
+{
+    this->stopWorkers();
+}
+
+std::string Learn::DistributedLearningAgent::encodeJob(
+    const Job& job, uint64_t jobIdx, uint64_t generationNumber,
+    LearningMode mode, std::vector<const Program::Program*>& programs) const
+{
+    std::string message;
+    appendValue<uint64_t>(message, jobIdx);
+    appendValue<uint64_t>(message, generationNumber);
+    appendValue<uint64_t>(message, (uint64_t)mode);
+    appendValue<uint64_t>(message, job.getArchiveSeed());
+
+    // Browse the subgraph reachable from the root, in breadth-first order.
+    // Outgoing edges of each vertex are kept in their order.
+    std::vector<const TPG::TPGVertex*> vertices{job.getRoot()};
+    std::map<const TPG::TPGVertex*, uint64_t> vertexIndexes{
+        {job.getRoot(), 0}};
+    std::map<const Program::Program*, uint64_t> programIndexes;
+    std::string programsContent;
+    std::string edges;
+    uint64_t nbEdges = 0;
+    programs.clear();
+    for (size_t i = 0; i < vertices.size(); i++) {
+        for (const TPG::TPGEdge* edge : vertices[i]->getOutgoingEdges()) {
+            const TPG::TPGVertex* destination = edge->getDestination();
+            if (vertexIndexes.emplace(destination, vertices.size()).second) {
+                vertices.push_back(destination);
+            }
+            const Program::Program* program = &edge->getProgram();
+            if (programIndexes.emplace(program, programs.size()).second) {
+                programs.push_back(program);
+                appendProgram(programsContent, *program, this->env);
+            }
+            appendValue<uint64_t>(edges, i);
+            appendValue<uint64_t>(edges, vertexIndexes.at(destination));
+            appendValue<uint64_t>(edges, programIndexes.at(program));
+            nbEdges++;
+        }
+    }
+
+    appendValue<uint64_t>(message, vertices.size());
+    for (const TPG::TPGVertex* vertex : vertices) {
+        const auto* action = dynamic_cast<const TPG::TPGAction*>(vertex);
+        appendValue<uint8_t>(message, action != nullptr);
+        if (action != nullptr) {
+            appendValue<uint64_t>(message, action->getActionID());
+        }
+    }
+    appendValue<uint64_t>(message, programs.size());
+    message.append(programsContent);
+    appendValue<uint64_t>(message, nbEdges);
+    message.append(edges);
+
+    return message;
+}
+
+const TPG::TPGVertex* Learn::DistributedLearningAgent::decodeJob(
+    const std::string& message, TPG::TPGGraph& graph, uint64_t& jobIdx,
+    uint64_t& generationNumber, LearningMode& mode, uint64_t& archiveSeed,
+    std::vector<const Program::Program*>& programs) const
+{
+    graph.clear();
+    programs.clear();
+
+    size_t offset = 0;
+    jobIdx = readValue<uint64_t>(message, offset);
+    generationNumber = readValue<uint64_t>(message, offset);
+    mode = (LearningMode)readValue<uint64_t>(message, offset);
+    archiveSeed = readValue<uint64_t>(message, offset);
+
+    // Sizes are checked against the message size before allocations.
+    uint64_t nbVertices = readValue<uint64_t>(message, offset);
+    if (nbVertices == 0 || nbVertices > message.size() - offset) {
+        throw std::runtime_error("Malformed job message.");
+    }
+    std::vector<const TPG::TPGVertex*> vertices;
+    for (uint64_t i = 0; i < nbVertices; i++) {
+        if (readValue<uint8_t>(message, offset) != 0) {
+            vertices.push_back(
+                &graph.addNewAction(readValue<uint64_t>(message, offset)));
+        }
+        else {
+            vertices.push_back(&graph.addNewTeam());
+        }
+    }
+
+    uint64_t nbPrograms = readValue<uint64_t>(message, offset);
+    if (nbPrograms > message.size() - offset) {
+        throw std::runtime_error("Malformed job message.");
+    }
+    std::vector<std::shared_ptr<Program::Program>> sharedPrograms;
+    for (uint64_t i = 0; i < nbPrograms; i++) {
+        sharedPrograms.push_back(
+            readProgram(message, offset, graph.getEnvironment()));
+        programs.push_back(sharedPrograms.back().get());
+    }
+
+    uint64_t nbEdges = readValue<uint64_t>(message, offset);
+    if (nbEdges > message.size() - offset) {
+        throw std::runtime_error("Malformed job message.");
+    }
+    for (uint64_t i = 0; i < nbEdges; i++) {
+        uint64_t source = readValue<uint64_t>(message, offset);
+        uint64_t destination = readValue<uint64_t>(message, offset);
+        uint64_t program = readValue<uint64_t>(message, offset);
+        if (source >= nbVertices || destination >= nbVertices ||
+            program >= nbPrograms) {
+            throw std::runtime_error("Malformed job message.");
+        }
+        graph.addNewEdge(*vertices[source], *vertices[destination],
+                         sharedPrograms[program]);
+    }
+
+    return vertices[0];
+}
+
+std::string Learn::DistributedLearningAgent::encodeJobResult(
+    uint64_t jobIdx, const EvaluationResult& result, const Archive* archive,
+    const std::vector<const Program::Program*>& programs) const
+{
+    std::string message;
+    appendValue<uint64_t>(message, jobIdx);
+    appendValue<double>(message, result.getResult());
+    appendValue<uint64_t>(message, result.getNbEvaluation());
+    appendValue<double>(message, result.getInferenceCost());
+
+    if (archive == nullptr) {
+        return message;
+    }
+
+    // Content of the archived DataHandler
+    std::string dataHandlersContent;
+    uint64_t nbDataHandlers = 0;
+    std::set<size_t> sentHashes;
+    for (const auto& hashAndDataHandlers : archive->getDataHandlers()) {
+        std::string content;
+        bool isSupported = true;
+        for (const auto& dHandler : hashAndDataHandlers.second) {
+            isSupported &= appendDataHandlerContent(content, dHandler.get());
+        }
+        if (isSupported) {
+            appendValue<uint64_t>(dataHandlersContent,
+                                  hashAndDataHandlers.first);
+            appendValue<uint64_t>(dataHandlersContent,
+                                  hashAndDataHandlers.second.size());
+            dataHandlersContent.append(content);
+            sentHashes.insert(hashAndDataHandlers.first);
+            nbDataHandlers++;
+        }
+    }
+    appendValue<uint64_t>(message, nbDataHandlers);
+    message.append(dataHandlersContent);
+
+    // Recordings, in their order of insertion. Program are identified by
+    // their index in the subgraph of the job.
+    std::map<const Program::Program*, uint64_t> programIndexes;
+    for (size_t i = 0; i < programs.size(); i++) {
+        programIndexes.emplace(programs[i], i);
+    }
+    std::string recordings;
+    uint64_t nbRecordings = 0;
+    for (uint64_t i = 0; i < archive->getNbRecordings(); i++) {
+        const ArchiveRecording& recording = archive->at(i);
+        auto programIndex = programIndexes.find(recording.prog);
+        if (sentHashes.count(recording.dataHash) != 0 &&
+            programIndex != programIndexes.end()) {
+            appendValue<uint64_t>(recordings, programIndex->second);
+            appendValue<uint64_t>(recordings, recording.dataHash);
+            appendValue<double>(recordings, recording.result);
+            nbRecordings++;
+        }
+    }
+    appendValue<uint64_t>(message, nbRecordings);
+    message.append(recordings);
+
+    return message;
+}
+
+std::shared_ptr<Learn::EvaluationResult> Learn::DistributedLearningAgent::
+    decodeJobResult(
+        const std::string& message,
+        const std::vector<std::shared_ptr<Job>>& jobs,
+        const std::vector<std::vector<const Program::Program*>>& programs,
+        uint64_t& jobIdx, Archive*& archive, LearningMode mode) const
+{
+    size_t offset = 0;
+    jobIdx = readValue<uint64_t>(message, offset);
+    if (jobIdx >= jobs.size() || jobIdx >= programs.size()) {
+        throw std::runtime_error("Invalid job index from a worker process.");
+    }
+    double score = readValue<double>(message, offset);
+    uint64_t nbEvaluation = readValue<uint64_t>(message, offset);
+    auto result = std::make_shared<EvaluationResult>(score, nbEvaluation);
+    result->setInferenceCost(readValue<double>(message, offset));
+
+    if (mode != LearningMode::TRAINING) {
+        return result;
+    }
+
+    // Rebuild the DataHandler from copies of the data sources
+    std::map<size_t, std::vector<std::unique_ptr<Data::DataHandler>>>
+        dataHandlers;
+    const auto& dataSources = this->env.getDataSources();
+    uint64_t nbDataHandlers = readValue<uint64_t>(message, offset);
+    for (uint64_t i = 0; i < nbDataHandlers; i++) {
+        size_t hash = readValue<uint64_t>(message, offset);
+        uint64_t nbDataSources = readValue<uint64_t>(message, offset);
+        if (nbDataSources != dataSources.size()) {
+            throw std::runtime_error("Archived data from a worker process "
+                                     "does not match the data sources.");
+        }
+        auto& copies = dataHandlers[hash];
+        for (uint64_t j = 0; j < nbDataSources; j++) {
+            copies.emplace_back(dataSources.at(j).get().clone());
+            readDataHandlerContent(message, offset, *copies.back());
+        }
+    }
+
+    // Replay the recordings in a new Archive
+    const std::vector<const Program::Program*>& jobPrograms =
+        programs.at(jobIdx);
+    std::unique_ptr<Archive> newArchive = std::make_unique<Archive>(
+        params.archiveSize, params.archivingProbability,
+        jobs.at(jobIdx)->getArchiveSeed());
+    uint64_t nbRecordings = readValue<uint64_t>(message, offset);
+    for (uint64_t i = 0; i < nbRecordings; i++) {
+        uint64_t programIndex = readValue<uint64_t>(message, offset);
+        size_t hash = readValue<uint64_t>(message, offset);
+        double recordingResult = readValue<double>(message, offset);
+        auto iter = dataHandlers.find(hash);
+        if (iter == dataHandlers.end() || programIndex >= jobPrograms.size()) {
+            throw std::runtime_error("Archived data from a worker process is "
+                                     "missing.");
+        }
+        std::vector<std::reference_wrapper<const Data::DataHandler>>
+            dHandlers;
+        for (const auto& dHandler : iter->second) {
+            dHandlers.push_back(*dHandler);
+        }
+        newArchive->addRecording(jobPrograms[programIndex], dHandlers,
+                                 recordingResult, true);
+    }
+    archive = newArchive.release();
+
+    return result;
+}
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+/// Write the given bytes to a socket, returns false on failure.
+static bool sendAll(int socket, const void* data, size_t size)
+{
+    const char* bytes = (const char*)data;
+    while (size > 0) {
+#ifdef MSG_NOSIGNAL
+        ssize_t nbSent = send(socket, bytes, size, MSG_NOSIGNAL);
+#else
+        ssize_t nbSent = send(socket, bytes, size, 0);
+#endif
+        if (nbSent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (nbSent <= 0) {
+            return false;
+        }
+        bytes += nbSent;
+        size -= nbSent;
+    }
+    return true;
+}
+
+/// Read the given number of bytes from a socket, returns false on failure.
+static bool receiveAll(int socket, void* data, size_t size)
+{
+    char* bytes = (char*)data;
+    while (size > 0) {
+        ssize_t nbReceived = recv(socket, bytes, size, 0);
+        if (nbReceived < 0 && errno == EINTR) {
+            continue;
+        }
+        if (nbReceived <= 0) {
+            return false;
+        }
+        bytes += nbReceived;
+        size -= nbReceived;
+    }
+    return true;
+}
+
+/// Send a message prefixed with its size.
+static bool sendMessage(int socket, const std::string& message)
+{
+    uint64_t size = message.size();
+    return sendAll(socket, &size, sizeof(size)) &&
+           sendAll(socket, message.data(), message.size());
+}
+
+/// Receive a message prefixed with its size.
+static bool receiveMessage(int socket, std::string& message)
+{
+    uint64_t size;
+    if (!receiveAll(socket, &size, sizeof(size))) {
+        return false;
+    }
+    message.resize(size);
+    return receiveAll(socket, &message[0], size);
+}
+#endif
+
+void Learn::DistributedLearningAgent::workerLoop(int socket)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    throw std::runtime_error(
+        "Worker processes are not supported on this platform.");
+#else
+    // The worker owns a private copy of the learning environment, and a
+    // private TPGGraph holding the subgraph of the current job.
+    std::shared_ptr<TPG::TPGGraph> graph =
+        this->tpg->getFactory().createTPGGraph(this->env);
+
+    std::string message;
+    while (receiveMessage(socket, message) && !message.empty()) {
+        uint64_t jobIdx;
+        uint64_t generationNumber;
+        LearningMode mode;
+        uint64_t archiveSeed;
+        std::vector<const Program::Program*> programs;
+        const TPG::TPGVertex* root =
+            this->decodeJob(message, *graph, jobIdx, generationNumber, mode,
+                            archiveSeed, programs);
+        Job job(root, archiveSeed, jobIdx);
+
+        // Dedicated archive and engine for the job, since the subgraph is
+        // rebuilt for each job.
+        std::unique_ptr<Archive> archive;
+        if (mode == LearningMode::TRAINING) {
+            archive = std::make_unique<Archive>(
+                params.archiveSize, params.archivingProbability, archiveSeed);
+        }
+        std::unique_ptr<TPG::TPGExecutionEngine> tee =
+            this->tpg->getFactory().createTPGExecutionEngine(this->env,
+                                                             archive.get());
+
+        std::shared_ptr<EvaluationResult> result = this->evaluateJob(
+            *tee, job, generationNumber, mode, this->learningEnvironment);
+
+        if (!sendMessage(socket, this->encodeJobResult(jobIdx, *result,
+                                                       archive.get(),
+                                                       programs))) {
+            throw std::runtime_error("Main process can not be reached.");
+        }
+    }
+#endif
+}
+
+void Learn::DistributedLearningAgent::startWorkers()
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    throw std::runtime_error(
+        "Worker processes are not supported on this platform.");
+#else
+    if (!this->workerSockets.empty() || this->maxNbThreads <= 1) {
+        return;
+    }
+
+    try {
+        for (size_t i = 0; i < this->maxNbThreads; i++) {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+                throw std::runtime_error(
+                    "Socket for a worker process could not be created.");
+            }
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(fds[0]);
+                close(fds[1]);
+                throw std::runtime_error(
+                    "Worker process could not be created.");
+            }
+            if (pid == 0) {
+                // Worker process: never returns to the caller.
+                close(fds[0]);
+                for (auto socket : this->workerSockets) {
+                    close(socket);
+                }
+                int status = EXIT_SUCCESS;
+                try {
+                    this->workerLoop(fds[1]);
+                }
+                catch (...) {
+                    status = EXIT_FAILURE;
+                }
+                close(fds[1]);
+                _exit(status);
+            }
+            close(fds[1]);
+            this->workerSockets.push_back(fds[0]);
+            this->workerPids.push_back(pid);
+        }
+    }
+    catch (...) {
+        this->stopWorkers(true);
+        throw;
+    }
+#endif
+}
+
+void Learn::DistributedLearningAgent::stopWorkers(bool kill)
+{
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+    // Workers stop on an empty message, or when their socket is closed.
+    for (auto socket : this->workerSockets) {
+        if (!kill) {
+            sendMessage(socket, std::string());
+        }
+        close(socket);
+    }
+    for (auto pid : this->workerPids) {
+        if (kill) {
+            ::kill((pid_t)pid, SIGKILL);
+        }
+        waitpid((pid_t)pid, nullptr, 0);
+    }
+#endif
+    this->workerSockets.clear();
+    this->workerPids.clear();
+}
+
+size_t Learn::DistributedLearningAgent::getNbWorkers() const
+{
+    return this->workerSockets.size();
+}
+
+void Learn::DistributedLearningAgent::evaluateAllRootsInParallelExecute(
+    uint64_t generationNumber, LearningMode mode,
+    std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
+                                 std::shared_ptr<Job>>>& resultsPerJobMap,
+    std::map<uint64_t, Archive*>& archiveMap)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    throw std::runtime_error(
+        "Worker processes are not supported on this platform.");
+#else
+    auto jobsQueue = makeJobs(mode);
+    std::vector<std::shared_ptr<Job>> jobs;
+    while (!jobsQueue.empty()) {
+        jobs.push_back(jobsQueue.front());
+        jobsQueue.pop();
+    }
+
+    // Previous results of the roots are only known by the main process.
+    // Roots whose evaluation is skipped are handled here, and results of
+    // the others are combined with their previous result when received.
+    std::vector<uint64_t> jobsToSend;
+    std::vector<std::shared_ptr<EvaluationResult>> previousEvals(jobs.size());
+    for (uint64_t i = 0; i < jobs.size(); i++) {
+        const auto& job = jobs[i];
+        std::shared_ptr<EvaluationResult>& previousEval = previousEvals[i];
+        if (mode == LearningMode::TRAINING &&
+            this->isRootEvalSkipped(*job->getRoot(), previousEval)) {
+            resultsPerJobMap.emplace(job->getIdx(),
+                                     std::make_pair(previousEval, job));
+            archiveMap.insert(
+                {job->getIdx(),
+                 new Archive(params.archiveSize, params.archivingProbability,
+                             job->getArchiveSeed())});
+        }
+        else {
+            jobsToSend.push_back(i);
+        }
+    }
+    if (jobsToSend.empty()) {
+        return;
+    }
+
+    try {
+        this->startWorkers();
+
+        // Program sent with each job, to identify archived Program
+        std::vector<std::vector<const Program::Program*>> programs(
+            jobs.size());
+        size_t nextJob = 0;
+        size_t nbPendingJobs = 0;
+        auto sendNextJob = [&](int socket) {
+            uint64_t jobIdx = jobsToSend[nextJob++];
+            if (!sendMessage(socket,
+                             this->encodeJob(*jobs[jobIdx], jobIdx,
+                                             generationNumber, mode,
+                                             programs[jobIdx]))) {
+                throw std::runtime_error(
+                    "Worker process terminated unexpectedly.");
+            }
+            nbPendingJobs++;
+        };
+
+        // Give a first job to each worker
+        std::vector<pollfd> pollFds;
+        for (auto socket : this->workerSockets) {
+            if (nextJob < jobsToSend.size()) {
+                sendNextJob(socket);
+                pollFds.push_back({socket, POLLIN, 0});
+            }
+        }
+
+        // Gather results and distribute remaining jobs
+        while (nbPendingJobs > 0) {
+            if (poll(pollFds.data(), pollFds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Failed to wait for workers.");
+            }
+            for (auto& pollFd : pollFds) {
+                if (pollFd.revents == 0) {
+                    continue;
+                }
+                std::string message;
+                if (!receiveMessage(pollFd.fd, message)) {
+                    throw std::runtime_error(
+                        "Worker process terminated unexpectedly.");
+                }
+                uint64_t jobIdx;
+                Archive* archive = nullptr;
+                auto result = this->decodeJobResult(message, jobs, programs,
+                                                    jobIdx, archive, mode);
+                if (previousEvals[jobIdx] != nullptr) {
+                    *result += *previousEvals[jobIdx];
+                }
+                const auto& job = jobs.at(jobIdx);
+                resultsPerJobMap.emplace(job->getIdx(),
+                                         std::make_pair(result, job));
+                if (mode == LearningMode::TRAINING) {
+                    archiveMap.insert({job->getIdx(), archive});
+                }
+                nbPendingJobs--;
+
+                if (nextJob < jobsToSend.size()) {
+                    sendNextJob(pollFd.fd);
+                }
+            }
+        }
+    }
+    catch (...) {
+        this->stopWorkers(true);
+        for (auto& idxAndArchive : archiveMap) {
+            delete idxAndArchive.second;
+        }
+        archiveMap.clear();
+        throw;
+    }
+#endif
+}
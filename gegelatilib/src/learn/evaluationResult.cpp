@@ -46,6 +46,16 @@ size_t Learn::EvaluationResult::getNbEvaluation() const
     return this->nbEvaluation;
 }
 
+double Learn::EvaluationResult::getInferenceCost() const
+{
+    return this->inferenceCost;
+}
+
+void Learn::EvaluationResult::setInferenceCost(double cost)
+{
+    this->inferenceCost = cost;
+}
+
 Learn::EvaluationResult& Learn::EvaluationResult::operator+=(
     const Learn::EvaluationResult& other)
 {
@@ -56,6 +66,13 @@ Learn::EvaluationResult& Learn::EvaluationResult::operator+=(
         throw std::runtime_error("Type mismatch between EvaluationResults.");
     }
 
+    // Weighted addition of inference costs
+    this->inferenceCost =
+        this->inferenceCost * (double)this->nbEvaluation +
+        other.inferenceCost * (double)other.nbEvaluation;
+    this->inferenceCost /=
+        (double)this->nbEvaluation + (double)other.nbEvaluation;
+
     // If the added type is Learn::EvaluationResult
     if (thisType == typeid(Learn::EvaluationResult)) {
         // Weighted addition of results
@@ -0,0 +1,191 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "data/hash.h"
+#include "util/trainingLoop.h"
+
+#include "learn/islandLearningAgent.h"
+
+Learn::IslandLearningAgent::IslandLearningAgent(
+    LearningEnvironment& le, const Instructions::Set& iSet,
+    const LearningParameters& p, size_t nbIslands, uint64_t migrationPeriod,
+    size_t nbMigrants, const TPG::TPGFactory& factory)
+    : params{p}, migrationPeriod{migrationPeriod}, nbMigrants{nbMigrants}
+{
+    if (nbIslands == 0) {
+        throw std::runtime_error("An IslandLearningAgent needs at least one "
+                                 "island.");
+    }
+    if (nbIslands > 1 && !le.isCopyable()) {
+        throw std::runtime_error(
+            "Islands can not be created with a non copyable environment.");
+    }
+
+    // Share threads between islands
+    LearningParameters islandParams = p;
+    islandParams.nbThreads = std::max((size_t)1, p.nbThreads / nbIslands);
+
+    for (size_t i = 0; i < nbIslands; i++) {
+        LearningEnvironment* islandLE = &le;
+        if (i > 0) {
+            this->learningEnvironments.emplace_back(le.clone());
+            islandLE = this->learningEnvironments.back().get();
+        }
+        this->islands.emplace_back(std::make_unique<ParallelLearningAgent>(
+            *islandLE, iSet, islandParams, factory));
+    }
+}
+
+size_t Learn::IslandLearningAgent::getNbIslands() const
+{
+    return this->islands.size();
+}
+
+Learn::ParallelLearningAgent& Learn::IslandLearningAgent::getIsland(size_t idx)
+{
+    return *this->islands.at(idx);
+}
+
+void Learn::IslandLearningAgent::init(uint64_t seed)
+{
+    Data::Hash<uint64_t> hasher;
+    for (size_t i = 0; i < this->islands.size(); i++) {
+        this->islands.at(i)->init(hasher(seed) ^ hasher(i));
+    }
+}
+
+void Learn::IslandLearningAgent::trainOneGeneration(uint64_t generationNumber)
+{
+    // Train the islands concurrently
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < this->islands.size(); i++) {
+        threads.emplace_back(std::thread(
+            &ParallelLearningAgent::trainOneGeneration,
+            this->islands.at(i).get(), generationNumber));
+    }
+    this->islands.at(0)->trainOneGeneration(generationNumber);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (this->migrationPeriod != 0 &&
+        (generationNumber + 1) % this->migrationPeriod == 0) {
+        this->migrate();
+    }
+}
+
+std::vector<const TPG::TPGVertex*> Learn::IslandLearningAgent::selectMigrants(
+    ParallelLearningAgent& island) const
+{
+    const auto& resultsPerRoot = island.getResultsPerRoot();
+
+    // Keep evaluated teams only
+    std::vector<std::pair<const TPG::TPGVertex*, double>> candidates;
+    for (auto root : island.getTPGGraph()->getRootVertices()) {
+        auto result = resultsPerRoot.find(root);
+        if (dynamic_cast<const TPG::TPGTeam*>(root) != nullptr &&
+            result != resultsPerRoot.end()) {
+            candidates.emplace_back(root, result->second->getResult());
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const std::pair<const TPG::TPGVertex*, double>& a,
+                        const std::pair<const TPG::TPGVertex*, double>& b) {
+                         return a.second > b.second;
+                     });
+
+    std::vector<const TPG::TPGVertex*> migrants;
+    for (size_t i = 0; i < std::min(this->nbMigrants, candidates.size());
+         i++) {
+        migrants.push_back(candidates.at(i).first);
+    }
+    return migrants;
+}
+
+void Learn::IslandLearningAgent::migrate()
+{
+    if (this->islands.size() < 2) {
+        return;
+    }
+
+    // Select all migrants before any copy, so that migrants received by an
+    // island are not sent again.
+    std::vector<std::vector<const TPG::TPGVertex*>> migrants;
+    for (auto& island : this->islands) {
+        migrants.push_back(this->selectMigrants(*island));
+    }
+
+    for (size_t i = 0; i < this->islands.size(); i++) {
+        auto& destination =
+            *this->islands.at((i + 1) % this->islands.size())->getTPGGraph();
+        for (auto migrant : migrants.at(i)) {
+            destination.importSubGraph(*migrant);
+        }
+    }
+}
+
+uint64_t Learn::IslandLearningAgent::train(volatile bool& altTraining,
+                                           bool printProgressBar)
+{
+    return Util::trainGenerations(
+        [this](uint64_t generationNumber) {
+            this->trainOneGeneration(generationNumber);
+        },
+        this->params.nbGenerations, altTraining, printProgressBar);
+}
+
+size_t Learn::IslandLearningAgent::getBestIslandIdx() const
+{
+    size_t bestIdx = 0;
+    for (size_t i = 1; i < this->islands.size(); i++) {
+        const auto& best = this->islands.at(bestIdx)->getBestRoot().second;
+        const auto& candidate = this->islands.at(i)->getBestRoot().second;
+        if (candidate != nullptr &&
+            (best == nullptr || candidate->getResult() > best->getResult())) {
+            bestIdx = i;
+        }
+    }
+    return bestIdx;
+}
+
+const std::pair<const TPG::TPGVertex*,
+                std::shared_ptr<Learn::EvaluationResult>>&
+Learn::IslandLearningAgent::getBestRoot() const
+{
+    return this->islands.at(this->getBestIslandIdx())->getBestRoot();
+}
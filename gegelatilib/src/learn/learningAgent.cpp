@@ -36,6 +36,7 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
 #include <inttypes.h>
 #include <queue>
 
@@ -43,7 +44,11 @@
 #include "learn/evaluationResult.h"
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
+#include "tpg/instrumented/streamingExecutionStats.h"
+#include "tpg/instrumented/tpgExecutionEngineInstrumented.h"
 #include "tpg/tpgExecutionEngine.h"
+#include "util/profiler.h"
+#include "util/trainingLoop.h"
 
 #include "learn/learningAgent.h"
 
@@ -89,6 +94,24 @@ void Learn::LearningAgent::addLogger(Log::LALogger& logger)
     loggers.push_back(std::reference_wrapper<Log::LALogger>(logger));
 }
 
+#ifdef NATIVE_BACKEND
+void Learn::LearningAgent::setNativeBackend(CodeGen::NativeBackend* backend)
+{
+    this->nativeBackend = backend;
+}
+#endif // NATIVE_BACKEND
+
+std::unique_ptr<TPG::TPGExecutionEngine> Learn::LearningAgent::
+    createTPGExecutionEngine(const Environment& env, Archive* arch) const
+{
+    std::unique_ptr<TPG::TPGExecutionEngine> tee =
+        this->tpg->getFactory().createTPGExecutionEngine(env, arch);
+#ifdef NATIVE_BACKEND
+    tee->setNativeBackend(this->nativeBackend);
+#endif // NATIVE_BACKEND
+    return tee;
+}
+
 bool Learn::LearningAgent::isRootEvalSkipped(
     const TPG::TPGVertex& root,
     std::shared_ptr<Learn::EvaluationResult>& previousResult) const
@@ -126,6 +149,22 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
     // Init results
     double result = 0.0;
 
+    // Measure the inference cost when it is used for selection
+    TPG::TPGExecutionEngineInstrumented* teeInstrumented = nullptr;
+    std::unique_ptr<TPG::StreamingExecutionStats> costStats;
+    if (this->isInferenceCostSelected()) {
+        teeInstrumented =
+            dynamic_cast<TPG::TPGExecutionEngineInstrumented*>(&tee);
+        if (teeInstrumented == nullptr) {
+            throw std::runtime_error(
+                "Selecting roots on their inference cost requires a TPGGraph "
+                "built with a TPGInstrumentedFactory.");
+        }
+        costStats = std::make_unique<TPG::StreamingExecutionStats>(
+            this->env.getNbInstructions(), 1);
+        teeInstrumented->setStreamingStats(costStats.get());
+    }
+
     // Evaluate nbIteration times
     for (auto i = 0; i < this->params.nbIterationsPerPolicyEvaluation; i++) {
         // Compute a Hash
@@ -133,8 +172,12 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
         uint64_t hash = hasher(generationNumber) ^ hasher(i);
 
         // Reset the learning Environment
-        le.reset(hash, mode);
+        {
+            Util::Profiler::Span span("resetEnvironment", "evaluation");
+            le.reset(hash, mode);
+        }
 
+        Util::Profiler::Span actionSpan("actionLoop", "evaluation");
         uint64_t nbActions = 0;
         while (!le.isTerminal() &&
                nbActions < this->params.maxNbActionsPerEval) {
@@ -158,6 +201,11 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
             result / (double)params.nbIterationsPerPolicyEvaluation,
             params.nbIterationsPerPolicyEvaluation));
 
+    if (teeInstrumented != nullptr) {
+        teeInstrumented->setStreamingStats(nullptr);
+        evaluationResult->setInferenceCost(costStats->getAvgExecutedLines());
+    }
+
     // Combine it with previous one if any
     if (previousEval != nullptr) {
         *evaluationResult += *previousEval;
@@ -175,7 +223,7 @@ Learn::LearningAgent::evaluateAllRoots(uint64_t generationNumber,
     // Create the TPGExecutionEngine for this evaluation.
     // The engine uses the Archive only in training mode.
     std::unique_ptr<TPG::TPGExecutionEngine> tee =
-        this->tpg->getFactory().createTPGExecutionEngine(
+        this->createTPGExecutionEngine(
             this->env,
             (mode == LearningMode::TRAINING) ? &this->archive : NULL);
 
@@ -207,7 +255,7 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateOneRoot(
     // Create the TPGExecutionEngine for this evaluation.
     // The engine uses the Archive only in training mode.
     std::unique_ptr<TPG::TPGExecutionEngine> tee =
-        this->tpg->getFactory().createTPGExecutionEngine(
+        this->createTPGExecutionEngine(
             this->env,
             (mode == LearningMode::TRAINING) ? &this->archive : NULL);
 
@@ -223,32 +271,51 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateOneRoot(
 
 void Learn::LearningAgent::trainOneGeneration(uint64_t generationNumber)
 {
+    Util::Profiler::Span generationSpan("trainOneGeneration", "generation");
     for (auto logger : loggers) {
         logger.get().logNewGeneration(generationNumber);
     }
 
     // Populate Sequentially
-    Mutator::TPGMutator::populateTPG(*this->tpg, this->archive,
-                                     this->params.mutation, this->rng,
-                                     maxNbThreads);
+    {
+        Util::Profiler::Span span("populateTPG", "generation");
+        Mutator::TPGMutator::populateTPG(*this->tpg, this->archive,
+                                         this->params.mutation, this->rng,
+                                         maxNbThreads);
+    }
     for (auto logger : loggers) {
         logger.get().logAfterPopulateTPG();
     }
 
     // Evaluate
-    auto results =
-        this->evaluateAllRoots(generationNumber, LearningMode::TRAINING);
+    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
+        results;
+    {
+        Util::Profiler::Span span("evaluateAllRoots", "generation");
+        results =
+            this->evaluateAllRoots(generationNumber, LearningMode::TRAINING);
+    }
     for (auto logger : loggers) {
         logger.get().logAfterEvaluate(results);
     }
 
-    // Save the best score of this generation
-    this->updateBestScoreLastGen(results);
+    {
+        Util::Profiler::Span span("decimate", "generation");
+        // Save the best score of this generation
+        this->updateBestScoreLastGen(results);
 
-    // Remove worst performing roots
-    decimateWorstRoots(results);
-    // Update the best
-    this->updateEvaluationRecords(results);
+        // Remove worst performing roots
+        decimateWorstRoots(results);
+        // Update the best
+        this->updateEvaluationRecords(results);
+    }
+
+#ifdef NATIVE_BACKEND
+    // Submit long-lived programs for their native compilation.
+    if (this->nativeBackend != nullptr) {
+        this->nativeBackend->update(*this->tpg);
+    }
+#endif // NATIVE_BACKEND
 
     for (auto logger : loggers) {
         logger.get().logAfterDecimate();
@@ -256,6 +323,7 @@ void Learn::LearningAgent::trainOneGeneration(uint64_t generationNumber)
 
     // Does a validation or not according to the parameter doValidation
     if (params.doValidation) {
+        Util::Profiler::Span span("validation", "generation");
         auto validationResults =
             evaluateAllRoots(generationNumber, Learn::LearningMode::VALIDATION);
         for (auto logger : loggers) {
@@ -272,6 +340,41 @@ void Learn::LearningAgent::decimateWorstRoots(
     std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
         results)
 {
+    if (this->isInferenceCostSelected()) {
+        // Rank roots from the worst to the best, with a stable sort to keep
+        // the order of the results map for equivalent roots.
+        std::vector<std::multimap<std::shared_ptr<EvaluationResult>,
+                                  const TPG::TPGVertex*>::iterator>
+            ranking;
+        for (auto iter = results.begin(); iter != results.end(); iter++) {
+            ranking.push_back(iter);
+        }
+        std::stable_sort(ranking.begin(), ranking.end(),
+                         [this](const auto& a, const auto& b) {
+                             return this->isWorseWithInferenceCost(*a->first,
+                                                                   *b->first);
+                         });
+
+        // Remove the worst roots, except actions.
+        uint64_t nbRootsToDelete = (uint64_t)floor(
+            this->params.ratioDeletedRoots *
+            (double)params.mutation.tpg.nbRoots);
+        uint64_t nbDeletedRoots = 0;
+        for (auto iter : ranking) {
+            if (nbDeletedRoots >= nbRootsToDelete) {
+                break;
+            }
+            const TPG::TPGVertex* root = iter->second;
+            if (dynamic_cast<const TPG::TPGAction*>(root) == nullptr) {
+                tpg->removeVertex(*root);
+                this->resultsPerRoot.erase(root);
+                results.erase(iter);
+                nbDeletedRoots++;
+            }
+        }
+        return;
+    }
+
     // Some actions may be encountered but not removed while scanning the
     // results map they should be re-inserted to the list before leaving the
     // method.
@@ -303,48 +406,39 @@ void Learn::LearningAgent::decimateWorstRoots(
     results.insert(preservedActionRoots.begin(), preservedActionRoots.end());
 }
 
-uint64_t Learn::LearningAgent::train(volatile bool& altTraining,
-                                     bool printProgressBar)
+bool Learn::LearningAgent::isInferenceCostSelected() const
 {
-    const int barLength = 50;
-    uint64_t generationNumber = 0;
-
-    while (!altTraining && generationNumber < this->params.nbGenerations) {
-        // Train one generation
-        trainOneGeneration(generationNumber);
-        generationNumber++;
-
-        // Print progressBar (homemade, probably not ideal)
-        if (printProgressBar) {
-            printf("\rTraining ["); // back
-            // filling ratio
-            double ratio =
-                (double)generationNumber / (double)this->params.nbGenerations;
-            int filledPart = (int)((double)ratio * (double)barLength);
-            // filled part
-            for (int i = 0; i < filledPart; i++) {
-                printf("%c", (char)219);
-            }
-
-            // empty part
-            for (int i = filledPart; i < barLength; i++) {
-                printf(" ");
-            }
+    return this->params.inferenceCostWeight != 0.0 ||
+           this->params.maxInferenceCost != 0.0;
+}
 
-            printf("] %4.2f%%", ratio * 100.00);
+bool Learn::LearningAgent::isWorseWithInferenceCost(
+    const EvaluationResult& a, const EvaluationResult& b) const
+{
+    // Roots exceeding the inference cost budget are the worst.
+    if (this->params.maxInferenceCost != 0.0) {
+        bool aExceeds = a.getInferenceCost() > this->params.maxInferenceCost;
+        bool bExceeds = b.getInferenceCost() > this->params.maxInferenceCost;
+        if (aExceeds != bExceeds) {
+            return aExceeds;
         }
     }
 
-    if (printProgressBar) {
-        if (!altTraining) {
-            printf("\nTraining completed\n");
-        }
-        else {
-            printf("\nTraining alted at generation %" PRIu64 ".\n",
-                   generationNumber);
-        }
-    }
-    return generationNumber;
+    // Compare cost-penalized scores
+    return a.getResult() -
+               this->params.inferenceCostWeight * a.getInferenceCost() <
+           b.getResult() -
+               this->params.inferenceCostWeight * b.getInferenceCost();
+}
+
+uint64_t Learn::LearningAgent::train(volatile bool& altTraining,
+                                     bool printProgressBar)
+{
+    return Util::trainGenerations(
+        [this](uint64_t generationNumber) {
+            this->trainOneGeneration(generationNumber);
+        },
+        this->params.nbGenerations, altTraining, printProgressBar);
 }
 
 void Learn::LearningAgent::updateEvaluationRecords(
@@ -400,6 +494,27 @@ Learn::LearningAgent::getBestRoot() const
     return this->bestRoot;
 }
 
+const std::map<const TPG::TPGVertex*,
+               std::shared_ptr<Learn::EvaluationResult>>&
+Learn::LearningAgent::getResultsPerRoot() const
+{
+    return this->resultsPerRoot;
+}
+
+Util::MemoryUsage Learn::LearningAgent::getMemoryUsage() const
+{
+    Util::MemoryUsage usage;
+    this->tpg->addMemoryUsage(usage);
+    this->archive.addMemoryUsage(usage);
+
+    usage.caches += this->resultsPerRoot.size() *
+                    (Util::getMapNodeSize<const TPG::TPGVertex*,
+                                          std::shared_ptr<EvaluationResult>>() +
+                     Util::getSharedObjectSize<EvaluationResult>());
+
+    return usage;
+}
+
 void Learn::LearningAgent::updateBestScoreLastGen(
     std::multimap<std::shared_ptr<Learn::EvaluationResult>,
                   const TPG::TPGVertex*>& results)
@@ -431,6 +546,22 @@ void Learn::LearningAgent::keepBestPolicy()
     }
 }
 
+Learn::PolicyPruner::PruningResult Learn::LearningAgent::pruneBestPolicy(
+    double tolerance)
+{
+    if (this->bestRoot.first == nullptr ||
+        !this->tpg->hasVertex(*this->bestRoot.first)) {
+        throw std::runtime_error(
+            "The best root is not a TPGVertex of the TPGGraph.");
+    }
+    this->keepBestPolicy();
+
+    PolicyPruner pruner(this->learningEnvironment,
+                        this->params.nbIterationsPerPolicyEvaluation,
+                        this->params.maxNbActionsPerEval, tolerance);
+    return pruner.prune(*this->tpg, *this->bestRoot.first);
+}
+
 std::shared_ptr<Learn::Job> Learn::LearningAgent::makeJob(
     const TPG::TPGVertex* vertex, Learn::LearningMode mode, int idx,
     TPG::TPGGraph* tpgGraph)
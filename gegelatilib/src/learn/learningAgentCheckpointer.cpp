@@ -0,0 +1,990 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <sys/types.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+#include "data/dataHandlerSerialization.h"
+#include "program/programSerialization.h"
+#include "tpg/tpgAction.h"
+
+#include "learn/classificationEvaluationResult.h"
+#include "learn/learningAgentCheckpointer.h"
+
+using Data::Serialization::appendDataHandlerContent;
+using Data::Serialization::appendValue;
+using Data::Serialization::readDataHandlerContent;
+using Data::Serialization::readValue;
+using Program::Serialization::appendProgram;
+using Program::Serialization::readProgram;
+
+/// Magic number at the beginning of checkpoint files.
+static const char CHECKPOINT_MAGIC[8] = {'G', 'E', 'G', 'E',
+                                         'L', 'C', 'K', 'P'};
+
+/// Version of the checkpoint file format.
+static const uint32_t CHECKPOINT_VERSION = 3;
+
+/// Value used to detect an endianness mismatch when resuming.
+static const uint32_t CHECKPOINT_ENDIANNESS = 0x01020304;
+
+/// Size of the size and checksum preceding each record payload.
+static const size_t RECORD_HEADER_SIZE = 2 * sizeof(uint64_t);
+
+/// FNV-1a hash of a record payload, used to detect corrupted records.
+static uint64_t computeChecksum(const char* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (uint8_t)data[i];
+        hash *= 1099511628211u;
+    }
+    return hash;
+}
+
+/// Truncate a file to the given size.
+static bool truncateFile(const std::string& filePath, uint64_t size)
+{
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+    return truncate(filePath.c_str(), (off_t)size) == 0;
+#else
+    FILE* pFile = fopen(filePath.c_str(), "r+b");
+    if (pFile == nullptr) {
+        return false;
+    }
+    bool success = _chsize_s(_fileno(pFile), (__int64)size) == 0;
+    return (fclose(pFile) == 0) && success;
+#endif
+}
+
+struct Learn::LearningAgentCheckpointer::ReplayState
+{
+    /// Definition of the vertices of the current TPGGraph.
+    std::unordered_map<uint64_t, VertexEntry> vertices;
+
+    /// Definition of the edges of the current TPGGraph.
+    std::unordered_map<uint64_t, EdgeEntry> edges;
+
+    /// Program of the edges of the current TPGGraph.
+    std::unordered_map<uint64_t, std::shared_ptr<Program::Program>> programs;
+
+    /// Vertices of the current TPGGraph, in order.
+    std::vector<uint64_t> vertexIds;
+
+    /// Edges of the current TPGGraph, in order.
+    std::vector<uint64_t> edgeIds;
+
+    /// Archived DataHandler, copied from the data sources.
+    std::unordered_map<size_t, std::vector<std::unique_ptr<Data::DataHandler>>>
+        dataHandlers;
+
+    /// Archive recordings, in their order of insertion.
+    std::deque<RecordingEntry> recordings;
+
+    /// Number of generations of the last record.
+    uint64_t nbGenerations = 0;
+
+    /// Next identifier of the last record.
+    uint64_t nextId = 0;
+
+    /// Payload of the last record.
+    std::string payload;
+
+    /// Offset of the non-incremental part of the payload of the last record.
+    size_t stateOffset = 0;
+};
+
+Learn::LearningAgentCheckpointer::LearningAgentCheckpointer(
+    LearningAgent& agent, const std::string& filePath, bool resume,
+    uint64_t snapshotInterval)
+    : agent{agent}, filePath{filePath},
+      snapshotInterval{std::max<uint64_t>(snapshotInterval, 1)}
+{
+    if (resume && this->resumeFromFile()) {
+        this->pFile = fopen(filePath.c_str(), "ab");
+    }
+    else {
+        this->pFile = fopen(filePath.c_str(), "wb");
+        if (this->pFile != nullptr) {
+            std::string header = this->makeHeader();
+            fwrite(header.data(), 1, header.size(), this->pFile);
+            fflush(this->pFile);
+        }
+    }
+    if (this->pFile == nullptr) {
+        throw std::runtime_error("Could not open checkpoint file " +
+                                 filePath + ".");
+    }
+
+    this->writer = std::thread(&LearningAgentCheckpointer::writeRecords, this);
+}
+
+Learn::LearningAgentCheckpointer::~LearningAgentCheckpointer()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->writerMutex);
+        this->stopWriter = true;
+    }
+    this->writerCondition.notify_all();
+    this->writer.join();
+    if (this->pFile != nullptr) {
+        fclose(this->pFile);
+    }
+}
+
+uint64_t Learn::LearningAgentCheckpointer::getNbGenerations() const
+{
+    return this->nbGenerations;
+}
+
+void Learn::LearningAgentCheckpointer::checkpoint(uint64_t nbGenerations)
+{
+    this->checkWriterError();
+
+    this->nbGenerations = nbGenerations;
+    bool isSnapshot = this->nbRecordsInFile == 0 ||
+                      this->nbRecordsInFile >= this->snapshotInterval;
+    this->nbRecordsInFile = isSnapshot ? 1 : this->nbRecordsInFile + 1;
+    std::string payload = this->encodeState(isSnapshot);
+
+    std::string record;
+    record.reserve(RECORD_HEADER_SIZE + payload.size());
+    appendValue<uint64_t>(record, payload.size());
+    appendValue<uint64_t>(record,
+                          computeChecksum(payload.data(), payload.size()));
+    record.append(payload);
+
+    {
+        std::lock_guard<std::mutex> lock(this->writerMutex);
+        this->pendingRecords.emplace_back(std::move(record), isSnapshot);
+    }
+    this->writerCondition.notify_all();
+}
+
+void Learn::LearningAgentCheckpointer::wait()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->writerMutex);
+        this->writerCondition.wait(lock, [this] {
+            return (this->pendingRecords.empty() && !this->isWriting) ||
+                   this->writerError != nullptr;
+        });
+    }
+    this->checkWriterError();
+}
+
+void Learn::LearningAgentCheckpointer::checkWriterError()
+{
+    std::lock_guard<std::mutex> lock(this->writerMutex);
+    if (this->writerError != nullptr) {
+        std::rethrow_exception(this->writerError);
+    }
+}
+
+void Learn::LearningAgentCheckpointer::writeRecords()
+{
+    std::unique_lock<std::mutex> lock(this->writerMutex);
+    while (true) {
+        this->writerCondition.wait(lock, [this] {
+            return !this->pendingRecords.empty() || this->stopWriter;
+        });
+        // Records following a failed write depend on a state missing from
+        // the file, so they are dropped instead of being appended to it.
+        if (this->writerError != nullptr && !this->pendingRecords.empty()) {
+            this->pendingRecords.clear();
+            this->writerCondition.notify_all();
+        }
+        if (this->pendingRecords.empty()) {
+            if (this->stopWriter) {
+                // Stop requested and nothing left to write.
+                return;
+            }
+            continue;
+        }
+        std::string record = std::move(this->pendingRecords.front().first);
+        bool isSnapshot = this->pendingRecords.front().second;
+        this->pendingRecords.pop_front();
+        this->isWriting = true;
+        lock.unlock();
+
+        // Write without holding the lock so that the training thread can
+        // queue new records meanwhile.
+        bool success;
+        if (isSnapshot) {
+            success = this->writeSnapshot(record);
+        }
+        else {
+            success = this->pFile != nullptr &&
+                      fwrite(record.data(), 1, record.size(), this->pFile) ==
+                          record.size() &&
+                      fflush(this->pFile) == 0;
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+            success = success && fsync(fileno(this->pFile)) == 0;
+#endif
+        }
+
+        lock.lock();
+        this->isWriting = false;
+        if (!success && this->writerError == nullptr) {
+            this->writerError = std::make_exception_ptr(std::runtime_error(
+                "Could not write to checkpoint file " + this->filePath + "."));
+            this->pendingRecords.clear();
+        }
+        this->writerCondition.notify_all();
+    }
+}
+
+bool Learn::LearningAgentCheckpointer::writeSnapshot(const std::string& record)
+{
+    std::string tmpPath = this->filePath + ".tmp";
+    FILE* pTmpFile = fopen(tmpPath.c_str(), "wb");
+    if (pTmpFile == nullptr) {
+        return false;
+    }
+    std::string header = this->makeHeader();
+    bool success =
+        fwrite(header.data(), 1, header.size(), pTmpFile) == header.size() &&
+        fwrite(record.data(), 1, record.size(), pTmpFile) == record.size() &&
+        fflush(pTmpFile) == 0;
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+    success = success && fsync(fileno(pTmpFile)) == 0;
+#endif
+    success = (fclose(pTmpFile) == 0) && success;
+    if (!success) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    if (this->pFile != nullptr) {
+        fclose(this->pFile);
+    }
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    // rename() does not replace existing files on Windows.
+    std::remove(this->filePath.c_str());
+#endif
+    success = std::rename(tmpPath.c_str(), this->filePath.c_str()) == 0;
+    this->pFile = fopen(this->filePath.c_str(), "ab");
+    return success && this->pFile != nullptr;
+}
+
+std::string Learn::LearningAgentCheckpointer::makeHeader() const
+{
+    const Environment& env = this->agent.env;
+    std::string header(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    appendValue<uint32_t>(header, CHECKPOINT_VERSION);
+    appendValue<uint32_t>(header, CHECKPOINT_ENDIANNESS);
+    appendValue<uint64_t>(header, env.getNbInstructions());
+    appendValue<uint64_t>(header, env.getMaxNbOperands());
+    appendValue<uint64_t>(header, env.getNbRegisters());
+    appendValue<uint64_t>(header, env.getNbConstant());
+    appendValue<uint64_t>(header, env.getNbDataSources());
+    return header;
+}
+
+void Learn::LearningAgentCheckpointer::appendEvaluationResult(
+    std::string& buffer, const EvaluationResult& result)
+{
+    if (typeid(result) == typeid(ClassificationEvaluationResult)) {
+        const auto& classifResult =
+            (const ClassificationEvaluationResult&)result;
+        appendValue<uint8_t>(buffer, 1);
+        appendValue<uint64_t>(buffer, classifResult.getScorePerClass().size());
+        for (size_t i = 0; i < classifResult.getScorePerClass().size(); i++) {
+            appendValue<double>(buffer, classifResult.getScorePerClass().at(i));
+            appendValue<uint64_t>(
+                buffer, classifResult.getNbEvaluationPerClass().at(i));
+        }
+    }
+    else {
+        appendValue<uint8_t>(buffer, 0);
+        appendValue<double>(buffer, result.getResult());
+        appendValue<uint64_t>(buffer, result.getNbEvaluation());
+    }
+    appendValue<double>(buffer, result.getInferenceCost());
+}
+
+std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgentCheckpointer::
+    readEvaluationResult(const std::string& buffer, size_t& offset)
+{
+    std::shared_ptr<EvaluationResult> evaluationResult;
+    uint8_t type = readValue<uint8_t>(buffer, offset);
+    if (type == 0) {
+        double result = readValue<double>(buffer, offset);
+        uint64_t nbEvaluation = readValue<uint64_t>(buffer, offset);
+        evaluationResult =
+            std::make_shared<EvaluationResult>(result, nbEvaluation);
+    }
+    else if (type == 1) {
+        uint64_t nbClasses = readValue<uint64_t>(buffer, offset);
+        if (nbClasses > buffer.size() - offset) {
+            throw std::runtime_error("Truncated serialized data.");
+        }
+        std::vector<double> scores;
+        std::vector<size_t> nbEvaluations;
+        for (uint64_t i = 0; i < nbClasses; i++) {
+            scores.push_back(readValue<double>(buffer, offset));
+            nbEvaluations.push_back(readValue<uint64_t>(buffer, offset));
+        }
+        evaluationResult = std::make_shared<ClassificationEvaluationResult>(
+            scores, nbEvaluations);
+    }
+    else {
+        throw std::runtime_error(
+            "Unknown EvaluationResult type in checkpoint.");
+    }
+    evaluationResult->setInferenceCost(readValue<double>(buffer, offset));
+    return evaluationResult;
+}
+
+std::string Learn::LearningAgentCheckpointer::encodeState(bool isSnapshot)
+{
+    if (isSnapshot) {
+        // Forget about everything saved, so that everything is saved again.
+        this->vertexEntries.clear();
+        this->edgeEntries.clear();
+        this->programEntries.clear();
+        this->recordingEntries.clear();
+        this->dataHashes.clear();
+    }
+
+    // Identify new vertices
+    std::unordered_map<const TPG::TPGVertex*, VertexEntry> newVertexEntries;
+    std::string newVertices;
+    uint64_t nbNewVertices = 0;
+    std::string vertexList;
+    const std::vector<const TPG::TPGVertex*> vertices =
+        this->agent.tpg->getVertices();
+    for (const TPG::TPGVertex* vertex : vertices) {
+        auto action = dynamic_cast<const TPG::TPGAction*>(vertex);
+        VertexEntry entry{0, action != nullptr,
+                          (action != nullptr) ? action->getActionID() : 0};
+        // The address of a deleted vertex may be reused for a new one, hence
+        // the comparison of content.
+        auto iter = this->vertexEntries.find(vertex);
+        if (iter != this->vertexEntries.end() &&
+            iter->second.isAction == entry.isAction &&
+            iter->second.actionID == entry.actionID) {
+            entry.id = iter->second.id;
+        }
+        else {
+            entry.id = this->nextId++;
+            appendValue<uint64_t>(newVertices, entry.id);
+            appendValue<uint8_t>(newVertices, entry.isAction);
+            appendValue<uint64_t>(newVertices, entry.actionID);
+            nbNewVertices++;
+        }
+        newVertexEntries.emplace(vertex, entry);
+        appendValue<uint64_t>(vertexList, entry.id);
+    }
+
+    // Identify new edges and programs
+    std::unordered_map<const TPG::TPGEdge*, EdgeEntry> newEdgeEntries;
+    std::unordered_map<const Program::Program*,
+                       std::pair<uint64_t, std::shared_ptr<Program::Program>>>
+        newProgramEntries;
+    std::string newPrograms;
+    uint64_t nbNewPrograms = 0;
+    std::string newEdges;
+    uint64_t nbNewEdges = 0;
+    std::string edgeList;
+    const Environment& env = this->agent.env;
+    for (const std::unique_ptr<TPG::TPGEdge>& edge :
+         this->agent.tpg->getEdges()) {
+        // Programs are held by the checkpointer, so their address can not
+        // have been reused.
+        const Program::Program* program = &edge->getProgram();
+        auto programIter = newProgramEntries.find(program);
+        if (programIter == newProgramEntries.end()) {
+            auto knownIter = this->programEntries.find(program);
+            if (knownIter != this->programEntries.end()) {
+                programIter = newProgramEntries.insert(*knownIter).first;
+            }
+            else {
+                uint64_t id = this->nextId++;
+                appendValue<uint64_t>(newPrograms, id);
+                appendProgram(newPrograms, *program, env);
+                nbNewPrograms++;
+                programIter =
+                    newProgramEntries
+                        .emplace(program,
+                                 std::make_pair(
+                                     id, edge->getProgramSharedPointer()))
+                        .first;
+            }
+        }
+
+        EdgeEntry entry{0, newVertexEntries.at(edge->getSource()).id,
+                        newVertexEntries.at(edge->getDestination()).id,
+                        programIter->second.first};
+        auto iter = this->edgeEntries.find(edge.get());
+        if (iter != this->edgeEntries.end() &&
+            iter->second.source == entry.source &&
+            iter->second.destination == entry.destination &&
+            iter->second.program == entry.program) {
+            entry.id = iter->second.id;
+        }
+        else {
+            entry.id = this->nextId++;
+            appendValue<uint64_t>(newEdges, entry.id);
+            appendValue<uint64_t>(newEdges, entry.source);
+            appendValue<uint64_t>(newEdges, entry.destination);
+            appendValue<uint64_t>(newEdges, entry.program);
+            nbNewEdges++;
+        }
+        newEdgeEntries.emplace(edge.get(), entry);
+        appendValue<uint64_t>(edgeList, entry.id);
+    }
+
+    // Forget about deleted vertices, edges and programs.
+    this->vertexEntries = std::move(newVertexEntries);
+    this->edgeEntries = std::move(newEdgeEntries);
+    this->programEntries = std::move(newProgramEntries);
+
+    // Archived DataHandler removed or added since the previous record
+    const Archive& archive = this->agent.archive;
+    std::string removedDataHandlers;
+    uint64_t nbRemovedDataHandlers = 0;
+    for (auto iter = this->dataHashes.begin();
+         iter != this->dataHashes.end();) {
+        if (!archive.hasDataHandlers(*iter)) {
+            appendValue<uint64_t>(removedDataHandlers, *iter);
+            nbRemovedDataHandlers++;
+            iter = this->dataHashes.erase(iter);
+        }
+        else {
+            iter++;
+        }
+    }
+    std::string newDataHandlers;
+    uint64_t nbNewDataHandlers = 0;
+    for (const auto& hashAndDataHandlers : archive.getDataHandlers()) {
+        if (this->dataHashes.count(hashAndDataHandlers.first) != 0) {
+            continue;
+        }
+        std::string content;
+        bool isSupported = true;
+        for (const auto& dHandler : hashAndDataHandlers.second) {
+            isSupported &= appendDataHandlerContent(content, dHandler.get());
+        }
+        if (isSupported) {
+            appendValue<uint64_t>(newDataHandlers, hashAndDataHandlers.first);
+            appendValue<uint64_t>(newDataHandlers,
+                                  hashAndDataHandlers.second.size());
+            newDataHandlers.append(content);
+            this->dataHashes.insert(hashAndDataHandlers.first);
+            nbNewDataHandlers++;
+        }
+    }
+
+    // Archive recordings. Since the Archive is a FIFO, the saved recordings
+    // still in the Archive are the first ones, in the same order.
+    std::vector<const ArchiveRecording*> recordings;
+    for (uint64_t i = 0; i < archive.getNbRecordings(); i++) {
+        const ArchiveRecording& recording = archive.at(i);
+        if (this->dataHashes.count(recording.dataHash) != 0) {
+            recordings.push_back(&recording);
+        }
+    }
+    size_t nbRemovedRecordings = this->recordingEntries.size();
+    for (size_t first = 0; first < this->recordingEntries.size(); first++) {
+        size_t nbKept = this->recordingEntries.size() - first;
+        bool isKept = nbKept <= recordings.size();
+        for (size_t i = 0; i < nbKept && isKept; i++) {
+            const RecordingEntry& entry = this->recordingEntries.at(first + i);
+            isKept = entry.prog == recordings.at(i)->prog &&
+                     entry.dataHash == recordings.at(i)->dataHash &&
+                     entry.result == recordings.at(i)->result;
+        }
+        if (isKept) {
+            nbRemovedRecordings = first;
+            break;
+        }
+    }
+    this->recordingEntries.erase(this->recordingEntries.begin(),
+                                 this->recordingEntries.begin() +
+                                     nbRemovedRecordings);
+
+    // Programs that are no longer in the graph keep the identifier of their
+    // previous recordings, so that their recordings remain grouped when
+    // restored.
+    std::unordered_map<const Program::Program*, uint64_t> archivedPrograms;
+    for (const RecordingEntry& entry : this->recordingEntries) {
+        archivedPrograms.emplace(entry.prog, entry.program);
+    }
+    std::string newRecordings;
+    uint64_t nbNewRecordings = 0;
+    for (size_t i = this->recordingEntries.size(); i < recordings.size();
+         i++) {
+        const ArchiveRecording& recording = *recordings.at(i);
+        RecordingEntry entry{recording.prog, 0, recording.dataHash,
+                             recording.result};
+        auto programIter = this->programEntries.find(recording.prog);
+        if (programIter != this->programEntries.end()) {
+            entry.program = programIter->second.first;
+        }
+        else {
+            auto inserted =
+                archivedPrograms.emplace(recording.prog, this->nextId);
+            entry.program = inserted.first->second;
+            if (inserted.second) {
+                this->nextId++;
+            }
+        }
+        appendValue<uint64_t>(newRecordings, entry.program);
+        appendValue<uint64_t>(newRecordings, entry.dataHash);
+        appendValue<double>(newRecordings, entry.result);
+        nbNewRecordings++;
+        this->recordingEntries.push_back(entry);
+    }
+
+    std::string payload;
+    appendValue<uint8_t>(payload, isSnapshot);
+    appendValue<uint64_t>(payload, this->nbGenerations);
+    appendValue<uint64_t>(payload, this->nextId);
+    appendValue<uint64_t>(payload, nbNewPrograms);
+    payload.append(newPrograms);
+    appendValue<uint64_t>(payload, nbNewVertices);
+    payload.append(newVertices);
+    appendValue<uint64_t>(payload, nbNewEdges);
+    payload.append(newEdges);
+    appendValue<uint64_t>(payload, vertices.size());
+    payload.append(vertexList);
+    appendValue<uint64_t>(payload, this->edgeEntries.size());
+    payload.append(edgeList);
+    appendValue<uint64_t>(payload, nbRemovedDataHandlers);
+    payload.append(removedDataHandlers);
+    appendValue<uint64_t>(payload, nbNewDataHandlers);
+    payload.append(newDataHandlers);
+    appendValue<uint64_t>(payload, nbRemovedRecordings);
+    appendValue<uint64_t>(payload, nbNewRecordings);
+    payload.append(newRecordings);
+
+    // Random number generator and best score
+    std::string rngState = this->agent.rng.getState();
+    appendValue<uint64_t>(payload, rngState.size());
+    payload.append(rngState);
+    appendValue<double>(payload, this->agent.bestScoreLastGen);
+
+    // Results of the roots still in the graph
+    std::string results;
+    uint64_t nbResults = 0;
+    for (const auto& rootAndResult : this->agent.resultsPerRoot) {
+        auto iter = this->vertexEntries.find(rootAndResult.first);
+        if (iter != this->vertexEntries.end()) {
+            appendValue<uint64_t>(results, iter->second.id);
+            appendEvaluationResult(results, *rootAndResult.second);
+            nbResults++;
+        }
+    }
+    appendValue<uint64_t>(payload, nbResults);
+    payload.append(results);
+
+    // Best root. A best root that is no longer in the graph is replaced at
+    // the next generation, like a missing one.
+    const auto& bestRoot = this->agent.bestRoot;
+    auto bestIter = this->vertexEntries.find(bestRoot.first);
+    bool isBestInGraph = bestRoot.first != nullptr &&
+                         bestIter != this->vertexEntries.end();
+    appendValue<uint8_t>(payload, isBestInGraph);
+    if (isBestInGraph) {
+        appendValue<uint64_t>(payload, bestIter->second.id);
+    }
+    auto bestResultIter = this->agent.resultsPerRoot.find(bestRoot.first);
+    if (bestRoot.second == nullptr) {
+        appendValue<uint8_t>(payload, 0);
+    }
+    else if (isBestInGraph &&
+             bestResultIter != this->agent.resultsPerRoot.end() &&
+             bestResultIter->second == bestRoot.second) {
+        // Result shared with resultsPerRoot
+        appendValue<uint8_t>(payload, 1);
+    }
+    else {
+        appendValue<uint8_t>(payload, 2);
+        appendEvaluationResult(payload, *bestRoot.second);
+    }
+
+    return payload;
+}
+
+void Learn::LearningAgentCheckpointer::decodeRecord(const std::string& payload,
+                                                    ReplayState& state) const
+{
+    size_t offset = 0;
+    if (readValue<uint8_t>(payload, offset) != 0) {
+        // Snapshots do not depend on previous records.
+        state.vertices.clear();
+        state.edges.clear();
+        state.programs.clear();
+        state.dataHandlers.clear();
+        state.recordings.clear();
+    }
+    state.nbGenerations = readValue<uint64_t>(payload, offset);
+    state.nextId = readValue<uint64_t>(payload, offset);
+
+    // New programs, vertices and edges
+    uint64_t nbNewPrograms = readValue<uint64_t>(payload, offset);
+    for (uint64_t i = 0; i < nbNewPrograms; i++) {
+        uint64_t id = readValue<uint64_t>(payload, offset);
+        if (id >= state.nextId) {
+            throw std::runtime_error("Checkpoint contains an invalid id.");
+        }
+        state.programs[id] = readProgram(payload, offset, this->agent.env);
+    }
+    uint64_t nbNewVertices = readValue<uint64_t>(payload, offset);
+    for (uint64_t i = 0; i < nbNewVertices; i++) {
+        VertexEntry entry;
+        entry.id = readValue<uint64_t>(payload, offset);
+        entry.isAction = readValue<uint8_t>(payload, offset) != 0;
+        entry.actionID = readValue<uint64_t>(payload, offset);
+        if (entry.id >= state.nextId) {
+            throw std::runtime_error("Checkpoint contains an invalid id.");
+        }
+        state.vertices[entry.id] = entry;
+    }
+    uint64_t nbNewEdges = readValue<uint64_t>(payload, offset);
+    for (uint64_t i = 0; i < nbNewEdges; i++) {
+        EdgeEntry entry;
+        entry.id = readValue<uint64_t>(payload, offset);
+        entry.source = readValue<uint64_t>(payload, offset);
+        entry.destination = readValue<uint64_t>(payload, offset);
+        entry.program = readValue<uint64_t>(payload, offset);
+        if (entry.id >= state.nextId) {
+            throw std::runtime_error("Checkpoint contains an invalid id.");
+        }
+        state.edges[entry.id] = entry;
+    }
+
+    // Content of the graph
+    std::unordered_map<uint64_t, VertexEntry> vertices;
+    uint64_t nbVertices = readValue<uint64_t>(payload, offset);
+    state.vertexIds.clear();
+    for (uint64_t i = 0; i < nbVertices; i++) {
+        uint64_t id = readValue<uint64_t>(payload, offset);
+        auto iter = state.vertices.find(id);
+        if (iter == state.vertices.end() || !vertices.insert(*iter).second) {
+            throw std::runtime_error("Checkpoint contains an invalid vertex.");
+        }
+        state.vertexIds.push_back(id);
+    }
+    std::unordered_map<uint64_t, EdgeEntry> edges;
+    std::unordered_map<uint64_t, std::shared_ptr<Program::Program>> programs;
+    uint64_t nbEdges = readValue<uint64_t>(payload, offset);
+    state.edgeIds.clear();
+    for (uint64_t i = 0; i < nbEdges; i++) {
+        uint64_t id = readValue<uint64_t>(payload, offset);
+        auto iter = state.edges.find(id);
+        if (iter == state.edges.end() || !edges.insert(*iter).second) {
+            throw std::runtime_error("Checkpoint contains an invalid edge.");
+        }
+        const EdgeEntry& entry = iter->second;
+        auto sourceIter = vertices.find(entry.source);
+        auto programIter = state.programs.find(entry.program);
+        if (sourceIter == vertices.end() || sourceIter->second.isAction ||
+            vertices.count(entry.destination) == 0 ||
+            programIter == state.programs.end()) {
+            throw std::runtime_error("Checkpoint contains an invalid edge.");
+        }
+        programs.insert(*programIter);
+        state.edgeIds.push_back(id);
+    }
+
+    // Forget about deleted vertices, edges and programs.
+    state.vertices = std::move(vertices);
+    state.edges = std::move(edges);
+    state.programs = std::move(programs);
+
+    // Archived DataHandler, rebuilt from copies of the data sources
+    uint64_t nbRemovedDataHandlers = readValue<uint64_t>(payload, offset);
+    for (uint64_t i = 0; i < nbRemovedDataHandlers; i++) {
+        size_t hash = readValue<uint64_t>(payload, offset);
+        if (state.dataHandlers.erase(hash) == 0) {
+            throw std::runtime_error("Checkpoint contains invalid archive.");
+        }
+    }
+    const auto& dataSources = this->agent.env.getDataSources();
+    uint64_t nbNewDataHandlers = readValue<uint64_t>(payload, offset);
+    for (uint64_t i = 0; i < nbNewDataHandlers; i++) {
+        size_t hash = readValue<uint64_t>(payload, offset);
+        uint64_t nbDataSources = readValue<uint64_t>(payload, offset);
+        if (nbDataSources != dataSources.size()) {
+            throw std::runtime_error("Archived data of the checkpoint does "
+                                     "not match the data sources.");
+        }
+        auto& copies = state.dataHandlers[hash];
+        copies.clear();
+        for (uint64_t j = 0; j < nbDataSources; j++) {
+            copies.emplace_back(dataSources.at(j).get().clone());
+            readDataHandlerContent(payload, offset, *copies.back());
+        }
+    }
+
+    // Archive recordings
+    uint64_t nbRemovedRecordings = readValue<uint64_t>(payload, offset);
+    if (nbRemovedRecordings > state.recordings.size()) {
+        throw std::runtime_error("Checkpoint contains invalid archive.");
+    }
+    state.recordings.erase(state.recordings.begin(),
+                           state.recordings.begin() + nbRemovedRecordings);
+    uint64_t nbNewRecordings = readValue<uint64_t>(payload, offset);
+    for (uint64_t i = 0; i < nbNewRecordings; i++) {
+        RecordingEntry entry;
+        entry.prog = nullptr;
+        entry.program = readValue<uint64_t>(payload, offset);
+        entry.dataHash = readValue<uint64_t>(payload, offset);
+        entry.result = readValue<double>(payload, offset);
+        if (entry.program >= state.nextId ||
+            state.dataHandlers.count(entry.dataHash) == 0) {
+            throw std::runtime_error("Checkpoint contains invalid archive.");
+        }
+        state.recordings.push_back(entry);
+    }
+
+    state.payload = payload;
+    state.stateOffset = offset;
+}
+
+void Learn::LearningAgentCheckpointer::restoreState(ReplayState& state)
+{
+    const std::string& payload = state.payload;
+    size_t offset = state.stateOffset;
+
+    // Read everything before modifying the LearningAgent.
+    uint64_t rngStateSize = readValue<uint64_t>(payload, offset);
+    if (rngStateSize > payload.size() - offset) {
+        throw std::runtime_error("Truncated serialized data.");
+    }
+    std::string rngState = payload.substr(offset, rngStateSize);
+    offset += rngStateSize;
+    double bestScoreLastGen = readValue<double>(payload, offset);
+
+    // Programs of the archive recordings that are no longer in the graph
+    std::unordered_map<uint64_t, size_t> deletedPrograms;
+    for (const RecordingEntry& recording : state.recordings) {
+        if (state.dataHandlers.count(recording.dataHash) == 0) {
+            throw std::runtime_error("Checkpoint contains invalid archive.");
+        }
+        if (state.programs.count(recording.program) == 0) {
+            deletedPrograms.emplace(recording.program, deletedPrograms.size());
+        }
+    }
+
+    // Results of the roots
+    std::map<uint64_t, std::shared_ptr<EvaluationResult>> results;
+    uint64_t nbResults = readValue<uint64_t>(payload, offset);
+    for (uint64_t i = 0; i < nbResults; i++) {
+        uint64_t id = readValue<uint64_t>(payload, offset);
+        if (state.vertices.count(id) == 0) {
+            throw std::runtime_error("Checkpoint contains an invalid result.");
+        }
+        results[id] = readEvaluationResult(payload, offset);
+    }
+
+    // Best root
+    bool isBestInGraph = readValue<uint8_t>(payload, offset) != 0;
+    uint64_t bestId = 0;
+    if (isBestInGraph) {
+        bestId = readValue<uint64_t>(payload, offset);
+        if (state.vertices.count(bestId) == 0) {
+            throw std::runtime_error("Checkpoint contains an invalid result.");
+        }
+    }
+    std::shared_ptr<EvaluationResult> bestResult;
+    switch (readValue<uint8_t>(payload, offset)) {
+    case 0:
+        break;
+    case 1:
+        if (!isBestInGraph || results.count(bestId) == 0) {
+            throw std::runtime_error("Checkpoint contains an invalid result.");
+        }
+        bestResult = results.at(bestId);
+        break;
+    case 2:
+        bestResult = readEvaluationResult(payload, offset);
+        break;
+    default:
+        throw std::runtime_error("Checkpoint contains an invalid result.");
+    }
+
+    // Restore the LearningAgent, starting with the only step that may still
+    // fail.
+    this->agent.rng.setState(rngState);
+    this->agent.bestScoreLastGen = bestScoreLastGen;
+
+    TPG::TPGGraph& tpg = *this->agent.tpg;
+    tpg.clear();
+    this->vertexEntries.clear();
+    this->edgeEntries.clear();
+    this->programEntries.clear();
+    std::unordered_map<uint64_t, const TPG::TPGVertex*> vertices;
+    for (uint64_t id : state.vertexIds) {
+        const VertexEntry& entry = state.vertices.at(id);
+        const TPG::TPGVertex* vertex =
+            entry.isAction
+                ? (const TPG::TPGVertex*)&tpg.addNewAction(entry.actionID)
+                : (const TPG::TPGVertex*)&tpg.addNewTeam();
+        this->vertexEntries.emplace(vertex, entry);
+        vertices.emplace(id, vertex);
+    }
+    for (uint64_t id : state.edgeIds) {
+        const EdgeEntry& entry = state.edges.at(id);
+        const std::shared_ptr<Program::Program>& program =
+            state.programs.at(entry.program);
+        const TPG::TPGEdge& edge =
+            tpg.addNewEdge(*vertices.at(entry.source),
+                           *vertices.at(entry.destination), program);
+        this->edgeEntries.emplace(&edge, entry);
+        this->programEntries.emplace(program.get(),
+                                     std::make_pair(entry.program, program));
+    }
+
+    this->deletedProgramKeys =
+        std::make_unique<char[]>(deletedPrograms.size() + 1);
+    this->agent.archive.clear();
+    this->recordingEntries.clear();
+    this->dataHashes.clear();
+    for (const RecordingEntry& recording : state.recordings) {
+        auto programIter = state.programs.find(recording.program);
+        const Program::Program* program =
+            (programIter != state.programs.end())
+                ? programIter->second.get()
+                : reinterpret_cast<const Program::Program*>(
+                      this->deletedProgramKeys.get() +
+                      deletedPrograms.at(recording.program));
+        std::vector<std::reference_wrapper<const Data::DataHandler>>
+            dHandlers;
+        for (const auto& dHandler : state.dataHandlers.at(recording.dataHash)) {
+            dHandlers.push_back(*dHandler);
+        }
+        this->agent.archive.addRecording(program, dHandlers, recording.result,
+                                         true);
+        this->recordingEntries.push_back({program, recording.program,
+                                          recording.dataHash,
+                                          recording.result});
+        this->dataHashes.insert(recording.dataHash);
+    }
+
+    this->agent.resultsPerRoot.clear();
+    for (const auto& idAndResult : results) {
+        this->agent.resultsPerRoot.emplace(vertices.at(idAndResult.first),
+                                           idAndResult.second);
+    }
+    this->agent.bestRoot = {isBestInGraph ? vertices.at(bestId) : nullptr,
+                            bestResult};
+
+    this->nbGenerations = state.nbGenerations;
+    this->nextId = state.nextId;
+}
+
+bool Learn::LearningAgentCheckpointer::resumeFromFile()
+{
+    std::string content;
+    {
+        std::ifstream file(this->filePath, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        content.assign(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+    }
+    if (content.empty()) {
+        return false;
+    }
+
+    std::string header = this->makeHeader();
+    if (content.size() < header.size() ||
+        content.compare(0, header.size(), header) != 0) {
+        throw std::runtime_error("File " + this->filePath +
+                                 " is not a checkpoint file compatible with "
+                                 "the LearningAgent.");
+    }
+
+    // Locate all complete records, and the last snapshot among them.
+    std::vector<std::pair<size_t, size_t>> records;
+    size_t lastSnapshot = 0;
+    size_t validSize = header.size();
+    while (content.size() - validSize >= RECORD_HEADER_SIZE) {
+        size_t offset = validSize;
+        uint64_t payloadSize = readValue<uint64_t>(content, offset);
+        uint64_t checksum = readValue<uint64_t>(content, offset);
+        if (payloadSize == 0 || payloadSize > content.size() - offset ||
+            computeChecksum(content.data() + offset, payloadSize) !=
+                checksum) {
+            // Record interrupted while being written.
+            break;
+        }
+        if (content[offset] != 0) {
+            lastSnapshot = records.size();
+        }
+        records.emplace_back(offset, payloadSize);
+        validSize = offset + payloadSize;
+    }
+
+    // Replay the records from the last snapshot
+    if (!records.empty()) {
+        if (content[records.at(lastSnapshot).first] == 0) {
+            throw std::runtime_error("File " + this->filePath +
+                                     " does not contain any snapshot.");
+        }
+        ReplayState state;
+        for (size_t i = lastSnapshot; i < records.size(); i++) {
+            this->decodeRecord(
+                content.substr(records.at(i).first, records.at(i).second),
+                state);
+        }
+        this->restoreState(state);
+        this->nbRecordsInFile = records.size() - lastSnapshot;
+    }
+
+    // Remove the incomplete record, if any, before appending new ones.
+    if (validSize < content.size() &&
+        !truncateFile(this->filePath, validSize)) {
+        throw std::runtime_error("Could not truncate checkpoint file " +
+                                 this->filePath + ".");
+    }
+
+    return true;
+}
@@ -44,6 +44,7 @@
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
 #include "tpg/tpgExecutionEngine.h"
+#include "util/profiler.h"
 
 #include "learn/evaluationResult.h"
 #include "learn/parallelLearningAgent.h"
@@ -60,7 +61,7 @@ Learn::ParallelLearningAgent::evaluateAllRoots(uint64_t generationNumber,
 
         // Create the TPGExecutionEngine
         std::unique_ptr<TPG::TPGExecutionEngine> tee =
-            this->tpg->getFactory().createTPGExecutionEngine(
+            this->createTPGExecutionEngine(
                 this->env,
                 (mode == LearningMode::TRAINING) ? &this->archive : NULL);
 
@@ -106,7 +107,7 @@ void Learn::ParallelLearningAgent::slaveEvalJobThread(
                            this->env.getNbRegisters(),
                            this->env.getNbConstant());
     std::unique_ptr<TPG::TPGExecutionEngine> tee =
-        this->tpg->getFactory().createTPGExecutionEngine(privateEnv, NULL);
+        this->createTPGExecutionEngine(privateEnv, NULL);
 
     int i = 0;
     // Pop a job
@@ -115,6 +116,7 @@ void Learn::ParallelLearningAgent::slaveEvalJobThread(
         bool doProcess = false;
         std::shared_ptr<Learn::Job> jobToProcess;
         { // Mutuel exclusion zone
+            Util::Profiler::Span span("waitJobQueue", "evaluation");
             std::lock_guard<std::mutex> lock(rootsToProcessMutex);
             if (!jobsToProcess.empty()) { // Additional verification after lock
                 jobToProcess = jobsToProcess.front();
@@ -126,9 +128,11 @@ void Learn::ParallelLearningAgent::slaveEvalJobThread(
         // Processing to do?
         if (doProcess) {
             doProcess = false;
+            Util::Profiler::Span jobSpan("evaluateJob", "evaluation");
             // Dedicated archive for the root
             Archive* temporaryArchive = NULL;
             if (mode == LearningMode::TRAINING) {
+                Util::Profiler::Span span("createArchive", "archive");
                 temporaryArchive =
                     new Archive(params.archiveSize, params.archivingProbability,
                                 jobToProcess->getArchiveSeed());
@@ -148,6 +152,7 @@ void Learn::ParallelLearningAgent::slaveEvalJobThread(
 
             if (mode == LearningMode::TRAINING) {
                 { // Insertion archiveMap update mutual exclusion zone
+                    Util::Profiler::Span span("storeArchive", "archive");
                     std::lock_guard<std::mutex> lock(archiveMapMutex);
                     archiveMap.insert(
                         {jobToProcess->getIdx(), temporaryArchive});
@@ -165,6 +170,8 @@ void Learn::ParallelLearningAgent::slaveEvalJobThread(
 void Learn::ParallelLearningAgent::mergeArchiveMap(
     std::map<uint64_t, Archive*>& archiveMap)
 {
+    Util::Profiler::Span span("mergeArchives", "archive");
+
     // Scan the archives backward, starting from the last to identify the
     // last params.archiveSize recordings to keep (or less).
     auto reverseIterator = archiveMap.rbegin();
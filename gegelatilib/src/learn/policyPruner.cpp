@@ -0,0 +1,279 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "data/hash.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgTeam.h"
+
+#include "learn/policyPruner.h"
+
+/**
+ * \brief Get the TPGEdge and TPGVertex reachable from a root.
+ *
+ * \param[in] root the root TPGVertex.
+ * \param[out] vertices the reachable TPGVertex, including the root.
+ * \param[out] edges the reachable TPGEdge.
+ */
+static void getReachableElements(const TPG::TPGVertex& root,
+                                 std::set<const TPG::TPGVertex*>& vertices,
+                                 std::vector<const TPG::TPGEdge*>& edges)
+{
+    std::vector<const TPG::TPGVertex*> toVisit{&root};
+    vertices.insert(&root);
+    while (!toVisit.empty()) {
+        const TPG::TPGVertex* vertex = toVisit.back();
+        toVisit.pop_back();
+        for (const TPG::TPGEdge* edge : vertex->getOutgoingEdges()) {
+            edges.push_back(edge);
+            if (vertices.insert(edge->getDestination()).second) {
+                toVisit.push_back(edge->getDestination());
+            }
+        }
+    }
+}
+
+/// Get the number of distinct Program of a list of TPGEdge.
+static size_t getNbPrograms(const std::vector<const TPG::TPGEdge*>& edges)
+{
+    std::set<const Program::Program*> programs;
+    for (const TPG::TPGEdge* edge : edges) {
+        programs.insert(&edge->getProgram());
+    }
+    return programs.size();
+}
+
+double Learn::PolicyPruner::PruningResult::getDecisionChangeRatio() const
+{
+    return (this->nbDecisions == 0)
+               ? 0.0
+               : (double)this->nbChangedDecisions / (double)this->nbDecisions;
+}
+
+double Learn::PolicyPruner::PruningResult::getInferenceCostReduction() const
+{
+    return (this->avgExecutedLinesBefore == 0.0)
+               ? 0.0
+               : 1.0 - this->avgExecutedLinesAfter /
+                           this->avgExecutedLinesBefore;
+}
+
+Learn::PolicyPruner::PolicyPruner(LearningEnvironment& le,
+                                  uint64_t nbEpisodes,
+                                  uint64_t maxNbActionsPerEpisode,
+                                  double tolerance, LearningMode mode)
+    : learningEnvironment{le}, nbEpisodes{nbEpisodes},
+      maxNbActionsPerEpisode{maxNbActionsPerEpisode}, tolerance{tolerance},
+      mode{mode}
+{
+    if (tolerance < 0.0 || tolerance > 1.0) {
+        throw std::invalid_argument(
+            "The tolerance of the PolicyPruner must be within [0.0, 1.0].");
+    }
+}
+
+Learn::PolicyPruner::WorkloadStats Learn::PolicyPruner::executeWorkload(
+    const TPG::TPGGraph& graph, const TPG::TPGVertex& root,
+    const std::set<const TPG::TPGEdge*>& excludedEdges,
+    const std::vector<std::vector<uint64_t>>* replayedActions)
+{
+    WorkloadStats stats;
+    TPG::TPGExecutionEngine tee(graph.getEnvironment());
+
+    for (uint64_t episode = 0; episode < this->nbEpisodes; episode++) {
+        Data::Hash<uint64_t> hasher;
+        this->learningEnvironment.reset(hasher(episode), this->mode);
+        stats.actions.emplace_back();
+
+        uint64_t nbActions = 0;
+        while (!this->learningEnvironment.isTerminal() &&
+               nbActions < this->maxNbActionsPerEpisode) {
+            // Browse the policy, ignoring excluded edges, with the same
+            // bidding rules as the TPGExecutionEngine.
+            const TPG::TPGVertex* vertex = &root;
+            while (dynamic_cast<const TPG::TPGTeam*>(vertex) != nullptr) {
+                stats.nbEvaluatedTeams++;
+                const TPG::TPGEdge* bestEdge = nullptr;
+                double bestBid = 0.0;
+                for (const TPG::TPGEdge* edge : vertex->getOutgoingEdges()) {
+                    if (excludedEdges.count(edge) != 0) {
+                        continue;
+                    }
+                    double bid = tee.evaluateEdge(*edge);
+                    stats.nbEvaluatedPrograms++;
+                    stats.nbExecutedLines += edge->getProgram().getNbLines();
+                    if (bestEdge == nullptr || bid >= bestBid) {
+                        bestEdge = edge;
+                        bestBid = bid;
+                    }
+                }
+                if (bestEdge == nullptr) {
+                    // All edges of the team are excluded.
+                    stats.reachedEmptyTeam = true;
+                    return stats;
+                }
+                stats.nbTraversals[bestEdge]++;
+                vertex = bestEdge->getDestination();
+            }
+            uint64_t actionID = ((const TPG::TPGAction*)vertex)->getActionID();
+            stats.actions.back().push_back(actionID);
+            stats.nbDecisions++;
+
+            // Apply the decision, or the replayed one
+            if (replayedActions != nullptr) {
+                uint64_t replayedID =
+                    replayedActions->at(episode).at(nbActions);
+                if (replayedID != actionID) {
+                    stats.nbChangedDecisions++;
+                }
+                actionID = replayedID;
+            }
+            this->learningEnvironment.doAction(actionID);
+            nbActions++;
+        }
+    }
+
+    return stats;
+}
+
+Learn::PolicyPruner::PruningResult Learn::PolicyPruner::prune(
+    TPG::TPGGraph& graph, const TPG::TPGVertex& root)
+{
+    if (!graph.hasVertex(root)) {
+        throw std::runtime_error(
+            "The pruned root is not a TPGVertex of the TPGGraph.");
+    }
+
+    PruningResult result;
+
+    // Characterize the unpruned policy
+    std::set<const TPG::TPGVertex*> vertices;
+    std::vector<const TPG::TPGEdge*> edges;
+    getReachableElements(root, vertices, edges);
+    result.nbVerticesBefore = vertices.size();
+    result.nbEdgesBefore = edges.size();
+    result.nbProgramsBefore = getNbPrograms(edges);
+
+    std::set<const TPG::TPGEdge*> excludedEdges;
+    WorkloadStats reference =
+        this->executeWorkload(graph, root, excludedEdges, nullptr);
+    result.nbDecisions = reference.nbDecisions;
+    if (reference.nbDecisions > 0) {
+        result.avgEvaluatedTeamsBefore = (double)reference.nbEvaluatedTeams /
+                                         (double)reference.nbDecisions;
+        result.avgEvaluatedProgramsBefore =
+            (double)reference.nbEvaluatedPrograms /
+            (double)reference.nbDecisions;
+        result.avgExecutedLinesBefore = (double)reference.nbExecutedLines /
+                                        (double)reference.nbDecisions;
+    }
+
+    // Edges never winning a bid can be removed without changing decisions.
+    std::vector<const TPG::TPGEdge*> candidates;
+    for (const TPG::TPGEdge* edge : edges) {
+        if (reference.nbTraversals.count(edge) == 0) {
+            excludedEdges.insert(edge);
+        }
+        else {
+            candidates.push_back(edge);
+        }
+    }
+
+    // Within the tolerance, try removing the least traversed edges first.
+    if (this->tolerance > 0.0) {
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [&reference](const TPG::TPGEdge* a,
+                                      const TPG::TPGEdge* b) {
+                             return reference.nbTraversals.at(a) <
+                                    reference.nbTraversals.at(b);
+                         });
+        uint64_t maxNbChangedDecisions = (uint64_t)floor(
+            this->tolerance * (double)reference.nbDecisions);
+        for (const TPG::TPGEdge* edge : candidates) {
+            // Each team keeps at least one edge.
+            const auto& siblings = edge->getSource()->getOutgoingEdges();
+            auto nbKeptSiblings =
+                std::count_if(siblings.begin(), siblings.end(),
+                              [&excludedEdges](const TPG::TPGEdge* sibling) {
+                                  return excludedEdges.count(sibling) == 0;
+                              });
+            if (nbKeptSiblings <= 1) {
+                continue;
+            }
+
+            excludedEdges.insert(edge);
+            WorkloadStats trial = this->executeWorkload(
+                graph, root, excludedEdges, &reference.actions);
+            if (trial.reachedEmptyTeam ||
+                trial.nbChangedDecisions > maxNbChangedDecisions) {
+                excludedEdges.erase(edge);
+            }
+        }
+    }
+
+    // Remove excluded edges, then vertices no longer reachable.
+    for (const TPG::TPGEdge* edge : excludedEdges) {
+        graph.removeEdge(*edge);
+    }
+    vertices.clear();
+    edges.clear();
+    getReachableElements(root, vertices, edges);
+    for (const TPG::TPGVertex* vertex : graph.getVertices()) {
+        if (vertices.count(vertex) == 0) {
+            graph.removeVertex(*vertex);
+        }
+    }
+
+    // Characterize the pruned policy
+    result.nbVerticesAfter = vertices.size();
+    result.nbEdgesAfter = edges.size();
+    result.nbProgramsAfter = getNbPrograms(edges);
+
+    WorkloadStats pruned =
+        this->executeWorkload(graph, root, {}, &reference.actions);
+    result.nbChangedDecisions = pruned.nbChangedDecisions;
+    if (pruned.nbDecisions > 0) {
+        result.avgEvaluatedTeamsAfter =
+            (double)pruned.nbEvaluatedTeams / (double)pruned.nbDecisions;
+        result.avgEvaluatedProgramsAfter =
+            (double)pruned.nbEvaluatedPrograms / (double)pruned.nbDecisions;
+        result.avgExecutedLinesAfter =
+            (double)pruned.nbExecutedLines / (double)pruned.nbDecisions;
+    }
+
+    return result;
+}
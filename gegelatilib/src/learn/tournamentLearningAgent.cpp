@@ -0,0 +1,267 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <thread>
+
+#include "learn/tournamentLearningAgent.h"
+
+void Learn::TournamentLearningAgent::evaluateAllRootsInParallelExecute(
+    uint64_t generationNumber, LearningMode mode,
+    std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
+                                 std::shared_ptr<Job>>>& resultsPerJobMap,
+    std::map<uint64_t, Archive*>& archiveMap)
+{
+    // Jobs are stored in a vector to give each thread direct access to its
+    // blocks.
+    auto jobsQueue = makeJobs(mode);
+    std::vector<std::shared_ptr<Job>> jobs;
+    jobs.reserve(jobsQueue.size());
+    while (!jobsQueue.empty()) {
+        jobs.push_back(jobsQueue.front());
+        jobsQueue.pop();
+    }
+
+    // One slot per job, written by a single thread.
+    std::vector<std::shared_ptr<EvaluationResult>> results(jobs.size());
+    std::vector<Archive*> archives(jobs.size(), nullptr);
+
+    // Group the schedule into blocks of matches sharing their home roots.
+    std::vector<size_t> order;
+    std::vector<size_t> blocks = this->makeJobBlocks(
+        jobs, this->maxNbThreads * NB_BLOCKS_PER_THREAD, order);
+    size_t nbBlocks = blocks.size() - 1;
+    std::atomic<size_t> nextBlock{0};
+
+    size_t nbThreads =
+        std::max((size_t)1, std::min((size_t)this->maxNbThreads, nbBlocks));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nbThreads; i++) {
+        threads.emplace_back(std::thread(
+            &TournamentLearningAgent::evalJobBlockThread, this,
+            generationNumber, mode, std::cref(jobs), std::cref(order),
+            std::cref(blocks), std::ref(nextBlock), std::ref(results),
+            std::ref(archives), false));
+    }
+
+    // Work in the main thread also, using the main environment
+    this->evalJobBlockThread(generationNumber, mode, jobs, order, blocks,
+                             nextBlock, results, archives, true);
+
+    // Join the threads
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Gather results in the job order
+    for (size_t i = 0; i < jobs.size(); i++) {
+        resultsPerJobMap.emplace(jobs[i]->getIdx(),
+                                 std::make_pair(results[i], jobs[i]));
+        if (mode == LearningMode::TRAINING) {
+            archiveMap.insert({jobs[i]->getIdx(), archives[i]});
+        }
+    }
+}
+
+std::vector<size_t> Learn::TournamentLearningAgent::makeJobBlocks(
+    const std::vector<std::shared_ptr<Job>>& jobs, size_t nbBlocks,
+    std::vector<size_t>& order) const
+{
+    // Position of each root in the list of roots
+    std::map<const TPG::TPGVertex*, size_t> rootPositions;
+    auto roots = this->tpg->getRootVertices();
+    for (size_t i = 0; i < roots.size(); i++) {
+        rootPositions.emplace(roots[i], i);
+    }
+
+    // Home root of each job
+    std::vector<size_t> homes(jobs.size(), 0);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const auto* job = dynamic_cast<const AdversarialJob*>(jobs[i].get());
+        size_t home = SIZE_MAX;
+        for (size_t j = 0; j < job->getSize(); j++) {
+            if (job->isFillerRoot(j)) {
+                continue;
+            }
+            auto position = rootPositions.find((*job)[j]);
+            if (position != rootPositions.end()) {
+                home = std::min(home, position->second);
+            }
+        }
+        homes[i] = home;
+    }
+
+    order.resize(jobs.size());
+    for (size_t i = 0; i < jobs.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&homes](size_t a, size_t b) {
+        return homes[a] < homes[b];
+    });
+
+    // Close blocks on home root changes once they are large enough.
+    size_t blockSize =
+        std::max((size_t)1, jobs.size() / std::max((size_t)1, nbBlocks));
+    std::vector<size_t> blocks{0};
+    for (size_t i = 1; i < order.size(); i++) {
+        if (i - blocks.back() >= blockSize &&
+            homes[order[i]] != homes[order[i - 1]]) {
+            blocks.push_back(i);
+        }
+    }
+    blocks.push_back(order.size());
+
+    return blocks;
+}
+
+void Learn::TournamentLearningAgent::evalJobBlockThread(
+    uint64_t generationNumber, LearningMode mode,
+    const std::vector<std::shared_ptr<Job>>& jobs,
+    const std::vector<size_t>& order, const std::vector<size_t>& blocks,
+    std::atomic<size_t>& nextBlock,
+    std::vector<std::shared_ptr<EvaluationResult>>& results,
+    std::vector<Archive*>& archives, bool useMainEnvironment)
+{
+    // Clone learningEnvironment
+    LearningEnvironment* privateLearningEnvironment =
+        useMainEnvironment ? &this->learningEnvironment
+                           : this->learningEnvironment.clone();
+
+    // Create a TPGExecutionEngine
+    Environment privateEnv(this->env.getInstructionSet(),
+                           privateLearningEnvironment->getDataSources(),
+                           this->env.getNbRegisters(),
+                           this->env.getNbConstant());
+    std::unique_ptr<TPG::TPGExecutionEngine> tee =
+        this->createTPGExecutionEngine(privateEnv, NULL);
+
+    // Pick blocks until all are evaluated
+    size_t block;
+    while ((block = nextBlock.fetch_add(1)) < blocks.size() - 1) {
+        for (size_t k = blocks[block]; k < blocks[block + 1]; k++) {
+            size_t i = order[k];
+
+            // Dedicated archive for the job
+            if (mode == LearningMode::TRAINING) {
+                archives[i] =
+                    new Archive(params.archiveSize, params.archivingProbability,
+                                jobs[i]->getArchiveSeed());
+            }
+            tee->setArchive(archives[i]);
+
+            results[i] = this->evaluateJob(*tee, *jobs[i], generationNumber,
+                                           mode, *privateLearningEnvironment);
+        }
+    }
+
+    // Clean up
+    if (!useMainEnvironment) {
+        delete privateLearningEnvironment;
+    }
+}
+
+size_t Learn::TournamentLearningAgent::getNbRounds() const
+{
+    return (size_t)std::ceil((double)params.nbIterationsPerPolicyEvaluation /
+                             (double)params.nbIterationsPerJob);
+}
+
+std::queue<std::shared_ptr<Learn::Job>> Learn::TournamentLearningAgent::
+    makeJobs(Learn::LearningMode mode, TPG::TPGGraph* tpgGraph)
+{
+    // sets the tpg to the Learning Agent's one if no one was specified
+    tpgGraph = tpgGraph == nullptr ? tpg.get() : tpgGraph;
+
+    std::queue<std::shared_ptr<Learn::Job>> jobs;
+
+    auto roots = tpgGraph->getRootVertices();
+    if (roots.empty()) {
+        return jobs;
+    }
+
+    size_t nbGroups =
+        (roots.size() + agentsPerEvaluation - 1) / agentsPerEvaluation;
+    size_t nbSeats = nbGroups * agentsPerEvaluation;
+    size_t nbRounds = this->getNbRounds();
+
+    size_t index = 0;
+    std::vector<const TPG::TPGVertex*> seats(nbSeats);
+    std::vector<const TPG::TPGVertex*> group(agentsPerEvaluation);
+    for (size_t round = 0; round < nbRounds; round++) {
+        // The first root never moves, the others rotate on the other seats.
+        // Seats exceeding the number of roots are byes, left empty.
+        seats[0] = roots[0];
+        for (size_t seat = 1; seat < nbSeats; seat++) {
+            size_t player = (seat - 1 + round) % (nbSeats - 1) + 1;
+            seats[seat] = (player < roots.size()) ? roots[player] : nullptr;
+        }
+
+        // Gather seats into groups, browsing them back and forth.
+        // e.g. with 3 groups of 2 agents: {0, 5}, {1, 4}, {2, 3}.
+        for (size_t g = 0; g < nbGroups; g++) {
+            for (size_t j = 0; j < agentsPerEvaluation; j++) {
+                size_t seat = (j % 2 == 0) ? j * nbGroups + g
+                                           : (j + 1) * nbGroups - 1 - g;
+                // Rotate the playing order
+                group[(j + round) % agentsPerEvaluation] = seats[seat];
+            }
+
+            uint64_t archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
+            auto job = std::make_shared<Learn::AdversarialJob>(
+                Learn::AdversarialJob({}, archiveSeed, index++, -1));
+            size_t filler = 0;
+            for (auto root : group) {
+                if (root != nullptr) {
+                    job->addRoot(root);
+                    continue;
+                }
+                // Byes are taken by the first roots not in the group, unless
+                // there are not enough roots.
+                while (filler < roots.size() &&
+                       std::find(group.begin(), group.end(), roots[filler]) !=
+                           group.end()) {
+                    filler++;
+                }
+                job->addFillerRoot(roots[std::min(filler, roots.size() - 1)]);
+                filler++;
+            }
+            jobs.push(job);
+        }
+    }
+
+    return jobs;
+}
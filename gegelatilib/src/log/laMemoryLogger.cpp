@@ -0,0 +1,96 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include "learn/learningAgent.h"
+
+#include "log/laMemoryLogger.h"
+
+void Log::LAMemoryLogger::logKiB(size_t bytes)
+{
+    *this << std::setw(colWidth) << (double)bytes / 1024.0;
+}
+
+void Log::LAMemoryLogger::logHeader()
+{
+    *this << std::setw(colWidth) << "Gen" << std::setw(colWidth) << "M_popul"
+          << std::setw(colWidth) << "Vertices" << std::setw(colWidth)
+          << "Edges" << std::setw(colWidth) << "Programs"
+          << std::setw(colWidth) << "Lines" << std::setw(colWidth)
+          << "Constants" << std::setw(colWidth) << "Archive"
+          << std::setw(colWidth) << "ArchData" << std::setw(colWidth)
+          << "Caches" << std::setw(colWidth) << "Total" << std::endl;
+}
+
+void Log::LAMemoryLogger::logNewGeneration(uint64_t& generationNumber)
+{
+    *this << std::setw(colWidth) << generationNumber;
+}
+
+void Log::LAMemoryLogger::logAfterPopulateTPG()
+{
+    logKiB(this->learningAgent.getMemoryUsage().getTotal());
+}
+
+void Log::LAMemoryLogger::logAfterEvaluate(
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>& results)
+{
+    // nothing to log
+}
+
+void Log::LAMemoryLogger::logAfterDecimate()
+{
+    // nothing to log
+}
+
+void Log::LAMemoryLogger::logAfterValidate(
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>& results)
+{
+    // nothing to log
+}
+
+void Log::LAMemoryLogger::logEndOfTraining()
+{
+    Util::MemoryUsage usage = this->learningAgent.getMemoryUsage();
+    logKiB(usage.vertices);
+    logKiB(usage.edges);
+    logKiB(usage.programs);
+    logKiB(usage.lines);
+    logKiB(usage.constants);
+    logKiB(usage.archiveRecordings);
+    logKiB(usage.archiveDataHandlers);
+    logKiB(usage.caches);
+    logKiB(usage.getTotal());
+    *this << std::endl;
+}
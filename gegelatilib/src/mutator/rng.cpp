@@ -33,6 +33,9 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <sstream>
+#include <stdexcept>
+
 #include "mutator/rng.h"
 #include "mutator/deterministicRandom.h"
 
@@ -41,6 +44,24 @@ void Mutator::RNG::setSeed(uint64_t seed)
     engine->seed(seed);
 }
 
+std::string Mutator::RNG::getState() const
+{
+    std::ostringstream stream;
+    stream << *engine;
+    return stream.str();
+}
+
+void Mutator::RNG::setState(const std::string& state)
+{
+    std::istringstream stream(state);
+    std::mt19937_64 newEngine;
+    stream >> newEngine;
+    if (stream.fail()) {
+        throw std::runtime_error("Invalid random number generator state.");
+    }
+    *engine = newEngine;
+}
+
 uint64_t Mutator::RNG::getUnsignedInt64(uint64_t min, uint64_t max)
 {
     Mutator::uniform_int_distribution<uint64_t> distribution(min, max);
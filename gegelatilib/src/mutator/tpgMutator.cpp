@@ -35,6 +35,7 @@
  */
 
 #include <algorithm>
+#include <exception>
 #include <mutex>
 #include <numeric>
 #include <queue>
@@ -49,6 +50,7 @@
 #include "tpg/tpgEdge.h"
 #include "tpg/tpgGraph.h"
 #include "tpg/tpgTeam.h"
+#include "util/profiler.h"
 
 #include "mutator/mutationParameters.h"
 #include "mutator/programMutator.h"
@@ -173,46 +175,60 @@ void Mutator::TPGMutator::removeRandomEdge(TPG::TPGGraph& graph,
     graph.removeEdge(*removedEdge);
 }
 
-void Mutator::TPGMutator::addRandomEdge(
-    TPG::TPGGraph& graph, const TPG::TPGTeam& team,
+/**
+ * \brief Pick randomly a TPGEdge to duplicate among pre-existing ones.
+ *
+ * TPGEdge whose source or destination is the given TPGVertex are excluded
+ * from the candidates. Candidates are counted and browsed in place, which
+ * avoids copying the list of pre-existing TPGEdge for each added TPGEdge.
+ *
+ * \param[in] team the TPGVertex whose connected TPGEdge are excluded.
+ * \param[in] preExistingEdges the TPGEdge candidates for cloning.
+ * \param[in] rng Random Number Generator used in the mutation process.
+ * \return a pointer to the picked TPGEdge.
+ * \throw std::runtime_error if there is no candidate TPGEdge.
+ */
+static const TPG::TPGEdge* pickEdgeToClone(
+    const TPG::TPGVertex* team,
     const std::list<const TPG::TPGEdge*>& preExistingEdges, Mutator::RNG& rng)
 {
-    // Pick an edge (excluding ones from the team and edges with the team as a
-    // destination)
-    auto pickableEdges(preExistingEdges);
-    // cf erase-remove idiom
-    pickableEdges.erase(
-        std::remove_if(pickableEdges.begin(), pickableEdges.end(),
-                       [&team](const TPG::TPGEdge* edge) -> bool {
-                           return edge->getSource() == &team ||
-                                  edge->getDestination() == &team;
-                       }),
-        pickableEdges.end());
+    auto isPickable = [team](const TPG::TPGEdge* edge) -> bool {
+        return edge->getSource() != team && edge->getDestination() != team;
+    };
+
+    size_t nbPickableEdges = std::count_if(
+        preExistingEdges.begin(), preExistingEdges.end(), isPickable);
+    if (nbPickableEdges == 0) {
+        throw std::runtime_error("No TPGEdge can be duplicated.");
+    }
 
     // Pick a pickable Edge
-    // (This code assumes that the set of pickable edge is never empty..
-    // otherwise it will throw an exception. Possible solution if needed
-    // initialize an entirely new program and pick a random target.)
-    std::list<const TPG::TPGEdge*>::iterator iter = pickableEdges.begin();
-    std::advance(iter, rng.getUnsignedInt64(0, pickableEdges.size() - 1));
-    const TPG::TPGEdge* pickedEdge = *iter;
+    uint64_t pickedIdx = rng.getUnsignedInt64(0, nbPickableEdges - 1);
+    auto iter = std::find_if(preExistingEdges.begin(), preExistingEdges.end(),
+                             isPickable);
+    while (pickedIdx > 0) {
+        iter = std::find_if(std::next(iter), preExistingEdges.end(),
+                            isPickable);
+        pickedIdx--;
+    }
 
-    // Create new edge from team and with the same ProgramSharedPointer
-    // But with the team as its source
-    // throw std::runtime_error if the edge is not from the graph;
-    const TPG::TPGEdge& newEdge = graph.cloneEdge(*pickedEdge);
-    graph.setEdgeSource(newEdge, team);
+    return *iter;
 }
 
-void Mutator::TPGMutator::mutateEdgeDestination(
-    TPG::TPGGraph& graph, const TPG::TPGEdge* edge,
+/**
+ * \brief Pick randomly a new destination for a mutated TPGEdge.
+ *
+ * \param[in] preExistingTeams the TPGTeam candidates for destination.
+ * \param[in] preExistingActions the TPGAction candidates for destination.
+ * \param[in] params Probability parameters for the mutation.
+ * \param[in] rng Random Number Generator used in the mutation process.
+ * \return a pointer to the picked TPGVertex.
+ */
+static const TPG::TPGVertex* pickEdgeDestination(
     const std::vector<const TPG::TPGTeam*>& preExistingTeams,
     const std::vector<const TPG::TPGAction*>& preExistingActions,
     const Mutator::MutationParameters& params, Mutator::RNG& rng)
 {
-    // Pick an edge among preexisting vertices
-    const TPG::TPGVertex* target = NULL;
-
     // Should the new target be an action or a team
     bool targetAction =
         rng.getDouble(0, 1) < params.tpg.pEdgeDestinationIsAction;
@@ -222,13 +238,40 @@ void Mutator::TPGMutator::mutateEdgeDestination(
     // as the presence of cycle in TPGs is not possible according to the current
     // mutation process.
     if (targetAction) {
-        target = preExistingTeams.at(
+        return preExistingTeams.at(
             rng.getUnsignedInt64(0, preExistingActions.size() - 1));
     }
     else {
-        target = preExistingTeams.at(
+        return preExistingTeams.at(
             rng.getUnsignedInt64(0, preExistingTeams.size() - 1));
     }
+}
+
+void Mutator::TPGMutator::addRandomEdge(
+    TPG::TPGGraph& graph, const TPG::TPGTeam& team,
+    const std::list<const TPG::TPGEdge*>& preExistingEdges, Mutator::RNG& rng)
+{
+    // Pick an edge (excluding ones from the team and edges with the team as a
+    // destination)
+    const TPG::TPGEdge* pickedEdge =
+        pickEdgeToClone(&team, preExistingEdges, rng);
+
+    // Create new edge from team and with the same ProgramSharedPointer
+    // But with the team as its source
+    // throw std::runtime_error if the edge is not from the graph;
+    const TPG::TPGEdge& newEdge = graph.cloneEdge(*pickedEdge);
+    graph.setEdgeSource(newEdge, team);
+}
+
+void Mutator::TPGMutator::mutateEdgeDestination(
+    TPG::TPGGraph& graph, const TPG::TPGEdge* edge,
+    const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+    const std::vector<const TPG::TPGAction*>& preExistingActions,
+    const Mutator::MutationParameters& params, Mutator::RNG& rng)
+{
+    // Pick an edge among preexisting vertices
+    const TPG::TPGVertex* target = pickEdgeDestination(
+        preExistingTeams, preExistingActions, params, rng);
 
     // Change the target
     // Changing the target should not fail.
@@ -315,11 +358,114 @@ void Mutator::TPGMutator::mutateTPGTeam(
     }
 }
 
+Mutator::TPGMutator::TPGTeamMutationPlan Mutator::TPGMutator::
+    planTPGTeamMutation(
+        const TPG::TPGTeam& clonedTeam,
+        const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+        const std::vector<const TPG::TPGAction*>& preExistingActions,
+        const std::list<const TPG::TPGEdge*>& preExistingEdges,
+        const Mutator::MutationParameters& params, Mutator::RNG& rng)
+{
+    // Start from a clone of the team outgoing edges
+    TPGTeamMutationPlan plan;
+    for (const TPG::TPGEdge* edge : clonedTeam.getOutgoingEdges()) {
+        plan.edges.push_back({edge, edge->getDestination(), false});
+    }
+
+    // 1. Remove randomly selected edges
+    {
+        // Keep at least two edges (otherwise the team is useless)
+        double proba = 1.0;
+        while (plan.edges.size() > 2 && proba > rng.getDouble(0.0, 1.0)) {
+            plan.edges.erase(plan.edges.begin() +
+                             rng.getUnsignedInt64(0, plan.edges.size() - 1));
+
+            // Decrement the proba of removing another edge
+            proba *= params.tpg.pEdgeDeletion;
+        }
+    }
+
+    // 2. Add random duplicated edge with the team as its source
+    // (the clone does not exist yet, so no candidate edge is connected to it)
+    {
+        double proba = 1.0;
+        while (plan.edges.size() < params.tpg.maxOutgoingEdges &&
+               proba > rng.getDouble(0.0, 1.0)) {
+            const TPG::TPGEdge* pickedEdge =
+                pickEdgeToClone(nullptr, preExistingEdges, rng);
+            plan.edges.push_back(
+                {pickedEdge, pickedEdge->getDestination(), false});
+
+            // Decrement the proba of adding another edge
+            proba *= params.tpg.pEdgeAddition;
+        }
+    }
+
+    // 3. Mutate edges of the team
+    {
+        bool anyMutationDone = false;
+        do {
+            for (TPGTeamMutationPlan::PlannedEdge& edge : plan.edges) {
+                if (rng.getDouble(0.0, 1.0) < params.tpg.pProgramMutation) {
+                    edge.mutateProgram = true;
+                    if (rng.getDouble(0.0, 1.0) <
+                        params.tpg.pEdgeDestinationChange) {
+                        edge.destination = pickEdgeDestination(
+                            preExistingTeams, preExistingActions, params, rng);
+                    }
+                    anyMutationDone = true;
+                }
+            }
+        } while (!anyMutationDone);
+    }
+
+    return plan;
+}
+
+const TPG::TPGTeam& Mutator::TPGMutator::applyTPGTeamMutationPlan(
+    TPG::TPGGraph& graph, const TPGTeamMutationPlan& plan,
+    std::list<std::shared_ptr<Program::Program>>& newPrograms)
+{
+    // Check the plan before modifying the graph
+    for (const TPGTeamMutationPlan::PlannedEdge& plannedEdge : plan.edges) {
+        if (std::none_of(
+                graph.getEdges().begin(), graph.getEdges().end(),
+                [&plannedEdge](const std::unique_ptr<TPG::TPGEdge>& edge) {
+                    return edge.get() == plannedEdge.model;
+                })) {
+            throw std::runtime_error(
+                "Cannot duplicate an Edge not belonging to the graph.");
+        }
+    }
+
+    const TPG::TPGTeam& team = graph.addNewTeam();
+    for (const TPGTeamMutationPlan::PlannedEdge& plannedEdge : plan.edges) {
+        // Duplicate the edge with the team as its source
+        const TPG::TPGEdge& newEdge = graph.cloneEdge(*plannedEdge.model);
+        graph.setEdgeSource(newEdge, team);
+        if (plannedEdge.destination != newEdge.getDestination()) {
+            graph.setEdgeDestination(newEdge, *plannedEdge.destination);
+        }
+
+        // Copy the program to mutate
+        if (plannedEdge.mutateProgram) {
+            std::shared_ptr<Program::Program> newProg(
+                new Program::Program(plannedEdge.model->getProgram()));
+            newPrograms.push_back(newProg);
+            newEdge.setProgram(newProg);
+        }
+    }
+
+    return team;
+}
+
 void Mutator::TPGMutator::mutateProgramBehaviorAgainstArchive(
     std::shared_ptr<Program::Program>& newProg,
     const Mutator::MutationParameters& params, const Archive& archive,
     Mutator::RNG& rng)
 {
+    Util::Profiler::Span span("mutateProgramBehavior", "mutation");
+
     // If the Program behavior should be new after mutation:
     std::shared_ptr<Program::Program> newProgCopy(nullptr);
     if (params.tpg.forceProgramBehaviorChangeOnMutation) {
@@ -331,6 +477,8 @@ void Mutator::TPGMutator::mutateProgramBehaviorAgainstArchive(
     bool allUnique;
     // Mutate behavior until it changes (against the archive).
     do {
+        // Each iteration is a new attempt at finding a unique behavior
+        Util::Profiler::Span attemptSpan("mutationAttempt", "mutation");
 
         // Mutate until something is mutated (i.e. the function returns true)
         // And until the program behavior is changed
@@ -396,6 +544,7 @@ void Mutator::TPGMutator::mutateNewProgramBehaviors(
                 std::pair<std::shared_ptr<Program::Program>, uint64_t> job;
                 jobDone = false;
                 { // get one job critical section
+                    Util::Profiler::Span span("waitMutationQueue", "mutation");
                     std::lock_guard lock(mutexMutation);
                     if (programsToMutate.size() != 0) {
                         jobDone = true;
@@ -491,19 +640,90 @@ void Mutator::TPGMutator::populateTPG(TPG::TPGGraph& graph,
     // While the target is not reached, add new teams
     uint64_t currentNumberOfRoot = rootVertices.size();
     while (params.tpg.nbRoots > currentNumberOfRoot) {
-        // Select a random existing root
-        uint64_t clonedRootIndex =
-            rng.getUnsignedInt64(0, rootTeams.size() - 1);
-        // clone it (the vertex and all its outgoing edges)
-        const TPG::TPGTeam& newRoot = (const TPG::TPGTeam&)graph.cloneVertex(
-            *rootTeams.at(clonedRootIndex));
-        // Apply mutations to the root
-        mutateTPGTeam(graph, archive, newRoot, preExistingTeams,
-                      preExistingActions, preExistingEdges, newPrograms, params,
-                      rng);
-        // Check the new number of roots
-        // Needed since preExisting root may be subsumed by new ones.
-        currentNumberOfRoot = graph.getNbRootVertices();
+        // Plan the mutation of one clone per missing root.
+        // The cloned root and the seed of each plan are drawn in order, so
+        // that plans do not depend on the number of threads.
+        size_t nbPlans = params.tpg.nbRoots - currentNumberOfRoot;
+        std::vector<std::pair<const TPG::TPGTeam*, uint64_t>> jobs;
+        for (size_t idx = 0; idx < nbPlans; idx++) {
+            // Select a random existing root
+            uint64_t clonedRootIndex =
+                rng.getUnsignedInt64(0, rootTeams.size() - 1);
+            uint64_t seed = rng.getUnsignedInt64(0, UINT64_MAX);
+            jobs.emplace_back(rootTeams.at(clonedRootIndex), seed);
+        }
+
+        // Plans only read the graph, which is not modified until all plans
+        // are built.
+        // Exceptions thrown while planning are kept, so that they do not
+        // terminate worker threads, and rethrown once all threads are
+        // joined.
+        std::vector<TPGTeamMutationPlan> plans(nbPlans);
+        std::vector<std::exception_ptr> errors(nbPlans);
+        auto planJob = [&](size_t jobIdx) {
+            try {
+                Mutator::RNG privateRNG(jobs.at(jobIdx).second);
+                plans.at(jobIdx) = planTPGTeamMutation(
+                    *jobs.at(jobIdx).first, preExistingTeams,
+                    preExistingActions, preExistingEdges, params, privateRNG);
+            }
+            catch (...) {
+                errors.at(jobIdx) = std::current_exception();
+            }
+        };
+
+        if (maxNbThreads <= 1 || nbPlans == 1) {
+            for (size_t idx = 0; idx < nbPlans; idx++) {
+                planJob(idx);
+            }
+        }
+        else {
+            std::mutex mutex;
+            size_t nextJob = 0;
+            auto parallelWorker = [&]() {
+                while (true) {
+                    size_t jobIdx;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (nextJob == nbPlans) {
+                            return;
+                        }
+                        jobIdx = nextJob++;
+                    }
+                    planJob(jobIdx);
+                }
+            };
+
+            std::vector<std::thread> threads;
+            uint64_t nbThreads = std::min<uint64_t>(maxNbThreads, nbPlans);
+            for (uint64_t idx = 0; idx < nbThreads - 1; idx++) {
+                threads.emplace_back(parallelWorker);
+            }
+            parallelWorker();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        // Rethrow the exception of the first failed plan, as in sequential
+        // mode.
+        for (const std::exception_ptr& error : errors) {
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Apply plans in order
+        for (const TPGTeamMutationPlan& plan : plans) {
+            applyTPGTeamMutationPlan(graph, plan, newPrograms);
+
+            // Check the new number of roots
+            // Needed since preExisting root may be subsumed by new ones.
+            currentNumberOfRoot = graph.getNbRootVertices();
+            if (currentNumberOfRoot >= params.tpg.nbRoots) {
+                break;
+            }
+        }
     }
 
     // Mutate the new Programs
@@ -44,6 +44,12 @@ const Environment& Program::Line::getEnvironment() const
     return this->environment;
 }
 
+size_t Program::Line::getMemoryFootprint() const
+{
+    return sizeof(Line) + this->environment.getMaxNbOperands() *
+                              sizeof(std::pair<uint64_t, uint64_t>);
+}
+
 uint64_t Program::Line::getDestinationIndex() const
 {
     return this->destinationIndex;
@@ -64,6 +64,7 @@ Program::Line& Program::Program::addNewLine(const uint64_t idx)
         throw std::out_of_range(
             "Attempting to insert a line beyond the program end.");
     }
+    this->setValidation(nullptr);
     // Allocate the zero-filled memory
     Line* newLine = new Line(this->environment);
     // new line is not marked as an intron by default
@@ -93,6 +94,7 @@ void Program::Program::clearIntrons()
 
 void Program::Program::removeLine(const uint64_t idx)
 {
+    this->setValidation(nullptr);
     delete this->lines.at(idx).first; // throws std::out_of_range on bad index.
     this->lines.erase(this->lines.begin() + idx);
 }
@@ -104,6 +106,7 @@ void Program::Program::swapLines(const uint64_t idx0, const uint64_t idx1)
             "Attempting to swap a line beyond the program end.");
     }
 
+    this->setValidation(nullptr);
     std::iter_swap(this->lines.begin() + idx0, this->lines.begin() + idx1);
 }
 
@@ -125,6 +128,8 @@ const Program::Line& Program::Program::getLine(uint64_t index) const
 
 Program::Line& Program::Program::getLine(uint64_t index)
 {
+    // The returned Line may be modified.
+    this->setValidation(nullptr);
     return *this->lines.at(index)
                 .first; // throws std::out_of_range on bad index.
 }
@@ -135,28 +140,27 @@ bool Program::Program::isIntron(uint64_t index) const
         .second; // throws std::out_of_range on bad index.
 }
 
-uint64_t Program::Program::identifyIntrons()
+std::vector<bool> Program::Program::findIntrons() const
 {
     // Create fake registers to identify accessed addresses.
     const Data::DataHandler& fakeRegisters =
         this->environment.getFakeDataSources().at(0);
-    // Number of introns within the Program.
-    uint64_t nbIntrons = 0;
+    // Intron flag of each line, in Program order.
+    std::vector<bool> introns(this->lines.size(), true);
     // Set of useful register
     std::set<uint64_t> usefulRegisters;
     // Start with only register 0
     usefulRegisters.insert(0);
 
     // Scan program lines backward
-    auto backIter = this->lines.rbegin();
-    while (backIter != this->lines.rend()) {
+    for (size_t idx = this->lines.size(); idx > 0; idx--) {
         // Check if the currentLine output is within usefulRegisters
-        Line* currentLine = backIter->first;
+        const Line* currentLine = this->lines.at(idx - 1).first;
         uint64_t destinationIndex = currentLine->getDestinationIndex();
         auto destinationRegister = usefulRegisters.find(destinationIndex);
         if (destinationRegister != usefulRegisters.end()) {
             // The Line is useful (i.e. not an introns)
-            backIter->second = false;
+            introns.at(idx - 1) = false;
 
             // Remove the destination register from the list of useful operands
             usefulRegisters.erase(*destinationRegister);
@@ -186,25 +190,57 @@ uint64_t Program::Program::identifyIntrons()
                 }
             }
         }
-        else {
-            // The destination of the line is not within useful registers
-            // the line does not contribute to the result of the Program
-            // it is an intron.
-            backIter->second = true;
-            nbIntrons++;
-        }
+        // Otherwise, the destination of the line is not within useful
+        // registers the line does not contribute to the result of the
+        // Program it is an intron.
+    }
 
-        backIter++;
+    return introns;
+}
+
+uint64_t Program::Program::identifyIntrons()
+{
+    std::vector<bool> introns = this->findIntrons();
+    this->setValidation(nullptr);
+
+    // Number of introns within the Program.
+    uint64_t nbIntrons = 0;
+    for (size_t idx = 0; idx < this->lines.size(); idx++) {
+        this->lines.at(idx).second = introns.at(idx);
+        nbIntrons += (introns.at(idx)) ? 1 : 0;
     }
 
     return nbIntrons;
 }
 
+std::shared_ptr<const Program::ProgramValidation> Program::Program::
+    getValidation() const
+{
+    return std::atomic_load(&this->validation);
+}
+
+void Program::Program::setValidation(
+    std::shared_ptr<const ProgramValidation> validation) const
+{
+    std::atomic_store(&this->validation, std::move(validation));
+}
+
 const Data::ConstantHandler& Program::Program::cGetConstantHandler() const
 {
     return this->constants;
 }
 
+void Program::Program::addMemoryUsage(Util::MemoryUsage& usage) const
+{
+    // The ConstantHandler is accounted as constants.
+    usage.programs += sizeof(Program) - sizeof(Data::ConstantHandler) +
+                      this->lines.capacity() * sizeof(std::pair<Line*, bool>);
+    for (const auto& line : this->lines) {
+        usage.lines += line.first->getMemoryFootprint();
+    }
+    usage.constants += this->constants.getMemoryFootprint();
+}
+
 Data::ConstantHandler& Program::Program::getConstantHandler()
 {
     return this->constants;
@@ -35,6 +35,8 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
+
 #include "program/programEngine.h"
 #include "data/constantHandler.h"
 
@@ -85,6 +87,157 @@ void Program::ProgramEngine::setProgram(const Program& prog)
 
     // Reset the counters
     this->programCounter = 0;
+
+    // Check the program once for all its executions
+    this->validation = this->validateProgram(prog);
+    this->programValidated = this->validation->isValid;
+
+    // Copy the constants used by validated programs
+    if (this->programValidated && this->nbConstants > 0) {
+        const std::vector<Data::Constant>& constants =
+            *prog.cGetConstantHandler().getPointer();
+        std::copy(constants.begin(), constants.end(), this->constantValues);
+    }
+}
+
+void Program::ProgramEngine::initValues(size_t nbRegs, size_t nbConsts)
+{
+    if (nbRegs <= NB_INLINE_REGISTERS) {
+        this->registerValues = this->inlineRegisters;
+    }
+    else {
+        this->heapRegisters.resize(nbRegs);
+        this->registerValues = this->heapRegisters.data();
+    }
+    if (nbConsts <= NB_INLINE_CONSTANTS) {
+        this->constantValues = this->inlineConstants;
+    }
+    else {
+        this->heapConstants.resize(nbConsts);
+        this->constantValues = this->heapConstants.data();
+    }
+    this->nbConstants = nbConsts;
+
+    // Operands never own the values.
+    for (size_t i = 0; i < nbRegs; i++) {
+        this->registerValues[i] = 0.0;
+        this->registerOperands.emplace_back(
+            (const double*)&this->registerValues[i],
+            Data::UntypedSharedPtr::emptyDestructor<const double>());
+    }
+    for (size_t i = 0; i < nbConsts; i++) {
+        this->constantValues[i] = {0};
+        this->constantOperands.emplace_back(
+            (const Data::Constant*)&this->constantValues[i],
+            Data::UntypedSharedPtr::emptyDestructor<const Data::Constant>());
+    }
+}
+
+std::shared_ptr<const Program::ProgramValidation> Program::ProgramEngine::
+    validateProgram(const Program& prog)
+{
+    const uint64_t nbRegisters = this->registers.getLargestAddressSpace();
+    const size_t nbDataHandlers = this->dataScsConstsAndRegs.size();
+
+    // Reuse the validation of a previous setProgram() when the Program was
+    // not modified since.
+    std::shared_ptr<const ProgramValidation> cached = prog.getValidation();
+    if (cached != nullptr && cached->nbRegisters == nbRegisters &&
+        cached->nbConstants == this->nbConstants &&
+        cached->nbDataHandlers == nbDataHandlers) {
+        return cached;
+    }
+
+    std::shared_ptr<ProgramValidation> validation =
+        std::make_shared<ProgramValidation>();
+    validation->nbRegisters = nbRegisters;
+    validation->nbConstants = this->nbConstants;
+    validation->nbDataHandlers = nbDataHandlers;
+    validation->isValid = this->fillValidation(prog, *validation);
+    if (!validation->isValid) {
+        validation->lines.clear();
+        validation->operands.clear();
+    }
+    prog.setValidation(validation);
+
+    return validation;
+}
+
+bool Program::ProgramEngine::fillValidation(const Program& prog,
+                                            ProgramValidation& validation)
+{
+    const Instructions::Set& set = prog.getEnvironment().getInstructionSet();
+    const size_t nbDataHandlers = this->dataScsConstsAndRegs.size();
+    const size_t maxNbOperands = set.getMaxNbOperands();
+
+    // Address spaces only depend on the Instructions and on the
+    // characteristics of the data sources, which are checked by setProgram.
+    if (this->addressSpacesSet != &set) {
+        this->addressSpaces.assign(
+            set.getNbInstructions() * maxNbOperands * nbDataHandlers, 0);
+        for (size_t i = 0; i < set.getNbInstructions(); i++) {
+            const Instructions::Instruction& instruction =
+                set.getInstruction(i);
+            for (size_t j = 0; j < instruction.getNbOperands(); j++) {
+                const std::type_info& type =
+                    instruction.getOperandTypes().at(j).get();
+                const size_t offset = (i * maxNbOperands + j) * nbDataHandlers;
+                for (size_t k = 0; k < nbDataHandlers; k++) {
+                    this->addressSpaces.at(offset + k) =
+                        this->dataScsConstsAndRegs.at(k).get().getAddressSpace(
+                            type);
+                }
+            }
+        }
+        this->addressSpacesSet = &set;
+    }
+
+    // Constants are copied in constantValues.
+    if (prog.getEnvironment().getNbConstant() != this->nbConstants) {
+        return false;
+    }
+
+    const uint64_t nbRegisters = validation.nbRegisters;
+    for (uint64_t lineIdx = 0; lineIdx < prog.getNbLines(); lineIdx++) {
+        if (prog.isIntron(lineIdx)) {
+            continue;
+        }
+
+        const Line& line = prog.getLine(lineIdx);
+        const uint64_t instructionIndex = line.getInstructionIndex();
+        if (instructionIndex >= set.getNbInstructions() ||
+            line.getDestinationIndex() >= nbRegisters) {
+            return false;
+        }
+
+        const Instructions::Instruction& instruction =
+            set.getInstruction(instructionIndex);
+        validation.lines.push_back({instructionIndex, &instruction,
+                                    line.getDestinationIndex(),
+                                    validation.operands.size()});
+        for (size_t j = 0; j < instruction.getNbOperands(); j++) {
+            const std::pair<uint64_t, uint64_t>& operand = line.getOperand(j);
+            if (operand.first >= nbDataHandlers) {
+                return false;
+            }
+            const size_t offset =
+                (instructionIndex * maxNbOperands + j) * nbDataHandlers;
+            const uint64_t addressSpace =
+                this->addressSpaces.at(offset + operand.first);
+            if (addressSpace == 0) {
+                return false;
+            }
+            validation.operands.emplace_back(operand.first,
+                                             operand.second % addressSpace);
+        }
+    }
+
+    return true;
+}
+
+bool Program::ProgramEngine::isProgramValidated() const
+{
+    return this->programValidated;
 }
 
 const std::vector<std::reference_wrapper<const Data::DataHandler>>& Program::
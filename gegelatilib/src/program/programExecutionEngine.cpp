@@ -35,6 +35,8 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
+
 #include "program/programExecutionEngine.h"
 #include "program/line.h"
 
@@ -57,6 +59,13 @@ void Program::ProgramExecutionEngine::executeCurrentLine()
 double Program::ProgramExecutionEngine::executeProgram(
     const bool ignoreException)
 {
+    if (this->programValidated) {
+        // Validated programs use the inline registers.
+        std::fill_n(this->registerValues, this->registerOperands.size(), 0.0);
+        this->executeValidatedProgram();
+        return this->registerValues[0];
+    }
+
     // Reset registers and programCounter
     this->registers.resetData();
 
@@ -68,6 +77,87 @@ double Program::ProgramExecutionEngine::executeProgram(
                  .getSharedPointer<const double>());
 }
 
+/**
+ * \brief Fetch an operand of a validated Program from the registerValues or
+ * the constantValues of a ProgramEngine.
+ *
+ * \param[in] values the registerValues or constantValues.
+ * \param[in] scalars the operands pointing to each element of values.
+ * \param[in] handler the DataHandler corresponding to the values.
+ * \param[in] type the type of the operand, T or an array of T.
+ * \param[in] location the scaled location of the operand.
+ */
+template <typename T>
+static Data::UntypedSharedPtr fetchValue(
+    const T* values, const std::vector<Data::UntypedSharedPtr>& scalars,
+    const Data::DataHandler& handler, const std::type_info& type,
+    uint64_t location)
+{
+    if (type == typeid(T)) {
+        return scalars[location];
+    }
+
+    // Arrays are copied, as done by Data::ArrayWrapper::getDataAt().
+    const size_t size = scalars.size() - handler.getAddressSpace(type) + 1;
+    T* array = new T[size];
+    std::copy(values + location, values + location + size, array);
+    return Data::UntypedSharedPtr(
+        std::make_shared<Data::UntypedSharedPtr::Model<const T[]>>(array));
+}
+
+void Program::ProgramExecutionEngine::executeValidatedProgram()
+{
+    const uint64_t firstDataSource = (this->nbConstants > 0) ? 2 : 1;
+
+    // Data sources, or their data, may have changed since the last execution.
+    this->scalarAccesses.resize(this->dataScsConstsAndRegs.size());
+    for (size_t i = firstDataSource; i < this->scalarAccesses.size(); i++) {
+        this->scalarAccesses[i] =
+            this->dataScsConstsAndRegs[i].get().getScalarAccess();
+    }
+
+    const ProgramValidation& validation = *this->validation;
+    for (const ValidatedLine& line : validation.lines) {
+        const Instructions::Instruction& instruction = *line.instruction;
+        const size_t nbOperands = instruction.getNbOperands();
+        this->operands.clear();
+        for (size_t i = 0; i < nbOperands; i++) {
+            const std::pair<uint64_t, uint64_t>& operand =
+                validation.operands[line.firstOperand + i];
+            const std::type_info& type =
+                instruction.getOperandTypes()[i].get();
+            const Data::DataHandler& handler =
+                this->dataScsConstsAndRegs[operand.first].get();
+            if (operand.first >= firstDataSource) {
+                const Data::DataHandler::ScalarAccess& access =
+                    this->scalarAccesses[operand.first];
+                if (access.type != nullptr && *access.type == type) {
+                    this->operands.push_back(
+                        access.get(access.data, operand.second));
+                }
+                else {
+                    this->operands.push_back(
+                        handler.getDataAt(type, operand.second));
+                }
+            }
+            else if (operand.first == 0) {
+                this->operands.push_back(
+                    fetchValue(this->registerValues, this->registerOperands,
+                               handler, type, operand.second));
+            }
+            else {
+                this->operands.push_back(
+                    fetchValue(this->constantValues, this->constantOperands,
+                               handler, type, operand.second));
+            }
+        }
+
+        this->registerValues[line.destinationIndex] =
+            instruction.execute(this->operands);
+    }
+    this->operands.clear();
+}
+
 void Program::ProgramExecutionEngine::processLine()
 {
     this->executeCurrentLine();
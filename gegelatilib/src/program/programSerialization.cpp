@@ -0,0 +1,96 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <stdexcept>
+
+#include "data/dataHandlerSerialization.h"
+
+#include "program/programSerialization.h"
+
+using Data::Serialization::appendValue;
+using Data::Serialization::readValue;
+
+void Program::Serialization::appendProgram(std::string& buffer,
+                                          const Program& program,
+                                          const Environment& env)
+{
+    appendValue<uint64_t>(buffer, program.getNbLines());
+    for (size_t i = 0; i < env.getNbConstant(); i++) {
+        appendValue<int32_t>(buffer,
+                             static_cast<int32_t>(program.getConstantAt(i)));
+    }
+    for (size_t i = 0; i < program.getNbLines(); i++) {
+        const Line& line = program.getLine(i);
+        appendValue<uint64_t>(buffer, line.getInstructionIndex());
+        appendValue<uint64_t>(buffer, line.getDestinationIndex());
+        for (size_t j = 0; j < env.getMaxNbOperands(); j++) {
+            const std::pair<uint64_t, uint64_t>& operand = line.getOperand(j);
+            appendValue<uint64_t>(buffer, operand.first);
+            appendValue<uint64_t>(buffer, operand.second);
+        }
+    }
+}
+
+std::shared_ptr<Program::Program> Program::Serialization::readProgram(
+    const std::string& buffer, size_t& offset, const Environment& env)
+{
+    auto program = std::make_shared<Program>(env);
+    uint64_t nbLines = readValue<uint64_t>(buffer, offset);
+    for (size_t i = 0; i < env.getNbConstant(); i++) {
+        program->getConstantHandler().setDataAt(
+            typeid(Data::Constant), i,
+            Data::Constant{readValue<int32_t>(buffer, offset)});
+    }
+    size_t lineSize = (2 + 2 * env.getMaxNbOperands()) * sizeof(uint64_t);
+    if (nbLines > (buffer.size() - offset) / lineSize) {
+        throw std::runtime_error("Truncated serialized data.");
+    }
+    for (uint64_t i = 0; i < nbLines; i++) {
+        Line& line = program->addNewLine();
+        uint64_t instructionIdx = readValue<uint64_t>(buffer, offset);
+        uint64_t destinationIdx = readValue<uint64_t>(buffer, offset);
+        bool valid = line.setInstructionIndex(instructionIdx) &&
+                     line.setDestinationIndex(destinationIdx);
+        for (size_t j = 0; j < env.getMaxNbOperands(); j++) {
+            uint64_t dataIndex = readValue<uint64_t>(buffer, offset);
+            uint64_t location = readValue<uint64_t>(buffer, offset);
+            valid = line.setOperand(j, dataIndex, location) && valid;
+        }
+        if (!valid) {
+            throw std::runtime_error(
+                "Serialized Program contains an invalid line.");
+        }
+    }
+    program->identifyIntrons();
+    return program;
+}
@@ -174,8 +174,8 @@ void TPG::ExecutionStats::analyzeExecution(
 
     analyzeInstrumentedGraph(graph);
 
-    for (const auto& trace : tee.getTraceHistory())
-        analyzeInferenceTrace(trace);
+    for (uint64_t i = 0; i < tee.getNbRecordedTraces(); i++)
+        analyzeInferenceTrace(tee.getTrace(i));
 }
 
 double TPG::ExecutionStats::getAvgEvaluatedTeams() const
@@ -0,0 +1,287 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include "tpg/instrumented/streamingExecutionStats.h"
+
+#include <algorithm>
+#include <fstream>
+#include <json.h>
+#include <stdexcept>
+#include <string>
+
+TPG::StreamingExecutionStats::StreamingExecutionStats(size_t nbInstructions,
+                                                      size_t nbBins,
+                                                      uint64_t binWidth)
+    : nbBins{nbBins}, binWidth{binWidth},
+      totalExecutionsPerInstruction(nbInstructions, 0),
+      histogramEvaluatedTeams(nbBins, 0), histogramEvaluatedPrograms(nbBins, 0),
+      histogramExecutedLines(nbBins, 0),
+      histogramExecutionsPerInstruction(nbInstructions,
+                                        std::vector<uint64_t>(nbBins, 0))
+{
+    if (nbBins == 0 || binWidth == 0) {
+        throw std::invalid_argument(
+            "Histograms must have at least one bin with a non-zero width.");
+    }
+}
+
+size_t TPG::StreamingExecutionStats::getBin(uint64_t value) const
+{
+    return (size_t)std::min<uint64_t>(value / this->binWidth,
+                                      this->nbBins - 1);
+}
+
+void TPG::StreamingExecutionStats::addInference(
+    uint64_t nbEvaluatedTeams, uint64_t nbEvaluatedPrograms,
+    uint64_t nbExecutedLines,
+    const std::vector<uint64_t>& nbExecutionsPerInstruction)
+{
+    if (nbExecutionsPerInstruction.size() !=
+        this->totalExecutionsPerInstruction.size()) {
+        throw std::invalid_argument("Number of instructions differs from the "
+                                    "one of the statistics.");
+    }
+
+    this->nbInferences++;
+    this->totalEvaluatedTeams += nbEvaluatedTeams;
+    this->totalEvaluatedPrograms += nbEvaluatedPrograms;
+    this->totalExecutedLines += nbExecutedLines;
+    this->histogramEvaluatedTeams.at(this->getBin(nbEvaluatedTeams))++;
+    this->histogramEvaluatedPrograms.at(this->getBin(nbEvaluatedPrograms))++;
+    this->histogramExecutedLines.at(this->getBin(nbExecutedLines))++;
+
+    for (size_t i = 0; i < nbExecutionsPerInstruction.size(); i++) {
+        uint64_t nbExecutions = nbExecutionsPerInstruction[i];
+        if (nbExecutions > 0) {
+            this->totalExecutionsPerInstruction[i] += nbExecutions;
+            size_t bin = this->getBin(nbExecutions);
+            this->histogramExecutionsPerInstruction[i][bin]++;
+        }
+    }
+}
+
+TPG::StreamingExecutionStats& TPG::StreamingExecutionStats::operator+=(
+    const StreamingExecutionStats& other)
+{
+    if (this->getNbInstructions() != other.getNbInstructions() ||
+        this->nbBins != other.nbBins || this->binWidth != other.binWidth) {
+        throw std::invalid_argument(
+            "Merged statistics do not have the same configuration.");
+    }
+
+    this->nbInferences += other.nbInferences;
+    this->totalEvaluatedTeams += other.totalEvaluatedTeams;
+    this->totalEvaluatedPrograms += other.totalEvaluatedPrograms;
+    this->totalExecutedLines += other.totalExecutedLines;
+    for (size_t bin = 0; bin < this->nbBins; bin++) {
+        this->histogramEvaluatedTeams[bin] +=
+            other.histogramEvaluatedTeams[bin];
+        this->histogramEvaluatedPrograms[bin] +=
+            other.histogramEvaluatedPrograms[bin];
+        this->histogramExecutedLines[bin] += other.histogramExecutedLines[bin];
+    }
+    for (size_t i = 0; i < this->getNbInstructions(); i++) {
+        this->totalExecutionsPerInstruction[i] +=
+            other.totalExecutionsPerInstruction[i];
+        for (size_t bin = 0; bin < this->nbBins; bin++) {
+            this->histogramExecutionsPerInstruction[i][bin] +=
+                other.histogramExecutionsPerInstruction[i][bin];
+        }
+    }
+
+    return *this;
+}
+
+size_t TPG::StreamingExecutionStats::getNbInstructions() const
+{
+    return this->totalExecutionsPerInstruction.size();
+}
+
+size_t TPG::StreamingExecutionStats::getNbBins() const
+{
+    return this->nbBins;
+}
+
+uint64_t TPG::StreamingExecutionStats::getBinWidth() const
+{
+    return this->binWidth;
+}
+
+uint64_t TPG::StreamingExecutionStats::getNbInferences() const
+{
+    return this->nbInferences;
+}
+
+double TPG::StreamingExecutionStats::getAvgEvaluatedTeams() const
+{
+    if (this->nbInferences == 0) {
+        return 0.0;
+    }
+    return (double)this->totalEvaluatedTeams / (double)this->nbInferences;
+}
+
+double TPG::StreamingExecutionStats::getAvgEvaluatedPrograms() const
+{
+    if (this->nbInferences == 0) {
+        return 0.0;
+    }
+    return (double)this->totalEvaluatedPrograms / (double)this->nbInferences;
+}
+
+double TPG::StreamingExecutionStats::getAvgExecutedLines() const
+{
+    if (this->nbInferences == 0) {
+        return 0.0;
+    }
+    return (double)this->totalExecutedLines / (double)this->nbInferences;
+}
+
+std::vector<double> TPG::StreamingExecutionStats::
+    getAvgNbExecutionPerInstruction() const
+{
+    std::vector<double> averages(this->totalExecutionsPerInstruction.size(),
+                                 0.0);
+    if (this->nbInferences == 0) {
+        return averages;
+    }
+    for (size_t i = 0; i < averages.size(); i++) {
+        averages.at(i) = (double)this->totalExecutionsPerInstruction.at(i) /
+                         (double)this->nbInferences;
+    }
+    return averages;
+}
+
+const std::vector<uint64_t>& TPG::StreamingExecutionStats::
+    getHistogramEvaluatedTeams() const
+{
+    return this->histogramEvaluatedTeams;
+}
+
+const std::vector<uint64_t>& TPG::StreamingExecutionStats::
+    getHistogramEvaluatedPrograms() const
+{
+    return this->histogramEvaluatedPrograms;
+}
+
+const std::vector<uint64_t>& TPG::StreamingExecutionStats::
+    getHistogramExecutedLines() const
+{
+    return this->histogramExecutedLines;
+}
+
+const std::vector<std::vector<uint64_t>>& TPG::StreamingExecutionStats::
+    getHistogramNbExecutionPerInstruction() const
+{
+    return this->histogramExecutionsPerInstruction;
+}
+
+void TPG::StreamingExecutionStats::clear()
+{
+    this->nbInferences = 0;
+    this->totalEvaluatedTeams = 0;
+    this->totalEvaluatedPrograms = 0;
+    this->totalExecutedLines = 0;
+    std::fill(this->totalExecutionsPerInstruction.begin(),
+              this->totalExecutionsPerInstruction.end(), 0);
+    std::fill(this->histogramEvaluatedTeams.begin(),
+              this->histogramEvaluatedTeams.end(), 0);
+    std::fill(this->histogramEvaluatedPrograms.begin(),
+              this->histogramEvaluatedPrograms.end(), 0);
+    std::fill(this->histogramExecutedLines.begin(),
+              this->histogramExecutedLines.end(), 0);
+    for (auto& histogram : this->histogramExecutionsPerInstruction) {
+        std::fill(histogram.begin(), histogram.end(), 0);
+    }
+}
+
+void TPG::StreamingExecutionStats::writeStatsToJson(const char* filePath,
+                                                    bool noIndent) const
+{
+    std::ofstream outputFile(filePath);
+
+    Json::Value root;
+    Json::Value& stats = root["ExecutionStats"];
+
+    stats["nbInferences"] = (Json::UInt64)this->nbInferences;
+    stats["binWidth"] = (Json::UInt64)this->binWidth;
+
+    // Average statistics
+    if (this->nbInferences > 0) {
+        stats["avgEvaluatedTeams"] = this->getAvgEvaluatedTeams();
+        stats["avgEvaluatedPrograms"] = this->getAvgEvaluatedPrograms();
+        stats["avgExecutedLines"] = this->getAvgExecutedLines();
+        for (size_t i = 0; i < this->getNbInstructions(); i++) {
+            if (this->totalExecutionsPerInstruction[i] > 0) {
+                stats["avgNbExecutionPerInstruction"][std::to_string(i)] =
+                    (double)this->totalExecutionsPerInstruction[i] /
+                    (double)this->nbInferences;
+            }
+        }
+    }
+
+    // Distributions, with non-empty bins only
+    auto writeHistogram = [this](Json::Value& value,
+                                 const std::vector<uint64_t>& histogram) {
+        for (size_t bin = 0; bin < this->nbBins; bin++) {
+            if (histogram[bin] > 0) {
+                value[std::to_string(bin * this->binWidth)] =
+                    (Json::UInt64)histogram[bin];
+            }
+        }
+    };
+    writeHistogram(stats["distributionEvaluatedTeams"],
+                   this->histogramEvaluatedTeams);
+    writeHistogram(stats["distributionEvaluatedPrograms"],
+                   this->histogramEvaluatedPrograms);
+    writeHistogram(stats["distributionExecutedLines"],
+                   this->histogramExecutedLines);
+    for (size_t i = 0; i < this->getNbInstructions(); i++) {
+        if (this->totalExecutionsPerInstruction[i] > 0) {
+            writeHistogram(
+                stats["distributionNbExecutionPerInstruction"]
+                     [std::to_string(i)],
+                this->histogramExecutionsPerInstruction[i]);
+        }
+    }
+
+    Json::StreamWriterBuilder writerFactory;
+    // Set a precision to 6 digits after the point.
+    writerFactory.settings_["precision"] = 6U;
+    if (noIndent)
+        writerFactory.settings_["indentation"] = "";
+    Json::StreamWriter* writer = writerFactory.newStreamWriter();
+    writer->write(root, &outputFile);
+    delete writer;
+
+    outputFile.close();
+}
@@ -40,11 +40,21 @@ uint64_t TPG::TPGEdgeInstrumented::getNbVisits() const
     return this->nbVisits;
 }
 
+size_t TPG::TPGEdgeInstrumented::getMemoryFootprint() const
+{
+    return sizeof(TPGEdgeInstrumented);
+}
+
 void TPG::TPGEdgeInstrumented::incrementNbVisits() const
 {
     this->nbVisits++;
 }
 
+void TPG::TPGEdgeInstrumented::addNbVisits(uint64_t nb) const
+{
+    this->nbVisits += nb;
+}
+
 uint64_t TPG::TPGEdgeInstrumented::getNbTraversal() const
 {
     return this->nbTraversal;
@@ -55,6 +65,11 @@ void TPG::TPGEdgeInstrumented::incrementNbTraversal() const
     this->nbTraversal++;
 }
 
+void TPG::TPGEdgeInstrumented::addNbTraversal(uint64_t nb) const
+{
+    this->nbTraversal += nb;
+}
+
 void TPG::TPGEdgeInstrumented::reset() const
 {
     this->nbTraversal = 0;
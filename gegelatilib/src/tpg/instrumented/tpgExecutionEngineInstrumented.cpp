@@ -34,20 +34,56 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
+
 #include "tpg/instrumented/tpgExecutionEngineInstrumented.h"
 #include "tpg/instrumented/tpgActionInstrumented.h"
 #include "tpg/instrumented/tpgEdgeInstrumented.h"
 #include "tpg/instrumented/tpgTeamInstrumented.h"
 
+TPG::TPGExecutionEngineInstrumented::~TPGExecutionEngineInstrumented()
+{
+    try {
+        this->flushCounters();
+    }
+    catch (const std::bad_cast&) {
+        // Counters of a non instrumented TPGGraph can not be kept, and
+        // destructors must not throw.
+    }
+}
+
 double TPG::TPGExecutionEngineInstrumented::evaluateEdge(const TPGEdge& edge)
 {
-    dynamic_cast<const TPGEdgeInstrumented&>(edge).incrementNbVisits();
+    if (this->streamingStats != nullptr) {
+        const Program::Program& program = edge.getProgram();
+        this->currentNbEvaluatedPrograms++;
+        this->currentNbExecutedLines += program.getNbLines();
+        for (size_t i = 0; i < program.getNbLines(); i++) {
+            this->currentNbExecutionsPerInstruction.at(
+                program.getLine(i).getInstructionIndex())++;
+        }
+    }
+    if (this->counterBuffering) {
+        this->pendingEdgeCounters[&edge].first++;
+    }
+    else {
+        dynamic_cast<const TPGEdgeInstrumented&>(edge).incrementNbVisits();
+    }
     return TPGExecutionEngine::evaluateEdge(edge);
 }
 
 const TPG::TPGEdge& TPG::TPGExecutionEngineInstrumented::evaluateTeam(
     const TPGTeam& team)
 {
+    if (this->counterBuffering) {
+        this->pendingVertexVisits[&team]++;
+        const TPGEdge& winningEdge = TPGExecutionEngine::evaluateTeam(team);
+        this->pendingEdgeCounters[&winningEdge].second++;
+        return winningEdge;
+    }
+
     dynamic_cast<const TPGTeamInstrumented&>(team).incrementNbVisits();
 
     const TPGEdge& winningEdge = TPGExecutionEngine::evaluateTeam(team);
@@ -59,25 +95,232 @@ const TPG::TPGEdge& TPG::TPGExecutionEngineInstrumented::evaluateTeam(
 const std::vector<const TPG::TPGVertex*> TPG::TPGExecutionEngineInstrumented::
     executeFromRoot(const TPG::TPGVertex& root)
 {
+    if (this->streamingStats != nullptr) {
+        this->currentNbEvaluatedPrograms = 0;
+        this->currentNbExecutedLines = 0;
+        std::fill(this->currentNbExecutionsPerInstruction.begin(),
+                  this->currentNbExecutionsPerInstruction.end(), 0);
+    }
+
     const std::vector<const TPG::TPGVertex*> result =
         TPGExecutionEngine::executeFromRoot(root);
 
+    if (this->streamingStats != nullptr) {
+        this->streamingStats->addInference(
+            result.size() - 1, this->currentNbEvaluatedPrograms,
+            this->currentNbExecutedLines,
+            this->currentNbExecutionsPerInstruction);
+    }
+
     // Increment action visit
-    dynamic_cast<const TPGActionInstrumented*>(result.back())
-        ->incrementNbVisits();
+    if (this->counterBuffering) {
+        this->pendingVertexVisits[result.back()]++;
+    }
+    else {
+        dynamic_cast<const TPGActionInstrumented*>(result.back())
+            ->incrementNbVisits();
+    }
 
-    this->traceHistory.push_back(result);
+    this->recordTrace(result);
 
     return result;
 }
 
-const std::vector<std::vector<const TPG::TPGVertex*>>& TPG::
+void TPG::TPGExecutionEngineInstrumented::recordTrace(
+    const std::vector<const TPGVertex*>& trace)
+{
+    uint64_t inferenceIdx = this->nbInferences++;
+
+    switch (this->traceMode) {
+    case ALL:
+        this->storeTrace(this->traceSlots.size(), trace);
+        break;
+    case NONE:
+        break;
+    case EVERY_NTH:
+        if (inferenceIdx % this->traceParameter == 0) {
+            this->storeTrace(this->traceSlots.size(), trace);
+        }
+        break;
+    case RESERVOIR:
+        if (this->traceSlots.size() < this->traceParameter) {
+            this->storeTrace(this->traceSlots.size(), trace);
+        }
+        else {
+            // Keep the trace with a probability traceParameter/nbInferences
+            uint64_t slot = this->traceRng.getUnsignedInt64(0, inferenceIdx);
+            if (slot < this->traceParameter) {
+                this->storeTrace(slot, trace);
+            }
+        }
+        break;
+    case RING_BUFFER:
+        if (this->traceSlots.size() < this->traceParameter) {
+            this->storeTrace(this->traceSlots.size(), trace);
+        }
+        else {
+            this->storeTrace(this->firstTraceSlot, trace);
+            this->firstTraceSlot =
+                (this->firstTraceSlot + 1) % this->traceParameter;
+        }
+        break;
+    }
+}
+
+void TPG::TPGExecutionEngineInstrumented::storeTrace(
+    size_t slot, const std::vector<const TPGVertex*>& trace)
+{
+    TraceSlot newSlot{this->traceVertices.size(), trace.size()};
+    this->traceVertices.insert(this->traceVertices.end(), trace.begin(),
+                               trace.end());
+    this->nbLiveTraceVertices += trace.size();
+
+    if (slot == this->traceSlots.size()) {
+        this->traceSlots.push_back(newSlot);
+    }
+    else {
+        this->nbLiveTraceVertices -= this->traceSlots.at(slot).length;
+        this->traceSlots.at(slot) = newSlot;
+
+        // Compact when replaced traces occupy most of the buffer.
+        if (this->traceVertices.size() > 2 * this->nbLiveTraceVertices + 64) {
+            this->compactTraces();
+        }
+    }
+}
+
+void TPG::TPGExecutionEngineInstrumented::compactTraces()
+{
+    std::vector<const TPGVertex*> compacted;
+    compacted.reserve(2 * this->nbLiveTraceVertices);
+    for (TraceSlot& slot : this->traceSlots) {
+        auto begin = this->traceVertices.begin() + slot.offset;
+        slot.offset = compacted.size();
+        compacted.insert(compacted.end(), begin, begin + slot.length);
+    }
+    this->traceVertices = std::move(compacted);
+}
+
+void TPG::TPGExecutionEngineInstrumented::setTraceRecording(
+    TraceRecordingMode mode, uint64_t parameter, uint64_t seed)
+{
+    if (parameter == 0 &&
+        (mode == EVERY_NTH || mode == RESERVOIR || mode == RING_BUFFER)) {
+        throw std::invalid_argument(
+            "Trace recording mode requires a non-zero parameter.");
+    }
+    this->traceMode = mode;
+    this->traceParameter = parameter;
+    this->traceRng.setSeed(seed);
+    this->clearTraceHistory();
+}
+
+TPG::TPGExecutionEngineInstrumented::TraceRecordingMode TPG::
+    TPGExecutionEngineInstrumented::getTraceRecordingMode() const
+{
+    return this->traceMode;
+}
+
+uint64_t TPG::TPGExecutionEngineInstrumented::getNbInferences() const
+{
+    return this->nbInferences;
+}
+
+uint64_t TPG::TPGExecutionEngineInstrumented::getNbRecordedTraces() const
+{
+    return this->traceSlots.size();
+}
+
+std::vector<const TPG::TPGVertex*> TPG::TPGExecutionEngineInstrumented::
+    getTrace(uint64_t idx) const
+{
+    if (idx >= this->traceSlots.size()) {
+        throw std::out_of_range("Trace index is out of range.");
+    }
+    const TraceSlot& slot =
+        this->traceSlots.at((this->firstTraceSlot + idx) %
+                            this->traceSlots.size());
+    auto begin = this->traceVertices.begin() + slot.offset;
+    return std::vector<const TPGVertex*>(begin, begin + slot.length);
+}
+
+std::vector<std::vector<const TPG::TPGVertex*>> TPG::
     TPGExecutionEngineInstrumented::getTraceHistory() const
 {
-    return this->traceHistory;
+    std::vector<std::vector<const TPGVertex*>> history;
+    history.reserve(this->traceSlots.size());
+    for (uint64_t i = 0; i < this->traceSlots.size(); i++) {
+        history.push_back(this->getTrace(i));
+    }
+    return history;
 }
 
 void TPG::TPGExecutionEngineInstrumented::clearTraceHistory()
 {
-    this->traceHistory.clear();
+    this->traceVertices.clear();
+    this->traceSlots.clear();
+    this->firstTraceSlot = 0;
+    this->nbLiveTraceVertices = 0;
+    this->nbInferences = 0;
+}
+
+void TPG::TPGExecutionEngineInstrumented::addMemoryUsage(
+    Util::MemoryUsage& usage) const
+{
+    usage.traces +=
+        this->traceVertices.capacity() * sizeof(const TPGVertex*) +
+        this->traceSlots.capacity() * sizeof(TraceSlot);
+
+    // Nodes of unordered_map hold a pointer to the next node and the value.
+    usage.caches +=
+        this->pendingVertexVisits.bucket_count() * sizeof(void*) +
+        this->pendingVertexVisits.size() *
+            (sizeof(void*) + sizeof(std::pair<const TPGVertex*, uint64_t>)) +
+        this->pendingEdgeCounters.bucket_count() * sizeof(void*) +
+        this->pendingEdgeCounters.size() *
+            (sizeof(void*) +
+             sizeof(std::pair<const TPGEdge*, std::pair<uint64_t, uint64_t>>));
+}
+
+void TPG::TPGExecutionEngineInstrumented::setCounterBuffering(bool enabled)
+{
+    if (this->counterBuffering && !enabled) {
+        this->flushCounters();
+    }
+    this->counterBuffering = enabled;
+}
+
+void TPG::TPGExecutionEngineInstrumented::flushCounters()
+{
+    for (const auto& vertexAndVisits : this->pendingVertexVisits) {
+        const TPGVertex* vertex = vertexAndVisits.first;
+        auto action = dynamic_cast<const TPGActionInstrumented*>(vertex);
+        const TPGVertexInstrumentation& instrumentation =
+            (action != nullptr)
+                ? (const TPGVertexInstrumentation&)*action
+                : dynamic_cast<const TPGTeamInstrumented&>(*vertex);
+        instrumentation.addNbVisits(vertexAndVisits.second);
+    }
+    this->pendingVertexVisits.clear();
+
+    for (const auto& edgeAndCounters : this->pendingEdgeCounters) {
+        const auto& edge =
+            dynamic_cast<const TPGEdgeInstrumented&>(*edgeAndCounters.first);
+        edge.addNbVisits(edgeAndCounters.second.first);
+        edge.addNbTraversal(edgeAndCounters.second.second);
+    }
+    this->pendingEdgeCounters.clear();
+}
+
+void TPG::TPGExecutionEngineInstrumented::setStreamingStats(
+    StreamingExecutionStats* stats)
+{
+    if (stats != nullptr &&
+        stats->getNbInstructions() != this->nbInstructions) {
+        throw std::invalid_argument("Number of instructions of the statistics "
+                                    "differs from the Environment.");
+    }
+    this->streamingStats = stats;
+    this->currentNbExecutionsPerInstruction.assign(
+        (stats != nullptr) ? stats->getNbInstructions() : 0, 0);
 }
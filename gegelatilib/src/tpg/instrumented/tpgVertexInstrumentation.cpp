@@ -45,6 +45,11 @@ void TPG::TPGVertexInstrumentation::incrementNbVisits() const
     this->nbVisits++;
 }
 
+void TPG::TPGVertexInstrumentation::addNbVisits(uint64_t nb) const
+{
+    this->nbVisits += nb;
+}
+
 void TPG::TPGVertexInstrumentation::reset() const
 {
     this->nbVisits = 0;
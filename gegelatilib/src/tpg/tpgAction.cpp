@@ -42,3 +42,8 @@ void TPG::TPGAction::addOutgoingEdge(TPGEdge* edge)
     throw std::runtime_error(
         "Cannot add an outgoing edge to an Action vertex.");
 }
+
+size_t TPG::TPGAction::getMemoryFootprint() const
+{
+    return sizeof(TPGAction) + this->getEdgeListsFootprint();
+}
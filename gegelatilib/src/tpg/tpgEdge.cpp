@@ -51,6 +51,11 @@ std::shared_ptr<Program::Program> TPG::TPGEdge::getProgramSharedPointer()
     return this->program;
 }
 
+size_t TPG::TPGEdge::getMemoryFootprint() const
+{
+    return sizeof(TPGEdge);
+}
+
 const TPG::TPGVertex* TPG::TPGEdge::getSource() const
 {
     return this->source;
@@ -43,21 +43,84 @@
 
 #include "tpg/tpgExecutionEngine.h"
 
+TPG::TPGExecutionEngine::TPGExecutionEngine(const Environment& env,
+                                            Archive* arch)
+    : progExecutionEngine(env), archive{arch}
+{
+#ifdef NATIVE_BACKEND
+    this->updateNativeDataPointers();
+#endif // NATIVE_BACKEND
+}
+
 void TPG::TPGExecutionEngine::setArchive(Archive* newArchive)
 {
     this->archive = newArchive;
 }
 
+void TPG::TPGExecutionEngine::setDataSources(
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>& dataSrc)
+{
+    this->progExecutionEngine.setDataSources(dataSrc);
+#ifdef NATIVE_BACKEND
+    this->updateNativeDataPointers();
+#endif // NATIVE_BACKEND
+}
+
+#ifdef NATIVE_BACKEND
+void TPG::TPGExecutionEngine::setNativeBackend(
+    const CodeGen::NativeBackend* backend)
+{
+    this->nativeBackend = backend;
+    this->nativeFunctions = nullptr;
+    this->nativeFunctionsVersion = 0;
+}
+
+void TPG::TPGExecutionEngine::updateNativeDataPointers()
+{
+    this->isNativeDataSupported = CodeGen::NativeBackend::getDataPointers(
+        this->progExecutionEngine.getDataSources(), this->nativeDataPointers);
+}
+
+CodeGen::NativeBackend::NativeFunction TPG::TPGExecutionEngine::
+    getNativeFunction(const Program::Program& prog)
+{
+    if (this->nativeBackend == nullptr || !this->isNativeDataSupported) {
+        return nullptr;
+    }
+
+    // Versions start at 1, so the first call always takes a snapshot.
+    uint64_t version = this->nativeBackend->getNativeFunctionsVersion();
+    if (version != this->nativeFunctionsVersion) {
+        this->nativeFunctions = this->nativeBackend->getNativeFunctions();
+        this->nativeFunctionsVersion = version;
+    }
+    auto iter = this->nativeFunctions->find(&prog);
+    return (iter != this->nativeFunctions->end()) ? iter->second : nullptr;
+}
+#endif // NATIVE_BACKEND
+
 double TPG::TPGExecutionEngine::evaluateEdge(const TPGEdge& edge)
 {
     // Get the program
     Program::Program& prog = edge.getProgram();
 
-    // Set the progExecutionEngine to the program
-    this->progExecutionEngine.setProgram(prog);
-
-    // Execute the program.
-    double result = this->progExecutionEngine.executeProgram();
+    double result;
+#ifdef NATIVE_BACKEND
+    // Use the native function of the program, if it was compiled.
+    CodeGen::NativeBackend::NativeFunction nativeFunction =
+        this->getNativeFunction(prog);
+    if (nativeFunction != nullptr) {
+        result = nativeFunction(this->nativeDataPointers.data());
+    }
+    else
+#endif // NATIVE_BACKEND
+    {
+        // Set the progExecutionEngine to the program
+        this->progExecutionEngine.setProgram(prog);
+
+        // Execute the program.
+        result = this->progExecutionEngine.executeProgram();
+    }
 
     // Filter NaN results: replace with -inf
     result = (std::isnan(result)) ? -std::numeric_limits<double>::infinity()
@@ -119,6 +182,12 @@ const TPG::TPGEdge& TPG::TPGExecutionEngine::evaluateTeam(const TPGTeam& team)
 const std::vector<const TPG::TPGVertex*> TPG::TPGExecutionEngine::
     executeFromRoot(const TPGVertex& root)
 {
+#ifdef NATIVE_BACKEND
+    if (this->nativeBackend != nullptr) {
+        this->updateNativeDataPointers();
+    }
+#endif // NATIVE_BACKEND
+
     const TPGVertex* currentVertex = &root;
 
     std::vector<const TPGVertex*> visitedVertices;
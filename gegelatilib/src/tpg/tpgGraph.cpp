@@ -35,8 +35,11 @@
  */
 
 #include <algorithm>
+#include <map>
+#include <set>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include "tpg/tpgGraph.h"
 
@@ -175,6 +178,108 @@ const TPG::TPGVertex& TPG::TPGGraph::cloneVertex(const TPGVertex& vertex)
     return *newVertex;
 }
 
+const TPG::TPGVertex& TPG::TPGGraph::importSubGraph(const TPGVertex& root)
+{
+    // Browse the subgraph in depth-first order
+    std::vector<const TPGVertex*> subGraphVertices;
+    std::set<const TPGVertex*> visitedVertices;
+    std::vector<const TPGVertex*> verticesToVisit{&root};
+    while (!verticesToVisit.empty()) {
+        const TPGVertex* vertex = verticesToVisit.back();
+        verticesToVisit.pop_back();
+        if (visitedVertices.insert(vertex).second) {
+            subGraphVertices.push_back(vertex);
+            for (auto edge : vertex->getOutgoingEdges()) {
+                verticesToVisit.push_back(edge->getDestination());
+            }
+        }
+    }
+
+    // Copy the programs first, so that the TPGGraph is left untouched if
+    // one of them can not be imported.
+    std::map<const Program::Program*, std::shared_ptr<Program::Program>>
+        copiedPrograms;
+    for (auto vertex : subGraphVertices) {
+        for (auto edge : vertex->getOutgoingEdges()) {
+            const Program::Program* program = &edge->getProgram();
+            if (copiedPrograms.count(program) == 0) {
+                copiedPrograms.emplace(program, this->importProgram(*program));
+            }
+        }
+    }
+
+    // Copy the vertices
+    std::map<const TPGVertex*, const TPGVertex*> copiedVertices;
+    for (auto vertex : subGraphVertices) {
+        if (dynamic_cast<const TPG::TPGAction*>(vertex) != nullptr) {
+            uint64_t actionID = ((const TPGAction*)vertex)->getActionID();
+            auto existingAction = std::find_if(
+                this->vertices.begin(), this->vertices.end(),
+                [actionID](const TPGVertex* other) {
+                    return dynamic_cast<const TPG::TPGAction*>(other) !=
+                               nullptr &&
+                           ((const TPGAction*)other)->getActionID() ==
+                               actionID;
+                });
+            copiedVertices.emplace(vertex,
+                                   (existingAction != this->vertices.end())
+                                       ? *existingAction
+                                       : &this->addNewAction(actionID));
+        }
+        else {
+            copiedVertices.emplace(vertex, &this->addNewTeam());
+        }
+    }
+
+    // Copy the edges, in the order of the outgoing edges of each vertex.
+    for (auto vertex : subGraphVertices) {
+        for (auto edge : vertex->getOutgoingEdges()) {
+            this->addNewEdge(*copiedVertices.at(vertex),
+                             *copiedVertices.at(edge->getDestination()),
+                             copiedPrograms.at(&edge->getProgram()));
+        }
+    }
+
+    return *copiedVertices.at(&root);
+}
+
+std::shared_ptr<Program::Program> TPG::TPGGraph::importProgram(
+    const Program::Program& program) const
+{
+    const Environment& otherEnv = program.getEnvironment();
+    if (otherEnv.getNbInstructions() != this->env.getNbInstructions() ||
+        otherEnv.getMaxNbOperands() != this->env.getMaxNbOperands() ||
+        otherEnv.getNbRegisters() != this->env.getNbRegisters() ||
+        otherEnv.getNbConstant() != this->env.getNbConstant() ||
+        otherEnv.getNbDataSources() != this->env.getNbDataSources()) {
+        throw std::runtime_error("Environment of the imported Program is not "
+                                 "compatible with the one of the TPGGraph.");
+    }
+
+    auto newProgram = std::make_shared<Program::Program>(this->env);
+
+    // Copy the constants
+    for (size_t i = 0; i < this->env.getNbConstant(); i++) {
+        newProgram->getConstantHandler().setDataAt(
+            typeid(Data::Constant), i, program.getConstantAt(i));
+    }
+
+    // Copy the lines
+    for (size_t i = 0; i < program.getNbLines(); i++) {
+        const Program::Line& line = program.getLine(i);
+        Program::Line& newLine = newProgram->addNewLine();
+        newLine.setInstructionIndex(line.getInstructionIndex(), false);
+        newLine.setDestinationIndex(line.getDestinationIndex(), false);
+        for (uint64_t j = 0; j < this->env.getMaxNbOperands(); j++) {
+            const auto& operand = line.getOperand(j);
+            newLine.setOperand(j, operand.first, operand.second, false);
+        }
+    }
+    newProgram->identifyIntrons();
+
+    return newProgram;
+}
+
 const TPG::TPGEdge& TPG::TPGGraph::addNewEdge(
     const TPGVertex& src, const TPGVertex& dest,
     const std::shared_ptr<Program::Program> prog)
@@ -325,3 +430,26 @@ void TPG::TPGGraph::clearProgramIntrons()
         edge.get()->getProgram().clearIntrons();
     }
 }
+
+void TPG::TPGGraph::addMemoryUsage(Util::MemoryUsage& usage) const
+{
+    usage.vertices += sizeof(TPGGraph);
+    for (const TPGVertex* vertex : this->vertices) {
+        usage.vertices +=
+            Util::getListNodeSize<TPGVertex*>() + vertex->getMemoryFootprint();
+    }
+
+    // Programs may be shared by several edges
+    std::set<const Program::Program*> programs;
+    for (const std::unique_ptr<TPGEdge>& edge : this->edges) {
+        usage.edges += Util::getListNodeSize<std::unique_ptr<TPGEdge>>() +
+                       edge->getMemoryFootprint();
+        const Program::Program& program = edge->getProgram();
+        if (programs.insert(&program).second) {
+            usage.programs +=
+                Util::getSharedObjectSize<Program::Program>() -
+                sizeof(Program::Program);
+            program.addMemoryUsage(usage);
+        }
+    }
+}
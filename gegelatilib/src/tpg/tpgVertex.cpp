@@ -36,6 +36,7 @@
 #include <algorithm>
 
 #include "tpg/tpgVertex.h"
+#include "util/memoryUsage.h"
 
 const std::list<TPG::TPGEdge*>& TPG::TPGVertex::getIncomingEdges() const
 {
@@ -81,3 +82,14 @@ void TPG::TPGVertex::removeOutgoingEdge(TPG::TPGEdge* edge)
 {
     this->outgoingEdges.remove(edge);
 }
+
+size_t TPG::TPGVertex::getMemoryFootprint() const
+{
+    return sizeof(TPGVertex) + this->getEdgeListsFootprint();
+}
+
+size_t TPG::TPGVertex::getEdgeListsFootprint() const
+{
+    return (this->incomingEdges.size() + this->outgoingEdges.size()) *
+           Util::getListNodeSize<TPGEdge*>();
+}
@@ -0,0 +1,296 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "util/profiler.h"
+
+/// Spans recorded by one thread.
+struct ProfilerThreadBuffer
+{
+    /// Recorded spans, in order of completion.
+    std::vector<Util::Profiler::Event> events;
+
+    /// Number of currently open spans.
+    uint32_t depth = 0;
+
+    /// Whether a living thread currently owns the buffer.
+    bool inUse = false;
+};
+
+/// Whether spans are recorded.
+static std::atomic<bool> profilerEnabled{false};
+
+/// steady_clock time (in ns) of the Profiler epoch.
+static std::atomic<int64_t> profilerEpoch{0};
+
+/// steady_clock time (in ns) of the last call to disable().
+static std::atomic<int64_t> profilerStop{0};
+
+/// Mutex protecting the lane registry.
+static std::mutex& getRegistryMutex()
+{
+    static std::mutex registryMutex;
+    return registryMutex;
+}
+
+/// Registry of lanes, indexed by lane number.
+static std::vector<std::unique_ptr<ProfilerThreadBuffer>>& getLanes()
+{
+    static std::vector<std::unique_ptr<ProfilerThreadBuffer>> lanes;
+    return lanes;
+}
+
+/// Current steady_clock time, in nanoseconds.
+static int64_t profilerNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Thread-local handle releasing the lane of its thread on termination.
+struct ProfilerLaneHandle
+{
+    /// Buffer of the lane owned by the thread, if any.
+    ProfilerThreadBuffer* buffer = nullptr;
+
+    ~ProfilerLaneHandle()
+    {
+        if (buffer != nullptr) {
+            std::lock_guard<std::mutex> lock(getRegistryMutex());
+            buffer->inUse = false;
+            buffer->depth = 0;
+        }
+    }
+};
+
+/// Get the buffer of the calling thread, acquiring a lane if needed.
+static ProfilerThreadBuffer& getThreadBuffer()
+{
+    static thread_local ProfilerLaneHandle handle;
+    if (handle.buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(getRegistryMutex());
+        auto& lanes = getLanes();
+        for (auto& lane : lanes) {
+            if (!lane->inUse) {
+                handle.buffer = lane.get();
+                break;
+            }
+        }
+        if (handle.buffer == nullptr) {
+            lanes.emplace_back(new ProfilerThreadBuffer());
+            handle.buffer = lanes.back().get();
+        }
+        handle.buffer->inUse = true;
+    }
+    return *handle.buffer;
+}
+
+double Util::Profiler::LaneUtilization::getUtilization() const
+{
+    return (profiledTime == 0) ? 0.0
+                               : (double)busyTime / (double)profiledTime;
+}
+
+Util::Profiler::Span::Span(const char* name, const char* category)
+    : name{name}, category{category}, start{UINT64_MAX}
+{
+    if (profilerEnabled.load(std::memory_order_relaxed)) {
+        getThreadBuffer().depth++;
+        this->start = (uint64_t)profilerNow();
+    }
+}
+
+Util::Profiler::Span::~Span()
+{
+    if (this->start == UINT64_MAX) {
+        return;
+    }
+
+    int64_t end = profilerNow();
+    int64_t epoch = profilerEpoch.load(std::memory_order_relaxed);
+    int64_t begin = std::max((int64_t)this->start, epoch);
+    ProfilerThreadBuffer& buffer = getThreadBuffer();
+    buffer.depth--;
+    buffer.events.push_back({this->name, this->category,
+                             (uint64_t)(begin - epoch),
+                             (uint64_t)std::max(end - begin, (int64_t)0),
+                             buffer.depth});
+}
+
+void Util::Profiler::enable()
+{
+    if (!profilerEnabled.load()) {
+        profilerEpoch.store(profilerNow());
+        profilerEnabled.store(true);
+    }
+}
+
+void Util::Profiler::disable()
+{
+    if (profilerEnabled.load()) {
+        profilerStop.store(profilerNow());
+        profilerEnabled.store(false);
+    }
+}
+
+bool Util::Profiler::isEnabled()
+{
+    return profilerEnabled.load();
+}
+
+void Util::Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    for (auto& lane : getLanes()) {
+        lane->events.clear();
+    }
+    int64_t now = profilerNow();
+    profilerEpoch.store(now);
+    profilerStop.store(now);
+}
+
+size_t Util::Profiler::getNbLanes()
+{
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    return getLanes().size();
+}
+
+std::vector<Util::Profiler::Event> Util::Profiler::getEvents(size_t lane)
+{
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    return getLanes().at(lane)->events;
+}
+
+std::vector<Util::Profiler::LaneUtilization> Util::Profiler::
+    getUtilizationSummary()
+{
+    int64_t end = profilerEnabled.load() ? profilerNow() : profilerStop.load();
+    uint64_t profiledTime =
+        (uint64_t)std::max(end - profilerEpoch.load(), (int64_t)0);
+
+    std::vector<LaneUtilization> summary;
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    auto& lanes = getLanes();
+    for (size_t idx = 0; idx < lanes.size(); idx++) {
+        LaneUtilization laneUtilization{idx, 0, profiledTime, {}, {}};
+        for (const Event& event : lanes.at(idx)->events) {
+            if (event.depth == 0) {
+                laneUtilization.busyTime += event.duration;
+            }
+            laneUtilization.timePerSpan[event.name] += event.duration;
+            laneUtilization.nbSpans[event.name]++;
+        }
+        summary.push_back(laneUtilization);
+    }
+
+    return summary;
+}
+
+/// Write a string as a JSON string literal.
+static void writeJsonString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (const char* c = str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+void Util::Profiler::writeChromeTrace(const std::string& filePath)
+{
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file " + filePath +
+                                 " to write the Chrome trace.");
+    }
+    file << std::fixed << std::setprecision(3);
+
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    auto& lanes = getLanes();
+    for (size_t idx = 0; idx < lanes.size(); idx++) {
+        // Name the thread of the lane
+        file << (first ? "\n" : ",\n");
+        first = false;
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+             << idx << ",\"args\":{\"name\":\"lane " << idx << "\"}}";
+
+        // Timestamps are expressed in microseconds
+        for (const Event& event : lanes.at(idx)->events) {
+            file << ",\n{\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"cat\":";
+            writeJsonString(file, event.category);
+            file << ",\"ph\":\"X\",\"ts\":" << (double)event.start / 1000.0
+                 << ",\"dur\":" << (double)event.duration / 1000.0
+                 << ",\"pid\":0,\"tid\":" << idx << "}";
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Util::Profiler::writeUtilizationSummary(std::ostream& out)
+{
+    auto summary = getUtilizationSummary();
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    for (const LaneUtilization& lane : summary) {
+        out << "Lane " << lane.lane << ": " << std::setprecision(1)
+            << lane.getUtilization() * 100.0 << "% busy ("
+            << std::setprecision(3) << (double)lane.busyTime / 1.0e6
+            << " ms over " << (double)lane.profiledTime / 1.0e6 << " ms)"
+            << std::endl;
+        for (const auto& span : lane.timePerSpan) {
+            out << "    " << span.first << ": "
+                << (double)span.second / 1.0e6 << " ms ("
+                << lane.nbSpans.at(span.first) << " spans)" << std::endl;
+        }
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
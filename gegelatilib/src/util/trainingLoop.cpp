@@ -0,0 +1,81 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "util/trainingLoop.h"
+
+uint64_t Util::trainGenerations(
+    const std::function<void(uint64_t)>& trainOneGeneration,
+    uint64_t nbGenerations, volatile bool& altTraining, bool printProgressBar)
+{
+    const int barLength = 50;
+    uint64_t generationNumber = 0;
+
+    while (!altTraining && generationNumber < nbGenerations) {
+        // Train one generation
+        trainOneGeneration(generationNumber);
+        generationNumber++;
+
+        // Print progressBar (homemade, probably not ideal)
+        if (printProgressBar) {
+            printf("\rTraining ["); // back
+            // filling ratio
+            double ratio = (double)generationNumber / (double)nbGenerations;
+            int filledPart = (int)((double)ratio * (double)barLength);
+            // filled part
+            for (int i = 0; i < filledPart; i++) {
+                printf("%c", (char)219);
+            }
+
+            // empty part
+            for (int i = filledPart; i < barLength; i++) {
+                printf(" ");
+            }
+
+            printf("] %4.2f%%", ratio * 100.00);
+        }
+    }
+
+    if (printProgressBar) {
+        if (!altTraining) {
+            printf("\nTraining completed\n");
+        }
+        else {
+            printf("\nTraining alted at generation %" PRIu64 ".\n",
+                   generationNumber);
+        }
+    }
+    return generationNumber;
+}
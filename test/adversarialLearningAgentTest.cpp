@@ -53,6 +53,21 @@
 #include "learn/parallelLearningAgent.h"
 #include "learn/stickGameAdversarial.h"
 
+/// StickGameAdversarial declaring itself deterministic (which it is).
+class DeterministicStickGameAdversarial : public StickGameAdversarial
+{
+  public:
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+    Learn::LearningEnvironment* clone() const override
+    {
+        return new DeterministicStickGameAdversarial(*this);
+    }
+};
+
 class adversarialLearningAgentTest : public ::testing::Test
 {
   protected:
@@ -251,11 +266,12 @@ TEST_F(adversarialLearningAgentTest, TrainPortability)
     TPG::TPGGraph& tpg = *la.getTPGGraph();
     ASSERT_EQ(tpg.getNbVertices(), 25)
         << "Graph does not have the expected determinst characteristics.";
-    ASSERT_EQ(tpg.getNbRootVertices(), 17)
+    ASSERT_EQ(tpg.getNbRootVertices(), 16)
         << "Graph does not have the expected determinist characteristics.";
-    ASSERT_EQ(tpg.getEdges().size(), 102)
+    ASSERT_EQ(tpg.getEdges().size(), 129)
         << "Graph does not have the expected determinst characteristics.";
-    ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX), 9442226923705130763u)
+    ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
+              15957714102312535924u)
         << "Graph does not have the expected determinst characteristics.";
 }
 
@@ -548,3 +564,55 @@ TEST_F(adversarialLearningAgentTest, EvalAllRootsParallelValidationDeterminism)
     ASSERT_EQ(laParallel.getArchive().getNbRecordings(), 0)
         << "Archives should be empty in Validation mode.";
 }
+
+TEST_F(adversarialLearningAgentTest, MatchResultsCache)
+{
+    params.archiveSize = 50;
+    params.archivingProbability = 0.1;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 10;
+    params.nbThreads = 4;
+
+    DeterministicStickGameAdversarial dle;
+    Learn::AdversarialLearningAgent laCached(dle, set, params);
+    Learn::AdversarialLearningAgent la(le, set, params);
+
+    laCached.init(0);
+    la.init(0);
+    ASSERT_EQ(laCached.getNbCachedMatchResults(), 0)
+        << "Cache should be empty after init.";
+
+    // First evaluation: all matches are played.
+    laCached.evaluateAllRoots(0, Learn::LearningMode::TRAINING);
+    la.evaluateAllRoots(0, Learn::LearningMode::TRAINING);
+    ASSERT_GT(laCached.getNbCachedMatchResults(), 0)
+        << "Matches played in a deterministic environment should be cached.";
+    ASSERT_EQ(la.getNbCachedMatchResults(), 0)
+        << "Matches played in a non-deterministic environment should not be "
+           "cached.";
+
+    // Second evaluation: matches already played are served from the cache
+    // and must produce the same results as replayed ones.
+    auto resultsCached =
+        laCached.evaluateAllRoots(1, Learn::LearningMode::TRAINING);
+    auto results = la.evaluateAllRoots(1, Learn::LearningMode::TRAINING);
+    ASSERT_EQ(resultsCached.size(), results.size());
+    auto iterCached = resultsCached.begin();
+    auto iter = results.begin();
+    while (iter != results.end()) {
+        ASSERT_EQ(iterCached->first->getResult(), iter->first->getResult())
+            << "Cached match results differ from played ones.";
+        iterCached++;
+        iter++;
+    }
+
+    // Decimation purges matches involving removed roots.
+    size_t nbCachedBeforeDecimation = laCached.getNbCachedMatchResults();
+    laCached.decimateWorstRoots(resultsCached);
+    ASSERT_LT(laCached.getNbCachedMatchResults(), nbCachedBeforeDecimation)
+        << "Matches involving decimated roots should be removed from cache.";
+
+    // Explicit clear
+    laCached.clearMatchResultsCache();
+    ASSERT_EQ(laCached.getNbCachedMatchResults(), 0);
+}
@@ -0,0 +1,275 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "data/constant.h"
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+#include "data/untypedSharedPtr.h"
+#include "environment.h"
+#include "instructions/arrayInstructions.h"
+#include "instructions/arrayKernels.h"
+#include "instructions/set.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+
+#ifdef NATIVE_BACKEND
+#include "codeGen/nativeBackend.h"
+#endif // NATIVE_BACKEND
+
+using namespace Instructions;
+
+TEST(ArrayKernelsTest, KnownValues)
+{
+    const double a[5]{1.0, -2.0, 3.5, 4.0, -0.5};
+    const double b[5]{0.0, 2.0, 3.5, 1.0, 0.5};
+    const Data::Constant c[5]{{2}, {1}, {0}, {-1}, {4}};
+
+    ASSERT_EQ(ArrayKernels::sum(a, 5), 6.0);
+    ASSERT_EQ(ArrayKernels::max(a, 5), 4.0);
+    ASSERT_EQ(ArrayKernels::min(a, 5), -2.0);
+    ASSERT_EQ(ArrayKernels::dotConstant(a, c, 5), -6.0);
+    ASSERT_EQ(ArrayKernels::l1Distance(a, b, 5), 9.0);
+    ASSERT_EQ(ArrayKernels::l2Distance(a, b, 5), std::sqrt(27.0));
+
+    // Empty arrays
+    ASSERT_EQ(ArrayKernels::sum(a, 0), 0.0);
+    ASSERT_EQ(ArrayKernels::max(a, 0),
+              -std::numeric_limits<double>::infinity());
+    ASSERT_EQ(ArrayKernels::min(a, 0), std::numeric_limits<double>::infinity());
+}
+
+TEST(ArrayKernelsTest, IgnoreNaN)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double a[6]{nan, -2.0, 3.0, nan, 7.0, nan};
+
+    ASSERT_EQ(ArrayKernels::max(a, 6), 7.0)
+        << "NaN elements should be ignored by the maximum.";
+    ASSERT_EQ(ArrayKernels::min(a, 6), -2.0)
+        << "NaN elements should be ignored by the minimum.";
+    ASSERT_EQ(ArrayKernels::Scalar::max(a, 6), 7.0);
+    ASSERT_EQ(ArrayKernels::Scalar::min(a, 6), -2.0);
+}
+
+TEST(ArrayKernelsTest, DispatchedEqualsScalar)
+{
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<double> real(-1000.0, 1000.0);
+    std::uniform_int_distribution<int32_t> integer(-100, 100);
+
+    // Sizes cover empty arrays, partial vectors and remainders.
+    for (size_t n = 0; n < 38; n++) {
+        std::vector<double> a(n), b(n);
+        std::vector<Data::Constant> c(n);
+        for (size_t i = 0; i < n; i++) {
+            a[i] = real(engine);
+            b[i] = real(engine);
+            c[i] = {integer(engine)};
+        }
+
+        // Results must be bitwise identical, whatever the dispatched kernels.
+        ASSERT_EQ(ArrayKernels::sum(a.data(), n),
+                  ArrayKernels::Scalar::sum(a.data(), n))
+            << "Wrong sum of " << n << " elements.";
+        ASSERT_EQ(ArrayKernels::max(a.data(), n),
+                  ArrayKernels::Scalar::max(a.data(), n))
+            << "Wrong maximum of " << n << " elements.";
+        ASSERT_EQ(ArrayKernels::min(a.data(), n),
+                  ArrayKernels::Scalar::min(a.data(), n))
+            << "Wrong minimum of " << n << " elements.";
+        ASSERT_EQ(ArrayKernels::dotConstant(a.data(), c.data(), n),
+                  ArrayKernels::Scalar::dotConstant(a.data(), c.data(), n))
+            << "Wrong dot product of " << n << " elements.";
+        ASSERT_EQ(ArrayKernels::l1Distance(a.data(), b.data(), n),
+                  ArrayKernels::Scalar::l1Distance(a.data(), b.data(), n))
+            << "Wrong L1 distance of " << n << " elements.";
+        ASSERT_EQ(ArrayKernels::l2Distance(a.data(), b.data(), n),
+                  ArrayKernels::Scalar::l2Distance(a.data(), b.data(), n))
+            << "Wrong L2 distance of " << n << " elements.";
+    }
+}
+
+TEST(ArrayInstructionsTest, Execute)
+{
+    std::vector<Data::UntypedSharedPtr> arguments;
+    arguments.emplace_back(
+        std::make_shared<Data::UntypedSharedPtr::Model<const double[]>>(
+            new double[6]{1.0, -2.0, 3.5, 4.0, -0.5, 6.0}));
+
+    ASSERT_EQ(ArraySum<6>().execute(arguments), 12.0);
+    ASSERT_EQ(ArrayMean<6>().execute(arguments), 2.0);
+    ASSERT_EQ(ArrayMax<6>().execute(arguments), 6.0);
+    ASSERT_EQ(ArrayMin<6>().execute(arguments), -2.0);
+    // 2x3 window, stored row by row.
+    ASSERT_EQ((WindowMaxPooling<2, 3>().execute(arguments)), 6.0);
+    ASSERT_EQ((WindowAveragePooling<2, 3>().execute(arguments)), 2.0);
+
+    arguments.emplace_back(
+        std::make_shared<Data::UntypedSharedPtr::Model<const double[]>>(
+            new double[6]{0.0, 2.0, 3.5, 1.0, 0.5, 6.0}));
+    ASSERT_EQ(ArrayL1Distance<6>().execute(arguments), 9.0);
+    ASSERT_EQ(ArrayL2Distance<6>().execute(arguments), std::sqrt(27.0));
+
+    arguments.pop_back();
+    arguments.emplace_back(
+        std::make_shared<Data::UntypedSharedPtr::Model<const Data::Constant[]>>(
+            new Data::Constant[6]{{2}, {1}, {0}, {-1}, {4}, {1}}));
+    ASSERT_EQ(ArrayDotConstant<6>().execute(arguments), 0.0);
+    ASSERT_EQ((WindowConvolution<2, 3>().execute(arguments)), 0.0);
+}
+
+class ArrayInstructionsProgramTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    std::vector<std::reference_wrapper<const Data::DataHandler>> data;
+    Data::PrimitiveTypeArray<double> state{16};
+    Data::PrimitiveTypeArray2D<double> image{4, 4};
+    Environment* e = nullptr;
+    TPG::TPGGraph* tpg = nullptr;
+    std::vector<std::shared_ptr<Program::Program>> progs;
+
+    virtual void SetUp()
+    {
+        data.emplace_back(state);
+        data.emplace_back(image);
+        for (size_t i = 0; i < 16; i++) {
+            state.setDataAt(typeid(double), i, 0.37 * i * i - 2.1 * i + 0.3);
+            image.setDataAt(typeid(double), i, std::cos(1.3 * i) * 10.0);
+        }
+
+        set.add(*(new ArraySum<8>()));
+        set.add(*(new ArrayMean<8>()));
+        set.add(*(new ArrayMax<8>()));
+        set.add(*(new ArrayMin<8>()));
+        set.add(*(new ArrayDotConstant<4>()));
+        set.add(*(new ArrayL1Distance<8>()));
+        set.add(*(new ArrayL2Distance<8>()));
+        set.add(*(new WindowConvolution<2, 2>()));
+        set.add(*(new WindowMaxPooling<3, 3>()));
+        set.add(*(new WindowAveragePooling<2, 3>()));
+
+        e = new Environment(set, data, 4, 4);
+        tpg = new TPG::TPGGraph(*e);
+
+        // One single-line Program per instruction, on edges of a root team.
+        const TPG::TPGVertex& root = tpg->addNewTeam();
+        for (size_t i = 0; i < set.getNbInstructions(); i++) {
+            progs.push_back(std::make_shared<Program::Program>(*e));
+            for (size_t c = 0; c < 4; c++) {
+                progs.back()->getConstantHandler().setDataAt(
+                    typeid(Data::Constant), c,
+                    {static_cast<int32_t>(3 * c) - 4});
+            }
+            Program::Line& l = progs.back()->addNewLine();
+            l.setDestinationIndex(0);
+            l.setInstructionIndex(i);
+            // Window instructions use the image, others the state.
+            l.setOperand(0, (i < 7) ? 2 : 3, i % 4);
+            // Second operand: constants or state.
+            const bool useConstants = (i == 4 || i == 7);
+            l.setOperand(1, (useConstants) ? 1 : 2, (useConstants) ? 0 : 6);
+            tpg->addNewEdge(root, tpg->addNewAction(i), progs.back());
+        }
+    }
+
+    virtual void TearDown()
+    {
+        delete tpg;
+        delete e;
+        for (size_t i = 0; i < set.getNbInstructions(); i++) {
+            delete (&set.getInstruction(i));
+        }
+    }
+};
+
+TEST_F(ArrayInstructionsProgramTest, ExecuteInProgram)
+{
+    ASSERT_EQ(e->getNbInstructions(), 10)
+        << "All array instructions should be usable in the Environment.";
+
+    std::vector<double> results;
+    for (auto& prog : progs) {
+        Program::ProgramExecutionEngine pee(*prog);
+        results.push_back(pee.executeProgram());
+    }
+
+    double s[16], img[16];
+    for (size_t i = 0; i < 16; i++) {
+        s[i] = 0.37 * i * i - 2.1 * i + 0.3;
+        img[i] = std::cos(1.3 * i) * 10.0;
+    }
+    const Data::Constant c[4]{{-4}, {-1}, {2}, {5}};
+    const double window[9]{img[0], img[1], img[2],  img[4], img[5],
+                           img[6], img[8], img[9], img[10]};
+
+    ASSERT_EQ(results.at(0), ArrayKernels::sum(s, 8));
+    ASSERT_EQ(results.at(1), ArrayKernels::sum(s + 1, 8) / 8.0);
+    ASSERT_EQ(results.at(2), ArrayKernels::max(s + 2, 8));
+    ASSERT_EQ(results.at(3), ArrayKernels::min(s + 3, 8));
+    ASSERT_EQ(results.at(4), ArrayKernels::dotConstant(s, c, 4));
+    ASSERT_EQ(results.at(5), ArrayKernels::l1Distance(s + 1, s + 6, 8));
+    ASSERT_EQ(results.at(6), ArrayKernels::l2Distance(s + 2, s + 6, 8));
+    ASSERT_EQ(results.at(8), ArrayKernels::max(window, 9));
+}
+
+#ifdef NATIVE_BACKEND
+TEST_F(ArrayInstructionsProgramTest, GeneratedCodeEquivalence)
+{
+    CodeGen::NativeBackend backend(*e, 1);
+    backend.update(*tpg);
+    backend.waitForCompilations();
+    ASSERT_EQ(backend.getNbNativePrograms(), progs.size())
+        << "Programs with array instructions should be compiled.";
+
+    // Generated code and interpreter give bitwise identical results.
+    std::vector<const void*> pointers;
+    ASSERT_TRUE(CodeGen::NativeBackend::getDataPointers(data, pointers));
+    TPG::TPGExecutionEngine tee(*e);
+    for (const auto& edge : tpg->getEdges()) {
+        auto nativeFunction = backend.getNativeFunction(edge->getProgram());
+        ASSERT_NE(nativeFunction, nullptr);
+        ASSERT_EQ(nativeFunction(pointers.data()), tee.evaluateEdge(*edge))
+            << "Native and interpreted results of a Program differ.";
+    }
+}
+#endif // NATIVE_BACKEND
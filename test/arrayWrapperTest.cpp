@@ -253,6 +253,26 @@ TEST(ArrayWrapperTest, GetDataAtArray)
     delete d;
 }
 
+TEST(ArrayWrapperTest, GetScalarAccess)
+{
+    std::vector<int> values{0, 1, 2, 3, 4, 5, 6, 7};
+    Data::ArrayWrapper<int> d(values.size());
+
+    ASSERT_EQ(d.getScalarAccess().type, nullptr)
+        << "ArrayWrapper associated to a nullptr should provide no access.";
+
+    d.setPointer(&values);
+    const Data::DataHandler::ScalarAccess access = d.getScalarAccess();
+    ASSERT_EQ(*access.type, typeid(int))
+        << "Access should provide the template type of the ArrayWrapper.";
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(
+            access.get(access.data, i).getSharedPointer<const int>().get(),
+            &values.at(i))
+            << "Access should point to the wrapped data.";
+    }
+}
+
 TEST(ArrayWrapperTest, GetLargestAddressSpace)
 {
     Data::DataHandler* d =
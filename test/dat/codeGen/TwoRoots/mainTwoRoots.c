@@ -0,0 +1,83 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+/// doc in ../README.md
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "TwoRoots.h"
+#include "csvparser.h"
+
+#define NB_ROOTS 2
+#define NB_DATA 6
+
+double* in1;
+
+int main(int argc, char* argv[])
+{
+    double tab[NB_DATA];
+    in1 = tab;
+
+    if (argc != 2) {
+        fprintf(stderr, "error the program only require one parameter : the "
+                        "filename of the data.\n");
+        return 3;
+    }
+
+    // Each row holds the expected action of each root, followed by the data.
+    CsvParser* csvparser = CsvParser_new(argv[1], " ", 0);
+    CsvRow* row;
+    int nbRows = 0;
+    while ((row = CsvParser_getRow(csvparser))) {
+        const char** rowFields = CsvParser_getFields(row);
+        for (int i = NB_ROOTS; i < CsvParser_getNumFields(row); i++) {
+            tab[i - NB_ROOTS] = strtod(rowFields[i], NULL);
+        }
+
+        for (int rootId = 0; rootId < NB_ROOTS; rootId++) {
+            int expected = strtol(rowFields[rootId], NULL, 10);
+            int action = inferenceTPG(rootId);
+            if (action != expected) {
+                printf("action : %d but expect %d for root %d of row %d\n",
+                       action, expected, rootId, nbRows);
+                return 1;
+            }
+        }
+
+        CsvParser_destroy_row(row);
+        nbRows++;
+    }
+    CsvParser_destroy(csvparser);
+
+    return 0;
+}
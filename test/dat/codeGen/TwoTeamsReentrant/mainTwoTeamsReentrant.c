@@ -0,0 +1,87 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+/// doc in ../README.md
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "TwoTeamsReentrant.h"
+#include "csvparser.h"
+
+#define MAX_NB_ROWS 16
+#define NB_DATA 6
+
+int main(int argc, char* argv[])
+{
+    double data[MAX_NB_ROWS][NB_DATA];
+    int expected[MAX_NB_ROWS];
+    Context contexts[MAX_NB_ROWS];
+    int nbRows = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "error the program only require one parameter : the "
+                        "filename of the data.\n");
+        return 3;
+    }
+
+    // Each row of the CSV gets its own context.
+    CsvParser* csvparser = CsvParser_new(argv[1], " ", 0);
+    CsvRow* row;
+    while (nbRows < MAX_NB_ROWS && (row = CsvParser_getRow(csvparser))) {
+        const char** rowFields = CsvParser_getFields(row);
+        expected[nbRows] = strtol(rowFields[0], NULL, 10);
+        for (int i = 1; i < CsvParser_getNumFields(row) && i <= NB_DATA; i++) {
+            data[nbRows][i - 1] = strtod(rowFields[i], NULL);
+        }
+        contexts[nbRows].in1 = data[nbRows];
+        CsvParser_destroy_row(row);
+        nbRows++;
+    }
+    CsvParser_destroy(csvparser);
+
+    // Interleave the inferences on the contexts, in both directions, to check
+    // that no state is shared between them.
+    for (int pass = 0; pass < 2; pass++) {
+        for (int r = 0; r < nbRows; r++) {
+            int idx = (pass == 0) ? r : nbRows - 1 - r;
+            int action = inferenceTPG(&contexts[idx]);
+            if (action != expected[idx]) {
+                printf("action : %d but expect %d for row %d\n", action,
+                       expected[idx], idx);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
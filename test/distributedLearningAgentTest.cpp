@@ -0,0 +1,289 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+#include <set>
+
+#include "instructions/addPrimitiveType.h"
+#include "tpg/instrumented/tpgInstrumentedFactory.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgGraph.h"
+
+#include "learn/distributedLearningAgent.h"
+#include "learn/learningParameters.h"
+#include "learn/parallelLearningAgent.h"
+#include "learn/stickGameWithOpponent.h"
+
+/// StickGameWithOpponent that can not be copied.
+class NotCopyableStickGame : public StickGameWithOpponent
+{
+  public:
+    bool isCopyable() const override
+    {
+        return false;
+    }
+};
+
+class DistributedLearningAgentTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+
+    virtual void SetUp()
+    {
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+
+        params.archiveSize = 50;
+        params.archivingProbability = 0.1;
+        params.maxNbActionsPerEval = 11;
+        params.nbIterationsPerPolicyEvaluation = 5;
+        params.nbThreads = 3;
+        params.mutation.tpg.maxInitOutgoingEdges = 3;
+        params.mutation.prog.maxProgramSize = 96;
+        params.mutation.tpg.nbRoots = 15;
+        params.mutation.tpg.pEdgeDeletion = 0.7;
+        params.mutation.tpg.pEdgeAddition = 0.7;
+        params.mutation.tpg.pProgramMutation = 0.2;
+        params.mutation.tpg.pEdgeDestinationChange = 0.1;
+        params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+        params.mutation.tpg.maxOutgoingEdges = 4;
+        params.mutation.prog.pAdd = 0.5;
+        params.mutation.prog.pDelete = 0.5;
+        params.mutation.prog.pMutate = 1.0;
+        params.mutation.prog.pSwap = 1.0;
+    }
+
+    virtual void TearDown()
+    {
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+};
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+TEST_F(DistributedLearningAgentTest, Constructor)
+{
+    Learn::DistributedLearningAgent* la;
+
+    ASSERT_NO_THROW(la = new Learn::DistributedLearningAgent(le, set, params))
+        << "Construction of the DistributedLearningAgent failed.";
+
+    ASSERT_NO_THROW(delete la)
+        << "Destruction of the DistributedLearningAgent failed.";
+}
+
+TEST_F(DistributedLearningAgentTest, EvalAllRootsDeterminism)
+{
+    // Results and archive must be identical to the ParallelLearningAgent.
+    Learn::ParallelLearningAgent laParallel(le, set, params);
+    Learn::DistributedLearningAgent laDistributed(le, set, params);
+    laParallel.init(0);
+    laDistributed.init(0);
+
+    // Train a few generations to get a meaningful population.
+    for (auto i = 0; i < 3; i++) {
+        laParallel.trainOneGeneration(i);
+        ASSERT_NO_THROW(laDistributed.trainOneGeneration(i))
+            << "Training with worker processes failed.";
+    }
+
+    auto resultsParallel =
+        laParallel.evaluateAllRoots(3, Learn::LearningMode::TRAINING);
+    auto resultsDistributed =
+        laDistributed.evaluateAllRoots(3, Learn::LearningMode::TRAINING);
+
+    ASSERT_EQ(resultsDistributed.size(),
+              laDistributed.getTPGGraph()->getNbRootVertices())
+        << "All roots should be evaluated.";
+    ASSERT_EQ(resultsParallel.size(), resultsDistributed.size())
+        << "Result maps have a different size.";
+    auto iterParallel = resultsParallel.begin();
+    auto iterDistributed = resultsDistributed.begin();
+    while (iterParallel != resultsParallel.end()) {
+        ASSERT_EQ(iterParallel->first->getResult(),
+                  iterDistributed->first->getResult())
+            << "Scores of thread and process evaluations are different.";
+        ASSERT_EQ(iterParallel->first->getNbEvaluation(),
+                  iterDistributed->first->getNbEvaluation())
+            << "Number of evaluations of thread and process evaluations are "
+               "different.";
+        iterParallel++;
+        iterDistributed++;
+    }
+
+    // Check archives
+    const Archive& archiveParallel = laParallel.getArchive();
+    const Archive& archiveDistributed = laDistributed.getArchive();
+    ASSERT_GT(archiveDistributed.getNbRecordings(), 0)
+        << "Archive recordings should be sent back by workers.";
+    ASSERT_EQ(archiveParallel.getNbRecordings(),
+              archiveDistributed.getNbRecordings())
+        << "Archives have different sizes.";
+    ASSERT_EQ(archiveParallel.getNbDataHandlers(),
+              archiveDistributed.getNbDataHandlers())
+        << "Archives have different data.";
+    for (auto i = 0; i < archiveParallel.getNbRecordings(); i++) {
+        ASSERT_EQ(archiveParallel.at(i).dataHash,
+                  archiveDistributed.at(i).dataHash)
+            << "Archives have different content.";
+        ASSERT_EQ(archiveParallel.at(i).result,
+                  archiveDistributed.at(i).result)
+            << "Archives have different content.";
+    }
+
+    // Recorded programs are those of the TPGGraph of the main process.
+    std::set<const Program::Program*> programs;
+    for (const auto& edge : laDistributed.getTPGGraph()->getEdges()) {
+        programs.insert(&edge->getProgram());
+    }
+    for (auto i = 0; i < archiveDistributed.getNbRecordings(); i++) {
+        ASSERT_EQ(programs.count(archiveDistributed.at(i).prog), 1)
+            << "Archived Program should belong to the TPGGraph.";
+    }
+}
+
+TEST_F(DistributedLearningAgentTest, InferenceCostSelection)
+{
+    // Decimation on the inference cost must match the ParallelLearningAgent.
+    params.inferenceCostWeight = 0.01;
+    Learn::ParallelLearningAgent laParallel(le, set, params,
+                                            TPG::TPGInstrumentedFactory());
+    Learn::DistributedLearningAgent laDistributed(
+        le, set, params, TPG::TPGInstrumentedFactory());
+    laParallel.init(0);
+    laDistributed.init(0);
+
+    for (auto i = 0; i < 3; i++) {
+        laParallel.trainOneGeneration(i);
+        ASSERT_NO_THROW(laDistributed.trainOneGeneration(i))
+            << "Training with worker processes failed.";
+    }
+
+    auto resultsParallel =
+        laParallel.evaluateAllRoots(3, Learn::LearningMode::TRAINING);
+    auto resultsDistributed =
+        laDistributed.evaluateAllRoots(3, Learn::LearningMode::TRAINING);
+    ASSERT_EQ(resultsParallel.size(), resultsDistributed.size())
+        << "Result maps have a different size.";
+    auto iterParallel = resultsParallel.begin();
+    auto iterDistributed = resultsDistributed.begin();
+    while (iterParallel != resultsParallel.end()) {
+        ASSERT_GT(iterDistributed->first->getInferenceCost(), 0.0)
+            << "Inference cost should be sent back by workers.";
+        ASSERT_EQ(iterParallel->first->getInferenceCost(),
+                  iterDistributed->first->getInferenceCost())
+            << "Inference costs of thread and process evaluations are "
+               "different.";
+        iterParallel++;
+        iterDistributed++;
+    }
+
+    // Same roots are decimated.
+    laParallel.decimateWorstRoots(resultsParallel);
+    laDistributed.decimateWorstRoots(resultsDistributed);
+    ASSERT_EQ(resultsParallel.size(), resultsDistributed.size())
+        << "A different number of roots was decimated.";
+    iterParallel = resultsParallel.begin();
+    iterDistributed = resultsDistributed.begin();
+    while (iterParallel != resultsParallel.end()) {
+        ASSERT_EQ(iterParallel->first->getResult(),
+                  iterDistributed->first->getResult())
+            << "Remaining roots are different after the decimation.";
+        ASSERT_EQ(iterParallel->first->getInferenceCost(),
+                  iterDistributed->first->getInferenceCost())
+            << "Remaining roots are different after the decimation.";
+        iterParallel++;
+        iterDistributed++;
+    }
+}
+
+TEST_F(DistributedLearningAgentTest, WorkersKeptAlive)
+{
+    Learn::DistributedLearningAgent la(le, set, params);
+    la.init(0);
+    ASSERT_EQ(la.getNbWorkers(), 0) << "Workers should start on demand.";
+
+    ASSERT_NO_THROW(la.startWorkers());
+    ASSERT_EQ(la.getNbWorkers(), params.nbThreads)
+        << "One worker should be started per thread.";
+
+    for (auto i = 0; i < 2; i++) {
+        ASSERT_NO_THROW(la.trainOneGeneration(i));
+        ASSERT_EQ(la.getNbWorkers(), params.nbThreads)
+            << "Workers should be kept alive between generations.";
+    }
+
+    ASSERT_NO_THROW(la.stopWorkers());
+    ASSERT_EQ(la.getNbWorkers(), 0);
+
+    // Workers are restarted by the next evaluation.
+    ASSERT_NO_THROW(la.evaluateAllRoots(2, Learn::LearningMode::VALIDATION));
+    ASSERT_EQ(la.getNbWorkers(), params.nbThreads);
+}
+
+TEST_F(DistributedLearningAgentTest, EvalAllRootsNotCopyable)
+{
+    NotCopyableStickGame notCopyableLE;
+
+    Learn::LearningParameters paramsSequential = params;
+    paramsSequential.nbThreads = 1;
+    Learn::ParallelLearningAgent laSequential(notCopyableLE, set,
+                                              paramsSequential);
+    Learn::DistributedLearningAgent laDistributed(notCopyableLE, set, params);
+    laSequential.init(0);
+    laDistributed.init(0);
+
+    auto resultsSequential =
+        laSequential.evaluateAllRoots(0, Learn::LearningMode::VALIDATION);
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>
+        resultsDistributed;
+    ASSERT_NO_THROW(resultsDistributed = laDistributed.evaluateAllRoots(
+                        0, Learn::LearningMode::VALIDATION))
+        << "Non-copyable environments should be evaluated by workers.";
+
+    ASSERT_EQ(resultsSequential.size(), resultsDistributed.size());
+    auto iterSequential = resultsSequential.begin();
+    auto iterDistributed = resultsDistributed.begin();
+    while (iterSequential != resultsSequential.end()) {
+        ASSERT_EQ(iterSequential->first->getResult(),
+                  iterDistributed->first->getResult())
+            << "Scores of sequential and process evaluations are different.";
+        iterSequential++;
+        iterDistributed++;
+    }
+}
+#endif
@@ -87,6 +87,25 @@ TEST(EvaluationResultTest, AssignmentAdditionOperator)
            "EvaluationResult classes.";
 }
 
+TEST(EvaluationResultTest, InferenceCost)
+{
+    Learn::EvaluationResult eval1(1.0, 10);
+    Learn::EvaluationResult eval2(2.0, 30);
+
+    ASSERT_EQ(eval1.getInferenceCost(), 0.0)
+        << "Default inference cost should be 0.0.";
+    ASSERT_NO_THROW(eval1.setInferenceCost(4.0))
+        << "Setting the inference cost failed.";
+    ASSERT_EQ(eval1.getInferenceCost(), 4.0)
+        << "Getter returned an unexpected value.";
+    eval2.setInferenceCost(8.0);
+
+    eval1 += eval2;
+    ASSERT_EQ(eval1.getInferenceCost(), (10 * 4.0 + 30 * 8.0) / (10.0 + 30.0))
+        << "Inference costs should be averaged with their number of "
+           "evaluation.";
+}
+
 TEST(ClassificationEvaluationResultTest, Constructor)
 {
     Learn::EvaluationResult* eval;
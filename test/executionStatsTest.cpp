@@ -34,6 +34,8 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <vector>
 
@@ -50,6 +52,7 @@
 #include "tpg/tpgGraph.h"
 
 #include "tpg/instrumented/executionStats.h"
+#include "tpg/instrumented/streamingExecutionStats.h"
 
 class ExecutionStatsTest : public ::testing::Test
 {
@@ -506,3 +509,110 @@ TEST_F(ExecutionStatsTest, WriteStatsToJson)
                               TESTS_DAT_PATH "execution_stats_ref.json"))
         << "Generated json file is different from the reference file.";
 }
+
+TEST_F(ExecutionStatsTest, StreamingExecutionStats)
+{
+    ASSERT_THROW(TPG::StreamingExecutionStats(set.getNbInstructions(), 0),
+                 std::invalid_argument)
+        << "Histograms without bins should not be accepted.";
+
+    TPG::StreamingExecutionStats streamingStats(set.getNbInstructions());
+    TPG::TPGExecutionEngineInstrumented engine(*e);
+    TPG::StreamingExecutionStats wrongStats(1);
+    ASSERT_THROW(engine.setStreamingStats(&wrongStats), std::invalid_argument)
+        << "Statistics with a wrong number of instructions should not be "
+           "accepted.";
+    ASSERT_NO_THROW(engine.setStreamingStats(&streamingStats))
+        << "Setting streaming statistics failed unexpectedly.";
+    engine.setTraceRecording(TPG::TPGExecutionEngineInstrumented::NONE);
+
+    // Averages are null before the first inference.
+    ASSERT_EQ(streamingStats.getAvgEvaluatedTeams(), 0.0)
+        << "Average should be null without inferences.";
+    ASSERT_EQ(streamingStats.getAvgEvaluatedPrograms(), 0.0)
+        << "Average should be null without inferences.";
+    ASSERT_EQ(streamingStats.getAvgExecutedLines(), 0.0)
+        << "Average should be null without inferences.";
+    for (double avg : streamingStats.getAvgNbExecutionPerInstruction()) {
+        ASSERT_EQ(avg, 0.0) << "Average should be null without inferences.";
+    }
+
+    // Execute with the data set at the end of the fixture setup, and with
+    // the data of the first inference.
+    engine.executeFromRoot(*tpg->getVertices().at(0));
+    data->setDataAt(typeid(double), 6, 2);
+    data->setDataAt(typeid(double), 12, -3);
+    engine.executeFromRoot(*tpg->getVertices().at(0));
+    engine.executeFromRoot(*tpg->getVertices().at(0));
+    ASSERT_EQ(engine.getNbRecordedTraces(), 0)
+        << "No trace should be recorded.";
+
+    // Compare with statistics computed from the traces.
+    TPG::TPGExecutionEngineInstrumented recordingEngine(*e);
+    recordingEngine.executeFromRoot(*tpg->getVertices().at(0));
+    recordingEngine.executeFromRoot(*tpg->getVertices().at(0));
+    data->setDataAt(typeid(double), 6, -3);
+    data->setDataAt(typeid(double), 12, 13);
+    recordingEngine.executeFromRoot(*tpg->getVertices().at(0));
+    TPG::ExecutionStats executionStats;
+    for (uint64_t i = 0; i < recordingEngine.getNbRecordedTraces(); i++) {
+        executionStats.analyzeInferenceTrace(recordingEngine.getTrace(i));
+    }
+
+    ASSERT_EQ(streamingStats.getNbInferences(), 3)
+        << "Incorrect number of inferences.";
+    uint64_t totalTeams = 0;
+    for (const auto& stats : executionStats.getInferenceTracesStats()) {
+        totalTeams += stats.nbEvaluatedTeams;
+    }
+    ASSERT_DOUBLE_EQ(streamingStats.getAvgEvaluatedTeams(), totalTeams / 3.0)
+        << "Incorrect average number of evaluated teams.";
+    for (const auto& p : executionStats.getDistribEvaluatedTeams()) {
+        ASSERT_EQ(streamingStats.getHistogramEvaluatedTeams().at(p.first),
+                  p.second)
+            << "Incorrect distribution of evaluated teams.";
+    }
+    for (const auto& p : executionStats.getDistribEvaluatedPrograms()) {
+        ASSERT_EQ(streamingStats.getHistogramEvaluatedPrograms().at(p.first),
+                  p.second)
+            << "Incorrect distribution of evaluated programs.";
+    }
+    for (const auto& p : executionStats.getDistribExecutedLines()) {
+        ASSERT_EQ(streamingStats.getHistogramExecutedLines().at(p.first),
+                  p.second)
+            << "Incorrect distribution of executed lines.";
+    }
+    for (const auto& p1 :
+         executionStats.getDistribNbExecutionPerInstruction()) {
+        for (const auto& p2 : p1.second) {
+            ASSERT_EQ(streamingStats.getHistogramNbExecutionPerInstruction()
+                          .at(p1.first)
+                          .at(p2.first),
+                      p2.second)
+                << "Incorrect distribution of instruction executions.";
+        }
+    }
+
+    // Merge and clear
+    TPG::StreamingExecutionStats merged(set.getNbInstructions());
+    merged += streamingStats;
+    merged += streamingStats;
+    ASSERT_EQ(merged.getNbInferences(), 6) << "Incorrect merge.";
+    ASSERT_DOUBLE_EQ(merged.getAvgExecutedLines(),
+                     streamingStats.getAvgExecutedLines())
+        << "Incorrect merge.";
+    ASSERT_THROW(merged += TPG::StreamingExecutionStats(
+                     set.getNbInstructions(), 4),
+                 std::invalid_argument)
+        << "Merging statistics with different bins should fail.";
+
+    ASSERT_NO_THROW(streamingStats.writeStatsToJson("streaming_stats.json"))
+        << "Exporting streaming statistics failed unexpectedly.";
+    std::ifstream file("streaming_stats.json");
+    ASSERT_TRUE(file.good()) << "Exported file does not exist.";
+    file.close();
+    std::remove("streaming_stats.json");
+
+    streamingStats.clear();
+    ASSERT_EQ(streamingStats.getNbInferences(), 0) << "Clear failed.";
+}
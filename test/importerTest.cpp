@@ -322,6 +322,77 @@ TEST_F(ImporterTest, importGraph)
         << "The constant changed";
 }
 
+TEST_F(ImporterTest, importGraphParallel)
+{
+    // Give distinct lines to all programs
+    for (int i = 1; i < progPointers.size(); i++) {
+        for (int j = 0; j < i; j++) {
+            Program::Line& l = progPointers.at(i)->addNewLine();
+            l.setInstructionIndex(j % 2);
+            l.setDestinationIndex(j % 8);
+            l.setOperand(0, 0, (i + j) % 24);
+            l.setOperand(1, 1, (i * j) % 5);
+        }
+    }
+    File::TPGGraphDotExporter exporter("exported_tpg_parallel.dot", *tpg);
+    exporter.print();
+
+    TPG::TPGGraph tpgSequential(*e);
+    TPG::TPGGraph tpgParallel(*e);
+    ASSERT_NO_THROW(File::TPGGraphDotImporter("exported_tpg_parallel.dot", *e,
+                                              tpgSequential, 0))
+        << "Sequential import failed.";
+    ASSERT_NO_THROW(File::TPGGraphDotImporter("exported_tpg_parallel.dot", *e,
+                                              tpgParallel, 4))
+        << "Parallel import failed.";
+
+    // Compare the imported programs with the exported ones
+    ASSERT_EQ(tpgParallel.getEdges().size(), tpg->getEdges().size());
+    ASSERT_EQ(tpgSequential.getEdges().size(), tpg->getEdges().size());
+    auto edgeSequential = tpgSequential.getEdges().begin();
+    for (auto& edgeParallel : tpgParallel.getEdges()) {
+        const Program::Program& p = edgeParallel->getProgram();
+        const Program::Program& pSeq = (*edgeSequential)->getProgram();
+        ASSERT_EQ(p.getNbLines(), pSeq.getNbLines())
+            << "Sequential and parallel imports differ.";
+        for (int i = 0; i < p.getNbLines(); i++) {
+            ASSERT_EQ(p.getLine(i), pSeq.getLine(i))
+                << "Sequential and parallel imports differ.";
+        }
+        edgeSequential++;
+    }
+    auto edgeRef = tpg->getEdges().begin();
+    for (auto& edgeParallel : tpgParallel.getEdges()) {
+        ASSERT_EQ(edgeParallel->getProgram().getNbLines(),
+                  (*edgeRef)->getProgram().getNbLines())
+            << "Programs were not imported correctly.";
+        edgeRef++;
+    }
+}
+
+TEST_F(ImporterTest, importGraphMalformedProgram)
+{
+    std::ofstream file("malformed_program.dot");
+    file << "digraph{\n"
+         << "\tgraph[pad = \"0.212, 0.055\" bgcolor = lightgray]\n"
+         << "\tnode[shape=circle style = filled label = \"\"]\n"
+         << "\t\tT0 [fillcolor=\"#1199bb\"]\n"
+         << "\t\tP0 [fillcolor=\"#cccccc\" shape=point] //0|0|0|0|0|\n"
+         << "\t\tI0 [shape=box style=invis label=\"0|1&0|x&#92;n\"]\n"
+         << "\t\tP0 -> I0[style=invis]\n"
+         << "\t\tA0 [fillcolor=\"#ff3366\" shape=box margin=0.03 width=0 "
+            "height=0 label=\"0\"]\n"
+         << "\t\tT0 -> P0 -> A0\n"
+         << "\t\t{ rank= same T0 }\n"
+         << "}\n";
+    file.close();
+
+    ASSERT_THROW(
+        File::TPGGraphDotImporter("malformed_program.dot", *e, *tpg_copy),
+        std::runtime_error)
+        << "Importing a malformed program should fail.";
+}
+
 TEST_F(ImporterTest, readLineFromFile)
 {
     std::ofstream myfile;
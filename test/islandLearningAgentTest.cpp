@@ -0,0 +1,184 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+
+#include "instructions/addPrimitiveType.h"
+#include "tpg/tpgGraph.h"
+
+#include "learn/fakeClassificationLearningEnvironment.h"
+#include "learn/islandLearningAgent.h"
+#include "learn/learningParameters.h"
+#include "learn/stickGameWithOpponent.h"
+
+class IslandLearningAgentTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+
+    virtual void SetUp()
+    {
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+
+        params.archiveSize = 50;
+        params.archivingProbability = 0.5;
+        params.maxNbActionsPerEval = 11;
+        params.nbIterationsPerPolicyEvaluation = 3;
+        params.ratioDeletedRoots = 0.5;
+        params.nbThreads = 4;
+        params.mutation.tpg.maxInitOutgoingEdges = 3;
+        params.mutation.prog.maxProgramSize = 96;
+        params.mutation.tpg.nbRoots = 15;
+        params.mutation.tpg.pEdgeDeletion = 0.7;
+        params.mutation.tpg.pEdgeAddition = 0.7;
+        params.mutation.tpg.pProgramMutation = 0.2;
+        params.mutation.tpg.pEdgeDestinationChange = 0.1;
+        params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+        params.mutation.tpg.maxOutgoingEdges = 4;
+        params.mutation.prog.pAdd = 0.5;
+        params.mutation.prog.pDelete = 0.5;
+        params.mutation.prog.pMutate = 1.0;
+        params.mutation.prog.pSwap = 1.0;
+    }
+
+    virtual void TearDown()
+    {
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+};
+
+TEST_F(IslandLearningAgentTest, Constructor)
+{
+    Learn::IslandLearningAgent* la;
+
+    ASSERT_NO_THROW(la = new Learn::IslandLearningAgent(le, set, params, 3))
+        << "Construction of the IslandLearningAgent failed.";
+    ASSERT_EQ(la->getNbIslands(), 3) << "Wrong number of islands.";
+    ASSERT_NO_THROW(la->getIsland(2)) << "Island should be accessible.";
+    ASSERT_THROW(la->getIsland(3), std::out_of_range)
+        << "Accessing a non-existing island should fail.";
+
+    ASSERT_NO_THROW(delete la)
+        << "Destruction of the IslandLearningAgent failed.";
+
+    ASSERT_THROW(Learn::IslandLearningAgent(le, set, params, 0),
+                 std::runtime_error)
+        << "An IslandLearningAgent without island should not be built.";
+
+    FakeClassificationLearningEnvironment notCopyableLE;
+    ASSERT_THROW(Learn::IslandLearningAgent(notCopyableLE, set, params, 2),
+                 std::runtime_error)
+        << "Islands should not be built from a non-copyable environment.";
+    ASSERT_NO_THROW(Learn::IslandLearningAgent(notCopyableLE, set, params, 1))
+        << "A single island does not need to copy the environment.";
+}
+
+TEST_F(IslandLearningAgentTest, Init)
+{
+    Learn::IslandLearningAgent la(le, set, params, 2);
+    ASSERT_NO_THROW(la.init(0)) << "Initialization of the islands failed.";
+
+    // Islands use distinct random streams
+    ASSERT_NE(la.getIsland(0).getRNG().getUnsignedInt64(0, UINT64_MAX),
+              la.getIsland(1).getRNG().getUnsignedInt64(0, UINT64_MAX))
+        << "Islands should be initialized with different seeds.";
+}
+
+TEST_F(IslandLearningAgentTest, Migrate)
+{
+    Learn::IslandLearningAgent la(le, set, params, 2, 0, 2);
+    la.init(0);
+    la.trainOneGeneration(0);
+
+    std::vector<size_t> nbRootsBefore;
+    std::vector<size_t> nbVerticesBefore;
+    for (size_t i = 0; i < la.getNbIslands(); i++) {
+        nbRootsBefore.push_back(
+            la.getIsland(i).getTPGGraph()->getNbRootVertices());
+        nbVerticesBefore.push_back(
+            la.getIsland(i).getTPGGraph()->getNbVertices());
+    }
+
+    ASSERT_NO_THROW(la.migrate()) << "Migration failed.";
+
+    for (size_t i = 0; i < la.getNbIslands(); i++) {
+        ASSERT_EQ(la.getIsland(i).getTPGGraph()->getNbRootVertices(),
+                  nbRootsBefore.at(i) + 2)
+            << "Each island should receive 2 new roots.";
+        ASSERT_GT(la.getIsland(i).getTPGGraph()->getNbVertices(),
+                  nbVerticesBefore.at(i) + 1)
+            << "Migrants should come with their subgraph.";
+    }
+
+    // Migrants are evaluated in the next generation
+    ASSERT_NO_THROW(la.trainOneGeneration(1))
+        << "Training after a migration failed.";
+}
+
+TEST_F(IslandLearningAgentTest, TrainDeterminism)
+{
+    params.nbGenerations = 4;
+
+    Learn::IslandLearningAgent la(le, set, params, 2, 2, 1);
+    Learn::LearningParameters paramsSequential = params;
+    paramsSequential.nbThreads = 1;
+    Learn::IslandLearningAgent laSequential(le, set, paramsSequential, 2, 2,
+                                            1);
+    la.init(0);
+    laSequential.init(0);
+
+    bool alt = false;
+    ASSERT_EQ(la.train(alt, false), params.nbGenerations)
+        << "Training did not run for the expected number of generations.";
+    laSequential.train(alt, false);
+
+    ASSERT_NE(la.getBestRoot().first, nullptr) << "No best root was found.";
+    ASSERT_EQ(la.getBestIslandIdx(), laSequential.getBestIslandIdx())
+        << "Best island differs with the number of threads.";
+    ASSERT_EQ(la.getBestRoot().second->getResult(),
+              laSequential.getBestRoot().second->getResult())
+        << "Best score differs with the number of threads.";
+    for (size_t i = 0; i < la.getNbIslands(); i++) {
+        ASSERT_EQ(la.getIsland(i).getTPGGraph()->getNbVertices(),
+                  laSequential.getIsland(i).getTPGGraph()->getNbVertices())
+            << "Islands differ with the number of threads.";
+        ASSERT_EQ(
+            la.getIsland(i).getRNG().getUnsignedInt64(0, UINT64_MAX),
+            laSequential.getIsland(i).getRNG().getUnsignedInt64(0, UINT64_MAX))
+            << "Islands random streams differ with the number of threads.";
+    }
+}
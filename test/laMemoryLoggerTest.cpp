@@ -0,0 +1,139 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "instructions/addPrimitiveType.h"
+#include "learn/learningAgent.h"
+#include "learn/stickGameWithOpponent.h"
+
+#include "log/laMemoryLogger.h"
+
+class LAMemoryLoggerTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+    Learn::LearningAgent* la;
+
+    void SetUp() override
+    {
+        params.mutation.tpg.maxInitOutgoingEdges = 3;
+        params.mutation.prog.maxProgramSize = 96;
+        params.mutation.tpg.nbRoots = 15;
+        params.mutation.tpg.pEdgeDeletion = 0.7;
+        params.mutation.tpg.pEdgeAddition = 0.7;
+        params.mutation.tpg.pProgramMutation = 0.2;
+        params.mutation.tpg.pEdgeDestinationChange = 0.1;
+        params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+        params.mutation.tpg.maxOutgoingEdges = 4;
+        params.mutation.prog.pAdd = 0.5;
+        params.mutation.prog.pDelete = 0.5;
+        params.mutation.prog.pMutate = 1.0;
+        params.mutation.prog.pSwap = 1.0;
+        params.mutation.prog.minConstValue = 0;
+        params.mutation.prog.maxConstValue = 3;
+        params.nbProgramConstant = 5;
+
+        params.archiveSize = 50;
+        params.archivingProbability = 0.5;
+        params.maxNbActionsPerEval = 11;
+        params.nbIterationsPerPolicyEvaluation = 3;
+        params.ratioDeletedRoots = 0.5;
+        params.nbThreads = 1;
+        params.nbGenerations = 3;
+
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+
+        la = new Learn::LearningAgent(le, set, params);
+    }
+
+    void TearDown() override
+    {
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+        delete la;
+    }
+};
+
+TEST_F(LAMemoryLoggerTest, Constructor)
+{
+    Log::LAMemoryLogger* l = nullptr;
+    ASSERT_NO_THROW(l = new Log::LAMemoryLogger(*la));
+    if (l != nullptr) {
+        delete l;
+    }
+    ASSERT_NO_THROW(Log::LAMemoryLogger l(*la, std::cerr));
+}
+
+TEST_F(LAMemoryLoggerTest, logTraining)
+{
+    std::stringstream strStr;
+    Log::LAMemoryLogger l(*la, strStr);
+    volatile bool alt = false;
+    la->init();
+    la->train(alt, false);
+
+    // One header line and one line per generation.
+    std::vector<std::vector<std::string>> lines;
+    std::string line;
+    while (std::getline(strStr, line)) {
+        std::stringstream lineStream(line);
+        std::vector<std::string> columns;
+        std::string column;
+        while (lineStream >> column) {
+            columns.push_back(column);
+        }
+        lines.push_back(columns);
+    }
+    ASSERT_EQ(lines.size(), params.nbGenerations + 1);
+    ASSERT_EQ(lines.at(0).size(), 11);
+    ASSERT_EQ(lines.at(0).at(0), "Gen");
+    ASSERT_EQ(lines.at(0).at(10), "Total");
+
+    for (size_t gen = 0; gen < params.nbGenerations; gen++) {
+        const auto& columns = lines.at(gen + 1);
+        ASSERT_EQ(columns.size(), 11);
+        ASSERT_EQ(std::stoull(columns.at(0)), gen);
+        // The total is the sum of all components (rounded to 0.1 KiB).
+        double sum = 0.0;
+        for (size_t i = 2; i < 10; i++) {
+            sum += std::stod(columns.at(i));
+        }
+        ASSERT_NEAR(sum, std::stod(columns.at(10)), 0.5);
+        ASSERT_GT(std::stod(columns.at(10)), 0.0);
+    }
+}
@@ -0,0 +1,329 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "instructions/addPrimitiveType.h"
+#include "tpg/instrumented/tpgInstrumentedFactory.h"
+#include "tpg/tpgGraph.h"
+
+#include "learn/learningAgent.h"
+#include "learn/learningAgentCheckpointer.h"
+#include "learn/learningParameters.h"
+#include "learn/stickGameWithOpponent.h"
+
+class LearningAgentCheckpointerTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+    const std::string filePath = "checkpointerTest.ckpt";
+
+    virtual void SetUp()
+    {
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+
+        params.archiveSize = 50;
+        params.archivingProbability = 0.5;
+        params.maxNbActionsPerEval = 11;
+        params.nbIterationsPerPolicyEvaluation = 5;
+        params.ratioDeletedRoots = 0.2;
+        params.maxNbEvaluationPerPolicy =
+            params.nbIterationsPerPolicyEvaluation * 3;
+        params.mutation.tpg.maxInitOutgoingEdges = 3;
+        params.mutation.tpg.nbRoots = 15;
+        params.mutation.tpg.pEdgeDeletion = 0.7;
+        params.mutation.tpg.pEdgeAddition = 0.7;
+        params.mutation.tpg.pProgramMutation = 0.2;
+        params.mutation.tpg.pEdgeDestinationChange = 0.1;
+        params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+        params.mutation.tpg.maxOutgoingEdges = 4;
+        params.mutation.tpg.forceProgramBehaviorChangeOnMutation = true;
+        params.mutation.prog.maxProgramSize = 96;
+        params.mutation.prog.pAdd = 0.5;
+        params.mutation.prog.pDelete = 0.5;
+        params.mutation.prog.pMutate = 1.0;
+        params.mutation.prog.pSwap = 1.0;
+        params.mutation.prog.pConstantMutation = 0.5;
+        params.mutation.prog.minConstValue = 0;
+        params.mutation.prog.maxConstValue = 1;
+    }
+
+    virtual void TearDown()
+    {
+        std::remove(filePath.c_str());
+        std::remove((filePath + ".tmp").c_str());
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+
+    /// Train the agent for generations [from, to[, with checkpoints.
+    void train(Learn::LearningAgent& la,
+               Learn::LearningAgentCheckpointer& checkpointer, uint64_t from,
+               uint64_t to)
+    {
+        for (uint64_t i = from; i < to; i++) {
+            la.trainOneGeneration(i);
+            checkpointer.checkpoint(i + 1);
+        }
+        checkpointer.wait();
+    }
+
+    /// Size of the checkpoint file.
+    uint64_t getFileSize() const
+    {
+        std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+        return (uint64_t)file.tellg();
+    }
+
+    /**
+     * \brief Check that a training interrupted after 5 generations and
+     * resumed from its checkpoint matches an uninterrupted training.
+     *
+     * \param[in] factory the TPGFactory of the trained LearningAgent.
+     */
+    void checkResumeTraining(const TPG::TPGFactory& factory)
+    {
+        // Reference training, without interruption
+        Learn::LearningAgent reference(le, set, params, factory);
+        reference.init();
+        for (uint64_t i = 0; i < 10; i++) {
+            reference.trainOneGeneration(i);
+        }
+
+        // Interrupted training
+        {
+            Learn::LearningAgent la(le, set, params, factory);
+            la.init();
+            Learn::LearningAgentCheckpointer checkpointer(la, filePath);
+            train(la, checkpointer, 0, 5);
+            ASSERT_EQ(checkpointer.getNbGenerations(), 5)
+                << "Incorrect number of generations after checkpoints.";
+        }
+
+        // Resumed training, with a different seed to make sure the state
+        // comes from the checkpoint.
+        Learn::LearningAgent la(le, set, params, factory);
+        la.init(1);
+        Learn::LearningAgentCheckpointer checkpointer(la, filePath, true);
+        ASSERT_EQ(checkpointer.getNbGenerations(), 5)
+            << "Incorrect number of generations after resume.";
+        train(la, checkpointer, checkpointer.getNbGenerations(), 10);
+
+        const TPG::TPGGraph& tpg = *la.getTPGGraph();
+        const TPG::TPGGraph& refTpg = *reference.getTPGGraph();
+        ASSERT_EQ(tpg.getNbVertices(), refTpg.getNbVertices())
+            << "Resumed training differs from the uninterrupted one.";
+        ASSERT_EQ(tpg.getNbRootVertices(), refTpg.getNbRootVertices())
+            << "Resumed training differs from the uninterrupted one.";
+        ASSERT_EQ(tpg.getEdges().size(), refTpg.getEdges().size())
+            << "Resumed training differs from the uninterrupted one.";
+        checkSameArchive(la.getArchive(), reference.getArchive());
+        ASSERT_EQ(la.getBestScoreLastGen(), reference.getBestScoreLastGen())
+            << "Resumed training differs from the uninterrupted one.";
+        ASSERT_EQ(la.getBestRoot().second->getResult(),
+                  reference.getBestRoot().second->getResult())
+            << "Resumed training differs from the uninterrupted one.";
+        ASSERT_EQ(la.getBestRoot().second->getInferenceCost(),
+                  reference.getBestRoot().second->getInferenceCost())
+            << "Resumed training differs from the uninterrupted one.";
+        ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
+                  reference.getRNG().getUnsignedInt64(0, UINT64_MAX))
+            << "Resumed training differs from the uninterrupted one.";
+    }
+
+    /// Check that two Archive contain the same recordings.
+    void checkSameArchive(const Archive& archive, const Archive& reference)
+    {
+        ASSERT_EQ(archive.getNbRecordings(), reference.getNbRecordings())
+            << "Resumed training differs from the uninterrupted one.";
+        for (uint64_t i = 0; i < archive.getNbRecordings(); i++) {
+            ASSERT_EQ(archive.at(i).dataHash, reference.at(i).dataHash)
+                << "Resumed training differs from the uninterrupted one.";
+            ASSERT_EQ(archive.at(i).result, reference.at(i).result)
+                << "Resumed training differs from the uninterrupted one.";
+        }
+    }
+};
+
+TEST_F(LearningAgentCheckpointerTest, Constructor)
+{
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+
+    Learn::LearningAgentCheckpointer* checkpointer = nullptr;
+    ASSERT_NO_THROW(checkpointer =
+                        new Learn::LearningAgentCheckpointer(la, filePath))
+        << "Construction of the checkpointer failed.";
+    ASSERT_EQ(checkpointer->getNbGenerations(), 0)
+        << "New checkpointer should not have any generation.";
+    ASSERT_NO_THROW(delete checkpointer)
+        << "Destruction of the checkpointer failed.";
+
+    // Resuming from a file without checkpoint leaves the agent untouched.
+    uint64_t nbVertices = la.getTPGGraph()->getNbVertices();
+    ASSERT_NO_THROW(checkpointer = new Learn::LearningAgentCheckpointer(
+                        la, filePath, true))
+        << "Resuming from a file without checkpoint failed.";
+    ASSERT_EQ(checkpointer->getNbGenerations(), 0)
+        << "Resumed checkpointer should not have any generation.";
+    ASSERT_EQ(la.getTPGGraph()->getNbVertices(), nbVertices)
+        << "TPGGraph should not be modified without checkpoint.";
+    delete checkpointer;
+
+    ASSERT_THROW(Learn::LearningAgentCheckpointer(
+                     la, "unexistingDirectory/checkpoint.ckpt"),
+                 std::runtime_error)
+        << "Construction with an invalid file path should fail.";
+}
+
+TEST_F(LearningAgentCheckpointerTest, ResumeTraining)
+{
+    checkResumeTraining(TPG::TPGFactory());
+
+    // Inference costs of the roots are restored too.
+    params.inferenceCostWeight = 0.05;
+    checkResumeTraining(TPG::TPGInstrumentedFactory());
+}
+
+TEST_F(LearningAgentCheckpointerTest, TruncatedRecord)
+{
+    uint64_t fileSize;
+    uint64_t nbVertices;
+    {
+        Learn::LearningAgent la(le, set, params);
+        la.init();
+        Learn::LearningAgentCheckpointer checkpointer(la, filePath);
+        train(la, checkpointer, 0, 3);
+        nbVertices = la.getTPGGraph()->getNbVertices();
+        fileSize = getFileSize();
+    }
+
+    // Simulate a crash while writing the next record.
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::app);
+        uint64_t payloadSize = 1024;
+        file.write((const char*)&payloadSize, sizeof(payloadSize));
+        file.write("torn record", 11);
+    }
+
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+    Learn::LearningAgentCheckpointer* checkpointer = nullptr;
+    ASSERT_NO_THROW(checkpointer = new Learn::LearningAgentCheckpointer(
+                        la, filePath, true))
+        << "Resuming from a file with a truncated record failed.";
+    ASSERT_EQ(checkpointer->getNbGenerations(), 3)
+        << "Last complete checkpoint was not restored.";
+    ASSERT_EQ(la.getTPGGraph()->getNbVertices(), nbVertices)
+        << "Last complete checkpoint was not restored.";
+    ASSERT_EQ(getFileSize(), fileSize)
+        << "Truncated record was not removed from the file.";
+
+    // New checkpoints are appended after the last complete one.
+    train(la, *checkpointer, 3, 4);
+    delete checkpointer;
+    Learn::LearningAgent other(le, set, params);
+    other.init();
+    Learn::LearningAgentCheckpointer otherCheckpointer(other, filePath, true);
+    ASSERT_EQ(otherCheckpointer.getNbGenerations(), 4)
+        << "Checkpoint appended after a resume was not restored.";
+    ASSERT_EQ(other.getTPGGraph()->getNbVertices(),
+              la.getTPGGraph()->getNbVertices())
+        << "Checkpoint appended after a resume was not restored.";
+}
+
+TEST_F(LearningAgentCheckpointerTest, SnapshotRollover)
+{
+    // File with a single snapshot followed by deltas
+    uint64_t deltaFileSize;
+    {
+        Learn::LearningAgent la(le, set, params);
+        la.init();
+        Learn::LearningAgentCheckpointer checkpointer(la, filePath);
+        train(la, checkpointer, 0, 7);
+        deltaFileSize = getFileSize();
+    }
+
+    // Reference training, without interruption
+    Learn::LearningAgent reference(le, set, params);
+    reference.init();
+    for (uint64_t i = 0; i < 10; i++) {
+        reference.trainOneGeneration(i);
+    }
+
+    // Interrupted training with a snapshot every other record.
+    {
+        Learn::LearningAgent la(le, set, params);
+        la.init();
+        Learn::LearningAgentCheckpointer checkpointer(la, filePath, false, 2);
+        train(la, checkpointer, 0, 7);
+    }
+    ASSERT_LT(getFileSize(), deltaFileSize)
+        << "Records preceding the last snapshot were not dropped.";
+
+    Learn::LearningAgent la(le, set, params);
+    la.init(1);
+    Learn::LearningAgentCheckpointer checkpointer(la, filePath, true, 2);
+    ASSERT_EQ(checkpointer.getNbGenerations(), 7)
+        << "Incorrect number of generations after resume from a snapshot.";
+    train(la, checkpointer, checkpointer.getNbGenerations(), 10);
+
+    ASSERT_EQ(la.getTPGGraph()->getNbVertices(),
+              reference.getTPGGraph()->getNbVertices())
+        << "Resumed training differs from the uninterrupted one.";
+    ASSERT_EQ(la.getTPGGraph()->getEdges().size(),
+              reference.getTPGGraph()->getEdges().size())
+        << "Resumed training differs from the uninterrupted one.";
+    checkSameArchive(la.getArchive(), reference.getArchive());
+    ASSERT_EQ(la.getBestScoreLastGen(), reference.getBestScoreLastGen())
+        << "Resumed training differs from the uninterrupted one.";
+}
+
+TEST_F(LearningAgentCheckpointerTest, InvalidFile)
+{
+    {
+        std::ofstream file(filePath, std::ios::binary);
+        file << "This is not a checkpoint file.";
+    }
+
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+    ASSERT_THROW(Learn::LearningAgentCheckpointer(la, filePath, true),
+                 std::runtime_error)
+        << "Resuming from an invalid file should fail.";
+}
@@ -265,6 +265,44 @@ TEST_F(LearningAgentTest, EvaluateOneRoot)
         << "Average score should not exceed the score of a perfect player.";
 }
 
+TEST_F(LearningAgentTest, EvaluateOneRootInferenceCost)
+{
+    params.archiveSize = 50;
+    params.archivingProbability = 1.0;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 10;
+
+    // Without inference cost selection, the cost is not measured.
+    Learn::LearningAgent la(le, set, params, TPG::TPGInstrumentedFactory());
+    la.init();
+    std::shared_ptr<Learn::EvaluationResult> result =
+        la.evaluateOneRoot(0, Learn::LearningMode::TRAINING,
+                           la.getTPGGraph()->getRootVertices().at(0));
+    ASSERT_EQ(result->getInferenceCost(), 0.0)
+        << "Inference cost should not be measured by default.";
+
+    // With inference cost selection, the cost is measured.
+    params.inferenceCostWeight = 0.01;
+    Learn::LearningAgent laCost(le, set, params,
+                                TPG::TPGInstrumentedFactory());
+    laCost.init();
+    ASSERT_NO_THROW(result = laCost.evaluateOneRoot(
+                        0, Learn::LearningMode::TRAINING,
+                        laCost.getTPGGraph()->getRootVertices().at(0)))
+        << "Evaluation from a root failed.";
+    ASSERT_GT(result->getInferenceCost(), 0.0)
+        << "Each decision executes at least one program line.";
+
+    // The cost can only be measured with an instrumented TPGGraph.
+    Learn::LearningAgent laNotInstrumented(le, set, params);
+    laNotInstrumented.init();
+    ASSERT_THROW(laNotInstrumented.evaluateOneRoot(
+                     0, Learn::LearningMode::TRAINING,
+                     laNotInstrumented.getTPGGraph()->getRootVertices().at(0)),
+                 std::runtime_error)
+        << "Inference cost selection should fail without instrumentation.";
+}
+
 TEST_F(LearningAgentTest, EvalAllRoots)
 {
     params.archiveSize = 50;
@@ -485,6 +523,61 @@ TEST_F(LearningAgentTest, DecimateWorstRoots)
                   params.ratioDeletedRoots * ((le.getNbActions() - 1)));
 }
 
+TEST_F(LearningAgentTest, DecimateWorstRootsInferenceCost)
+{
+    params.ratioDeletedRoots = 0.50;
+    params.mutation.tpg.nbRoots =
+        le.getNbActions() - 1; // Param used in decimation
+    params.nbRegisters = 4;
+
+    // Costs of the roots: the root with the best score is the costliest.
+    std::vector<double> costs = {0.0, 5.0, 50.0};
+    ASSERT_EQ(costs.size(), le.getNbActions());
+
+    // With a budget, the root exceeding it is decimated.
+    params.maxInferenceCost = 10.0;
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+    std::vector<const TPG::TPGVertex*> roots =
+        la.getTPGGraph()->getRootVertices();
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>
+        results;
+    for (size_t i = 0; i < roots.size(); i++) {
+        auto result = std::make_shared<Learn::EvaluationResult>((double)i, 5);
+        result->setInferenceCost(costs.at(i));
+        results.emplace(result, roots.at(i));
+    }
+    ASSERT_NO_THROW(la.decimateWorstRoots(results))
+        << "Decimating worst roots failed.";
+    ASSERT_EQ(results.size(), roots.size() - 1)
+        << "A single root should have been decimated.";
+    auto vertices = la.getTPGGraph()->getVertices();
+    ASSERT_EQ(std::count(vertices.begin(), vertices.end(), roots.at(2)), 0)
+        << "The root exceeding the inference cost budget should be decimated.";
+    ASSERT_EQ(std::count(vertices.begin(), vertices.end(), roots.at(0)), 1)
+        << "The root with the worst score should be kept.";
+
+    // With a cost penalty, scores are 0.0, 0.5 and -3.0.
+    params.maxInferenceCost = 0.0;
+    params.inferenceCostWeight = 0.1;
+    Learn::LearningAgent laWeight(le, set, params);
+    laWeight.init();
+    roots = laWeight.getTPGGraph()->getRootVertices();
+    results.clear();
+    for (size_t i = 0; i < roots.size(); i++) {
+        auto result = std::make_shared<Learn::EvaluationResult>((double)i, 5);
+        result->setInferenceCost(costs.at(i));
+        results.emplace(result, roots.at(i));
+    }
+    laWeight.decimateWorstRoots(results);
+    vertices = laWeight.getTPGGraph()->getVertices();
+    ASSERT_EQ(std::count(vertices.begin(), vertices.end(), roots.at(2)), 0)
+        << "The root with the worst penalized score should be decimated.";
+    ASSERT_EQ(std::count(vertices.begin(), vertices.end(), roots.at(0)), 1)
+        << "The root with the worst score should be kept.";
+}
+
 TEST_F(LearningAgentTest, TrainOnegeneration)
 {
     params.archiveSize = 50;
@@ -590,14 +683,14 @@ TEST_F(LearningAgentTest, TrainPortability)
     // end up with the same number of vertices, roots, edges and calls to
     // the RNG without being identical.
     TPG::TPGGraph& tpg = *la.getTPGGraph();
-    ASSERT_EQ(tpg.getNbVertices(), 31)
+    ASSERT_EQ(tpg.getNbVertices(), 32)
         << "Graph does not have the expected determinst characteristics.";
     ASSERT_EQ(tpg.getNbRootVertices(), 25)
         << "Graph does not have the expected determinist characteristics.";
-    ASSERT_EQ(tpg.getEdges().size(), 106)
+    ASSERT_EQ(tpg.getEdges().size(), 108)
         << "Graph does not have the expected determinst characteristics.";
     ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
-              14825295448422883263u)
+              6019707042902807330u)
         << "Graph does not have the expected determinst characteristics.";
 }
 
@@ -626,14 +719,14 @@ TEST_F(LearningAgentTest, TrainInstrumented)
     // end up with the same number of vertices, roots, edges and calls to
     // the RNG without being identical.
     TPG::TPGGraph& tpg = *la.getTPGGraph();
-    ASSERT_EQ(tpg.getNbVertices(), 31)
+    ASSERT_EQ(tpg.getNbVertices(), 32)
         << "Graph does not have the expected determinst characteristics.";
     ASSERT_EQ(tpg.getNbRootVertices(), 25)
         << "Graph does not have the expected determinist characteristics.";
-    ASSERT_EQ(tpg.getEdges().size(), 106)
+    ASSERT_EQ(tpg.getEdges().size(), 108)
         << "Graph does not have the expected determinst characteristics.";
     ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
-              14825295448422883263u)
+              6019707042902807330u)
         << "Graph does not have the expected determinst characteristics.";
 
     // Check number of visits of a few edges & vertices
@@ -641,7 +734,7 @@ TEST_F(LearningAgentTest, TrainInstrumented)
     const auto* edge1 = edgesIterator->get();
     ASSERT_EQ(
         dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge1)->getNbVisits(),
-        2151);
+        163);
     ASSERT_EQ(
         dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge1)->getNbTraversal(),
         0);
@@ -653,17 +746,39 @@ TEST_F(LearningAgentTest, TrainInstrumented)
         106);
     ASSERT_EQ(
         dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge2)->getNbTraversal(),
-        106);
+        0);
 
     auto& verticesIterator = tpg.getVertices();
     ASSERT_EQ(dynamic_cast<const TPG::TPGVertexInstrumentation*>(
                   verticesIterator.at(0))
                   ->getNbVisits(),
-              8488);
+              5870);
     ASSERT_EQ(dynamic_cast<const TPG::TPGVertexInstrumentation*>(
                   verticesIterator.at(3))
                   ->getNbVisits(),
-              2151);
+              1112);
+}
+
+TEST_F(LearningAgentTest, TrainInferenceCost)
+{
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 5;
+    params.ratioDeletedRoots = 0.2;
+    params.nbGenerations = 5;
+    params.mutation.tpg.nbRoots = 30;
+    params.inferenceCostWeight = 0.01;
+    params.maxInferenceCost = 20.0;
+
+    Learn::LearningAgent la(le, set, params, TPG::TPGInstrumentedFactory());
+
+    la.init();
+    bool alt = false;
+    ASSERT_NO_THROW(la.train(alt, false))
+        << "Training with inference cost selection failed.";
+    ASSERT_GT(la.getBestRoot().second->getInferenceCost(), 0.0)
+        << "The inference cost of the best root should have been measured.";
 }
 
 TEST_F(LearningAgentTest, KeepBestPolicy)
@@ -1204,6 +1319,29 @@ TEST_F(ParallelLearningAgentTest, TrainParallelDeterminism)
            "TPGGraphs.";
 }
 
+TEST_F(ParallelLearningAgentTest, TrainParallelInferenceCost)
+{
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 5;
+    params.ratioDeletedRoots = 0.2;
+    params.nbGenerations = 5;
+    params.mutation.tpg.nbRoots = 30;
+    params.nbThreads = 4;
+    params.inferenceCostWeight = 0.01;
+
+    Learn::ParallelLearningAgent pla(le, set, params,
+                                     TPG::TPGInstrumentedFactory());
+
+    pla.init();
+    bool alt = false;
+    ASSERT_NO_THROW(pla.train(alt, false))
+        << "Training with inference cost selection failed.";
+    ASSERT_GT(pla.getBestRoot().second->getInferenceCost(), 0.0)
+        << "The inference cost of the best root should have been measured.";
+}
+
 TEST_F(ParallelLearningAgentTest, KeepBestPolicy)
 {
     params.archiveSize = 50;
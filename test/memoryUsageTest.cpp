@@ -0,0 +1,299 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+
+#include "archive.h"
+#include "data/arrayWrapper.h"
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/multByConstant.h"
+#include "learn/adversarialLearningAgent.h"
+#include "learn/learningAgent.h"
+#include "learn/stickGameAdversarial.h"
+#include "learn/stickGameWithOpponent.h"
+#include "mutator/programMutator.h"
+#include "mutator/rng.h"
+#include "program/program.h"
+#include "tpg/instrumented/tpgExecutionEngineInstrumented.h"
+#include "tpg/instrumented/tpgInstrumentedFactory.h"
+#include "tpg/tpgGraph.h"
+#include "util/memoryUsage.h"
+
+/// StickGameAdversarial whose match results can be cached.
+class CacheableStickGameAdversarial : public StickGameAdversarial
+{
+  public:
+    bool isDeterministic() const override
+    {
+        return true;
+    }
+
+    Learn::LearningEnvironment* clone() const override
+    {
+        return new CacheableStickGameAdversarial(*this);
+    }
+};
+
+class MemoryUsageTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    Data::PrimitiveTypeArray<double> data;
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Environment* e = nullptr;
+    Learn::LearningParameters params;
+
+    MemoryUsageTest() : data(16)
+    {
+    }
+
+    void SetUp() override
+    {
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::MultByConstant<double>()));
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        vect.push_back(data);
+        e = new Environment(set, vect, 8, 5);
+
+        params.archiveSize = 50;
+        params.archivingProbability = 0.5;
+        params.maxNbActionsPerEval = 11;
+        params.nbIterationsPerPolicyEvaluation = 3;
+        params.ratioDeletedRoots = 0.2;
+        params.nbThreads = 1;
+        params.mutation.tpg.maxInitOutgoingEdges = 3;
+        params.mutation.tpg.nbRoots = 15;
+        params.mutation.tpg.pEdgeDeletion = 0.7;
+        params.mutation.tpg.pEdgeAddition = 0.7;
+        params.mutation.tpg.pProgramMutation = 0.2;
+        params.mutation.tpg.pEdgeDestinationChange = 0.1;
+        params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+        params.mutation.tpg.maxOutgoingEdges = 4;
+        params.mutation.prog.maxProgramSize = 96;
+        params.mutation.prog.pAdd = 0.5;
+        params.mutation.prog.pDelete = 0.5;
+        params.mutation.prog.pMutate = 1.0;
+        params.mutation.prog.pSwap = 1.0;
+        params.mutation.prog.minConstValue = 0;
+        params.mutation.prog.maxConstValue = 3;
+    }
+
+    void TearDown() override
+    {
+        delete e;
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+        delete (&set.getInstruction(2));
+    }
+};
+
+TEST_F(MemoryUsageTest, MemoryUsageTotal)
+{
+    Util::MemoryUsage usage;
+    ASSERT_EQ(usage.getTotal(), 0);
+
+    usage.vertices = 1;
+    usage.edges = 2;
+    usage.programs = 4;
+    usage.lines = 8;
+    usage.constants = 16;
+    usage.archiveRecordings = 32;
+    usage.archiveDataHandlers = 64;
+    usage.caches = 128;
+    usage.traces = 256;
+    ASSERT_EQ(usage.getTotal(), 511);
+
+    Util::MemoryUsage other;
+    other.lines = 1000;
+    other += usage;
+    ASSERT_EQ(other.lines, 1008);
+    ASSERT_EQ(other.getTotal(), 1511);
+}
+
+TEST_F(MemoryUsageTest, DataHandlerFootprint)
+{
+    Data::PrimitiveTypeArray<double> small(10);
+    Data::PrimitiveTypeArray<double> large(1000);
+    ASSERT_GE(small.getMemoryFootprint(), 10 * sizeof(double));
+    ASSERT_EQ(large.getMemoryFootprint() - small.getMemoryFootprint(),
+              990 * sizeof(double))
+        << "Footprint of PrimitiveTypeArray should grow with its size.";
+
+    Data::PrimitiveTypeArray2D<int> array2D(10, 20);
+    ASSERT_GE(array2D.getMemoryFootprint(), 200 * sizeof(int));
+
+    // Wrapped data is not owned.
+    std::vector<double> values(1000);
+    Data::ArrayWrapper<double> wrapper(values.size(), &values);
+    ASSERT_LT(wrapper.getMemoryFootprint(), 1000 * sizeof(double));
+
+    // Clones own their data.
+    Data::DataHandler* clone = wrapper.clone();
+    ASSERT_GE(clone->getMemoryFootprint(), 1000 * sizeof(double));
+    delete clone;
+}
+
+TEST_F(MemoryUsageTest, ProgramMemoryUsage)
+{
+    Program::Program p(*e);
+    Util::MemoryUsage emptyUsage;
+    p.addMemoryUsage(emptyUsage);
+    ASSERT_GT(emptyUsage.programs, 0);
+    ASSERT_EQ(emptyUsage.lines, 0);
+    ASSERT_GE(emptyUsage.constants, 5 * sizeof(Data::Constant));
+
+    p.addNewLine();
+    p.addNewLine();
+    Util::MemoryUsage usage;
+    p.addMemoryUsage(usage);
+    ASSERT_EQ(usage.lines, 2 * p.getLine(0).getMemoryFootprint());
+    ASSERT_GT(p.getLine(0).getMemoryFootprint(), sizeof(Program::Line));
+    ASSERT_EQ(usage.constants, emptyUsage.constants);
+    ASSERT_EQ(usage.archiveRecordings, 0);
+}
+
+TEST_F(MemoryUsageTest, TPGGraphMemoryUsage)
+{
+    TPG::TPGGraph tpg(*e);
+    Util::MemoryUsage emptyUsage;
+    tpg.addMemoryUsage(emptyUsage);
+    ASSERT_EQ(emptyUsage.edges, 0);
+    ASSERT_EQ(emptyUsage.programs, 0);
+
+    const TPG::TPGVertex& t0 = tpg.addNewTeam();
+    const TPG::TPGVertex& a0 = tpg.addNewAction(0);
+    const TPG::TPGVertex& a1 = tpg.addNewAction(1);
+    auto prog = std::make_shared<Program::Program>(*e);
+    prog->addNewLine();
+    tpg.addNewEdge(t0, a0, prog);
+
+    Util::MemoryUsage usage;
+    tpg.addMemoryUsage(usage);
+    ASSERT_GT(usage.vertices, emptyUsage.vertices);
+    ASSERT_GT(usage.edges, 0);
+    ASSERT_GT(usage.lines, 0);
+
+    // A Program shared by two edges is accounted once.
+    tpg.addNewEdge(t0, a1, prog);
+    Util::MemoryUsage sharedUsage;
+    tpg.addMemoryUsage(sharedUsage);
+    ASSERT_EQ(sharedUsage.programs, usage.programs);
+    ASSERT_EQ(sharedUsage.lines, usage.lines);
+    ASSERT_EQ(sharedUsage.edges, 2 * usage.edges);
+    ASSERT_GT(sharedUsage.vertices, usage.vertices);
+
+    // Instrumented vertices and edges are larger.
+    TPG::TPGGraph tpgInstrumented(
+        *e, std::make_unique<TPG::TPGInstrumentedFactory>());
+    const TPG::TPGVertex& t1 = tpgInstrumented.addNewTeam();
+    const TPG::TPGVertex& a2 = tpgInstrumented.addNewAction(0);
+    tpgInstrumented.addNewEdge(t1, a2, prog);
+    Util::MemoryUsage instrumentedUsage;
+    tpgInstrumented.addMemoryUsage(instrumentedUsage);
+    ASSERT_GT(instrumentedUsage.edges, usage.edges);
+    ASSERT_GT(a2.getMemoryFootprint(), a0.getMemoryFootprint());
+}
+
+TEST_F(MemoryUsageTest, ArchiveMemoryUsage)
+{
+    Archive archive(10, 1.0);
+    Util::MemoryUsage emptyUsage;
+    archive.addMemoryUsage(emptyUsage);
+    ASSERT_EQ(emptyUsage.archiveRecordings, sizeof(Archive));
+    ASSERT_EQ(emptyUsage.archiveDataHandlers, 0);
+
+    Program::Program p(*e);
+    archive.addRecording(&p, vect, 1.0, true);
+    Util::MemoryUsage usage;
+    archive.addMemoryUsage(usage);
+    ASSERT_GT(usage.archiveRecordings, emptyUsage.archiveRecordings);
+    ASSERT_GE(usage.archiveDataHandlers, data.getMemoryFootprint());
+    ASSERT_EQ(usage.programs, 0);
+}
+
+TEST_F(MemoryUsageTest, TPGExecutionEngineInstrumentedMemoryUsage)
+{
+    TPG::TPGGraph tpg(*e, std::make_unique<TPG::TPGInstrumentedFactory>());
+    const TPG::TPGVertex& t0 = tpg.addNewTeam();
+    const TPG::TPGVertex& a0 = tpg.addNewAction(0);
+    tpg.addNewEdge(t0, a0, std::make_shared<Program::Program>(*e));
+
+    TPG::TPGExecutionEngineInstrumented tee(*e);
+    Util::MemoryUsage emptyUsage;
+    tee.addMemoryUsage(emptyUsage);
+    for (auto i = 0; i < 100; i++) {
+        tee.executeFromRoot(t0);
+    }
+    Util::MemoryUsage usage;
+    tee.addMemoryUsage(usage);
+    ASSERT_GE(usage.traces - emptyUsage.traces, 200 * sizeof(void*));
+}
+
+TEST_F(MemoryUsageTest, LearningAgentMemoryUsage)
+{
+    StickGameWithOpponent le;
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+
+    Util::MemoryUsage initUsage = la.getMemoryUsage();
+    ASSERT_GT(initUsage.vertices, 0);
+    ASSERT_GT(initUsage.edges, 0);
+    ASSERT_GT(initUsage.programs, 0);
+    ASSERT_GT(initUsage.lines, 0);
+    ASSERT_EQ(initUsage.caches, 0);
+
+    la.trainOneGeneration(0);
+    Util::MemoryUsage usage = la.getMemoryUsage();
+    ASSERT_GT(usage.caches, 0) << "Results of roots should be accounted.";
+    ASSERT_GT(usage.archiveDataHandlers, 0);
+    ASSERT_GT(usage.getTotal(), initUsage.getTotal());
+}
+
+TEST_F(MemoryUsageTest, AdversarialLearningAgentMemoryUsage)
+{
+    CacheableStickGameAdversarial le;
+    params.nbIterationsPerPolicyEvaluation = 1;
+    Learn::AdversarialLearningAgent la(le, set, params);
+    la.init();
+    la.trainOneGeneration(0);
+    ASSERT_GT(la.getNbCachedMatchResults(), 0);
+
+    Util::MemoryUsage usage = la.getMemoryUsage();
+    Util::MemoryUsage baseUsage = la.LearningAgent::getMemoryUsage();
+    ASSERT_GT(usage.caches, baseUsage.caches)
+        << "Cached match results should be accounted.";
+    ASSERT_EQ(usage.vertices, baseUsage.vertices);
+}
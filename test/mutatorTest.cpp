@@ -128,6 +128,26 @@ TEST_F(MutatorTest, RNG)
         << "Returned pseudo-random value changed with a known seed.";
 }
 
+TEST_F(MutatorTest, RNGState)
+{
+    Mutator::RNG rng(42);
+    rng.getUnsignedInt64(0, 100);
+
+    std::string state;
+    ASSERT_NO_THROW(state = rng.getState()) << "Getting the RNG state failed.";
+
+    Mutator::RNG other;
+    ASSERT_NO_THROW(other.setState(state)) << "Setting the RNG state failed.";
+    for (auto i = 0; i < 10; i++) {
+        ASSERT_EQ(rng.getUnsignedInt64(0, UINT64_MAX),
+                  other.getUnsignedInt64(0, UINT64_MAX))
+            << "RNG with a restored state does not generate the same numbers.";
+    }
+
+    ASSERT_THROW(other.setState("not a state"), std::runtime_error)
+        << "Setting an invalid RNG state should fail.";
+}
+
 TEST_F(MutatorTest, LineMutatorInitRandomCorrectLine1)
 {
     Mutator::RNG rng;
@@ -829,6 +849,105 @@ TEST_F(MutatorTest, TPGMutatorMutateTeam)
     // already covered in other unit tests.
 }
 
+TEST_F(MutatorTest, TPGMutatorPlanTeamMutation)
+{
+    // Create a TPG
+    TPG::TPGGraph tpg(*e);
+    const TPG::TPGTeam& vertex0 = tpg.addNewTeam();
+    const TPG::TPGAction& vertex1 = tpg.addNewAction(0);
+    const TPG::TPGAction& vertex2 = tpg.addNewAction(1);
+    const TPG::TPGAction& vertex3 = tpg.addNewAction(2);
+    const TPG::TPGTeam& vertex4 = tpg.addNewTeam();
+    const TPG::TPGEdge& edge0 = tpg.addNewEdge(vertex0, vertex1, progPointer);
+    const TPG::TPGEdge& edge1 = tpg.addNewEdge(vertex0, vertex2, progPointer);
+    const TPG::TPGEdge& edge2 = tpg.addNewEdge(vertex4, vertex3, progPointer);
+    const TPG::TPGEdge& edge3 = tpg.addNewEdge(vertex0, vertex3, progPointer);
+    const TPG::TPGEdge& edge4 = tpg.addNewEdge(vertex4, vertex1, progPointer);
+
+    Mutator::MutationParameters params;
+    params.tpg.maxOutgoingEdges = 5;
+    params.tpg.pEdgeDeletion = 0.7;
+    params.tpg.pEdgeAddition = 0.7;
+    params.tpg.pProgramMutation = 0.5;
+    params.tpg.pEdgeDestinationChange = 0.5;
+    params.tpg.pEdgeDestinationIsAction = 0.5;
+
+    std::vector<const TPG::TPGTeam*> teams{&vertex0, &vertex4};
+    std::vector<const TPG::TPGAction*> actions{&vertex1, &vertex2};
+    std::list<const TPG::TPGEdge*> edges{&edge0, &edge1, &edge2, &edge3,
+                                         &edge4};
+
+    for (uint64_t seed = 0; seed < 20; seed++) {
+        // Plan the mutation of a clone of vertex0
+        Mutator::RNG rng(seed);
+        Mutator::TPGMutator::TPGTeamMutationPlan plan;
+        ASSERT_NO_THROW(plan = Mutator::TPGMutator::planTPGTeamMutation(
+                            vertex0, teams, actions, edges, params, rng))
+            << "Planning the mutation of a team should not fail.";
+        uint64_t nextValue = rng.getUnsignedInt64(0, UINT64_MAX);
+
+        // Do the same mutation directly in the graph
+        rng.setSeed(seed);
+        std::list<std::shared_ptr<Program::Program>> newPrograms;
+        const TPG::TPGTeam& mutatedTeam =
+            (const TPG::TPGTeam&)tpg.cloneVertex(vertex0);
+        Mutator::TPGMutator::mutateTPGTeam(tpg, Archive(), mutatedTeam, teams,
+                                           actions, edges, newPrograms, params,
+                                           rng);
+        ASSERT_EQ(rng.getUnsignedInt64(0, UINT64_MAX), nextValue)
+            << "Planning a mutation should draw the same random numbers as "
+               "mutating a team.";
+
+        // Apply the plan
+        std::list<std::shared_ptr<Program::Program>> plannedPrograms;
+        const TPG::TPGTeam* plannedTeam = nullptr;
+        ASSERT_NO_THROW(plannedTeam =
+                            &Mutator::TPGMutator::applyTPGTeamMutationPlan(
+                                tpg, plan, plannedPrograms))
+            << "Applying a valid plan should not fail.";
+
+        // Compare the two teams
+        ASSERT_EQ(plannedPrograms.size(), newPrograms.size())
+            << "Number of new Program differs from mutateTPGTeam.";
+        ASSERT_EQ(plannedTeam->getOutgoingEdges().size(),
+                  mutatedTeam.getOutgoingEdges().size())
+            << "Number of outgoing edges differs from mutateTPGTeam.";
+        auto plannedEdge = plannedTeam->getOutgoingEdges().begin();
+        auto plannedProgram = plannedPrograms.begin();
+        for (const TPG::TPGEdge* mutatedEdge : mutatedTeam.getOutgoingEdges()) {
+            ASSERT_EQ((*plannedEdge)->getDestination(),
+                      mutatedEdge->getDestination())
+                << "Destination of planned edge differs from mutateTPGTeam.";
+            if (&mutatedEdge->getProgram() == progPointer.get()) {
+                ASSERT_EQ(&(*plannedEdge)->getProgram(), progPointer.get())
+                    << "Planned edge Program should not have been copied.";
+            }
+            else {
+                ASSERT_EQ(&(*plannedEdge)->getProgram(),
+                          plannedProgram->get())
+                    << "Planned edge Program should have been copied.";
+                plannedProgram++;
+            }
+            plannedEdge++;
+        }
+    }
+
+    // Apply a plan with an edge not belonging to the graph.
+    TPG::TPGEdge newEdge(&vertex0, &vertex1, progPointer);
+    Mutator::TPGMutator::TPGTeamMutationPlan plan;
+    plan.edges.push_back({&edge0, &vertex1, false});
+    plan.edges.push_back({&newEdge, &vertex1, false});
+    std::list<std::shared_ptr<Program::Program>> newPrograms;
+    uint64_t nbVertices = tpg.getNbVertices();
+    ASSERT_THROW(Mutator::TPGMutator::applyTPGTeamMutationPlan(tpg, plan,
+                                                               newPrograms),
+                 std::runtime_error)
+        << "Applying a plan with an edge not belonging to the graph should "
+           "fail.";
+    ASSERT_EQ(tpg.getNbVertices(), nbVertices)
+        << "Failed plan application should not modify the graph.";
+}
+
 TEST_F(MutatorTest, TPGMutatorMutateProgramBehaviorAgainstArchive)
 {
     Mutator::RNG rng;
@@ -1081,3 +1200,99 @@ TEST_F(MutatorTest, TPGMutatorPopulate)
         Mutator::TPGMutator::populateTPG(tpg2, arch, params, rng, 0))
         << "Populating an empty TPG failed.";
 }
+
+TEST_F(MutatorTest, TPGMutatorPopulateException)
+{
+    Mutator::MutationParameters params;
+    params.tpg.nbRoots = 5;
+    params.tpg.maxOutgoingEdges = 4;
+    params.tpg.pEdgeDeletion = 0.0;
+    params.tpg.pEdgeAddition = 1.0;
+    Archive arch;
+    Mutator::RNG rng(0);
+
+    // A single team without edges: no edge can be cloned in new roots.
+    TPG::TPGGraph tpg(*e);
+    tpg.addNewTeam();
+    tpg.addNewAction(0);
+
+    ASSERT_THROW(Mutator::TPGMutator::populateTPG(tpg, arch, params, rng, 0),
+                 std::runtime_error)
+        << "Exception raised while planning mutations should be thrown.";
+    ASSERT_THROW(Mutator::TPGMutator::populateTPG(tpg, arch, params, rng, 4),
+                 std::runtime_error)
+        << "Exception raised in planning threads should be rethrown.";
+}
+
+TEST_F(MutatorTest, TPGMutatorPopulateDeterminism)
+{
+    Mutator::MutationParameters params;
+    params.tpg.nbActions = 4;
+    params.tpg.maxInitOutgoingEdges = 3;
+    params.prog.maxProgramSize = 96;
+    params.tpg.nbRoots = 20;
+    params.tpg.pEdgeDeletion = 0.7;
+    params.tpg.pEdgeAddition = 0.7;
+    params.tpg.pProgramMutation = 0.2;
+    params.tpg.pEdgeDestinationChange = 0.1;
+    params.tpg.pEdgeDestinationIsAction = 0.5;
+    params.prog.pAdd = 0.5;
+    params.prog.pDelete = 0.5;
+    params.prog.pMutate = 1.0;
+    params.prog.pSwap = 1.0;
+    params.prog.pConstantMutation = 0.5;
+    params.prog.minConstValue = 0;
+    params.prog.maxConstValue = 10;
+    Archive arch;
+
+    Mutator::RNG rng;
+    TPG::TPGGraph tpgSequential(*e);
+    rng.setSeed(0);
+    Mutator::TPGMutator::initRandomTPG(tpgSequential, params, rng);
+    Mutator::TPGMutator::populateTPG(tpgSequential, arch, params, rng, 0);
+    uint64_t nextValueSequential = rng.getUnsignedInt64(0, UINT64_MAX);
+
+    TPG::TPGGraph tpgParallel(*e);
+    rng.setSeed(0);
+    Mutator::TPGMutator::initRandomTPG(tpgParallel, params, rng);
+    Mutator::TPGMutator::populateTPG(tpgParallel, arch, params, rng, 4);
+    uint64_t nextValueParallel = rng.getUnsignedInt64(0, UINT64_MAX);
+
+    ASSERT_EQ(nextValueSequential, nextValueParallel)
+        << "RNG state differs after sequential and parallel populate.";
+    ASSERT_EQ(tpgSequential.getNbRootVertices(), params.tpg.nbRoots);
+    ASSERT_EQ(tpgSequential.getNbVertices(), tpgParallel.getNbVertices())
+        << "Number of vertices differs after sequential and parallel "
+           "populate.";
+    ASSERT_EQ(tpgSequential.getEdges().size(), tpgParallel.getEdges().size())
+        << "Number of edges differs after sequential and parallel populate.";
+
+    // Compare the edges structure and programs
+    auto verticesSequential = tpgSequential.getVertices();
+    auto verticesParallel = tpgParallel.getVertices();
+    auto iterParallel = tpgParallel.getEdges().begin();
+    for (auto& edgeSequentialPtr : tpgSequential.getEdges()) {
+        const TPG::TPGEdge& edgeSequential = *edgeSequentialPtr;
+        const TPG::TPGEdge& edgeParallel = **(iterParallel++);
+        ASSERT_EQ(std::find(verticesSequential.begin(),
+                            verticesSequential.end(),
+                            edgeSequential.getSource()) -
+                      verticesSequential.begin(),
+                  std::find(verticesParallel.begin(), verticesParallel.end(),
+                            edgeParallel.getSource()) -
+                      verticesParallel.begin())
+            << "Edge source differs after sequential and parallel populate.";
+        ASSERT_EQ(std::find(verticesSequential.begin(),
+                            verticesSequential.end(),
+                            edgeSequential.getDestination()) -
+                      verticesSequential.begin(),
+                  std::find(verticesParallel.begin(), verticesParallel.end(),
+                            edgeParallel.getDestination()) -
+                      verticesParallel.begin())
+            << "Edge destination differs after sequential and parallel "
+               "populate.";
+        ASSERT_TRUE(edgeSequential.getProgram().hasIdenticalBehavior(
+            edgeParallel.getProgram()))
+            << "Edge program differs after sequential and parallel populate.";
+    }
+}
@@ -0,0 +1,334 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifdef NATIVE_BACKEND
+
+#include <gtest/gtest.h>
+
+#include "data/arrayWrapper.h"
+#include "data/pointerWrapper.h"
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "learn/learningAgent.h"
+#include "learn/stickGameWithOpponent.h"
+#include "tpg/tpgExecutionEngine.h"
+#include "tpg/tpgGraph.h"
+
+#include "codeGen/nativeBackend.h"
+
+class NativeBackendTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    std::vector<std::reference_wrapper<const Data::DataHandler>> data;
+    Data::PrimitiveTypeArray<double> currentState{8};
+    Environment* e = nullptr;
+    TPG::TPGGraph* tpg = nullptr;
+    std::vector<std::shared_ptr<Program::Program>> progs;
+
+    virtual void SetUp()
+    {
+        data.emplace_back(currentState);
+        for (size_t i = 0; i < 8; i++) {
+            currentState.setDataAt(typeid(double), i, 1.5 * i - 3.0);
+        }
+
+        auto add = [](double a, double b) -> double { return a + b; };
+        auto mul = [](double a, double b) -> double { return a * b; };
+        set.add(*(new Instructions::LambdaInstruction<double, double>(
+            add, "$0 = $1 + $2;")));
+        set.add(*(new Instructions::LambdaInstruction<double, double>(
+            mul, "$0 = $1 * $2;")));
+        // Not printable
+        set.add(*(new Instructions::LambdaInstruction<double, double>(add)));
+
+        e = new Environment(set, data, 8);
+        tpg = new TPG::TPGGraph(*e);
+
+        // Root -> T1 -> A0 / A1
+        const TPG::TPGVertex& root = tpg->addNewTeam();
+        const TPG::TPGVertex& t1 = tpg->addNewTeam();
+        const TPG::TPGVertex& a0 = tpg->addNewAction(0);
+        const TPG::TPGVertex& a1 = tpg->addNewAction(1);
+        for (size_t i = 0; i < 4; i++) {
+            progs.push_back(std::make_shared<Program::Program>(*e));
+            // reg[1] = in1[i] * in1[i + 1]; reg[0] = reg[1] + in1[i + 2]
+            Program::Line& l1 = progs.back()->addNewLine();
+            l1.setDestinationIndex(1);
+            l1.setInstructionIndex(1);
+            l1.setOperand(0, 1, i);
+            l1.setOperand(1, 1, i + 1);
+            Program::Line& l2 = progs.back()->addNewLine();
+            l2.setDestinationIndex(0);
+            l2.setInstructionIndex(0);
+            l2.setOperand(0, 0, 1);
+            l2.setOperand(1, 1, i + 2);
+        }
+        tpg->addNewEdge(root, t1, progs.at(0));
+        tpg->addNewEdge(root, a0, progs.at(1));
+        tpg->addNewEdge(t1, a0, progs.at(2));
+        tpg->addNewEdge(t1, a1, progs.at(3));
+    }
+
+    virtual void TearDown()
+    {
+        delete tpg;
+        delete e;
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+        delete (&set.getInstruction(2));
+    }
+};
+
+TEST_F(NativeBackendTest, ConstructorDestructor)
+{
+    CodeGen::NativeBackend* backend;
+    ASSERT_NO_THROW(backend = new CodeGen::NativeBackend(*e))
+        << "Construction of a NativeBackend failed.";
+    ASSERT_NO_THROW(delete backend)
+        << "Destruction of a NativeBackend failed.";
+}
+
+TEST_F(NativeBackendTest, UpdateAndCompile)
+{
+    CodeGen::NativeBackend backend(*e, 2);
+
+    backend.update(*tpg);
+    backend.waitForCompilations();
+    ASSERT_EQ(backend.getNbNativePrograms(), 0)
+        << "Program should not be compiled before minNbGenerations.";
+    ASSERT_EQ(backend.getNativeFunction(*progs.at(0)), nullptr);
+    uint64_t version = backend.getNativeFunctionsVersion();
+
+    backend.update(*tpg);
+    backend.waitForCompilations();
+    ASSERT_NE(backend.getNativeFunctionsVersion(), version)
+        << "Publishing native functions should change their version.";
+    ASSERT_EQ(backend.getNativeFunctions()->size(), 4);
+    ASSERT_EQ(backend.getNbCompilations(), 1)
+        << "All eligible Program should be compiled in one shared object.";
+    ASSERT_EQ(backend.getNbFailures(), 0);
+    ASSERT_EQ(backend.getNbNativePrograms(), 4)
+        << "All Program should be compiled after minNbGenerations.";
+
+    // Native and interpreted results are identical
+    std::vector<const void*> pointers;
+    ASSERT_TRUE(CodeGen::NativeBackend::getDataPointers(data, pointers));
+    TPG::TPGExecutionEngine tee(*e);
+    for (const auto& edge : tpg->getEdges()) {
+        auto nativeFunction = backend.getNativeFunction(edge->getProgram());
+        ASSERT_NE(nativeFunction, nullptr);
+        ASSERT_DOUBLE_EQ(nativeFunction(pointers.data()),
+                         tee.evaluateEdge(*edge))
+            << "Native and interpreted results of a Program differ.";
+    }
+
+    // Program removed from the graph are released.
+    auto snapshot = backend.getNativeFunctions();
+    version = backend.getNativeFunctionsVersion();
+    tpg->removeEdge(*tpg->getEdges().back());
+    backend.update(*tpg);
+    ASSERT_EQ(backend.getNbNativePrograms(), 3)
+        << "Program removed from the graph should be released.";
+    ASSERT_NE(backend.getNativeFunctionsVersion(), version)
+        << "Releasing native functions should change their version.";
+    ASSERT_EQ(snapshot->size(), 4)
+        << "Published native functions should never be modified.";
+}
+
+TEST_F(NativeBackendTest, NotPrintableProgram)
+{
+    CodeGen::NativeBackend backend(*e, 1);
+
+    progs.at(3)->getLine(1).setInstructionIndex(2);
+    backend.update(*tpg);
+    backend.waitForCompilations();
+    ASSERT_EQ(backend.getNbNativePrograms(), 3)
+        << "Only Program with printable Instruction should be compiled.";
+    ASSERT_EQ(backend.getNbFailures(), 1);
+    ASSERT_EQ(backend.getNativeFunction(*progs.at(3)), nullptr);
+}
+
+TEST_F(NativeBackendTest, TPGExecutionEngine)
+{
+    CodeGen::NativeBackend backend(*e, 1);
+    backend.update(*tpg);
+    backend.waitForCompilations();
+    ASSERT_EQ(backend.getNbNativePrograms(), 4);
+
+    TPG::TPGExecutionEngine interpreted(*e);
+    TPG::TPGExecutionEngine native(*e);
+    native.setNativeBackend(&backend);
+
+    for (size_t i = 0; i < 8; i++) {
+        currentState.setDataAt(typeid(double), i, 0.7 * i * i - 5.0);
+    }
+    for (const auto& edge : tpg->getEdges()) {
+        ASSERT_EQ(native.evaluateEdge(*edge), interpreted.evaluateEdge(*edge))
+            << "Native execution of a Program should give the interpreted "
+               "result.";
+    }
+    const TPG::TPGVertex* root = tpg->getRootVertices().at(0);
+    ASSERT_EQ(native.executeFromRoot(*root), interpreted.executeFromRoot(*root))
+        << "Native execution of a TPG should traverse the same vertices.";
+
+    // Native functions are given the data sources set after construction.
+    std::unique_ptr<Data::PrimitiveTypeArray<double>> otherState(
+        (Data::PrimitiveTypeArray<double>*)currentState.clone());
+    for (size_t i = 0; i < 8; i++) {
+        otherState->setDataAt(typeid(double), i, 2.0 - 0.3 * i);
+    }
+    std::vector<std::reference_wrapper<const Data::DataHandler>> otherData{
+        *otherState};
+    ASSERT_NO_THROW(native.setDataSources(otherData))
+        << "Setting new data sources failed.";
+    interpreted.setDataSources(otherData);
+    for (const auto& edge : tpg->getEdges()) {
+        ASSERT_EQ(native.evaluateEdge(*edge), interpreted.evaluateEdge(*edge))
+            << "Native execution should use the new data sources.";
+    }
+    ASSERT_DOUBLE_EQ(native.evaluateEdge(*tpg->getEdges().front()),
+                     2.0 * 1.7 + 1.4)
+        << "Native execution should use the new data sources.";
+}
+
+TEST_F(NativeBackendTest, TPGExecutionEngineReplacedStorage)
+{
+    CodeGen::NativeBackend backend(*e, 1);
+    backend.update(*tpg);
+    backend.waitForCompilations();
+
+    // ArrayWrapper sharing the id of currentState, whose storage is
+    // replaced between inferences.
+    Data::ArrayWrapper<double> wrapper(currentState, 8);
+    std::vector<double> storage1(8), storage2(8);
+    for (size_t i = 0; i < 8; i++) {
+        storage1.at(i) = 0.7 * i * i - 5.0;
+        storage2.at(i) = 2.0 - 0.3 * i;
+    }
+    wrapper.setPointer(&storage1);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> wrapperData{
+        wrapper};
+
+    TPG::TPGExecutionEngine interpreted(*e);
+    TPG::TPGExecutionEngine native(*e);
+    interpreted.setDataSources(wrapperData);
+    native.setDataSources(wrapperData);
+    native.setNativeBackend(&backend);
+
+    const TPG::TPGVertex* root = tpg->getRootVertices().at(0);
+    ASSERT_EQ(native.executeFromRoot(*root), interpreted.executeFromRoot(*root))
+        << "Native execution of a TPG should traverse the same vertices.";
+
+    wrapper.setPointer(&storage2);
+    ASSERT_EQ(native.executeFromRoot(*root), interpreted.executeFromRoot(*root))
+        << "Native execution of a TPG should use the replaced storage.";
+    for (const auto& edge : tpg->getEdges()) {
+        ASSERT_EQ(native.evaluateEdge(*edge), interpreted.evaluateEdge(*edge))
+            << "Native data pointers should be refreshed by "
+               "executeFromRoot.";
+    }
+    ASSERT_DOUBLE_EQ(native.evaluateEdge(*tpg->getEdges().front()),
+                     2.0 * 1.7 + 1.4)
+        << "Native execution should use the replaced storage.";
+}
+
+TEST_F(NativeBackendTest, GetDataPointers)
+{
+    std::vector<const void*> pointers;
+    ASSERT_TRUE(CodeGen::NativeBackend::getDataPointers(data, pointers))
+        << "Arrays of primitive types should be given to native functions.";
+    ASSERT_EQ(pointers.size(), 1);
+    ASSERT_EQ(pointers.at(0), currentState.getScalarAccess().data)
+        << "Native functions should be given the storage of data sources.";
+
+    // No direct access to the wrapped data: a copy would be given to native
+    // functions.
+    double value = 1.0;
+    Data::PointerWrapper<double> pointerWrapper(&value);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> otherData{
+        pointerWrapper};
+    ASSERT_FALSE(CodeGen::NativeBackend::getDataPointers(otherData, pointers))
+        << "DataHandler without direct access to their storage should be "
+           "rejected.";
+}
+
+TEST_F(NativeBackendTest, LearningAgentTrain)
+{
+    Instructions::Set laSet;
+    laSet.add(*(new Instructions::AddPrimitiveType<int>("$0 = $1 + $2;")));
+    laSet.add(*(new Instructions::AddPrimitiveType<double>("$0 = $1 + $2;")));
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 3;
+    params.nbGenerations = 4;
+    params.mutation.tpg.nbRoots = 10;
+    params.mutation.tpg.maxInitOutgoingEdges = 3;
+    params.mutation.tpg.maxOutgoingEdges = 4;
+    params.mutation.prog.maxProgramSize = 20;
+
+    // Reference training, interpreted.
+    Learn::LearningAgent reference(le, laSet, params);
+    reference.init(0);
+    for (uint64_t i = 0; i < params.nbGenerations; i++) {
+        reference.trainOneGeneration(i);
+    }
+
+    Learn::LearningAgent la(le, laSet, params);
+    CodeGen::NativeBackend backend(la.getEnvironment(), 1);
+    la.setNativeBackend(&backend);
+    la.init(0);
+    for (uint64_t i = 0; i < params.nbGenerations; i++) {
+        la.trainOneGeneration(i);
+        // Make native functions available for the next generation.
+        backend.waitForCompilations();
+    }
+    ASSERT_GT(backend.getNbNativePrograms(), 0)
+        << "Surviving Program should be executed natively.";
+    ASSERT_EQ(backend.getNbFailures(), 0);
+
+    ASSERT_EQ(la.getTPGGraph()->getNbVertices(),
+              reference.getTPGGraph()->getNbVertices())
+        << "Native execution should not change the training.";
+    ASSERT_EQ(la.getTPGGraph()->getEdges().size(),
+              reference.getTPGGraph()->getEdges().size())
+        << "Native execution should not change the training.";
+
+    delete (&laSet.getInstruction(0));
+    delete (&laSet.getInstruction(1));
+}
+
+#endif // NATIVE_BACKEND
@@ -60,7 +60,7 @@ TEST(LearningParametersTest, readConfigFile)
         << "Ill-formed parameters file should result in no root filling";
 
     File::ParametersParser::readConfigFile(TESTS_DAT_PATH "params.json", root);
-    ASSERT_EQ(13, root.size())
+    ASSERT_EQ(15, root.size())
         << "Wrong number of elements in parsed json file";
     ASSERT_EQ(10, root["mutation"]["tpg"].size())
         << "Wrong number of elements in parsed json file";
@@ -92,6 +92,8 @@ TEST(LearningParametersTest, setAllParamsFrom)
     ASSERT_EQ(31, params.nbIterationsPerJob);
     ASSERT_EQ(5, params.maxNbActionsPerEval);
     ASSERT_EQ(0.85, params.ratioDeletedRoots);
+    ASSERT_EQ(0.01, params.inferenceCostWeight);
+    ASSERT_EQ(120.0, params.maxInferenceCost);
     ASSERT_EQ(100, params.maxNbEvaluationPerPolicy);
     ASSERT_EQ(3.0, params.nbRegisters);
     ASSERT_EQ(5, params.nbProgramConstant);
@@ -169,6 +171,8 @@ TEST(LearningParametersTest, writeParametersToJson)
     ASSERT_EQ(params.archiveSize, params2.archiveSize);
     ASSERT_EQ(params.archivingProbability, params2.archivingProbability);
     ASSERT_EQ(params.doValidation, params2.doValidation);
+    ASSERT_EQ(params.inferenceCostWeight, params2.inferenceCostWeight);
+    ASSERT_EQ(params.maxInferenceCost, params2.maxInferenceCost);
     ASSERT_EQ(params.maxNbActionsPerEval, params2.maxNbActionsPerEval);
     ASSERT_EQ(params.maxNbEvaluationPerPolicy,
               params2.maxNbEvaluationPerPolicy);
@@ -0,0 +1,216 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+
+#include "environment.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/set.h"
+#include "learn/learningAgent.h"
+#include "learn/learningParameters.h"
+#include "learn/stickGameWithOpponent.h"
+#include "program/program.h"
+#include "tpg/tpgGraph.h"
+
+#include "learn/policyPruner.h"
+
+class PolicyPrunerTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    StickGameWithOpponent le;
+    Environment* e = nullptr;
+    TPG::TPGGraph* tpg = nullptr;
+
+    /// Create a Program executing one line, which always returns 0.0.
+    std::shared_ptr<Program::Program> makeProgram()
+    {
+        auto prog = std::make_shared<Program::Program>(*e);
+        auto& line = prog->addNewLine();
+        // Add register 0 to itself in register 1
+        line.setInstructionIndex(1);
+        line.setOperand(0, 0, 0);
+        line.setOperand(1, 0, 0);
+        line.setDestinationIndex(1);
+        return prog;
+    }
+
+    virtual void SetUp()
+    {
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        e = new Environment(set, le.getDataSources(), 8);
+        tpg = new TPG::TPGGraph(*e);
+
+        // Create a TPG where all bids are equal, so the last evaluated edge
+        // of a team always wins.
+        // (T= Team, A= Action)
+        //
+        // T0---->T1
+        // | \     |
+        // v  v    v
+        // A0 A1   A2
+        const TPG::TPGVertex& t0 = tpg->addNewTeam();
+        const TPG::TPGVertex& t1 = tpg->addNewTeam();
+        const TPG::TPGVertex& a0 = tpg->addNewAction(0);
+        const TPG::TPGVertex& a1 = tpg->addNewAction(1);
+        const TPG::TPGVertex& a2 = tpg->addNewAction(2);
+        tpg->addNewEdge(t0, t1, makeProgram());
+        tpg->addNewEdge(t0, a0, makeProgram());
+        tpg->addNewEdge(t0, a1, makeProgram());
+        tpg->addNewEdge(t1, a2, makeProgram());
+    }
+
+    virtual void TearDown()
+    {
+        delete tpg;
+        delete e;
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+};
+
+TEST_F(PolicyPrunerTest, Constructor)
+{
+    ASSERT_NO_THROW(Learn::PolicyPruner pruner(le, 5, 10))
+        << "Construction of the PolicyPruner failed.";
+    ASSERT_NO_THROW(Learn::PolicyPruner pruner(le, 5, 10, 0.1))
+        << "Construction of the PolicyPruner failed.";
+    ASSERT_THROW(Learn::PolicyPruner pruner(le, 5, 10, -0.1),
+                 std::invalid_argument)
+        << "Construction should fail with a negative tolerance.";
+    ASSERT_THROW(Learn::PolicyPruner pruner(le, 5, 10, 1.5),
+                 std::invalid_argument)
+        << "Construction should fail with a tolerance above 1.0.";
+}
+
+TEST_F(PolicyPrunerTest, Prune)
+{
+    Learn::PolicyPruner pruner(le, 3, 10);
+    const TPG::TPGVertex* root = tpg->getRootVertices().at(0);
+
+    Learn::PolicyPruner::PruningResult result;
+    ASSERT_NO_THROW(result = pruner.prune(*tpg, *root))
+        << "Pruning the policy failed.";
+
+    // Only the last edge of T0 wins its bids.
+    ASSERT_EQ(result.nbVerticesBefore, 5);
+    ASSERT_EQ(result.nbEdgesBefore, 4);
+    ASSERT_EQ(result.nbProgramsBefore, 4);
+    ASSERT_EQ(result.nbVerticesAfter, 2);
+    ASSERT_EQ(result.nbEdgesAfter, 1);
+    ASSERT_EQ(result.nbProgramsAfter, 1);
+    ASSERT_EQ(tpg->getNbVertices(), 2)
+        << "Unreachable vertices should be removed from the TPGGraph.";
+    ASSERT_EQ(tpg->getEdges().size(), 1)
+        << "Edges never winning a bid should be removed from the TPGGraph.";
+    ASSERT_EQ(tpg->getEdges().front()->getSource(), root);
+
+    // Decisions are unchanged, but cheaper.
+    ASSERT_GT(result.nbDecisions, 0);
+    ASSERT_EQ(result.nbChangedDecisions, 0);
+    ASSERT_EQ(result.getDecisionChangeRatio(), 0.0);
+    ASSERT_EQ(result.avgEvaluatedTeamsBefore, 1.0);
+    ASSERT_EQ(result.avgEvaluatedTeamsAfter, 1.0);
+    ASSERT_EQ(result.avgEvaluatedProgramsBefore, 3.0);
+    ASSERT_EQ(result.avgEvaluatedProgramsAfter, 1.0);
+    ASSERT_EQ(result.avgExecutedLinesBefore, 3.0);
+    ASSERT_EQ(result.avgExecutedLinesAfter, 1.0);
+    ASSERT_DOUBLE_EQ(result.getInferenceCostReduction(), 2.0 / 3.0);
+}
+
+TEST_F(PolicyPrunerTest, PruneRootNotInGraph)
+{
+    Learn::PolicyPruner pruner(le, 3, 10);
+    TPG::TPGGraph otherGraph(*e);
+    const TPG::TPGVertex& otherRoot = otherGraph.addNewTeam();
+
+    ASSERT_THROW(pruner.prune(*tpg, otherRoot), std::runtime_error)
+        << "Pruning a root from another TPGGraph should fail.";
+}
+
+TEST_F(PolicyPrunerTest, PruneBestPolicy)
+{
+    Learn::LearningParameters params;
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 5;
+    params.ratioDeletedRoots = 0.2;
+    params.nbGenerations = 10;
+    params.mutation.tpg.nbRoots = 30;
+    params.mutation.tpg.maxInitOutgoingEdges = 3;
+    params.mutation.tpg.maxOutgoingEdges = 4;
+    params.mutation.tpg.pEdgeDeletion = 0.7;
+    params.mutation.tpg.pEdgeAddition = 0.7;
+    params.mutation.tpg.pProgramMutation = 0.2;
+    params.mutation.tpg.pEdgeDestinationChange = 0.1;
+    params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+    params.mutation.prog.maxProgramSize = 96;
+    params.mutation.prog.pAdd = 0.5;
+    params.mutation.prog.pDelete = 0.5;
+    params.mutation.prog.pMutate = 1.0;
+    params.mutation.prog.pSwap = 1.0;
+
+    // Train two identical agents
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+    bool alt = false;
+    la.train(alt, false);
+
+    StickGameWithOpponent le2;
+    Learn::LearningAgent la2(le2, set, params);
+    la2.init();
+    la2.train(alt, false);
+
+    // Exact pruning
+    Learn::PolicyPruner::PruningResult result;
+    ASSERT_NO_THROW(result = la.pruneBestPolicy())
+        << "Pruning the best policy failed.";
+    ASSERT_EQ(result.nbChangedDecisions, 0)
+        << "Pruning without tolerance should not change decisions.";
+    ASSERT_LE(result.nbEdgesAfter, result.nbEdgesBefore);
+    ASSERT_LE(result.avgExecutedLinesAfter, result.avgExecutedLinesBefore);
+    ASSERT_EQ(la.getTPGGraph()->getNbRootVertices(), 1);
+    ASSERT_EQ(la.getTPGGraph()->getNbVertices(), result.nbVerticesAfter);
+    ASSERT_EQ(la.getTPGGraph()->getEdges().size(), result.nbEdgesAfter);
+
+    // Pruning with a tolerance removes at least as many edges.
+    Learn::PolicyPruner::PruningResult tolerantResult;
+    ASSERT_NO_THROW(tolerantResult = la2.pruneBestPolicy(0.5))
+        << "Pruning the best policy with a tolerance failed.";
+    ASSERT_EQ(tolerantResult.nbEdgesBefore, result.nbEdgesBefore)
+        << "Both agents should have trained the same policy.";
+    ASSERT_LE(tolerantResult.nbEdgesAfter, result.nbEdgesAfter);
+    ASSERT_LE(tolerantResult.getDecisionChangeRatio(), 0.5);
+}
@@ -0,0 +1,310 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../lib/JsonCpp/json.h"
+
+#include "instructions/addPrimitiveType.h"
+#include "learn/learningParameters.h"
+#include "learn/parallelLearningAgent.h"
+#include "learn/stickGameWithOpponent.h"
+#include "util/profiler.h"
+
+class ProfilerTest : public ::testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        Util::Profiler::disable();
+        Util::Profiler::clear();
+    }
+
+    virtual void TearDown()
+    {
+        Util::Profiler::disable();
+        Util::Profiler::clear();
+    }
+
+    // Collect the names of all recorded spans.
+    std::multiset<std::string> getSpanNames()
+    {
+        std::multiset<std::string> names;
+        for (size_t lane = 0; lane < Util::Profiler::getNbLanes(); lane++) {
+            for (auto& event : Util::Profiler::getEvents(lane)) {
+                names.insert(event.name);
+            }
+        }
+        return names;
+    }
+};
+
+TEST_F(ProfilerTest, EnableDisable)
+{
+    ASSERT_FALSE(Util::Profiler::isEnabled())
+        << "Profiler should be disabled by default.";
+    {
+        Util::Profiler::Span span("disabled");
+    }
+    ASSERT_EQ(getSpanNames().count("disabled"), 0)
+        << "No span should be recorded when the profiler is disabled.";
+
+    Util::Profiler::enable();
+    ASSERT_TRUE(Util::Profiler::isEnabled());
+    {
+        Util::Profiler::Span span("enabled");
+    }
+    Util::Profiler::disable();
+    ASSERT_FALSE(Util::Profiler::isEnabled());
+    ASSERT_EQ(getSpanNames().count("enabled"), 1)
+        << "Span was not recorded when the profiler is enabled.";
+
+    Util::Profiler::clear();
+    ASSERT_EQ(getSpanNames().size(), 0)
+        << "Spans should be discarded by clear().";
+
+    ASSERT_THROW(Util::Profiler::getEvents(Util::Profiler::getNbLanes()),
+                 std::out_of_range);
+}
+
+TEST_F(ProfilerTest, NestedSpans)
+{
+    Util::Profiler::enable();
+    {
+        Util::Profiler::Span outer("outer", "test");
+        {
+            Util::Profiler::Span inner("inner", "test");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    Util::Profiler::disable();
+
+    // Find the lane of the main thread
+    const Util::Profiler::Event* outer = nullptr;
+    const Util::Profiler::Event* inner = nullptr;
+    std::vector<Util::Profiler::Event> events;
+    for (size_t lane = 0; lane < Util::Profiler::getNbLanes(); lane++) {
+        if (Util::Profiler::getEvents(lane).size() > 0) {
+            events = Util::Profiler::getEvents(lane);
+        }
+    }
+    ASSERT_EQ(events.size(), 2);
+    for (auto& event : events) {
+        if (std::string(event.name) == "outer") {
+            outer = &event;
+        }
+        else {
+            inner = &event;
+        }
+    }
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    ASSERT_STREQ(inner->category, "test");
+    ASSERT_EQ(outer->depth, 0);
+    ASSERT_EQ(inner->depth, 1);
+    ASSERT_LE(outer->start, inner->start);
+    ASSERT_GE(outer->start + outer->duration, inner->start + inner->duration)
+        << "Inner span should be contained in the outer one.";
+    ASSERT_GE(inner->duration, 2000000);
+
+    // Only the top-level span counts as busy time.
+    auto summary = Util::Profiler::getUtilizationSummary();
+    bool found = false;
+    for (auto& lane : summary) {
+        if (lane.timePerSpan.count("outer") != 0) {
+            found = true;
+            ASSERT_EQ(lane.busyTime, outer->duration);
+            ASSERT_EQ(lane.timePerSpan.at("inner"), inner->duration);
+            ASSERT_EQ(lane.nbSpans.at("inner"), 1);
+            ASSERT_GE(lane.profiledTime, lane.busyTime);
+            ASSERT_GT(lane.getUtilization(), 0.0);
+            ASSERT_LE(lane.getUtilization(), 1.0);
+        }
+    }
+    ASSERT_TRUE(found);
+
+    std::stringstream out;
+    ASSERT_NO_THROW(Util::Profiler::writeUtilizationSummary(out));
+    ASSERT_NE(out.str().find("inner"), std::string::npos);
+}
+
+TEST_F(ProfilerTest, LanesReuse)
+{
+    Util::Profiler::enable();
+    // Record spans in the main thread to give it a lane.
+    {
+        Util::Profiler::Span span("main");
+    }
+
+    // Threads executed one after the other share a single lane.
+    std::thread first([]() { Util::Profiler::Span span("worker"); });
+    first.join();
+    size_t nbLanes = Util::Profiler::getNbLanes();
+    for (auto i = 0; i < 3; i++) {
+        std::thread other([]() { Util::Profiler::Span span("worker"); });
+        other.join();
+    }
+    ASSERT_EQ(Util::Profiler::getNbLanes(), nbLanes)
+        << "Lanes of terminated threads should be reused.";
+
+    // Concurrent threads get distinct lanes.
+    std::thread t0([]() {
+        Util::Profiler::Span span("concurrent");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    std::thread t1([]() {
+        Util::Profiler::Span span("concurrent");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    t0.join();
+    t1.join();
+    Util::Profiler::disable();
+
+    ASSERT_GE(Util::Profiler::getNbLanes(), 2);
+    size_t nbLanesWithConcurrent = 0;
+    for (size_t lane = 0; lane < Util::Profiler::getNbLanes(); lane++) {
+        for (auto& event : Util::Profiler::getEvents(lane)) {
+            if (std::string(event.name) == "concurrent") {
+                nbLanesWithConcurrent++;
+                break;
+            }
+        }
+    }
+    ASSERT_EQ(nbLanesWithConcurrent, 2);
+    ASSERT_EQ(getSpanNames().count("worker"), 4);
+}
+
+TEST_F(ProfilerTest, ChromeTraceExport)
+{
+    Util::Profiler::enable();
+    {
+        Util::Profiler::Span outer("outer", "test");
+        Util::Profiler::Span inner("in\"ner", "test");
+    }
+    Util::Profiler::disable();
+
+    ASSERT_NO_THROW(Util::Profiler::writeChromeTrace("profilerTest.json"));
+    ASSERT_THROW(Util::Profiler::writeChromeTrace("XXX/profilerTest.json"),
+                 std::runtime_error);
+
+    std::ifstream file("profilerTest.json");
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    std::string errs;
+    ASSERT_TRUE(Json::parseFromStream(builder, file, &root, &errs))
+        << "Exported trace is not valid JSON: " << errs;
+
+    const Json::Value& events = root["traceEvents"];
+    ASSERT_TRUE(events.isArray());
+    size_t nbSpans = 0;
+    size_t nbMetadata = 0;
+    for (const Json::Value& event : events) {
+        if (event["ph"].asString() == "X") {
+            nbSpans++;
+            ASSERT_EQ(event["cat"].asString(), "test");
+            ASSERT_TRUE(event["ts"].isNumeric());
+            ASSERT_TRUE(event["dur"].isNumeric());
+            ASSERT_TRUE(event["tid"].isNumeric());
+        }
+        else if (event["ph"].asString() == "M") {
+            nbMetadata++;
+            ASSERT_EQ(event["name"].asString(), "thread_name");
+        }
+    }
+    ASSERT_EQ(nbSpans, 2);
+    ASSERT_EQ(nbMetadata, Util::Profiler::getNbLanes());
+}
+
+TEST_F(ProfilerTest, ParallelTraining)
+{
+    Instructions::Set set;
+    set.add(*(new Instructions::AddPrimitiveType<int>()));
+    set.add(*(new Instructions::AddPrimitiveType<double>()));
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 3;
+    params.ratioDeletedRoots = 0.2;
+    params.mutation.tpg.maxInitOutgoingEdges = 3;
+    params.mutation.tpg.nbRoots = 10;
+    params.mutation.tpg.pEdgeDeletion = 0.7;
+    params.mutation.tpg.pEdgeAddition = 0.7;
+    params.mutation.tpg.pProgramMutation = 0.2;
+    params.mutation.tpg.pEdgeDestinationChange = 0.1;
+    params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+    params.mutation.tpg.maxOutgoingEdges = 4;
+    params.mutation.tpg.forceProgramBehaviorChangeOnMutation = true;
+    params.mutation.prog.maxProgramSize = 96;
+    params.mutation.prog.pAdd = 0.5;
+    params.mutation.prog.pDelete = 0.5;
+    params.mutation.prog.pMutate = 1.0;
+    params.mutation.prog.pSwap = 1.0;
+    params.mutation.prog.pConstantMutation = 0.5;
+    params.mutation.prog.minConstValue = 0;
+    params.mutation.prog.maxConstValue = 1;
+    params.nbThreads = 4;
+
+    Learn::ParallelLearningAgent la(le, set, params);
+    la.init();
+
+    Util::Profiler::enable();
+    la.trainOneGeneration(0);
+    la.trainOneGeneration(1);
+    Util::Profiler::disable();
+
+    auto names = getSpanNames();
+    ASSERT_EQ(names.count("trainOneGeneration"), 2);
+    ASSERT_EQ(names.count("populateTPG"), 2);
+    ASSERT_EQ(names.count("evaluateAllRoots"), 2);
+    ASSERT_EQ(names.count("decimate"), 2);
+    ASSERT_EQ(names.count("mergeArchives"), 2);
+    ASSERT_GT(names.count("resetEnvironment"), 0);
+    ASSERT_EQ(names.count("resetEnvironment"), names.count("actionLoop"));
+    ASSERT_GT(names.count("waitJobQueue"), 0);
+    ASSERT_GT(names.count("evaluateJob"), 0);
+    ASSERT_EQ(names.count("evaluateJob"), names.count("createArchive"));
+    ASSERT_EQ(names.count("evaluateJob"), names.count("storeArchive"));
+    ASSERT_GT(names.count("mutateProgramBehavior"), 0);
+    ASSERT_GE(names.count("mutationAttempt"),
+              names.count("mutateProgramBehavior"));
+
+    delete (&set.getInstruction(0));
+    delete (&set.getInstruction(1));
+}
@@ -251,6 +251,11 @@ TEST_F(ProgramExecutionEngineTest, execute)
     // Instruction 4 does not exist. Must deactivate checks to write this
     // instruction
     l5.setInstructionIndex(4, false);
+    // Modified programs must be set again to be validated.
+    progExecEng.setProgram(*p);
+    ASSERT_FALSE(progExecEng.isProgramValidated())
+        << "Program line using a incorrect Instruction index should not be "
+           "validated.";
     ASSERT_THROW(progExecEng.executeProgram(), std::out_of_range)
         << "Program line using a incorrect Instruction index should throw an "
            "exception.";
@@ -262,3 +267,135 @@ TEST_F(ProgramExecutionEngineTest, execute)
     ASSERT_EQ(result, r0) << "Result of the program from Fixture, with an "
                              "additional ignored line, is not as expected.";
 }
+
+TEST_F(ProgramExecutionEngineTest, executeValidatedProgram)
+{
+    Program::ProgramExecutionEngine progExecEng(*p);
+    ASSERT_TRUE(progExecEng.isProgramValidated())
+        << "Program from fixture should be validated.";
+
+    double r6 = (value0 + value1 + value0 + value0) / 4;
+    double r1 = value0 + r6;
+    double r0 = r1 * ((int)value1);
+    r0 = r0 * value2 + r1 * value3;
+    ASSERT_EQ(progExecEng.executeProgram(), r0)
+        << "Result of the validated program from Fixture is not as expected.";
+
+    // Line with an operand from a non-existing data source.
+    Program::Line& l5 = p->addNewLine();
+    l5.setInstructionIndex(0);
+    l5.setDestinationIndex(1);
+    l5.setOperand(0, 5, 0, false);
+    progExecEng.setProgram(*p);
+    ASSERT_FALSE(progExecEng.isProgramValidated())
+        << "Program line using a non-existing data source should not be "
+           "validated.";
+    ASSERT_THROW(progExecEng.executeProgram(), std::out_of_range)
+        << "Unvalidated program should be executed with checks.";
+    ASSERT_EQ(progExecEng.executeProgram(true), r0)
+        << "Unvalidated program should be executed with checks.";
+
+    // Intron lines are not validated.
+    p->identifyIntrons();
+    progExecEng.setProgram(*p);
+    ASSERT_TRUE(progExecEng.isProgramValidated())
+        << "Invalid intron lines should not prevent validation.";
+    ASSERT_EQ(progExecEng.executeProgram(), r0);
+}
+
+TEST_F(ProgramExecutionEngineTest, validationCache)
+{
+    Program::ProgramExecutionEngine progExecEng(*p);
+    std::shared_ptr<const Program::ProgramValidation> validation =
+        p->getValidation();
+    ASSERT_NE(validation, nullptr)
+        << "Validation of the Program should be cached by setProgram.";
+
+    // Engines with the same characteristics reuse the validation.
+    Program::ProgramExecutionEngine otherEng(*p);
+    ASSERT_TRUE(otherEng.isProgramValidated());
+    ASSERT_EQ(p->getValidation(), validation)
+        << "Cached validation should be reused by setProgram.";
+
+    // Unmodified copies keep the validation.
+    Program::Program copy(*p);
+    ASSERT_EQ(copy.getValidation(), validation)
+        << "Copy of the Program should keep its validation.";
+
+    // Modifications clear the validation.
+    p->swapLines(1, 4);
+    ASSERT_EQ(p->getValidation(), nullptr)
+        << "Swapping lines should clear the validation.";
+    p->swapLines(1, 4);
+    progExecEng.setProgram(*p);
+    ASSERT_NE(p->getValidation(), validation)
+        << "Modified Program should be validated again.";
+    p->getLine(0);
+    ASSERT_EQ(p->getValidation(), nullptr)
+        << "Accessing a modifiable line should clear the validation.";
+    progExecEng.setProgram(*p);
+    p->identifyIntrons();
+    ASSERT_EQ(p->getValidation(), nullptr)
+        << "Identifying introns should clear the validation.";
+
+    double r6 = (value0 + value1 + value0 + value0) / 4;
+    double r1 = value0 + r6;
+    double r0 = r1 * ((int)value1);
+    r0 = r0 * value2 + r1 * value3;
+    progExecEng.setProgram(copy);
+    ASSERT_EQ(progExecEng.executeProgram(), r0)
+        << "Result of the copied program with a cached validation is not as "
+           "expected.";
+}
+
+TEST_F(ProgramExecutionEngineTest, inlineConstants)
+{
+    Program::ProgramExecutionEngine progExecEng(*p);
+    double r6 = (value0 + value1 + value0 + value0) / 4;
+    double r1 = value0 + r6;
+
+    // Constants are copied when setting the program.
+    p->getConstantHandler().setDataAt(typeid(Data::Constant), 1, {3});
+    progExecEng.setProgram(*p);
+    ASSERT_TRUE(progExecEng.isProgramValidated());
+    ASSERT_EQ(progExecEng.executeProgram(), r1 * 3 * value2 + r1 * value3)
+        << "Constants of the program were not updated by setProgram.";
+}
+
+TEST_F(ProgramExecutionEngineTest, heapRegistersAndConstants)
+{
+    // More registers and constants than the inline capacity.
+    Environment bigEnv(set, vect, 20, 20);
+    Program::Program prog(bigEnv);
+
+    Program::Line& l0 = prog.addNewLine();
+    l0.setInstructionIndex(0); // AddPrimitiveType<double>
+    l0.setOperand(0, 3, 25);
+    l0.setOperand(1, 3, 5);
+    l0.setDestinationIndex(17);
+
+    Program::Line& l1 = prog.addNewLine();
+    l1.setInstructionIndex(1); // MultByConstant<double>
+    l1.setOperand(0, 0, 17);
+    l1.setOperand(1, 1, 18);
+    prog.getConstantHandler().setDataAt(typeid(Data::Constant), 18, {3});
+    l1.setDestinationIndex(16);
+
+    Program::Line& l2 = prog.addNewLine();
+    l2.setInstructionIndex(2); // LambdaInstruction<double[2], double[2]>
+    l2.setOperand(0, 0, 16);
+    l2.setOperand(1, 3, 5);
+    l2.setDestinationIndex(0);
+
+    Program::ProgramExecutionEngine progExecEng(prog);
+    ASSERT_TRUE(progExecEng.isProgramValidated())
+        << "Program with heap registers and constants should be validated.";
+
+    double r17 = value0 + value2;
+    double r16 = r17 * 3;
+    double r0 = r16 * value2 + r17 * value3;
+    ASSERT_EQ(progExecEng.executeProgram(), r0)
+        << "Result of the program using heap registers is not as expected.";
+    ASSERT_EQ(progExecEng.executeProgram(), r0)
+        << "Registers are not reset between executions.";
+}
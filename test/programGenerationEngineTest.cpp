@@ -35,7 +35,9 @@
  */
 
 #ifdef CODE_GENERATION
+#include <fstream>
 #include <gtest/gtest.h>
+#include <sstream>
 
 #if defined(_MSC_VER) || (__MINGW32__)
 // C++17 not available in gcc7 or clang7
@@ -250,6 +252,30 @@ TEST_F(ProgramGenerationEngineTest, generateProgram)
         << "Fail to generate a program with constant";
 }
 
+TEST_F(ProgramGenerationEngineTest, generateProgramOptimized)
+{
+    p3->getConstantHandler().setDataAt(typeid(Data::Constant), 1, {42});
+    // Reg[0] = cst[1] + in1[1]; otherwise the line is an intron.
+    p3->getLine(0).setDestinationIndex(0);
+
+    CodeGen::GenerationParameters params;
+    params.optimize = true;
+    {
+        CodeGen::ProgramGenerationEngine engine("programOptimized", *p3, "./",
+                                                params);
+        ASSERT_NO_THROW(engine.generateProgram(3))
+            << "Fail to generate an optimized program with constant";
+    }
+
+    std::ifstream file("./programOptimized.c");
+    std::stringstream code;
+    code << file.rdbuf();
+    ASSERT_EQ(code.str().find("cst"), std::string::npos)
+        << "Constants of an optimized program should not be declared.";
+    ASSERT_NE(code.str().find(" = 42;"), std::string::npos)
+        << "Used constants of an optimized program should be inlined.";
+}
+
 TEST_F(ProgramGenerationEngineTest, initOperandCurrentLine)
 {
 
@@ -0,0 +1,177 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "data/constant.h"
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+#include "data/untypedSharedPtr.h"
+#include "environment.h"
+#include "instructions/inlineInstruction.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "instructions/staticSet.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/programMutator.h"
+#include "mutator/rng.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+#include "program/staticProgramExecutionEngine.h"
+
+static auto add = [](double a, double b) { return a + b; };
+static auto multByConst = [](double a, Data::Constant c) {
+    return a * (double)c;
+};
+static auto dot = [](const double a[2], const double b[2]) {
+    return a[0] * b[0] + a[1] * b[1];
+};
+static auto mean2D = [](const double a[2][2]) {
+    return (a[0][0] + a[0][1] + a[1][0] + a[1][1]) / 4.0;
+};
+static auto intSub = [](int a, double b) { return (double)a - b; };
+
+class StaticProgramExecutionEngineTest : public ::testing::Test
+{
+  protected:
+    Instructions::StaticSet<
+        Instructions::InlineInstruction<decltype(add), double, double>,
+        Instructions::InlineInstruction<decltype(multByConst), double,
+                                        Data::Constant>,
+        Instructions::InlineInstruction<decltype(dot), const double[2],
+                                        const double[2]>,
+        Instructions::InlineInstruction<decltype(mean2D), const double[2][2]>,
+        Instructions::InlineInstruction<decltype(intSub), int, double>>
+        set{Instructions::makeInlineInstruction<double, double>(add),
+            Instructions::makeInlineInstruction<double, Data::Constant>(
+                multByConst),
+            Instructions::makeInlineInstruction<const double[2],
+                                                const double[2]>(dot),
+            Instructions::makeInlineInstruction<const double[2][2]>(mean2D),
+            Instructions::makeInlineInstruction<int, double>(intSub)};
+
+    Data::PrimitiveTypeArray<double> doubles{24};
+    Data::PrimitiveTypeArray2D<double> image{5, 4};
+    Data::PrimitiveTypeArray<int> ints{8};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> data;
+    Environment* e = nullptr;
+
+    virtual void SetUp()
+    {
+        for (size_t i = 0; i < 24; i++) {
+            doubles.setDataAt(typeid(double), i, std::cos(0.7 * i) * 3.0);
+        }
+        for (size_t i = 0; i < 20; i++) {
+            image.setDataAt(typeid(double), i, 0.25 * i - 2.0);
+        }
+        for (size_t i = 0; i < 8; i++) {
+            ints.setDataAt(typeid(int), i, (int)(3 * i) - 10);
+        }
+        data.push_back(doubles);
+        data.push_back(image);
+        data.push_back(ints);
+
+        e = new Environment(set, data, 8, 5);
+    }
+
+    virtual void TearDown()
+    {
+        delete e;
+    }
+};
+
+TEST_F(StaticProgramExecutionEngineTest, StaticSet)
+{
+    ASSERT_EQ(set.getNbInstructions(), 5)
+        << "All InlineInstruction should be added to the Set.";
+    ASSERT_EQ(set.getNbStaticInstructions(), 5);
+    ASSERT_EQ(set.getStaticIndex(set.getInstruction(3)), 3);
+
+    Instructions::LambdaInstruction<double, double> other(add);
+    ASSERT_EQ(set.getStaticIndex(other), 5)
+        << "Instruction not owned by the StaticSet should not be found.";
+
+    // InlineInstruction can still be executed dynamically.
+    double a = 2.5;
+    double b = 4.0;
+    std::vector<Data::UntypedSharedPtr> args;
+    args.emplace_back(&a, Data::UntypedSharedPtr::emptyDestructor<double>());
+    args.emplace_back(&b, Data::UntypedSharedPtr::emptyDestructor<double>());
+    ASSERT_EQ(set.getInstruction(0).execute(args), 6.5);
+}
+
+TEST_F(StaticProgramExecutionEngineTest, Constructor)
+{
+    ASSERT_NO_THROW(
+        Program::StaticProgramExecutionEngine engine(set, *e));
+
+    // Environment built with other instructions.
+    Instructions::Set otherSet;
+    Instructions::LambdaInstruction<double, double> other(add);
+    otherSet.add(set.getInstruction(0));
+    otherSet.add(other);
+    Environment otherEnv(otherSet, data, 8, 5);
+    ASSERT_THROW(Program::StaticProgramExecutionEngine engine(set, otherEnv),
+                 std::invalid_argument)
+        << "Instructions of the Environment must be part of the StaticSet.";
+}
+
+TEST_F(StaticProgramExecutionEngineTest, SameResults)
+{
+    Mutator::RNG rng;
+    rng.setSeed(0);
+    Mutator::MutationParameters params;
+    params.prog.maxProgramSize = 40;
+    params.prog.minConstValue = -5;
+    params.prog.maxConstValue = 5;
+
+    Program::ProgramExecutionEngine dynamicEngine(*e);
+    Program::StaticProgramExecutionEngine staticEngine(set, *e);
+    for (size_t i = 0; i < 50; i++) {
+        Program::Program p(*e);
+        Mutator::ProgramMutator::initRandomProgram(p, params, rng);
+
+        dynamicEngine.setProgram(p);
+        staticEngine.setProgram(p);
+        ASSERT_EQ(staticEngine.executeProgram(), dynamicEngine.executeProgram())
+            << "Static and dynamic execution of Program " << i << " differ.";
+
+        // Data updated between two executions.
+        doubles.setDataAt(typeid(double), i % 24, 0.5 * i);
+        ASSERT_EQ(staticEngine.executeProgram(), dynamicEngine.executeProgram())
+            << "Static execution should use the updated data.";
+    }
+}
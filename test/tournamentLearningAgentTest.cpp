@@ -0,0 +1,329 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+
+#include "instructions/addPrimitiveType.h"
+#include "tpg/tpgGraph.h"
+
+#include "learn/adversarialJob.h"
+#include "learn/learningParameters.h"
+#include "learn/stickGameAdversarial.h"
+#include "learn/tournamentLearningAgent.h"
+
+class TournamentLearningAgentTest : public ::testing::Test
+{
+  protected:
+    Instructions::Set set;
+    StickGameAdversarial le;
+    Learn::LearningParameters params;
+
+    virtual void SetUp()
+    {
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+
+        params.archiveSize = 50;
+        params.archivingProbability = 0.1;
+        params.maxNbActionsPerEval = 11;
+        params.ratioDeletedRoots = 0.5;
+        params.mutation.tpg.maxInitOutgoingEdges = 3;
+        params.mutation.prog.maxProgramSize = 96;
+        params.mutation.tpg.nbRoots = 15;
+        params.mutation.tpg.pEdgeDeletion = 0.7;
+        params.mutation.tpg.pEdgeAddition = 0.7;
+        params.mutation.tpg.pProgramMutation = 0.2;
+        params.mutation.tpg.pEdgeDestinationChange = 0.1;
+        params.mutation.tpg.pEdgeDestinationIsAction = 0.5;
+        params.mutation.tpg.maxOutgoingEdges = 4;
+        params.mutation.prog.pAdd = 0.5;
+        params.mutation.prog.pDelete = 0.5;
+        params.mutation.prog.pMutate = 1.0;
+        params.mutation.prog.pSwap = 1.0;
+    }
+
+    virtual void TearDown()
+    {
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+};
+
+TEST_F(TournamentLearningAgentTest, Constructor)
+{
+    Learn::TournamentLearningAgent* la;
+
+    ASSERT_NO_THROW(la = new Learn::TournamentLearningAgent(le, set, params))
+        << "Construction of the TournamentLearningAgent failed.";
+
+    ASSERT_NO_THROW(delete la)
+        << "Destruction of the TournamentLearningAgent failed.";
+}
+
+TEST_F(TournamentLearningAgentTest, MakeJobs)
+{
+    params.nbIterationsPerPolicyEvaluation = 20;
+    params.nbIterationsPerJob = 6;
+    size_t agentsPerEval = 4;
+    Learn::TournamentLearningAgent la(le, set, params, agentsPerEval);
+    la.init();
+
+    // 20 evaluations per root, 6 per job => 4 rounds
+    ASSERT_EQ(la.getNbRounds(), 4) << "Wrong number of rounds.";
+
+    // Get 8 roots, i.e. 2 groups per round.
+    while (la.getTPGGraph()->getNbRootVertices() < 8) {
+        la.getTPGGraph()->addNewTeam();
+    }
+
+    std::queue<std::shared_ptr<Learn::Job>> jobs;
+    ASSERT_NO_THROW(jobs = la.makeJobs(Learn::LearningMode::TRAINING))
+        << "makeJobs shouldn't throw an exception in TournamentLearningAgent.";
+    ASSERT_EQ(jobs.size(), 8) << "There should be 2 jobs per round.";
+
+    std::map<const TPG::TPGVertex*, size_t> nbMatchesPerRoot;
+    uint64_t idx = 0;
+    while (!jobs.empty()) {
+        auto job =
+            std::dynamic_pointer_cast<Learn::AdversarialJob>(jobs.front());
+        ASSERT_EQ(job->getSize(), agentsPerEval)
+            << "Job doesn't contain the right number of roots.";
+        ASSERT_EQ(job->getPosOfStudiedRoot(), -1)
+            << "All roots of a tournament match should be scored.";
+        ASSERT_EQ(job->getIdx(), idx++) << "Jobs are not indexed in order.";
+        for (auto root : job->getRoots()) {
+            nbMatchesPerRoot[root]++;
+        }
+        jobs.pop();
+    }
+
+    ASSERT_EQ(nbMatchesPerRoot.size(), 8) << "Some roots are never evaluated.";
+    for (auto& pair : nbMatchesPerRoot) {
+        ASSERT_EQ(pair.second, 4)
+            << "Each root should play exactly once per round.";
+    }
+}
+
+TEST_F(TournamentLearningAgentTest, MakeJobsRoundRobin)
+{
+    // With 2 agents per evaluation and an even number of roots, every pair
+    // of roots meets exactly once in nbRoots - 1 rounds.
+    params.nbIterationsPerPolicyEvaluation = 5;
+    params.nbIterationsPerJob = 1;
+    Learn::TournamentLearningAgent la(le, set, params);
+    la.init();
+    while (la.getTPGGraph()->getNbRootVertices() < 6) {
+        la.getTPGGraph()->addNewTeam();
+    }
+
+    auto jobs = la.makeJobs(Learn::LearningMode::TRAINING);
+    ASSERT_EQ(jobs.size(), 15) << "There should be 3 jobs for each 5 rounds.";
+
+    std::set<std::set<const TPG::TPGVertex*>> pairs;
+    while (!jobs.empty()) {
+        auto job =
+            std::dynamic_pointer_cast<Learn::AdversarialJob>(jobs.front());
+        auto roots = job->getRoots();
+        pairs.insert({roots.begin(), roots.end()});
+        jobs.pop();
+    }
+
+    ASSERT_EQ(pairs.size(), 15) << "Each pair of roots should meet once.";
+    for (auto& pair : pairs) {
+        ASSERT_EQ(pair.size(), 2) << "A root should not face itself.";
+    }
+}
+
+TEST_F(TournamentLearningAgentTest, MakeJobsPadding)
+{
+    // 5 roots and 2 agents per evaluation: one bye per round, taken by a
+    // filler root whose score is ignored.
+    params.nbIterationsPerPolicyEvaluation = 4;
+    params.nbIterationsPerJob = 1;
+    Learn::TournamentLearningAgent la(le, set, params);
+    la.init();
+    while (la.getTPGGraph()->getNbRootVertices() < 5) {
+        la.getTPGGraph()->addNewTeam();
+    }
+
+    auto jobs = la.makeJobs(Learn::LearningMode::TRAINING);
+    ASSERT_EQ(jobs.size(), 12) << "There should be 3 jobs for each 4 rounds.";
+
+    std::map<const TPG::TPGVertex*, size_t> nbMatchesPerRoot;
+    size_t nbFillers = 0;
+    while (!jobs.empty()) {
+        auto job =
+            std::dynamic_pointer_cast<Learn::AdversarialJob>(jobs.front());
+        auto roots = job->getRoots();
+        ASSERT_EQ(job->getSize(), 2)
+            << "Job doesn't contain the right number of roots.";
+        ASSERT_EQ(std::set<const TPG::TPGVertex*>(roots.begin(), roots.end())
+                      .size(),
+                  roots.size())
+            << "A root should not face itself.";
+        for (size_t i = 0; i < job->getSize(); i++) {
+            if (job->isFillerRoot(i)) {
+                nbFillers++;
+            }
+            else {
+                nbMatchesPerRoot[roots[i]]++;
+            }
+        }
+        jobs.pop();
+    }
+    ASSERT_EQ(nbFillers, 4) << "There should be one bye per round.";
+    ASSERT_EQ(nbMatchesPerRoot.size(), 5) << "Some roots are never scored.";
+    for (auto& pair : nbMatchesPerRoot) {
+        ASSERT_EQ(pair.second, 4)
+            << "Each root should be scored exactly once per round.";
+    }
+}
+
+TEST_F(TournamentLearningAgentTest, MakeJobBlocks)
+{
+    params.nbIterationsPerPolicyEvaluation = 20;
+    params.nbIterationsPerJob = 2;
+    Learn::TournamentLearningAgent la(le, set, params);
+    la.init();
+    while (la.getTPGGraph()->getNbRootVertices() < 12) {
+        la.getTPGGraph()->addNewTeam();
+    }
+    auto roots = la.getTPGGraph()->getRootVertices();
+
+    auto jobsQueue = la.makeJobs(Learn::LearningMode::TRAINING);
+    std::vector<std::shared_ptr<Learn::Job>> jobs;
+    while (!jobsQueue.empty()) {
+        jobs.push_back(jobsQueue.front());
+        jobsQueue.pop();
+    }
+
+    std::vector<size_t> order;
+    std::vector<size_t> blocks;
+    ASSERT_NO_THROW(blocks = la.makeJobBlocks(jobs, 4, order));
+    ASSERT_EQ(order.size(), jobs.size());
+    ASSERT_EQ(std::set<size_t>(order.begin(), order.end()).size(),
+              jobs.size())
+        << "Each job should appear exactly once in the blocks.";
+    ASSERT_GE(blocks.size(), 3) << "Jobs should be split in several blocks.";
+    ASSERT_EQ(blocks.front(), 0);
+    ASSERT_EQ(blocks.back(), jobs.size());
+
+    // The home root of a job is its first root in the list of roots.
+    auto home = [&roots](const std::shared_ptr<Learn::Job>& job) {
+        size_t pos = roots.size();
+        for (auto root :
+             std::dynamic_pointer_cast<Learn::AdversarialJob>(job)
+                 ->getRoots()) {
+            pos = std::min(pos, (size_t)(std::find(roots.begin(), roots.end(),
+                                                   root) -
+                                          roots.begin()));
+        }
+        return pos;
+    };
+    std::map<size_t, size_t> blockPerHome;
+    for (size_t b = 0; b + 1 < blocks.size(); b++) {
+        ASSERT_LT(blocks[b], blocks[b + 1]) << "Blocks should not be empty.";
+        for (size_t k = blocks[b]; k < blocks[b + 1]; k++) {
+            size_t h = home(jobs[order[k]]);
+            auto inserted = blockPerHome.emplace(h, b);
+            ASSERT_EQ(inserted.first->second, b)
+                << "Jobs of a home root should not be split between blocks.";
+        }
+    }
+}
+
+TEST_F(TournamentLearningAgentTest, EvalAllRootsParallelDeterminism)
+{
+    params.nbIterationsPerPolicyEvaluation = 10;
+    params.nbIterationsPerJob = 2;
+
+    Learn::LearningParameters paramsSequential = params;
+    paramsSequential.nbThreads = 1;
+    Learn::TournamentLearningAgent laSequential(le, set, paramsSequential);
+    laSequential.init(0);
+
+    Learn::LearningParameters paramsParallel = params;
+    paramsParallel.nbThreads = 4;
+    Learn::TournamentLearningAgent laParallel(le, set, paramsParallel);
+    laParallel.init(0);
+
+    // Train a few generations to get a meaningful population.
+    for (auto i = 0; i < 3; i++) {
+        laSequential.trainOneGeneration(i);
+        laParallel.trainOneGeneration(i);
+    }
+
+    auto resultsSequential =
+        laSequential.evaluateAllRoots(3, Learn::LearningMode::TRAINING);
+    auto resultsParallel =
+        laParallel.evaluateAllRoots(3, Learn::LearningMode::TRAINING);
+
+    ASSERT_EQ(resultsSequential.size(),
+              laSequential.getTPGGraph()->getNbRootVertices())
+        << "All roots should be evaluated.";
+    ASSERT_EQ(resultsSequential.size(), resultsParallel.size())
+        << "Result maps have a different size.";
+    auto iterSequential = resultsSequential.begin();
+    auto iterParallel = resultsParallel.begin();
+    while (iterSequential != resultsSequential.end()) {
+        ASSERT_EQ(iterSequential->first->getResult(),
+                  iterParallel->first->getResult())
+            << "Scores of sequential and parallel executions are different.";
+        ASSERT_EQ(iterSequential->first->getNbEvaluation(),
+                  iterParallel->first->getNbEvaluation())
+            << "Number of evaluations of sequential and parallel executions "
+               "are different.";
+        iterSequential++;
+        iterParallel++;
+    }
+
+    // Check determinism of the number of RNG calls.
+    ASSERT_EQ(laSequential.getRNG().getUnsignedInt64(0, UINT64_MAX),
+              laParallel.getRNG().getUnsignedInt64(0, UINT64_MAX))
+        << "Mutator::RNG was called a different number of time in parallel "
+           "and sequential execution.";
+
+    // Check archives
+    ASSERT_GT(laParallel.getArchive().getNbRecordings(), 0);
+    ASSERT_EQ(laParallel.getArchive().getNbRecordings(),
+              laSequential.getArchive().getNbRecordings())
+        << "Archives have different sizes.";
+    for (auto i = 0; i < laParallel.getArchive().getNbRecordings(); i++) {
+        ASSERT_EQ(laParallel.getArchive().at(i).dataHash,
+                  laSequential.getArchive().at(i).dataHash)
+            << "Archives have different content.";
+    }
+}
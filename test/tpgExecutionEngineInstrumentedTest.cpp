@@ -289,3 +289,119 @@ TEST_F(TPGExecutionEngineInstrumentedTest, TraceHistoryAccessors)
     ASSERT_EQ(tpeei.getTraceHistory().size(), 0)
         << "Trace history isn't empty after clear.";
 }
+
+TEST_F(TPGExecutionEngineInstrumentedTest, TraceRecordingModes)
+{
+    TPG::TPGExecutionEngineInstrumented tpeei(*e);
+    const TPG::TPGVertex& root = *tpg->getRootVertices().at(0);
+    const std::vector<const TPG::TPGVertex*> trace =
+        tpeei.executeFromRoot(root);
+    tpeei.clearTraceHistory();
+
+    ASSERT_THROW(
+        tpeei.setTraceRecording(
+            TPG::TPGExecutionEngineInstrumented::RING_BUFFER, 0),
+        std::invalid_argument)
+        << "Ring buffer without capacity should not be accepted.";
+
+    // No recording
+    tpeei.setTraceRecording(TPG::TPGExecutionEngineInstrumented::NONE);
+    for (auto i = 0; i < 5; i++) {
+        tpeei.executeFromRoot(root);
+    }
+    ASSERT_EQ(tpeei.getNbInferences(), 5) << "Wrong number of inferences.";
+    ASSERT_EQ(tpeei.getNbRecordedTraces(), 0)
+        << "No trace should be recorded.";
+
+    // Every third inference
+    tpeei.setTraceRecording(TPG::TPGExecutionEngineInstrumented::EVERY_NTH,
+                            3);
+    ASSERT_EQ(tpeei.getNbInferences(), 0)
+        << "Changing the recording mode should clear the history.";
+    for (auto i = 0; i < 7; i++) {
+        tpeei.executeFromRoot(root);
+    }
+    ASSERT_EQ(tpeei.getNbRecordedTraces(), 3)
+        << "Wrong number of recorded traces.";
+
+    // Ring buffer keeps the last traces.
+    tpeei.setTraceRecording(TPG::TPGExecutionEngineInstrumented::RING_BUFFER,
+                            4);
+    for (auto i = 0; i < 100; i++) {
+        tpeei.executeFromRoot(root);
+    }
+    ASSERT_EQ(tpeei.getNbInferences(), 100) << "Wrong number of inferences.";
+    ASSERT_EQ(tpeei.getNbRecordedTraces(), 4)
+        << "Ring buffer should keep a bounded number of traces.";
+    ASSERT_EQ(tpeei.getTraceHistory().size(), 4)
+        << "Ring buffer should keep a bounded number of traces.";
+    ASSERT_EQ(tpeei.getTrace(3), trace)
+        << "Recorded trace is different from result trace.";
+    ASSERT_THROW(tpeei.getTrace(4), std::out_of_range)
+        << "Access to a trace out of range should fail.";
+
+    // Reservoir sampling
+    tpeei.setTraceRecording(TPG::TPGExecutionEngineInstrumented::RESERVOIR, 5,
+                            42);
+    ASSERT_EQ(tpeei.getTraceRecordingMode(),
+              TPG::TPGExecutionEngineInstrumented::RESERVOIR)
+        << "Recording mode was not updated.";
+    for (auto i = 0; i < 100; i++) {
+        tpeei.executeFromRoot(root);
+    }
+    ASSERT_EQ(tpeei.getNbRecordedTraces(), 5)
+        << "Reservoir should keep a bounded number of traces.";
+    for (uint64_t i = 0; i < tpeei.getNbRecordedTraces(); i++) {
+        ASSERT_EQ(tpeei.getTrace(i), trace)
+            << "Recorded trace is different from result trace.";
+    }
+}
+
+TEST_F(TPGExecutionEngineInstrumentedTest, CounterBuffering)
+{
+    TPG::TPGExecutionEngineInstrumented tpeei(*e);
+    const TPG::TPGVertex& root = *tpg->getRootVertices().at(0);
+    auto rootTeam = dynamic_cast<const TPG::TPGTeamInstrumented*>(&root);
+    auto action = dynamic_cast<const TPG::TPGActionInstrumented*>(
+        tpg->getVertices().at(6));
+    auto edge = dynamic_cast<const TPG::TPGEdgeInstrumented*>(edges.at(5));
+
+    // Reference counters without buffering
+    tpeei.executeFromRoot(root);
+    uint64_t nbEdgeVisits = edge->getNbVisits();
+    uint64_t nbEdgeTraversals = edge->getNbTraversal();
+    TPG::TPGInstrumentedFactory().resetTPGGraphCounters(*tpg);
+
+    tpeei.setCounterBuffering(true);
+    tpeei.executeFromRoot(root);
+    tpeei.executeFromRoot(root);
+    ASSERT_EQ(rootTeam->getNbVisits(), 0)
+        << "Buffered counters should not be merged before a flush.";
+    ASSERT_EQ(action->getNbVisits(), 0)
+        << "Buffered counters should not be merged before a flush.";
+
+    ASSERT_NO_THROW(tpeei.flushCounters()) << "Flushing counters failed.";
+    ASSERT_EQ(rootTeam->getNbVisits(), 2) << "Flushed counter is incorrect.";
+    ASSERT_EQ(action->getNbVisits(), 2) << "Flushed counter is incorrect.";
+    ASSERT_EQ(edge->getNbVisits(), 2 * nbEdgeVisits)
+        << "Flushed counter is incorrect.";
+    ASSERT_EQ(edge->getNbTraversal(), 2 * nbEdgeTraversals)
+        << "Flushed counter is incorrect.";
+
+    // Disabling the buffering flushes remaining counters.
+    tpeei.executeFromRoot(root);
+    tpeei.setCounterBuffering(false);
+    ASSERT_EQ(rootTeam->getNbVisits(), 3) << "Flushed counter is incorrect.";
+    tpeei.executeFromRoot(root);
+    ASSERT_EQ(rootTeam->getNbVisits(), 4)
+        << "Counters should be updated directly without buffering.";
+
+    // Destroying the engine flushes remaining counters.
+    {
+        TPG::TPGExecutionEngineInstrumented other(*e);
+        other.setCounterBuffering(true);
+        other.executeFromRoot(root);
+    }
+    ASSERT_EQ(rootTeam->getNbVisits(), 5)
+        << "Buffered counters were lost when destroying the engine.";
+}
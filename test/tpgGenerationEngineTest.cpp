@@ -38,8 +38,10 @@
 
 #ifdef CODE_GENERATION
 #include <cstddef>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <sstream>
 
 #if defined(_MSC_VER) || (__MINGW32__)
 // C++17 not available in gcc7 or clang7
@@ -761,4 +763,253 @@ TEST_BOTH_MODE(ThreeTeamsThreeLeaves, {
         << "Error wrong action returned in test "
            "ThreeTeamsThreeLeaves.";
 });
+
+TEST_BOTH_MODE(TwoTeamsReentrant, {
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+
+    // Same graph as in TwoTeams.
+    const std::shared_ptr<Program::Program> prog1(new Program::Program(*e));
+    Program::Line& prog1L1 = prog1->addNewLine();
+    // reg[0] = ctx->in1[0] + ctx->in1[1];
+    prog1L1.setDestinationIndex(0);
+    prog1L1.setInstructionIndex(0);
+    prog1L1.setOperand(0, 1, 0);
+    prog1L1.setOperand(1, 1, 1);
+
+    const std::shared_ptr<Program::Program> prog2(new Program::Program(*e));
+    Program::Line& prog2L1 = prog2->addNewLine();
+    // reg[0] = ctx->in1[1] + ctx->in1[2];
+    prog2L1.setDestinationIndex(0);
+    prog2L1.setInstructionIndex(0);
+    prog2L1.setOperand(0, 1, 1);
+    prog2L1.setOperand(1, 1, 2);
+
+    const std::shared_ptr<Program::Program> prog3(new Program::Program(*e));
+    Program::Line& prog3L1 = prog3->addNewLine();
+    // reg[0] = ctx->in1[1] + ctx->in1[3];
+    prog3L1.setDestinationIndex(0);
+    prog3L1.setInstructionIndex(0);
+    prog3L1.setOperand(0, 1, 1);
+    prog3L1.setOperand(1, 1, 3);
+
+    const std::shared_ptr<Program::Program> prog4(new Program::Program(*e));
+    Program::Line& prog4L1 = prog4->addNewLine();
+    // reg[0] = ctx->in1[1] + ctx->in1[4];
+    prog4L1.setDestinationIndex(0);
+    prog4L1.setInstructionIndex(0);
+    prog4L1.setOperand(0, 1, 1);
+    prog4L1.setOperand(1, 1, 4);
+
+    tpg->addNewEdge(*root, *T1, prog1);
+    tpg->addNewEdge(*T1, *leaf, prog2);
+    tpg->addNewEdge(*T1, *T2, prog3);
+    tpg->addNewEdge(*T2, *leaf2, prog4);
+
+    CodeGen::GenerationParameters params;
+    params.reentrant = true;
+    tpgGen = factory.create("TwoTeamsReentrant", *tpg, "./src/", params);
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    // The main of this test declares no global variable for the data: the
+    // link fails if the generated code still refers to one.
+    cmdCompile += "TwoTeamsReentrant";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test TwoTeamsReentrant.";
+
+    cmdExec += "TwoTeamsReentrant" + executableExtension;
+
+    ASSERT_EQ(system((cmdExec + path +
+                      "/TwoTeamsReentrant/DataTwoTeamsReentrant.csv")
+                         .c_str()),
+              0)
+        << "Error wrong action returned in test TwoTeamsReentrant.";
+});
+TEST_BOTH_MODE(ThreeTeamsThreeLeavesBatch, {
+    // Same graph as in ThreeTeamsThreeLeaves.
+    const TPG::TPGVertex* A1 = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* A2 = (&tpg->addNewAction(2));
+    const TPG::TPGVertex* A0 = (&tpg->addNewAction(0));
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T3 = (&tpg->addNewTeam());
+
+    std::vector<std::shared_ptr<Program::Program>> progs;
+    for (int i = 0; i < 6; i++) {
+        progs.emplace_back(new Program::Program(*e));
+        // reg[0] = in1[i] + reg[1] (reg[1] = 0)
+        setProgLine(progs.back(), i);
+    }
+
+    tpg->addNewEdge(*T1, *T2, progs.at(0));
+    tpg->addNewEdge(*T1, *A1, progs.at(1));
+    tpg->addNewEdge(*T1, *T3, progs.at(2));
+
+    tpg->addNewEdge(*T2, *A0, progs.at(3));
+    tpg->addNewEdge(*T2, *T3, progs.at(4));
+
+    tpg->addNewEdge(*T3, *A2, progs.at(5));
+
+    // Batches smaller than the 7 observations of the data.
+    CodeGen::GenerationParameters params;
+    params.reentrant = true;
+    params.batchSize = 3;
+    tpgGen =
+        factory.create("ThreeTeamsThreeLeavesBatch", *tpg, "./src/", params);
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    cmdCompile += "ThreeTeamsThreeLeavesBatch";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test ThreeTeamsThreeLeavesBatch.";
+
+    cmdExec += "ThreeTeamsThreeLeavesBatch" + executableExtension;
+
+    ASSERT_EQ(system((cmdExec + path +
+                      "/ThreeTeamsThreeLeavesBatch/"
+                      "DataThreeTeamsThreeLeavesBatch.csv")
+                         .c_str()),
+              0)
+        << "Error wrong action returned in test ThreeTeamsThreeLeavesBatch.";
+});
+
+TEST_BOTH_MODE(TwoTeamsOptimized, {
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* A0 = (&tpg->addNewAction(0));
+    const TPG::TPGVertex* A1 = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* A2 = (&tpg->addNewAction(2));
+    // Team and action unreachable from the exported root.
+    const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* A3 = (&tpg->addNewAction(3));
+
+    std::vector<std::shared_ptr<Program::Program>> progs;
+    for (int i = 0; i < 4; i++) {
+        progs.emplace_back(new Program::Program(*e));
+    }
+    // reg[5] = in1[4] + reg[1] is an intron of prog2.
+    Program::Line& intron = progs.at(2)->addNewLine();
+    intron.setDestinationIndex(5);
+    intron.setInstructionIndex(0);
+    intron.setOperand(0, 1, 4);
+    intron.setOperand(1, 0, 1);
+    for (int i = 0; i < 4; i++) {
+        // reg[0] = in1[i] + reg[1] (reg[1] = 0)
+        setProgLine(progs.at(i), i);
+    }
+
+    tpg->addNewEdge(*root, *T1, progs.at(0));
+    // prog1 is shared by the root and T1.
+    tpg->addNewEdge(*root, *A0, progs.at(1));
+    tpg->addNewEdge(*T1, *A1, progs.at(1));
+    tpg->addNewEdge(*T1, *A2, progs.at(2));
+    tpg->addNewEdge(*T2, *A3, progs.at(3));
+
+    CodeGen::GenerationParameters params;
+    params.optimize = true;
+    tpgGen = factory.create("TwoTeamsOptimized", *tpg, "./src/", params);
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    // Neither prog3 nor the intron of prog2 are generated.
+    std::ifstream programFile("./src/TwoTeamsOptimized_program.c");
+    std::stringstream programCode;
+    programCode << programFile.rdbuf();
+    ASSERT_EQ(programCode.str().find("P3("), std::string::npos)
+        << "Program of an unreachable team should not be generated.";
+    ASSERT_EQ(programCode.str().find("reg[5] ="), std::string::npos)
+        << "Intron lines should not be generated.";
+
+    cmdCompile += "TwoTeamsOptimized";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test TwoTeamsOptimized.";
+
+    cmdExec += "TwoTeamsOptimized" + executableExtension;
+
+    ASSERT_EQ(system((cmdExec + path +
+                      "/TwoTeamsOptimized/DataTwoTeamsOptimized.csv")
+                         .c_str()),
+              0)
+        << "Error wrong action returned in test TwoTeamsOptimized.";
+});
+
+TEST_F(TPGGenerationEngineTest, BatchRequiresReentrant)
+{
+    CodeGen::GenerationParameters params;
+    params.batchSize = 4;
+    ASSERT_THROW(CodeGen::TPGSwitchGenerationEngine("BatchNotReentrant", *tpg,
+                                                    "./src/", params),
+                 std::invalid_argument)
+        << "Batch generation should require the reentrant mode.";
+}
+
+TEST_BOTH_MODE(TwoRoots, {
+    const TPG::TPGVertex* R0 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* R1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T = (&tpg->addNewTeam());
+    const TPG::TPGVertex* A0 = (&tpg->addNewAction(0));
+    const TPG::TPGVertex* A1 = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* A2 = (&tpg->addNewAction(2));
+
+    std::vector<std::shared_ptr<Program::Program>> progs;
+    for (int i = 0; i < 6; i++) {
+        progs.emplace_back(new Program::Program(*e));
+        // reg[0] = in1[i] + reg[1] (reg[1] = 0)
+        setProgLine(progs.back(), i);
+    }
+
+    // Both roots share the team T.
+    tpg->addNewEdge(*R0, *T, progs.at(0));
+    tpg->addNewEdge(*R0, *A0, progs.at(1));
+    tpg->addNewEdge(*R1, *T, progs.at(2));
+    tpg->addNewEdge(*R1, *A1, progs.at(3));
+    tpg->addNewEdge(*T, *A2, progs.at(4));
+    tpg->addNewEdge(*T, *A0, progs.at(5));
+
+    // rootId 0 executes R1, rootId 1 executes R0.
+    CodeGen::GenerationParameters params;
+    params.roots.push_back(1);
+    params.roots.push_back(0);
+    tpgGen = factory.create("TwoRoots", *tpg, "./src/", params);
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    cmdCompile += "TwoRoots";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test TwoRoots.";
+
+    cmdExec += "TwoRoots" + executableExtension;
+
+    ASSERT_EQ(system((cmdExec + path + "/TwoRoots/DataTwoRoots.csv").c_str()),
+              0)
+        << "Error wrong action returned in test TwoRoots.";
+});
+
+TEST_F(TPGGenerationEngineTest, InvalidRoots)
+{
+    tpg->addNewTeam();
+    CodeGen::GenerationParameters params;
+    params.roots = {1};
+    ASSERT_THROW(CodeGen::TPGSwitchGenerationEngine("InvalidRoots", *tpg,
+                                                    "./src/", params),
+                 std::invalid_argument)
+        << "Selecting a root absent from the TPGGraph should fail.";
+
+    tpg->addNewTeam();
+    params.roots = {0, 1};
+    params.reentrant = true;
+    params.batchSize = 4;
+    ASSERT_THROW(CodeGen::TPGStackGenerationEngine("InvalidRoots", *tpg,
+                                                   "./src/", params),
+                 std::invalid_argument)
+        << "Batch inference should require a single root.";
+}
 #endif // CODE_GENERATION
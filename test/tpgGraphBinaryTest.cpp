@@ -0,0 +1,237 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "data/primitiveTypeArray.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/rng.h"
+#include "mutator/tpgMutator.h"
+#include "program/program.h"
+#include "tpg/tpgAction.h"
+#include "tpg/tpgEdge.h"
+#include "tpg/tpgGraph.h"
+#include "tpg/tpgTeam.h"
+
+#include "file/tpgGraphBinaryExporter.h"
+#include "file/tpgGraphBinaryImporter.h"
+
+class TPGGraphBinaryTest : public ::testing::Test
+{
+  protected:
+    const size_t size1{24};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Instructions::Set set;
+    Environment* e = NULL;
+    TPG::TPGGraph* tpg = NULL;
+
+    virtual void SetUp()
+    {
+        vect.push_back(
+            *(new Data::PrimitiveTypeArray<double>((unsigned int)size1)));
+
+        auto minus = [](double a, double b) -> double { return a - b; };
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::LambdaInstruction<double, double>(minus)));
+        e = new Environment(set, vect, 8, 5);
+        tpg = new TPG::TPGGraph(*e);
+
+        // Create a random TPG with shared programs and team to team edges
+        Mutator::MutationParameters params;
+        params.tpg.nbActions = 4;
+        params.tpg.maxInitOutgoingEdges = 3;
+        params.tpg.nbRoots = 10;
+        params.tpg.maxOutgoingEdges = 5;
+        params.tpg.pEdgeDeletion = 0.7;
+        params.tpg.pEdgeAddition = 0.7;
+        params.tpg.pProgramMutation = 0.2;
+        params.tpg.pEdgeDestinationChange = 0.1;
+        params.tpg.pEdgeDestinationIsAction = 0.5;
+        params.prog.maxProgramSize = 20;
+        params.prog.pAdd = 0.5;
+        params.prog.pDelete = 0.5;
+        params.prog.pMutate = 1.0;
+        params.prog.pSwap = 1.0;
+        params.prog.pConstantMutation = 0.5;
+        params.prog.minConstValue = -10;
+        params.prog.maxConstValue = 10;
+        Mutator::RNG rng(0);
+        Archive archive;
+        Mutator::TPGMutator::initRandomTPG(*tpg, params, rng);
+        Mutator::TPGMutator::populateTPG(*tpg, archive, params, rng, 1);
+    }
+
+    virtual void TearDown()
+    {
+        delete tpg;
+        delete e;
+        delete (&(vect.at(0).get()));
+        delete (&set.getInstruction(0));
+        delete (&set.getInstruction(1));
+    }
+};
+
+TEST_F(TPGGraphBinaryTest, ExporterConstructor)
+{
+    File::TPGGraphBinaryExporter* exporter;
+    ASSERT_NO_THROW(exporter = new File::TPGGraphBinaryExporter(
+                        "tpg_binary.bin", *tpg))
+        << "The TPGGraphBinaryExporter could not be constructed with a valid "
+           "file path.";
+    ASSERT_NO_THROW(delete exporter)
+        << "TPGGraphBinaryExporter could not be deleted.";
+
+    ASSERT_THROW(
+        exporter = new File::TPGGraphBinaryExporter("XXX://INVALID_PATH", *tpg),
+        std::runtime_error)
+        << "The TPGGraphBinaryExporter construction should fail with an "
+           "invalid path.";
+}
+
+TEST_F(TPGGraphBinaryTest, ExportImport)
+{
+    File::TPGGraphBinaryExporter exporter("tpg_binary.bin", *tpg);
+    ASSERT_NO_THROW(exporter.print()) << "Binary export failed.";
+
+    TPG::TPGGraph tpgCopy(*e);
+    ASSERT_NO_THROW(File::TPGGraphBinaryImporter("tpg_binary.bin", tpgCopy))
+        << "Binary import failed.";
+
+    // Compare vertices
+    auto vertices = tpg->getVertices();
+    auto verticesCopy = tpgCopy.getVertices();
+    ASSERT_EQ(verticesCopy.size(), vertices.size())
+        << "Wrong number of imported vertices.";
+    for (size_t i = 0; i < vertices.size(); i++) {
+        auto action = dynamic_cast<const TPG::TPGAction*>(vertices.at(i));
+        auto actionCopy =
+            dynamic_cast<const TPG::TPGAction*>(verticesCopy.at(i));
+        ASSERT_EQ(action == nullptr, actionCopy == nullptr)
+            << "Wrong type for imported vertex " << i << ".";
+        if (action != nullptr) {
+            ASSERT_EQ(actionCopy->getActionID(), action->getActionID())
+                << "Wrong action ID for imported vertex " << i << ".";
+        }
+    }
+
+    // Compare edges and programs
+    ASSERT_EQ(tpgCopy.getEdges().size(), tpg->getEdges().size())
+        << "Wrong number of imported edges.";
+    std::map<const Program::Program*, const Program::Program*> programs;
+    auto edgeCopy = tpgCopy.getEdges().begin();
+    for (const auto& edge : tpg->getEdges()) {
+        auto vertexIdx = [](const std::vector<const TPG::TPGVertex*>& vect,
+                            const TPG::TPGVertex* vertex) {
+            return std::find(vect.begin(), vect.end(), vertex) - vect.begin();
+        };
+        ASSERT_EQ(vertexIdx(verticesCopy, (*edgeCopy)->getSource()),
+                  vertexIdx(vertices, edge->getSource()))
+            << "Wrong source for imported edge.";
+        ASSERT_EQ(vertexIdx(verticesCopy, (*edgeCopy)->getDestination()),
+                  vertexIdx(vertices, edge->getDestination()))
+            << "Wrong destination for imported edge.";
+
+        // Program sharing is preserved
+        const Program::Program& program = edge->getProgram();
+        const Program::Program& programCopy = (*edgeCopy)->getProgram();
+        auto known = programs.emplace(&program, &programCopy);
+        ASSERT_EQ(known.first->second, &programCopy)
+            << "Program sharing was not preserved.";
+
+        // Program content is preserved
+        ASSERT_EQ(programCopy.getNbLines(), program.getNbLines())
+            << "Wrong number of lines in imported Program.";
+        for (size_t i = 0; i < program.getNbLines(); i++) {
+            ASSERT_EQ(programCopy.getLine(i), program.getLine(i))
+                << "Wrong content for imported Program line.";
+            ASSERT_EQ(programCopy.isIntron(i), program.isIntron(i))
+                << "Wrong intron status for imported Program line.";
+        }
+        for (size_t i = 0; i < e->getNbConstant(); i++) {
+            ASSERT_EQ(programCopy.getConstantAt(i), program.getConstantAt(i))
+                << "Wrong constant in imported Program.";
+        }
+        edgeCopy++;
+    }
+}
+
+TEST_F(TPGGraphBinaryTest, ImportErrors)
+{
+    TPG::TPGGraph tpgCopy(*e);
+    ASSERT_THROW(File::TPGGraphBinaryImporter("XXX://INVALID_PATH", tpgCopy),
+                 std::runtime_error)
+        << "Importing a non-existing file should fail.";
+
+    // Not a binary TPGGraph file
+    {
+        std::ofstream file("tpg_binary_invalid.bin");
+        file << "digraph{ }" << std::endl;
+    }
+    ASSERT_THROW(
+        File::TPGGraphBinaryImporter("tpg_binary_invalid.bin", tpgCopy),
+        std::runtime_error)
+        << "Importing a file with a wrong format should fail.";
+
+    // Truncated file
+    {
+        File::TPGGraphBinaryExporter exporter("tpg_binary.bin", *tpg);
+        exporter.print();
+    }
+    std::ifstream original("tpg_binary.bin", std::ios::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(original)),
+                              std::istreambuf_iterator<char>());
+    {
+        std::ofstream file("tpg_binary_invalid.bin", std::ios::binary);
+        file.write(content.data(), content.size() - 8);
+    }
+    File::TPGGraphBinaryImporter importer("tpg_binary.bin", tpgCopy);
+    uint64_t nbVertices = tpgCopy.getNbVertices();
+    importer.setNewFilePath("tpg_binary_invalid.bin");
+    ASSERT_THROW(importer.importGraph(), std::runtime_error)
+        << "Importing a truncated file should fail.";
+    ASSERT_EQ(tpgCopy.getNbVertices(), nbVertices)
+        << "A failed import should leave the TPGGraph untouched.";
+
+    // Incompatible environment
+    Environment otherEnv(set, vect, 4, 5);
+    TPG::TPGGraph otherTpg(otherEnv);
+    ASSERT_THROW(File::TPGGraphBinaryImporter("tpg_binary.bin", otherTpg),
+                 std::runtime_error)
+        << "Importing a file in an incompatible Environment should fail.";
+}
@@ -735,3 +735,86 @@ TEST_F(TPGTest, TPGAffectationOperator)
     ASSERT_NO_THROW(TPG::TPGGraph& destination = source)
         << "The affectation operator is never supposed to fail";
 }
+
+TEST_F(TPGTest, TPGGraphImportSubGraph)
+{
+    TPG::TPGGraph source(*e);
+    const TPG::TPGTeam& vertex0 = source.addNewTeam();
+    const TPG::TPGAction& vertex1 = source.addNewAction(4);
+    const TPG::TPGTeam& vertex2 = source.addNewTeam();
+    const TPG::TPGTeam& vertex3 = source.addNewTeam();
+
+    Program::Line& line = progPointer->addNewLine();
+    line.setInstructionIndex(1);
+    line.setDestinationIndex(3);
+    line.setOperand(0, 2, 4);
+    progPointer->getConstantHandler().setDataAt(typeid(Data::Constant), 2,
+                                                Data::Constant{7});
+    auto progPointer2 = std::make_shared<Program::Program>(*e);
+
+    source.addNewEdge(vertex0, vertex1, progPointer);
+    source.addNewEdge(vertex0, vertex2, progPointer2);
+    source.addNewEdge(vertex2, vertex1, progPointer);
+    source.addNewEdge(vertex3, vertex1, progPointer2);
+
+    /*
+     *	 T2
+     *	  ^	\
+     *    |	  A4 <- T3
+     *	 T0	/
+     */
+
+    // Destination with its own environment and an existing A4 action.
+    Environment e2(set, vect, 8, 5);
+    TPG::TPGGraph destination(e2);
+    destination.addNewTeam();
+    const TPG::TPGAction& action4 = destination.addNewAction(4);
+
+    const TPG::TPGVertex* copy = nullptr;
+    ASSERT_NO_THROW(copy = &destination.importSubGraph(vertex0))
+        << "Importing a subgraph from another TPGGraph failed.";
+
+    // T0 and T2 are copied, A4 is reused, T3 is not reachable.
+    ASSERT_EQ(destination.getNbVertices(), 4)
+        << "Incorrect number of vertices after the subgraph import.";
+    ASSERT_EQ(destination.getEdges().size(), 3)
+        << "Incorrect number of edges after the subgraph import.";
+    ASSERT_EQ(action4.getIncomingEdges().size(), 2)
+        << "Existing TPGAction should be reused by the imported subgraph.";
+    ASSERT_EQ(destination.getNbRootVertices(), 2)
+        << "The imported root should be a root of the destination.";
+
+    // Outgoing edges order and program sharing are preserved.
+    ASSERT_EQ(copy->getOutgoingEdges().size(), 2);
+    const TPG::TPGEdge* edgeToAction = copy->getOutgoingEdges().front();
+    const TPG::TPGEdge* edgeToTeam = copy->getOutgoingEdges().back();
+    ASSERT_EQ(edgeToAction->getDestination(), &action4)
+        << "Order of the outgoing edges was not preserved.";
+    ASSERT_EQ(&edgeToAction->getProgram(),
+              &edgeToTeam->getDestination()
+                   ->getOutgoingEdges()
+                   .front()
+                   ->getProgram())
+        << "Shared program should remain shared in the copy.";
+    ASSERT_NE(&edgeToAction->getProgram(), progPointer.get())
+        << "Programs should be duplicated.";
+
+    // Program content is copied within the new environment
+    const Program::Program& prog = edgeToAction->getProgram();
+    ASSERT_EQ(&prog.getEnvironment(), &e2)
+        << "Imported program should use the environment of the TPGGraph.";
+    ASSERT_EQ(prog.getNbLines(), 1);
+    ASSERT_EQ(prog.getLine(0).getInstructionIndex(), 1);
+    ASSERT_EQ(prog.getLine(0).getDestinationIndex(), 3);
+    ASSERT_EQ(prog.getLine(0).getOperand(0).first, 2);
+    ASSERT_EQ(prog.getLine(0).getOperand(0).second, 4);
+    ASSERT_EQ((int32_t)prog.getConstantAt(2), 7);
+
+    // Incompatible environment
+    Environment e3(set, vect, 4, 5);
+    TPG::TPGGraph otherDestination(e3);
+    ASSERT_THROW(otherDestination.importSubGraph(vertex0), std::runtime_error)
+        << "Importing programs from an incompatible environment should fail.";
+    ASSERT_EQ(otherDestination.getNbVertices(), 0)
+        << "TPGGraph should be left untouched after a failed import.";
+}